@@ -22,6 +22,37 @@ describe('hierarchyArtifactCompression', () => {
         expect(gunzipSync(result.normalizedBuffer).toString('utf8')).toBe(raw.toString('utf8'));
     });
 
+    it('expands gzipped binary snapshots into gzipped JSON', () => {
+        const snapshot = Buffer.alloc(4 + 1 + 8 + 12 + 4 + 4 + 4 + 4 + 4);
+        snapshot.write('RJHS', 0, 'ascii');
+        snapshot[4] = 1;
+        snapshot.writeBigUInt64BE(BigInt(1234), 5);
+        snapshot.writeUInt32BE(0xffffffff, 25);
+        const result = normalizeHierarchyArtifactBuffer(
+            'tenant/team/project/sessions/id/hierarchy/127.json.gz',
+            gzipSync(snapshot)
+        );
+
+        expect(result.repaired).toBe(true);
+        expect(result.reason).toBe('expanded_binary_snapshot');
+        expect(JSON.parse(gunzipSync(result.normalizedBuffer).toString('utf8'))).toEqual({
+            timestamp: 1234,
+            screen: { width: 0, height: 0, scale: 0 },
+            root: {},
+        });
+    });
+
+    it('gzips raw binary deltas without expanding them', () => {
+        const delta = Buffer.alloc(4 + 1 + 4 + 8 + 12 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
+        delta.write('RJHD', 0, 'ascii');
+        delta[4] = 1;
+        const result = normalizeHierarchyArtifactBuffer('tenant/team/project/sessions/id/hierarchy/128.json.gz', delta);
+
+        expect(result.repaired).toBe(true);
+        expect(result.reason).toBe('compressed_binary_delta');
+        expect(gunzipSync(result.normalizedBuffer)).toEqual(delta);
+    });
+
     it('keeps already-gzipped hierarchy payloads unchanged', () => {
         const gzipped = gzipSync(Buffer.from('{"timestamp":2}', 'utf8'));
         const result = normalizeHierarchyArtifactBuffer('tenant/team/project/sessions/id/hierarchy/124.json.gz', gzipped);
@@ -0,0 +1,292 @@
+import { describe, expect, it } from 'vitest';
+import { gzipSync } from 'zlib';
+import {
+    applyHierarchyDelta,
+    decodeHierarchyDelta,
+    decodeHierarchySnapshot,
+    isHierarchyDelta,
+    isHierarchySnapshot,
+    parseHierarchyArtifactPayload,
+    resolveHierarchyPayloads,
+} from '../services/hierarchySnapshot.js';
+
+type SnapshotNode = {
+    parent: number;
+    type: number;
+    frame: [number, number, number, number];
+    alpha?: number;
+    flags?: number;
+};
+
+function u32(value: number): Buffer {
+    const out = Buffer.alloc(4);
+    out.writeUInt32BE(value >>> 0);
+    return out;
+}
+
+function f32(value: number): Buffer {
+    const out = Buffer.alloc(4);
+    out.writeFloatBE(value);
+    return out;
+}
+
+function encodeStrings(parts: Buffer[], strings: string[]): void {
+    parts.push(u32(strings.length));
+    for (const value of strings) {
+        const bytes = Buffer.from(value, 'utf8');
+        parts.push(u32(bytes.length), bytes);
+    }
+}
+
+function encodeNodeColumns(parts: Buffer[], nodes: SnapshotNode[], params: {
+    attributes?: Array<[number, number, number]>;
+    scrolls?: Array<[number, number, number, number, number]>;
+}): void {
+    for (const node of nodes) parts.push(u32(node.type));
+    for (let axis = 0; axis < 4; axis++) {
+        for (const node of nodes) parts.push(f32(node.frame[axis]));
+    }
+    for (const node of nodes) parts.push(f32(node.alpha ?? 1));
+    for (const node of nodes) {
+        const flags = Buffer.alloc(2);
+        flags.writeUInt16BE(node.flags ?? 0);
+        parts.push(flags);
+    }
+    const attributes = params.attributes ?? [];
+    parts.push(u32(attributes.length));
+    for (const [node, key, value] of attributes) parts.push(u32(node), Buffer.from([key]), u32(value));
+    const scrolls = params.scrolls ?? [];
+    parts.push(u32(scrolls.length));
+    for (const [node, ...values] of scrolls) parts.push(u32(node), ...values.map(f32));
+}
+
+/** Version 1 without `keyframeId`, version 2 with it. */
+function encodeSnapshot(params: {
+    timestamp: number;
+    screenName: number;
+    strings: string[];
+    nodes: SnapshotNode[];
+    attributes?: Array<[number, number, number]>;
+    scrolls?: Array<[number, number, number, number, number]>;
+    keyframeId?: number;
+}): Buffer {
+    const header = Buffer.alloc(13);
+    header.write('RJHS', 0, 'ascii');
+    header[4] = params.keyframeId === undefined ? 1 : 2;
+    header.writeBigUInt64BE(BigInt(params.timestamp), 5);
+    const parts: Buffer[] = [header, f32(390), f32(844), f32(3), u32(params.screenName)];
+    if (params.keyframeId !== undefined) parts.push(u32(params.keyframeId));
+    encodeStrings(parts, params.strings);
+    parts.push(u32(params.nodes.length));
+    for (const node of params.nodes) parts.push(u32(node.parent));
+    encodeNodeColumns(parts, params.nodes, params);
+    return Buffer.concat(parts);
+}
+
+function encodeDelta(params: {
+    keyframeId: number;
+    timestamp: number;
+    screenName: number;
+    strings: string[];
+    rootId: number;
+    upserts: Array<SnapshotNode & { id: number }>;
+    attributes?: Array<[number, number, number]>;
+    childLists?: Array<[number, number[]]>;
+    removed?: number[];
+}): Buffer {
+    const header = Buffer.alloc(17);
+    header.write('RJHD', 0, 'ascii');
+    header[4] = 1;
+    header.writeUInt32BE(params.keyframeId, 5);
+    header.writeBigUInt64BE(BigInt(params.timestamp), 9);
+    const parts: Buffer[] = [header, f32(390), f32(844), f32(3), u32(params.screenName)];
+    encodeStrings(parts, params.strings);
+    parts.push(u32(params.rootId), u32(params.upserts.length));
+    for (const node of params.upserts) parts.push(u32(node.id));
+    encodeNodeColumns(parts, params.upserts, params);
+    const childLists = params.childLists ?? [];
+    parts.push(u32(childLists.length));
+    for (const [parent, ids] of childLists) parts.push(u32(parent), u32(ids.length), ...ids.map(u32));
+    const removed = params.removed ?? [];
+    parts.push(u32(removed.length), ...removed.map(u32));
+    return Buffer.concat(parts);
+}
+
+/** UIWindow > [UIView > UILabel "Hi", UIButton] as keyframe 7. */
+function encodeKeyframe(timestamp: number): Buffer {
+    return encodeSnapshot({
+        timestamp,
+        screenName: 0,
+        keyframeId: 7,
+        strings: ['Home', 'UIWindow', 'UIView', 'UILabel', 'Hi', 'UIButton'],
+        nodes: [
+            { parent: -1, type: 1, frame: [0, 0, 390, 844] },
+            { parent: 0, type: 2, frame: [0, 0, 390, 100] },
+            { parent: 1, type: 3, frame: [10, 10, 50, 20] },
+            { parent: 0, type: 5, frame: [0, 200, 100, 44] },
+        ],
+        attributes: [[2, 4, 4]],
+    });
+}
+
+/** Moves the label, drops the button and adds an image under the window. */
+function encodeKeyframeDelta(keyframeId: number, timestamp: number): Buffer {
+    return encodeDelta({
+        keyframeId,
+        timestamp,
+        screenName: 0,
+        strings: ['Cart', 'UILabel', 'Bye', 'UIImageView'],
+        rootId: 0,
+        upserts: [
+            { id: 2, parent: 0, type: 1, frame: [10, 30, 50, 20] },
+            { id: 4, parent: 0, type: 3, frame: [0, 300, 64, 64], flags: 1 << 5 },
+        ],
+        attributes: [[2, 4, 2]],
+        childLists: [[0, [1, 4]]],
+        removed: [3],
+    });
+}
+
+describe('hierarchySnapshot', () => {
+    it('rebuilds the nested hierarchy tree', () => {
+        const snapshot = encodeSnapshot({
+            timestamp: 1700000000123,
+            screenName: 0,
+            strings: ['Home', 'UIWindow', 'UIScrollView', 'UIButton', 'Buy', '#FF0000', 'UIView'],
+            nodes: [
+                { parent: -1, type: 1, frame: [0, 0, 390, 844] },
+                { parent: 0, type: 2, frame: [0, 50, 390, 700.3333], alpha: 0.5, flags: 1 << 4 },
+                { parent: 1, type: 3, frame: [10, 20, 100, 44], flags: (1 << 2) | (1 << 3) | (1 << 7) },
+                { parent: 0, type: 6, frame: [0, 0, 0, 0], flags: 1 << 6 },
+            ],
+            attributes: [[2, 7, 4], [2, 3, 5], [2, 5, 3]],
+            scrolls: [[1, 0, 120, 390, 2400]],
+        });
+
+        expect(isHierarchySnapshot(snapshot)).toBe(true);
+        expect(decodeHierarchySnapshot(snapshot)).toEqual({
+            timestamp: 1700000000123,
+            screen: { width: 390, height: 844, scale: 3 },
+            screenName: 'Home',
+            root: {
+                type: 'UIWindow',
+                frame: { x: 0, y: 0, w: 390, h: 844 },
+                children: [
+                    {
+                        type: 'UIScrollView',
+                        frame: { x: 0, y: 50, w: 390, h: 700.333 },
+                        alpha: 0.5,
+                        scrollEnabled: true,
+                        contentOffset: { x: 0, y: 120 },
+                        contentSize: { w: 390, h: 2400 },
+                        children: [
+                            {
+                                type: 'UIButton',
+                                frame: { x: 10, y: 20, w: 100, h: 44 },
+                                interactive: true,
+                                enabled: true,
+                                buttonTitle: 'Buy',
+                                bg: '#FF0000',
+                                textLength: 3,
+                            },
+                        ],
+                    },
+                    { type: 'UIView', bailout: true },
+                ],
+            },
+        });
+    });
+
+    it('decodes an empty snapshot without a screen name', () => {
+        const snapshot = encodeSnapshot({ timestamp: 5, screenName: 0xffffffff, strings: [], nodes: [] });
+
+        expect(decodeHierarchySnapshot(snapshot)).toEqual({
+            timestamp: 5,
+            screen: { width: 390, height: 844, scale: 3 },
+            root: {},
+        });
+    });
+
+    it('rejects truncated and inconsistent snapshots', () => {
+        const snapshot = encodeSnapshot({
+            timestamp: 5,
+            screenName: 0xffffffff,
+            strings: ['UIWindow'],
+            nodes: [{ parent: -1, type: 0, frame: [0, 0, 1, 1] }, { parent: 3, type: 0, frame: [0, 0, 1, 1] }],
+        });
+
+        expect(() => decodeHierarchySnapshot(snapshot.subarray(0, snapshot.length - 6))).toThrow('truncated');
+        expect(() => decodeHierarchySnapshot(snapshot)).toThrow('invalid parent');
+        expect(isHierarchySnapshot(Buffer.from('{"root":{}}'))).toBe(false);
+    });
+
+    it('tags keyframe nodes with their ids', () => {
+        const keyframe = decodeHierarchySnapshot(encodeKeyframe(1000));
+
+        expect(keyframe.keyframeId).toBe(7);
+        expect(keyframe.root).toMatchObject({
+            id: 0,
+            children: [{ id: 1, children: [{ id: 2, text: 'Hi' }] }, { id: 3, type: 'UIButton' }],
+        });
+    });
+
+    it('applies a delta to its keyframe', () => {
+        const deltaBuffer = encodeKeyframeDelta(7, 1500);
+        expect(isHierarchyDelta(deltaBuffer)).toBe(true);
+        expect(isHierarchySnapshot(deltaBuffer)).toBe(false);
+
+        const keyframe = decodeHierarchySnapshot(encodeKeyframe(1000));
+        const delta = decodeHierarchyDelta(deltaBuffer);
+        expect(delta.removed).toEqual([3]);
+        expect(delta.childLists.get(0)).toEqual([1, 4]);
+
+        expect(applyHierarchyDelta(keyframe, delta)).toEqual({
+            timestamp: 1500,
+            screen: { width: 390, height: 844, scale: 3 },
+            screenName: 'Cart',
+            keyframeId: 7,
+            root: {
+                id: 0,
+                type: 'UIWindow',
+                frame: { x: 0, y: 0, w: 390, h: 844 },
+                children: [
+                    {
+                        id: 1,
+                        type: 'UIView',
+                        frame: { x: 0, y: 0, w: 390, h: 100 },
+                        children: [
+                            { id: 2, type: 'UILabel', frame: { x: 10, y: 30, w: 50, h: 20 }, text: 'Bye' },
+                        ],
+                    },
+                    { id: 4, type: 'UIImageView', frame: { x: 0, y: 300, w: 64, h: 64 }, hasImage: true },
+                ],
+            },
+        });
+        // The keyframe is left intact for later deltas.
+        expect(keyframe.root).toMatchObject({ children: [{ children: [{ text: 'Hi' }] }, { id: 3 }] });
+    });
+
+    it('resolves stored payloads against the latest earlier keyframe', () => {
+        const payloads = [
+            parseHierarchyArtifactPayload(gzipSync(encodeKeyframe(1000))),
+            parseHierarchyArtifactPayload(gzipSync(encodeKeyframeDelta(7, 1500))),
+            parseHierarchyArtifactPayload(gzipSync(encodeKeyframeDelta(8, 1600))),
+            parseHierarchyArtifactPayload(Buffer.from('{"timestamp":1700,"root":{"type":"View"}}', 'utf8')),
+            parseHierarchyArtifactPayload(gzipSync(encodeKeyframe(2000))),
+            parseHierarchyArtifactPayload(gzipSync(encodeKeyframeDelta(7, 2500))),
+            null,
+        ];
+
+        const resolved = resolveHierarchyPayloads(payloads);
+
+        expect(resolved.map((snapshot) => snapshot?.timestamp ?? null)).toEqual([1000, 1500, null, 1700, 2000, 2500, null]);
+        expect(resolved[1].root.children[0].children[0].text).toBe('Bye');
+        expect(resolved[5].root.children[1].type).toBe('UIImageView');
+    });
+
+    it('rejects truncated deltas', () => {
+        const delta = encodeKeyframeDelta(7, 1500);
+
+        expect(() => decodeHierarchyDelta(delta.subarray(0, delta.length - 2))).toThrow('truncated');
+    });
+});
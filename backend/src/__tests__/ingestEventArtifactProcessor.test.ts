@@ -1,11 +1,16 @@
+import { gzipSync } from 'zlib';
 import { describe, expect, it } from 'vitest';
 import {
     buildWebAttributionMetadata,
     computeMobileFrustrationCountsForIngest,
+    decodeBinaryEventBatch,
     getFrustrationTapKindForIngest,
+    isBinaryEventBatch,
     isKeyboardAreaEventForIngest,
     mergeEventArtifactFrustrationCounts,
     registerTapForIngestRageInference,
+    summarizeEventsArtifact,
+    transcodeBinaryEventsArtifact,
 } from '../services/ingestEventArtifactProcessor.js';
 import { buildClickHouseApiEndpointEventRow } from '../services/clickhouseApiStatsSink.js';
 import { normalizeIngestAppVersion } from '../services/ingestSessionLifecycle.js';
@@ -260,3 +265,86 @@ describe('ingest mobile frustration event compatibility', () => {
         )).toEqual({ rageTapCount: 3, deadTapCount: 4 });
     });
 });
+
+describe('binary event batches', () => {
+    function varint(value: number): number[] {
+        const out: number[] = [];
+        while (value >= 0x80) {
+            out.push((value % 0x80) | 0x80);
+            value = Math.floor(value / 0x80);
+        }
+        out.push(value);
+        return out;
+    }
+    const zigzag = (value: number) => (value >= 0 ? value * 2 : -value * 2 - 1);
+    const inline = (value: string) => {
+        const bytes = Buffer.from(value, 'utf8');
+        return [...varint(bytes.length * 2 + 1), ...bytes];
+    };
+    const ref = (index: number) => varint(index * 2);
+
+    function buildBatch(): Buffer {
+        const meta = Buffer.from('{"platform":"ios"}', 'utf8');
+        const dictionary = ['tap', 'label', 'Buy'];
+        const ratio = Buffer.alloc(8);
+        ratio.writeDoubleLE(0.5);
+        return Buffer.from([
+            ...Buffer.from('RJEB', 'ascii'), 1,
+            ...varint(1_700_000_000_000),
+            ...varint(meta.length), ...meta,
+            ...varint(dictionary.length),
+            ...dictionary.flatMap((entry) => [...varint(entry.length), ...Buffer.from(entry, 'utf8')]),
+            ...varint(2),
+            // { type: 'tap', timestamp: base + 250, label: 'Buy', x: -12, ratio: 0.5, touches: [{ ok: true }, null] }
+            0x03, ...varint(zigzag(250)), ...ref(0), ...varint(4),
+            ...ref(1), 5, ...ref(2),
+            ...inline('x'), 3, ...varint(zigzag(-12)),
+            ...inline('ratio'), 4, ...ratio,
+            ...inline('touches'), 6, ...varint(2), 7, ...varint(1), ...inline('ok'), 2, 0,
+            // { url: 'https://api.example.com' } without timestamp or type
+            0x00, ...varint(1), ...inline('url'), 5, ...inline('https://api.example.com'),
+        ]);
+    }
+
+    it('decodes records, dictionary references and inline strings', () => {
+        const batch = buildBatch();
+        expect(isBinaryEventBatch(batch)).toBe(true);
+        expect(isBinaryEventBatch(Buffer.from('{"events":[]}', 'utf8'))).toBe(false);
+
+        expect(decodeBinaryEventBatch(batch)).toEqual({
+            deviceInfo: { platform: 'ios' },
+            events: [
+                {
+                    type: 'tap',
+                    timestamp: 1_700_000_000_250,
+                    label: 'Buy',
+                    x: -12,
+                    ratio: 0.5,
+                    touches: [{ ok: true }, null],
+                },
+                { url: 'https://api.example.com' },
+            ],
+        });
+    });
+
+    it('transcodes gzipped binary artifacts to the JSON wrapper and leaves JSON alone', () => {
+        const json = transcodeBinaryEventsArtifact(gzipSync(buildBatch()));
+        expect(json).not.toBeNull();
+        const parsed = JSON.parse(json!.toString('utf8'));
+        expect(parsed.deviceInfo.platform).toBe('ios');
+        expect(parsed.events).toHaveLength(2);
+
+        expect(transcodeBinaryEventsArtifact(gzipSync(Buffer.from('{"events":[]}', 'utf8')))).toBeNull();
+    });
+
+    it('summarizes binary artifacts like their JSON equivalent', () => {
+        const summary = summarizeEventsArtifact(gzipSync(buildBatch()));
+        expect(summary.eventCount).toBe(2);
+        expect(summary.startTime).toBe(1_700_000_000_250);
+    });
+
+    it('rejects truncated batches', () => {
+        const batch = buildBatch();
+        expect(() => decodeBinaryEventBatch(batch.subarray(0, batch.length - 3))).toThrow();
+    });
+});
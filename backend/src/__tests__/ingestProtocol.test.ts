@@ -1,5 +1,12 @@
 import { describe, expect, it } from 'vitest';
-import { buildReplaySegmentId, parseBatchId, parseSegmentId } from '../services/ingestProtocol.js';
+import {
+    MAX_REPLAY_SEGMENT_BATCH,
+    buildReplaySegmentId,
+    parseBatchId,
+    parseReplaySegmentCompleteBatch,
+    parseReplaySegmentPresignBatch,
+    parseSegmentId,
+} from '../services/ingestProtocol.js';
 
 describe('ingestProtocol', () => {
     it('parses batch ids for timestamp-based session ids', () => {
@@ -117,4 +124,86 @@ describe('ingestProtocol', () => {
             endTime: 1771045975000,
         });
     });
+
+    it('parses batch presign bodies into per-segment presign requests', () => {
+        const parsed = parseReplaySegmentPresignBatch({
+            sessionId: 'session_aabbccddeeff00112233445566778899',
+            segments: [
+                { kind: 'screenshots', startTime: 1771045974000, endTime: 1771045975000, frameCount: 3, sizeBytes: '2048.7', compression: 'gzip' },
+                { kind: 'hierarchy', startTime: 1771045974000, sizeBytes: 512 },
+            ],
+        });
+
+        expect(parsed.sessionId).toBe('session_aabbccddeeff00112233445566778899');
+        expect(parsed.segments).toEqual([
+            {
+                sessionId: 'session_aabbccddeeff00112233445566778899',
+                kind: 'screenshots',
+                startTime: 1771045974000,
+                endTime: 1771045975000,
+                frameCount: 3,
+                sizeBytes: 2048,
+                compression: 'gzip',
+            },
+            {
+                sessionId: 'session_aabbccddeeff00112233445566778899',
+                kind: 'hierarchy',
+                startTime: 1771045974000,
+                endTime: undefined,
+                frameCount: undefined,
+                sizeBytes: 512,
+                compression: undefined,
+            },
+        ]);
+    });
+
+    it('rejects malformed or oversized batch presign bodies', () => {
+        const segment = { kind: 'screenshots', startTime: 1771045974000, sizeBytes: 1024 };
+
+        expect(() => parseReplaySegmentPresignBatch({ segments: [segment] })).toThrow(/sessionId/);
+        expect(() => parseReplaySegmentPresignBatch({ sessionId: 's', segments: [] })).toThrow(/non-empty/);
+        expect(() => parseReplaySegmentPresignBatch({
+            sessionId: 's',
+            segments: Array.from({ length: MAX_REPLAY_SEGMENT_BATCH + 1 }, () => segment),
+        })).toThrow(/At most/);
+        expect(() => parseReplaySegmentPresignBatch({ sessionId: 's', segments: [segment, { kind: 'rrweb', startTime: 1, sizeBytes: 1 }] }))
+            .toThrow(/segments\[1\]/);
+        expect(() => parseReplaySegmentPresignBatch({ sessionId: 's', segments: [{ ...segment, sizeBytes: 0 }] })).toThrow(/sizeBytes/);
+    });
+
+    it('parses batch completions of one session', () => {
+        const first = buildReplaySegmentId({
+            sessionId: 'session_aabbccddeeff00112233445566778899',
+            kind: 'screenshots',
+            startTime: 1771045974000,
+            endTime: 1771045975000,
+        });
+        const second = buildReplaySegmentId({
+            sessionId: 'session_aabbccddeeff00112233445566778899',
+            kind: 'hierarchy',
+            startTime: 1771045976000,
+        });
+
+        expect(parseReplaySegmentCompleteBatch({
+            segments: [
+                { segmentId: first, actualSizeBytes: 2048, frameCount: 3 },
+                { segmentId: second },
+            ],
+        })).toEqual({
+            sessionId: 'session_aabbccddeeff00112233445566778899',
+            segments: [
+                { segmentId: first, actualSizeBytes: 2048, frameCount: 3 },
+                { segmentId: second, actualSizeBytes: null, frameCount: null },
+            ],
+        });
+
+        const other = buildReplaySegmentId({
+            sessionId: 'session_1771045973773_f81477f8042b4b299ba7de872bf5c0d2',
+            kind: 'screenshots',
+            startTime: 1771045974000,
+        });
+        expect(() => parseReplaySegmentCompleteBatch({ segments: [{ segmentId: first }, { segmentId: other }] }))
+            .toThrow(/one session/);
+        expect(() => parseReplaySegmentCompleteBatch({ segments: [{ actualSizeBytes: 1 }] })).toThrow(/segmentId/);
+    });
 });
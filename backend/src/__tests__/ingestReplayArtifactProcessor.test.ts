@@ -68,6 +68,25 @@ describe('ingestReplayArtifactProcessor', () => {
         expect(log.info).toHaveBeenCalledTimes(1);
     });
 
+    it('verifies binary hierarchy deltas that only remove nodes', async () => {
+        const delta = Buffer.alloc(65);
+        delta.write('RJHD', 0, 'ascii');
+        delta[4] = 1;
+        delta.writeUInt32BE(0xffffffff, 29);
+        delta.writeUInt32BE(1, 57);
+        delta.writeUInt32BE(3, 61);
+
+        await processRecoveredReplayArtifact({
+            artifactId: 'artifact-3',
+            data: delta,
+            job: { kind: 'hierarchy', sessionId: 'session-1' },
+            log,
+            sessionStartTime: 1_771_045_973_773,
+        });
+
+        expect(log.info).toHaveBeenCalledWith(expect.objectContaining({ nodeCount: 0, rootType: 'delta' }), 'Replay hierarchy artifact verified');
+    });
+
     it('rejects hierarchy artifacts without a valid root object', async () => {
         await expect(processRecoveredReplayArtifact({
             artifactId: 'artifact-2',
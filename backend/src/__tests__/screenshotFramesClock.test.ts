@@ -1,3 +1,4 @@
+import { createRequire } from 'node:module';
 import { describe, expect, it, vi } from 'vitest';
 import { gzipSync } from 'zlib';
 
@@ -41,6 +42,23 @@ import {
     normalizeScreenshotArchiveClockFields,
 } from '../services/screenshotFrames.js';
 
+const require = createRequire(import.meta.url);
+const jpegCodec = require('jpeg-js') as {
+    decode: (buffer: Buffer) => { width: number; height: number; data: Uint8Array };
+    encode: (image: { width: number; height: number; data: Buffer }, quality?: number) => { data: Buffer };
+};
+
+function solidJpeg(width: number, height: number, rgb: [number, number, number]): Buffer {
+    const data = Buffer.alloc(width * height * 4);
+    for (let i = 0; i < width * height; i++) {
+        data[i * 4] = rgb[0];
+        data[i * 4 + 1] = rgb[1];
+        data[i * 4 + 2] = rgb[2];
+        data[i * 4 + 3] = 255;
+    }
+    return jpegCodec.encode({ width, height, data }, 95).data;
+}
+
 function tarHeader(name: string, size: number): Buffer {
     const header = Buffer.alloc(512, 0);
     header.write(name, 0, 100, 'utf8');
@@ -74,6 +92,16 @@ function androidBinaryGzipFrame(timestampOffsetMs: number, data: Buffer): Buffer
     return gzipSync(Buffer.concat([header, data]));
 }
 
+function taggedFrameBundle(codec: number, timestampOffsetMs: number, data: Buffer): Buffer {
+    const frame = Buffer.alloc(12);
+    frame.writeUInt32BE(Math.floor(timestampOffsetMs / 0x100000000), 0);
+    frame.writeUInt32BE(timestampOffsetMs >>> 0, 4);
+    frame.writeUInt32BE(data.length, 8);
+    const frames = Buffer.concat([frame, data]);
+    const header = Buffer.from([0x52, 0x4a, 0x46, 0x42, 1, codec]);
+    return Buffer.concat([header, codec === 0 ? frames : gzipSync(frames)]);
+}
+
 describe('screenshot frame clock normalization', () => {
     const rawSessionStartMs = Date.UTC(2026, 5, 27, 12, 15, 14, 606);
     const normalizedSessionStartMs = Date.UTC(2026, 5, 12, 18, 0, 0, 0);
@@ -135,4 +163,144 @@ describe('screenshot frame clock normalization', () => {
         expect(normalized.normalized).toBe(false);
         expect(normalized.data).toEqual(archive);
     });
+
+    it.each([0, 1, 2])('decodes tagged frame bundles with codec %i', async (codec) => {
+        const archive = taggedFrameBundle(codec, 500, jpeg);
+
+        const frames = await extractFramesFromArchive(archive, normalizedSessionStartMs);
+
+        expect(frames).toHaveLength(1);
+        expect(frames[0].timestamp).toBe(normalizedSessionStartMs + 500);
+        expect(frames[0].data).toEqual(jpeg);
+    });
+
+    it('does not rewrite tagged frame bundles', () => {
+        const archive = taggedFrameBundle(0, 500, jpeg);
+
+        const normalized = normalizeScreenshotArchiveClockFields(archive, normalizedSessionStartMs);
+
+        expect(normalized.normalized).toBe(false);
+        expect(normalized.data).toEqual(archive);
+    });
+
+    it('returns no frames for tagged bundles with an unknown codec', async () => {
+        const archive = taggedFrameBundle(9, 500, jpeg);
+
+        await expect(extractFramesFromArchive(archive, normalizedSessionStartMs)).resolves.toEqual([]);
+    });
+
+    it('expands repeat records into copies of the previous frame', async () => {
+        const frame = (offsetMs: number, data: Buffer) => {
+            const header = Buffer.alloc(12);
+            header.writeUInt32BE(offsetMs, 4);
+            header.writeUInt32BE(data.length, 8);
+            return Buffer.concat([header, data]);
+        };
+        const archive = Buffer.concat([
+            Buffer.from([0x52, 0x4a, 0x46, 0x42, 1, 0]),
+            frame(500, jpeg),
+            frame(1500, Buffer.alloc(0)),
+            frame(2500, Buffer.alloc(0)),
+        ]);
+
+        const frames = await extractFramesFromArchive(archive, normalizedSessionStartMs);
+
+        expect(frames.map((f) => f.timestamp)).toEqual([
+            normalizedSessionStartMs + 500,
+            normalizedSessionStartMs + 1500,
+            normalizedSessionStartMs + 2500,
+        ]);
+        expect(frames[2].data).toEqual(jpeg);
+    });
+
+    it('reads per-frame JPEG qualities from version 2 bundles', async () => {
+        const frame = (offsetMs: number, data: Buffer) => {
+            const header = Buffer.alloc(12);
+            header.writeUInt32BE(offsetMs, 4);
+            header.writeUInt32BE(data.length, 8);
+            return Buffer.concat([header, data]);
+        };
+        const body = Buffer.concat([frame(500, jpeg), frame(1500, Buffer.alloc(0)), frame(2500, jpeg)]);
+
+        for (const codec of [0, 2]) {
+            const archive = Buffer.concat([
+                Buffer.from([0x52, 0x4a, 0x46, 0x42, 2, codec, 0, 3, 50, 50, 0]),
+                codec === 0 ? body : gzipSync(body),
+            ]);
+
+            const frames = await extractFramesFromArchive(archive, normalizedSessionStartMs);
+
+            expect(frames.map((f) => f.quality)).toEqual([50, 50, undefined]);
+            expect(frames[2].data).toEqual(jpeg);
+        }
+    });
+});
+
+describe('screenshot tile delta frames', () => {
+    const sessionStartMs = Date.UTC(2026, 5, 12, 18, 0, 0, 0);
+
+    function frame(offsetMs: number, data: Buffer): Buffer {
+        const header = Buffer.alloc(12);
+        header.writeUInt32BE(offsetMs, 4);
+        header.writeUInt32BE(data.length, 8);
+        return Buffer.concat([header, data]);
+    }
+
+    function tileDelta(width: number, height: number, tiles: Array<[number, number]>, atlas: Buffer | null): Buffer {
+        const header = Buffer.alloc(15 + tiles.length * 4);
+        header.write('RJTD', 0, 'ascii');
+        header[4] = 1;
+        header.writeUInt16BE(16, 5);
+        header.writeUInt16BE(width, 7);
+        header.writeUInt16BE(height, 9);
+        header.writeUInt16BE(Math.ceil(Math.sqrt(tiles.length)), 11);
+        header.writeUInt16BE(tiles.length, 13);
+        tiles.forEach(([column, row], i) => {
+            header.writeUInt16BE(column, 15 + i * 4);
+            header.writeUInt16BE(row, 17 + i * 4);
+        });
+        return atlas ? Buffer.concat([header, atlas]) : header;
+    }
+
+    function pixel(image: { width: number; data: Uint8Array }, x: number, y: number): number[] {
+        const i = (y * image.width + x) * 4;
+        return [image.data[i], image.data[i + 1], image.data[i + 2]];
+    }
+
+    it('composites changed tiles over the latest full frame', async () => {
+        const keyframe = solidJpeg(40, 40, [255, 0, 0]);
+        const archive = Buffer.concat([
+            Buffer.from([0x52, 0x4a, 0x46, 0x42, 1, 0]),
+            frame(0, keyframe),
+            frame(1000, tileDelta(40, 40, [[1, 1]], solidJpeg(16, 16, [0, 0, 255]))),
+            frame(2000, Buffer.alloc(0)),
+            frame(3000, tileDelta(40, 40, [], null)),
+        ]);
+
+        const frames = await extractFramesFromArchive(archive, sessionStartMs);
+
+        expect(frames).toHaveLength(4);
+        const composited = jpegCodec.decode(frames[1].data);
+        expect(composited.width).toBe(40);
+        const inside = pixel(composited, 24, 24);
+        const outside = pixel(composited, 4, 4);
+        expect(inside[2]).toBeGreaterThan(200);
+        expect(inside[0]).toBeLessThan(50);
+        expect(outside[0]).toBeGreaterThan(200);
+        expect(outside[2]).toBeLessThan(50);
+        expect(frames[2].data).toBe(frames[1].data);
+        expect(pixel(jpegCodec.decode(frames[3].data), 24, 24)[0]).toBeGreaterThan(200);
+    });
+
+    it('skips tile deltas that do not match the keyframe', async () => {
+        const archive = Buffer.concat([
+            Buffer.from([0x52, 0x4a, 0x46, 0x42, 1, 0]),
+            frame(0, solidJpeg(40, 40, [255, 0, 0])),
+            frame(1000, tileDelta(80, 40, [], null)),
+        ]);
+
+        const frames = await extractFramesFromArchive(archive, sessionStartMs);
+
+        expect(frames).toHaveLength(1);
+    });
 });
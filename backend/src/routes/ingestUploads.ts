@@ -40,6 +40,8 @@ import {
     buildReplaySegmentId,
     extractDeviceIdFromUploadToken,
     parseBatchId,
+    parseReplaySegmentCompleteBatch,
+    parseReplaySegmentPresignBatch,
     parseRequestedSizeBytes,
     parseSegmentId,
 } from '../services/ingestProtocol.js';
@@ -878,6 +880,277 @@ router.post(
     })
 );
 
+function countReplaySegmentSessionStart(projectId: string, teamId: string, session: any, deviceId: string | null): void {
+    incrementProjectSessionCount(projectId, teamId, 1)
+        .then(() => {
+            logger.debug({ projectId, teamId, sessionId: session.id }, 'Captured session counted for usage');
+        })
+        .catch((err) => {
+            logger.warn({ err, projectId, teamId, sessionId: session.id }, 'Failed to increment captured session count');
+        });
+
+    updateDeviceUsage(deviceId || session.deviceId || null, projectId, {
+        sessionsStarted: 1,
+    }).catch(() => {});
+}
+
+type ReplaySegmentPresignContext = {
+    route: string;
+    projectId: string;
+    teamId: string;
+    project: any;
+    session: any;
+    serverNow: Date;
+    segmentDeviceId: string | null;
+    replayBillingGate: ReplayBillingGate;
+};
+
+/**
+ * Per-segment half of a replay segment presign, once the project and session
+ * are resolved and the session accepts new work: segment-level skips, the
+ * artifact row and its relay URL. Returns the response body for the segment,
+ * so the batch route answers many segments with one project and session
+ * lookup.
+ */
+async function presignReplaySegment(
+    ctx: ReplaySegmentPresignContext,
+    data: any,
+    requestedSizeBytes: number,
+    idempotencyKey?: string,
+): Promise<Record<string, unknown>> {
+    const { route, projectId, teamId, project, session, segmentDeviceId, replayBillingGate } = ctx;
+    const rawStartTimeInt = Math.floor(Number(data.startTime));
+    const rawEndTimeInt = data.endTime ? Math.floor(Number(data.endTime)) : null;
+    const normalizedTiming = normalizeArtifactTimeRangeForSession({
+        session,
+        serverNow: ctx.serverNow,
+        timestamp: rawStartTimeInt,
+        startTime: rawStartTimeInt,
+        endTime: rawEndTimeInt,
+    });
+    const startTimeInt = normalizedTiming.startTime ?? rawStartTimeInt;
+    const endTimeInt = normalizedTiming.endTime;
+
+    if (data.kind === 'screenshots' && !session.isSampledIn) {
+        logIngestPresignSkip({
+            route,
+            projectId,
+            reason: 'session_sampled_out',
+            sessionId: data.sessionId,
+            kind: data.kind,
+        });
+        return {
+            skipUpload: true,
+            sessionId: data.sessionId,
+            reason: 'Session sampled out - recording disabled for this session',
+        };
+    }
+
+    if (data.kind === 'screenshots' && session.replayQuotaBillingExhausted) {
+        logIngestPresignSkip({
+            route,
+            projectId,
+            reason: 'replay_quota_billing_exhausted',
+            sessionId: data.sessionId,
+            kind: data.kind,
+        });
+        return {
+            skipUpload: true,
+            sessionId: session.id,
+            reason: replayBillingGate.reason || 'Replay quota reached. Analytics will continue without replay.',
+        };
+    }
+
+    if ((data.kind === 'screenshots' || data.kind === 'hierarchy') && project.maxRecordingMinutes) {
+        const maxRecordingMs = project.maxRecordingMinutes * 60 * 1000;
+        const sessionStartMs = session.startedAt.getTime();
+        const segmentStartMs = startTimeInt;
+        const segmentEndMs = endTimeInt ?? segmentStartMs;
+        const wallGraceMs = 120_000;
+        const elapsedStartMs = segmentStartMs - sessionStartMs;
+        const elapsedEndMs = segmentEndMs - sessionStartMs;
+
+        if (elapsedStartMs > maxRecordingMs) {
+            logIngestPresignSkip({
+                route,
+                projectId,
+                reason: 'exceeds_max_recording_duration',
+                sessionId: data.sessionId,
+                kind: data.kind,
+                extra: {
+                    segmentStartMs,
+                    segmentEndMs,
+                    sessionStartMs,
+                    elapsedStartMs,
+                    maxRecordingMs,
+                    maxRecordingMinutes: project.maxRecordingMinutes,
+                },
+            });
+
+            return {
+                skipUpload: true,
+                sessionId: data.sessionId,
+                reason: `Recording limit exceeded (${project.maxRecordingMinutes} minutes max)`,
+            };
+        }
+
+        if (elapsedEndMs > maxRecordingMs + wallGraceMs) {
+            logIngestPresignSkip({
+                route,
+                projectId,
+                reason: 'exceeds_max_recording_duration_end',
+                sessionId: data.sessionId,
+                kind: data.kind,
+                extra: {
+                    segmentStartMs,
+                    segmentEndMs,
+                    sessionStartMs,
+                    elapsedEndMs,
+                    maxRecordingMs,
+                    wallGraceMs,
+                    maxRecordingMinutes: project.maxRecordingMinutes,
+                },
+            });
+
+            return {
+                skipUpload: true,
+                sessionId: data.sessionId,
+                reason: `Recording limit exceeded (${project.maxRecordingMinutes} minutes max)`,
+            };
+        }
+    }
+
+    let extension: string;
+    let subFolder: string;
+
+    switch (data.kind) {
+        case 'screenshots':
+            extension = 'tar.gz';
+            subFolder = 'screenshots';
+            break;
+        case 'hierarchy':
+            extension = data.compression === 'gzip' ? 'json.gz' : 'json';
+            subFolder = 'hierarchy';
+            break;
+        default:
+            extension = 'bin';
+            subFolder = 'other';
+    }
+
+    const segmentId = buildReplaySegmentId({
+        sessionId: session.id,
+        kind: data.kind,
+        startTime: startTimeInt,
+        endTime: endTimeInt,
+        frameCount: data.frameCount,
+        declaredSizeBytes: requestedSizeBytes,
+    });
+    const filename = `${startTimeInt}.${extension}`;
+    const s3Key = generateS3Key(teamId, projectId, session.id, subFolder, filename);
+    const endpoint = await getEndpointForSession(session.id, projectId);
+
+    const preparation = await prepareReplayArtifactForUpload({
+        projectId,
+        sessionId: session.id,
+        kind: data.kind,
+        s3ObjectKey: s3Key,
+        endpointId: endpoint.id,
+        clientUploadId: segmentId,
+        declaredSizeBytes: requestedSizeBytes,
+        timestamp: startTimeInt,
+        startTime: startTimeInt,
+        endTime: endTimeInt,
+        frameCount: data.frameCount || null,
+        prefetchedSession: session,
+    });
+    if (preparation.action === 'skip') {
+        if (idempotencyKey) {
+            await setIdempotencyStatus(projectId, idempotencyKey, 'done', segmentId);
+        }
+
+        logIngestPresignSkip({
+            route,
+            projectId,
+            reason: 'replay_segment_already_processed',
+            sessionId: session.id,
+            kind: data.kind,
+            deduplicated: true,
+            extra: { segmentId },
+        });
+
+        return {
+            skipUpload: true,
+            deduplicated: true,
+            sessionId: session.id,
+            segmentId,
+            reason: 'Already processed',
+        };
+    }
+
+    const artifact = preparation.artifact;
+    const presignedUrl = buildArtifactUploadRelayUrl({
+        artifactId: artifact.id,
+        projectId,
+        sessionId: session.id,
+        kind: data.kind,
+    });
+
+    if (segmentDeviceId) {
+        updateDeviceUsage(segmentDeviceId, projectId, { requestCount: 1 }).catch(() => {});
+    }
+
+    if (idempotencyKey) {
+        await setIdempotencyStatus(projectId, idempotencyKey, 'processing');
+    }
+
+    const relayCtx = getUploadRelayBuildContext();
+    logger.info(
+        {
+            event: 'ingest.replay_relay_url_issued',
+            sessionId: session.id,
+            projectId,
+            artifactId: artifact.id,
+            segmentId,
+            kind: data.kind,
+            preparationAction: preparation.action,
+            isSampledIn: session.isSampledIn,
+            recordingEnabled: project.recordingEnabled,
+            relayHost: relayCtx.relayHost,
+            relayBaseUrl: relayCtx.relayBaseUrl,
+            publicBaseSource: relayCtx.publicBaseSource,
+            uploadPathTemplate: `/upload/artifacts/${artifact.id}`,
+            tokenTtlSeconds: ARTIFACT_UPLOAD_URL_TTL_SECONDS,
+            startTime: data.startTime,
+            endTime: data.endTime,
+            frameCount: data.frameCount,
+            sizeBytes: requestedSizeBytes,
+            s3KeySuffix: s3Key.length > 80 ? s3Key.slice(-80) : s3Key,
+            endpointId: endpoint.id,
+        },
+        'ingest.replay_relay_url_issued',
+    );
+
+    logger.info({
+        sessionId: session.id,
+        artifactId: artifact.id,
+        segmentId,
+        kind: data.kind,
+        startTime: data.startTime,
+        endTime: data.endTime,
+        frameCount: data.frameCount,
+        sizeBytes: requestedSizeBytes,
+        action: preparation.action,
+    }, 'Replay segment presigned URL generated');
+
+    return {
+        presignedUrl,
+        segmentId,
+        sessionId: session.id,
+        s3Key,
+        endpointId: endpoint.id,
+    };
+}
+
 router.post(
     '/segment/presign',
     apiKeyAuth,
@@ -1012,264 +1285,30 @@ router.post(
             replayQuotaBillingExhausted: replayBillingGate.replayQuotaBillingExhausted,
         }, existingSession);
 
-        const rawStartTimeInt = Math.floor(Number(data.startTime));
-        const rawEndTimeInt = data.endTime ? Math.floor(Number(data.endTime)) : null;
         const serverNow = new Date();
         // Pass the session we already have so maybeBackfillSessionStartedAt skips its SELECT
         // when the timestamp is already correct (the common case).
-        const backfilledSession = await maybeBackfillSessionStartedAt(session.id, rawStartTimeInt, session, serverNow);
+        const backfilledSession = await maybeBackfillSessionStartedAt(session.id, Math.floor(Number(data.startTime)), session, serverNow);
         if (backfilledSession) {
             session = backfilledSession;
         }
-        const normalizedTiming = normalizeArtifactTimeRangeForSession({
-            session,
-            serverNow,
-            timestamp: rawStartTimeInt,
-            startTime: rawStartTimeInt,
-            endTime: rawEndTimeInt,
-        });
-        const startTimeInt = normalizedTiming.startTime ?? rawStartTimeInt;
-        const endTimeInt = normalizedTiming.endTime;
 
         assertSessionAcceptsNewIngestWork(session);
 
         if (isNewSession && project.rejourneyEnabled) {
-            incrementProjectSessionCount(projectId, teamId, 1)
-                .then(() => {
-                    logger.debug({ projectId, teamId, sessionId: session.id }, 'Captured session counted for usage');
-                })
-                .catch((err) => {
-                    logger.warn({ err, projectId, teamId, sessionId: session.id }, 'Failed to increment captured session count');
-                });
-
-            updateDeviceUsage(segmentDeviceId || session.deviceId || null, projectId, {
-                sessionsStarted: 1,
-            }).catch(() => {});
+            countReplaySegmentSessionStart(projectId, teamId, session, segmentDeviceId);
         }
 
-        if (data.kind === 'screenshots' && !session.isSampledIn) {
-            logIngestPresignSkip({
-                route: '/api/ingest/segment/presign',
-                projectId,
-                reason: 'session_sampled_out',
-                sessionId: data.sessionId,
-                kind: data.kind,
-            });
-            res.json({
-                skipUpload: true,
-                sessionId: data.sessionId,
-                reason: 'Session sampled out - recording disabled for this session',
-            });
-            return;
-        }
-
-        if (data.kind === 'screenshots' && session.replayQuotaBillingExhausted) {
-            logIngestPresignSkip({
-                route: '/api/ingest/segment/presign',
-                projectId,
-                reason: 'replay_quota_billing_exhausted',
-                sessionId: data.sessionId,
-                kind: data.kind,
-            });
-            res.json({
-                skipUpload: true,
-                sessionId: session.id,
-                reason: replayBillingGate.reason || 'Replay quota reached. Analytics will continue without replay.',
-            });
-            return;
-        }
-
-        if ((data.kind === 'screenshots' || data.kind === 'hierarchy') && project.maxRecordingMinutes) {
-            const maxRecordingMs = project.maxRecordingMinutes * 60 * 1000;
-            const sessionStartMs = session.startedAt.getTime();
-            const segmentStartMs = startTimeInt;
-            const segmentEndMs = endTimeInt ?? segmentStartMs;
-            const wallGraceMs = 120_000;
-            const elapsedStartMs = segmentStartMs - sessionStartMs;
-            const elapsedEndMs = segmentEndMs - sessionStartMs;
-
-            if (elapsedStartMs > maxRecordingMs) {
-                logIngestPresignSkip({
-                    route: '/api/ingest/segment/presign',
-                    projectId,
-                    reason: 'exceeds_max_recording_duration',
-                    sessionId: data.sessionId,
-                    kind: data.kind,
-                    extra: {
-                        segmentStartMs,
-                        segmentEndMs,
-                        sessionStartMs,
-                        elapsedStartMs,
-                        maxRecordingMs,
-                        maxRecordingMinutes: project.maxRecordingMinutes,
-                    },
-                });
-
-                res.json({
-                    skipUpload: true,
-                    sessionId: data.sessionId,
-                    reason: `Recording limit exceeded (${project.maxRecordingMinutes} minutes max)`,
-                });
-                return;
-            }
-
-            if (elapsedEndMs > maxRecordingMs + wallGraceMs) {
-                logIngestPresignSkip({
-                    route: '/api/ingest/segment/presign',
-                    projectId,
-                    reason: 'exceeds_max_recording_duration_end',
-                    sessionId: data.sessionId,
-                    kind: data.kind,
-                    extra: {
-                        segmentStartMs,
-                        segmentEndMs,
-                        sessionStartMs,
-                        elapsedEndMs,
-                        maxRecordingMs,
-                        wallGraceMs,
-                        maxRecordingMinutes: project.maxRecordingMinutes,
-                    },
-                });
-
-                res.json({
-                    skipUpload: true,
-                    sessionId: data.sessionId,
-                    reason: `Recording limit exceeded (${project.maxRecordingMinutes} minutes max)`,
-                });
-                return;
-            }
-        }
-
-        let extension: string;
-        let subFolder: string;
-
-        switch (data.kind) {
-            case 'screenshots':
-                extension = 'tar.gz';
-                subFolder = 'screenshots';
-                break;
-            case 'hierarchy':
-                extension = data.compression === 'gzip' ? 'json.gz' : 'json';
-                subFolder = 'hierarchy';
-                break;
-            default:
-                extension = 'bin';
-                subFolder = 'other';
-        }
-
-        const segmentId = buildReplaySegmentId({
-            sessionId: session.id,
-            kind: data.kind,
-            startTime: startTimeInt,
-            endTime: endTimeInt,
-            frameCount: data.frameCount,
-            declaredSizeBytes: requestedSizeBytes,
-        });
-        const filename = `${startTimeInt}.${extension}`;
-        const s3Key = generateS3Key(teamId, projectId, session.id, subFolder, filename);
-        const endpoint = await getEndpointForSession(session.id, projectId);
-
-        const preparation = await prepareReplayArtifactForUpload({
+        res.json(await presignReplaySegment({
+            route: '/api/ingest/segment/presign',
             projectId,
-            sessionId: session.id,
-            kind: data.kind,
-            s3ObjectKey: s3Key,
-            endpointId: endpoint.id,
-            clientUploadId: segmentId,
-            declaredSizeBytes: requestedSizeBytes,
-            timestamp: startTimeInt,
-            startTime: startTimeInt,
-            endTime: endTimeInt,
-            frameCount: data.frameCount || null,
-            prefetchedSession: session,
-        });
-        if (preparation.action === 'skip') {
-            if (idempotencyKey) {
-                await setIdempotencyStatus(projectId, idempotencyKey, 'done', segmentId);
-            }
-
-            logIngestPresignSkip({
-                route: '/api/ingest/segment/presign',
-                projectId,
-                reason: 'replay_segment_already_processed',
-                sessionId: session.id,
-                kind: data.kind,
-                deduplicated: true,
-                extra: { segmentId },
-            });
-
-            res.json({
-                skipUpload: true,
-                deduplicated: true,
-                sessionId: session.id,
-                segmentId,
-                reason: 'Already processed',
-            });
-            return;
-        }
-
-        const artifact = preparation.artifact;
-        const presignedUrl = buildArtifactUploadRelayUrl({
-            artifactId: artifact.id,
-            projectId,
-            sessionId: session.id,
-            kind: data.kind,
-        });
-
-        if (segmentDeviceId) {
-            updateDeviceUsage(segmentDeviceId, projectId, { requestCount: 1 }).catch(() => {});
-        }
-
-        if (idempotencyKey) {
-            await setIdempotencyStatus(projectId, idempotencyKey, 'processing');
-        }
-
-        const relayCtx = getUploadRelayBuildContext();
-        logger.info(
-            {
-                event: 'ingest.replay_relay_url_issued',
-                sessionId: session.id,
-                projectId,
-                artifactId: artifact.id,
-                segmentId,
-                kind: data.kind,
-                preparationAction: preparation.action,
-                isSampledIn: session.isSampledIn,
-                recordingEnabled: project.recordingEnabled,
-                relayHost: relayCtx.relayHost,
-                relayBaseUrl: relayCtx.relayBaseUrl,
-                publicBaseSource: relayCtx.publicBaseSource,
-                uploadPathTemplate: `/upload/artifacts/${artifact.id}`,
-                tokenTtlSeconds: ARTIFACT_UPLOAD_URL_TTL_SECONDS,
-                startTime: data.startTime,
-                endTime: data.endTime,
-                frameCount: data.frameCount,
-                sizeBytes: requestedSizeBytes,
-                s3KeySuffix: s3Key.length > 80 ? s3Key.slice(-80) : s3Key,
-                endpointId: endpoint.id,
-            },
-            'ingest.replay_relay_url_issued',
-        );
-
-        logger.info({
-            sessionId: session.id,
-            artifactId: artifact.id,
-            segmentId,
-            kind: data.kind,
-            startTime: data.startTime,
-            endTime: data.endTime,
-            frameCount: data.frameCount,
-            sizeBytes: requestedSizeBytes,
-            action: preparation.action,
-        }, 'Replay segment presigned URL generated');
-
-        res.json({
-            presignedUrl,
-            segmentId,
-            sessionId: session.id,
-            s3Key,
-            endpointId: endpoint.id,
-        });
+            teamId,
+            project,
+            session,
+            serverNow,
+            segmentDeviceId,
+            replayBillingGate,
+        }, data, requestedSizeBytes, idempotencyKey));
     })
 );
 
@@ -1347,4 +1386,185 @@ router.post(
     })
 );
 
+/**
+ * Presigns up to MAX_REPLAY_SEGMENT_BATCH segments of one session in one
+ * round-trip. The project, byte budget, billing gate and session are
+ * resolved once for the whole batch; each entry of `segments` in the
+ * response is what /segment/presign would have answered for that segment.
+ */
+router.post(
+    '/segment/presign/batch',
+    apiKeyAuth,
+    requireScope('ingest'),
+    ingestSegmentProjectRateLimiter,
+    ingestSegmentDeviceRateLimiter,
+    asyncHandler(async (req, res) => {
+        const data = req.body;
+        const projectId = req.project!.id;
+        const teamId = req.project!.teamId;
+        const route = '/api/ingest/segment/presign/batch';
+        const { sessionId, segments } = parseReplaySegmentPresignBatch(data);
+        const segmentDeviceId = extractDeviceIdFromUploadToken(req);
+
+        const [, project, existingSession] = await Promise.all([
+            enforceIngestByteBudget({
+                projectId,
+                deviceId: segmentDeviceId,
+                clientIp: getRequestIp(req),
+                bytes: segments.reduce((total, segment) => total + segment.sizeBytes, 0),
+                endpoint: 'segment/presign',
+            }),
+            loadProjectForIngest(projectId),
+            findExistingProjectSession(projectId, sessionId, { hydrateCacheHit: true }),
+        ]);
+
+        if (!project) {
+            throw ApiError.notFound('Project not found');
+        }
+
+        if (!project.rejourneyEnabled) {
+            throw ApiError.forbidden('Rejourney is disabled for this project');
+        }
+
+        const sampleSkipReason = samplingSkipReason(project, data, req);
+        if (sampleSkipReason) {
+            logIngestPresignSkip({ route, projectId, reason: sampleSkipReason, sessionId });
+            res.json({
+                sessionId,
+                segments: segments.map(() => ({
+                    skipUpload: true,
+                    sessionId,
+                    reason: 'Session sampled out - recording disabled for this session',
+                })),
+            });
+            return;
+        }
+
+        const replayBillingGate = existingSession
+            ? { replayQuotaBillingExhausted: Boolean(existingSession.replayQuotaBillingExhausted), reason: 'Replay quota reached. Analytics will continue without replay.' }
+            : await resolveReplayBillingGate(teamId);
+
+        let { session, created: isNewSession } = await ensureIngestSession(projectId, sessionId, req, {
+            platform: data.platform,
+            deviceModel: data.deviceModel,
+            appVersion: data.appVersion,
+            deviceId: segmentDeviceId || undefined,
+            sdkVersion: typeof data.sdkVersion === 'string' ? data.sdkVersion : undefined,
+        }, {
+            replayQuotaBillingExhausted: replayBillingGate.replayQuotaBillingExhausted,
+        }, existingSession);
+
+        const serverNow = new Date();
+        const earliestStartTime = Math.min(...segments.map((segment) => Math.floor(Number(segment.startTime))));
+        const backfilledSession = await maybeBackfillSessionStartedAt(session.id, earliestStartTime, session, serverNow);
+        if (backfilledSession) {
+            session = backfilledSession;
+        }
+
+        assertSessionAcceptsNewIngestWork(session);
+
+        if (isNewSession && project.rejourneyEnabled) {
+            countReplaySegmentSessionStart(projectId, teamId, session, segmentDeviceId);
+        }
+
+        const ctx: ReplaySegmentPresignContext = {
+            route,
+            projectId,
+            teamId,
+            project,
+            session,
+            serverNow,
+            segmentDeviceId,
+            replayBillingGate,
+        };
+        const results = await Promise.all(segments.map((segment) => {
+            if (!project.recordingEnabled && segment.kind === 'screenshots') {
+                logIngestPresignSkip({
+                    route,
+                    projectId,
+                    reason: 'recording_disabled_for_project',
+                    sessionId,
+                    kind: segment.kind,
+                });
+                return {
+                    skipUpload: true,
+                    sessionId,
+                    reason: 'Recording disabled for project',
+                };
+            }
+            return presignReplaySegment(ctx, segment, segment.sizeBytes);
+        }));
+
+        res.json({ sessionId: session.id, segments: results });
+    })
+);
+
+/**
+ * Confirms up to MAX_REPLAY_SEGMENT_BATCH uploaded segments of one session.
+ * Each entry of `segments` in the response is what /segment/complete would
+ * have answered for that segment.
+ */
+router.post(
+    '/segment/complete/batch',
+    apiKeyAuth,
+    requireScope('ingest'),
+    ingestSegmentProjectRateLimiter,
+    asyncHandler(async (req, res) => {
+        const projectId = req.project!.id;
+        const { sessionId, segments } = parseReplaySegmentCompleteBatch(req.body);
+        const normalizedSdkTelemetry = normalizeSdkTelemetry(req.body.sdkTelemetry);
+        const log = logger.child({
+            route: '/api/ingest/segment/complete/batch',
+            projectId,
+            sessionId,
+            segmentCount: segments.length,
+        });
+
+        const [segSession] = await db
+            .select()
+            .from(sessions)
+            .where(and(eq(sessions.id, sessionId), eq(sessions.projectId, projectId)))
+            .limit(1);
+        const segSessionOpen = Boolean(segSession && !isSessionIngestImmutable(segSession));
+        if (normalizedSdkTelemetry && segSessionOpen) {
+            const sdkUpdates = buildSdkTelemetryMergeSet(normalizedSdkTelemetry);
+            if (Object.keys(sdkUpdates).length > 0) {
+                await db.update(sessionMetrics)
+                    .set(sdkUpdates)
+                    .where(eq(sessionMetrics.sessionId, sessionId));
+            }
+        }
+
+        const completions = await Promise.all(segments.map((segment) => completeArtifactUpload({
+            projectId,
+            clientUploadId: segment.segmentId,
+            actualSizeBytes: segment.actualSizeBytes,
+            frameCount: segment.frameCount,
+        })));
+
+        const deviceId = extractDeviceIdFromUploadToken(req);
+        updateDeviceUsage(deviceId, projectId, {
+            bytesUploaded: segments.reduce((total, segment) => total + (segment.actualSizeBytes || 0), 0),
+            requestCount: 1,
+        }).catch(() => {});
+
+        log.info({
+            hadSdkTelemetry: Boolean(normalizedSdkTelemetry && segSessionOpen),
+            queued: completions.filter((completion) => completion.queued).length,
+            alreadyCompleted: completions.filter((completion) => completion.alreadyCompleted).length,
+            ignored: completions.filter((completion) => completion.ignored).length,
+        }, 'Replay segments completed');
+
+        res.json({
+            success: true,
+            segments: segments.map((segment, index) => ({
+                segmentId: segment.segmentId,
+                success: true,
+                queued: completions[index].queued,
+                alreadyCompleted: completions[index].alreadyCompleted,
+            })),
+        });
+    })
+);
+
 export default router;
@@ -56,6 +56,11 @@ import {
     sessionArchiveIssueFilterUsesMetrics,
 } from '../services/sessionArchiveFilters.js';
 import { hasSuccessfulRecording } from '../services/replayAvailability.js';
+import {
+    parseHierarchyArtifactPayload,
+    resolveHierarchyPayloads,
+    type HierarchyArtifactPayload,
+} from '../services/hierarchySnapshot.js';
 import {
     deriveSessionPresentationState,
     type SessionPresentationState,
@@ -2309,43 +2314,42 @@ async function loadHierarchyPayload(session: any, artifactsList: any[]) {
         .filter((a) => a.kind === 'hierarchy')
         .sort((a, b) => (a.timestamp || 0) - (b.timestamp || 0));
 
-    const snapshots = await mapWithConcurrency(
+    const payloads = await mapWithConcurrency(
         hierarchyArtifacts,
         DETAIL_FETCH_CONCURRENCY,
         async (artifact) => {
             try {
                 const data = await downloadFromS3ForArtifact(session.projectId, artifact.s3ObjectKey, artifact.endpointId);
-                if (!data) return null;
-                const parsed = (() => {
-                    const isGzipped = (data.length > 2 && data[0] === 0x1f && data[1] === 0x8b) ||
-                        artifact.s3ObjectKey.endsWith('.gz');
-                    if (isGzipped) {
-                        try {
-                            return JSON.parse(gunzipSync(data).toString());
-                        } catch {
-                            return JSON.parse(data.toString());
-                        }
-                    }
-                    return JSON.parse(data.toString());
-                })();
-                const rootElement = parsed.rootElement || parsed.root || parsed;
-                return {
-                    timestamp: artifact.timestamp || parsed.timestamp || 0,
-                    screenName: parsed.screenName || null,
-                    screen: parsed.screen || rootElement?.screen || null,
-                    rootElement,
-                };
+                return data ? parseHierarchyArtifactPayload(data) : null;
             } catch {
                 return null;
             }
         }
     );
 
-    return snapshots
-        .filter((snapshot): snapshot is { timestamp: number; screenName: string | null; rootElement: any; screen: any } => Boolean(snapshot))
+    return toHierarchySnapshotEntries(hierarchyArtifacts, payloads)
         .sort((a, b) => (a.timestamp || 0) - (b.timestamp || 0));
 }
 
+type HierarchySnapshotEntry = { timestamp: number; screenName: string | null; rootElement: any; screen: any };
+
+/** Resolve deltas against their keyframes and shape snapshots for the dashboard. */
+function toHierarchySnapshotEntries(artifacts: any[], payloads: Array<HierarchyArtifactPayload | null>): HierarchySnapshotEntry[] {
+    const entries: HierarchySnapshotEntry[] = [];
+    resolveHierarchyPayloads(payloads).forEach((parsed, index) => {
+        if (!parsed) return;
+        // Support both 'rootElement' (expected) and 'root' (Android SDK legacy)
+        const rootElement = parsed.rootElement || parsed.root || parsed;
+        entries.push({
+            timestamp: artifacts[index].timestamp || parsed.timestamp || 0,
+            screenName: parsed.screenName || null,
+            screen: parsed.screen || rootElement?.screen || null,
+            rootElement,
+        });
+    });
+    return entries;
+}
+
 async function sendRrwebSegmentForSession(res: any, session: any, sessionId: string, rawArtifactId: string, cacheControl = 'private, max-age=300') {
     const artifactId = rawArtifactId
         .replace(/\.json\.gz$/i, '')
@@ -3677,40 +3681,17 @@ router.get(
 
         // Download and embed hierarchy snapshots that remain after retention.
         hierarchyArtifacts.sort((a, b) => (a.timestamp || 0) - (b.timestamp || 0));
+        const hierarchyPayloads: Array<HierarchyArtifactPayload | null> = [];
         for (const artifact of hierarchyArtifacts) {
             try {
                 const data = await downloadFromS3ForArtifact(session.projectId, artifact.s3ObjectKey, artifact.endpointId);
-                if (data) {
-                    const parsed = (() => {
-                        // Check for GZip compression (magic bytes: 0x1f 0x8b) or file extension
-                        const isGzipped = (data.length > 2 && data[0] === 0x1f && data[1] === 0x8b) ||
-                            artifact.s3ObjectKey.endsWith('.gz');
-
-                        if (isGzipped) {
-                            try {
-                                const decompressed = gunzipSync(data);
-                                return JSON.parse(decompressed.toString());
-                            } catch {
-                                // Fallback to raw parsing if decompression fails (might be mislabeled)
-                                return JSON.parse(data.toString());
-                            }
-                        }
-                        return JSON.parse(data.toString());
-                    })();
-
-                    // Support both 'rootElement' (expected) and 'root' (Android SDK legacy)
-                    const rootElement = parsed.rootElement || parsed.root || parsed;
-                    hierarchySnapshots.push({
-                        timestamp: artifact.timestamp || parsed.timestamp || 0,
-                        screenName: parsed.screenName || null,
-                        screen: parsed.screen || rootElement?.screen || null,
-                        rootElement,
-                    });
-                }
+                hierarchyPayloads.push(data ? parseHierarchyArtifactPayload(data) : null);
             } catch {
                 // Silently skip failed artifacts - they may be corrupted or missing
+                hierarchyPayloads.push(null);
             }
         }
+        hierarchySnapshots.push(...toHierarchySnapshotEntries(hierarchyArtifacts, hierarchyPayloads));
 
         allEvents.sort((a: any, b: any) => (a.timestamp || 0) - (b.timestamp || 0));
         allNetwork.sort((a: any, b: any) => (a.timestamp || 0) - (b.timestamp || 0));
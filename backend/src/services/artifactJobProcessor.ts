@@ -4,7 +4,7 @@ import { db, projects, recordingArtifacts, sessionMetrics, sessions } from '../d
 import { downloadFromS3ForArtifact } from '../db/s3.js';
 import { logger } from '../logger.js';
 import { ensureHierarchyArtifactCompressed } from './hierarchyArtifactCompression.js';
-import { summarizeEventsArtifact } from './ingestEventArtifactProcessor.js';
+import { ensureEventsArtifactJson, summarizeEventsArtifact } from './ingestEventArtifactProcessor.js';
 import { processAnrsArtifact, processCrashesArtifact } from './ingestFaultArtifactProcessors.js';
 import { processRecoveredReplayArtifact } from './ingestReplayArtifactProcessor.js';
 import { normalizeScreenshotArchiveClockFieldsInStorage } from './screenshotFrames.js';
@@ -93,10 +93,19 @@ export const artifactProcessors: Record<string, ArtifactProcessor> = {
     events: async (context) => {
         const data = await downloadFromS3ForArtifact(context.projectId, context.s3Key, context.artifact.endpointId);
         if (!data) throw new Error('Artifact payload missing from S3 for events');
-        const normalized = await normalizeArtifactPayloadClockFieldsInStorage({
+        const decoded = await ensureEventsArtifactJson({
             artifactId: context.job.artifactId,
             data,
             endpointId: context.artifact.endpointId,
+            log: context.log,
+            projectId: context.projectId,
+            s3Key: context.s3Key,
+            sessionId: context.job.sessionId,
+        });
+        const normalized = await normalizeArtifactPayloadClockFieldsInStorage({
+            artifactId: context.job.artifactId,
+            data: decoded.data,
+            endpointId: context.artifact.endpointId,
             kind: 'events',
             log: context.log,
             projectId: context.projectId,
@@ -106,7 +115,7 @@ export const artifactProcessors: Record<string, ArtifactProcessor> = {
         const summary = summarizeEventsArtifact(normalized.data);
         return {
             ...summary,
-            sizeBytes: normalized.uploadedSizeBytes ?? normalized.data.length,
+            sizeBytes: normalized.uploadedSizeBytes ?? decoded.uploadedSizeBytes ?? normalized.data.length,
         };
     },
     crashes: async (context) => {
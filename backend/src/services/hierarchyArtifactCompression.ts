@@ -1,16 +1,17 @@
-import { gzipSync } from 'zlib';
+import { gunzipSync, gzipSync } from 'zlib';
 import {
     downloadRawFromS3ForArtifact,
     getObjectSizeBytesForArtifact,
     uploadToS3ForArtifact,
 } from '../db/s3.js';
 import { logger } from '../logger.js';
+import { decodeHierarchySnapshot, isHierarchyDelta, isHierarchySnapshot } from './hierarchySnapshot.js';
 
 export interface HierarchyArtifactNormalizationResult {
     repaired: boolean;
     normalizedBuffer: Buffer;
     contentType: 'application/gzip';
-    reason: 'not_target' | 'already_gzipped' | 'recompressed_raw_json' | 'invalid_raw_payload';
+    reason: 'not_target' | 'already_gzipped' | 'recompressed_raw_json' | 'expanded_binary_snapshot' | 'compressed_binary_delta' | 'invalid_raw_payload';
 }
 
 export interface EnsureHierarchyArtifactCompressedResult {
@@ -23,6 +24,25 @@ export function isGzipBuffer(buffer: Buffer | Uint8Array): boolean {
     return buffer.length >= 2 && buffer[0] === 0x1f && buffer[1] === 0x8b;
 }
 
+/**
+ * Expand a (possibly gzipped) binary snapshot into gzipped hierarchy JSON.
+ * Returns null if the payload is not a binary snapshot; throws if it is one
+ * but cannot be decoded.
+ */
+function expandBinarySnapshot(buffer: Buffer): Buffer | null {
+    let inner = buffer;
+    if (isGzipBuffer(buffer)) {
+        try {
+            inner = gunzipSync(buffer);
+        } catch {
+            return null;
+        }
+    }
+    if (!isHierarchySnapshot(inner)) return null;
+    const json = Buffer.from(JSON.stringify(decodeHierarchySnapshot(inner)), 'utf8');
+    return gzipSync(json, { level: 9 });
+}
+
 export function normalizeHierarchyArtifactBuffer(
     s3Key: string,
     buffer: Buffer
@@ -36,6 +56,26 @@ export function normalizeHierarchyArtifactBuffer(
         };
     }
 
+    let expanded: Buffer | null;
+    try {
+        expanded = expandBinarySnapshot(buffer);
+    } catch {
+        return {
+            repaired: false,
+            normalizedBuffer: buffer,
+            contentType: 'application/gzip',
+            reason: 'invalid_raw_payload',
+        };
+    }
+    if (expanded) {
+        return {
+            repaired: true,
+            normalizedBuffer: expanded,
+            contentType: 'application/gzip',
+            reason: 'expanded_binary_snapshot',
+        };
+    }
+
     if (isGzipBuffer(buffer)) {
         return {
             repaired: false,
@@ -45,6 +85,16 @@ export function normalizeHierarchyArtifactBuffer(
         };
     }
 
+    // Deltas stay binary; they are applied to their keyframe on read.
+    if (isHierarchyDelta(buffer)) {
+        return {
+            repaired: true,
+            normalizedBuffer: gzipSync(buffer, { level: 9 }),
+            contentType: 'application/gzip',
+            reason: 'compressed_binary_delta',
+        };
+    }
+
     try {
         JSON.parse(buffer.toString('utf8'));
     } catch {
@@ -89,7 +139,7 @@ export async function ensureHierarchyArtifactCompressed(params: {
                 artifactId,
                 sessionId,
                 s3Key,
-            }, 'Hierarchy artifact looks mislabeled but raw bytes are not valid JSON; leaving object unchanged');
+            }, 'Hierarchy artifact is neither valid JSON nor a decodable snapshot; leaving object unchanged');
         }
 
         return {
@@ -120,7 +170,8 @@ export async function ensureHierarchyArtifactCompressed(params: {
         s3Key,
         endpointId: uploadResult.endpointId,
         sizeBytes: sizeBytes ?? normalized.normalizedBuffer.length,
-    }, 'Normalized raw hierarchy JSON artifact to gzip in S3');
+        reason: normalized.reason,
+    }, 'Normalized hierarchy artifact to gzipped JSON in S3');
 
     return {
         repaired: true,
@@ -0,0 +1,423 @@
+/**
+ * Binary view hierarchy snapshots
+ *
+ * Decodes the flat snapshot written by the SDK's native core
+ * (packages/react-native/cpp/HierarchySnapshot.h) back into the nested JSON
+ * tree the dashboard reads. Layout, all big-endian:
+ *
+ *   "RJHS" u8 version
+ *   u64 timestampMs, f32 screenWidth, f32 screenHeight, f32 screenScale,
+ *   u32 screenName string id, u32 keyframeId (version 2 only)
+ *   u32 stringCount, then per string: u32 byte length, UTF-8 bytes
+ *   u32 nodeCount, then columns: i32 parent, u32 type, f32 x, f32 y,
+ *     f32 width, f32 height, f32 alpha, u16 flags
+ *   u32 attributeCount, then per attribute: u32 node, u8 key, u32 value
+ *   u32 scrollCount, then per scroll: u32 node, f32 offsetX, f32 offsetY,
+ *     f32 contentWidth, f32 contentHeight
+ *
+ * Node 0 is the root and parents always precede their children. In version
+ * 2 a node's index is its id, and later deltas
+ * (packages/react-native/cpp/HierarchyDelta.h) patch the snapshot by id:
+ *
+ *   "RJHD" u8 version, u32 keyframeId
+ *   u64 timestampMs, f32 screenWidth, f32 screenHeight, f32 screenScale,
+ *   u32 screenName string id
+ *   u32 stringCount, then per string: u32 byte length, UTF-8 bytes
+ *   u32 rootId
+ *   u32 upsertCount, then columns: u32 id, u32 type, f32 x, f32 y,
+ *     f32 width, f32 height, f32 alpha, u16 flags
+ *   u32 attributeCount, then per attribute: u32 id, u8 key, u32 value
+ *   u32 scrollCount, then per scroll: u32 id, f32 offsetX, f32 offsetY,
+ *     f32 contentWidth, f32 contentHeight
+ *   u32 childListCount, then per list: u32 parentId, u32 count, u32 ids
+ *   u32 removedCount, then u32 ids
+ *
+ * Deltas are stored as uploaded and applied to their keyframe on read.
+ */
+
+import { gunzipSync } from 'zlib';
+
+const HIERARCHY_SNAPSHOT_MAGIC = Buffer.from('RJHS', 'ascii');
+const HIERARCHY_SNAPSHOT_VERSION = 2;
+const HIERARCHY_DELTA_MAGIC = Buffer.from('RJHD', 'ascii');
+const HIERARCHY_DELTA_VERSION = 1;
+const NO_STRING = 0xffffffff;
+
+const FLAG_HIDDEN = 1 << 0;
+const FLAG_MASKED = 1 << 1;
+const FLAG_INTERACTIVE = 1 << 2;
+const FLAG_ENABLED = 1 << 3;
+const FLAG_SCROLL_ENABLED = 1 << 4;
+const FLAG_HAS_IMAGE = 1 << 5;
+const FLAG_BAILOUT = 1 << 6;
+const FLAG_HAS_ENABLED = 1 << 7;
+
+const STRING_ATTRIBUTES: Record<number, string> = {
+    1: 'testID',
+    2: 'label',
+    3: 'bg',
+    4: 'text',
+    6: 'placeholder',
+    7: 'buttonTitle',
+};
+const ATTRIBUTE_TEXT_LENGTH = 5;
+
+type JsonNode = Record<string, unknown>;
+
+export interface HierarchySnapshotJson {
+    timestamp: number;
+    screen: { width: number; height: number; scale: number };
+    root: JsonNode;
+    screenName?: string;
+    /** Set on keyframes that deltas may refer to; nodes then carry an `id`. */
+    keyframeId?: number;
+}
+
+export interface HierarchyDelta {
+    keyframeId: number;
+    timestamp: number;
+    screen: { width: number; height: number; scale: number };
+    screenName?: string;
+    rootId: number;
+    /** Replaced or added nodes, without children. */
+    upserts: Map<number, JsonNode>;
+    /** Replaced ordered child ids. */
+    childLists: Map<number, number[]>;
+    removed: number[];
+}
+
+export type HierarchyArtifactPayload =
+    | { kind: 'snapshot'; snapshot: any }
+    | { kind: 'delta'; delta: HierarchyDelta };
+
+function hasMagic(buffer: Buffer, magic: Buffer): boolean {
+    return buffer.length > magic.length && buffer.subarray(0, magic.length).equals(magic);
+}
+
+export function isHierarchySnapshot(buffer: Buffer): boolean {
+    return hasMagic(buffer, HIERARCHY_SNAPSHOT_MAGIC);
+}
+
+export function isHierarchyDelta(buffer: Buffer): boolean {
+    return hasMagic(buffer, HIERARCHY_DELTA_MAGIC);
+}
+
+/** Float32 columns carry noise past the third decimal; points need no more. */
+function round(value: number): number {
+    return Math.round(value * 1000) / 1000;
+}
+
+class SnapshotReader {
+    private offset = 0;
+
+    constructor(private readonly buffer: Buffer) {}
+
+    private take(bytes: number): number {
+        if (this.offset + bytes > this.buffer.length) {
+            throw new Error('Hierarchy snapshot is truncated');
+        }
+        const at = this.offset;
+        this.offset += bytes;
+        return at;
+    }
+
+    u8(): number { return this.buffer.readUInt8(this.take(1)); }
+    u16(): number { return this.buffer.readUInt16BE(this.take(2)); }
+    u32(): number { return this.buffer.readUInt32BE(this.take(4)); }
+    i32(): number { return this.buffer.readInt32BE(this.take(4)); }
+    u64(): number { return Number(this.buffer.readBigUInt64BE(this.take(8))); }
+    f32(): number { return round(this.buffer.readFloatBE(this.take(4))); }
+
+    utf8(length: number): string {
+        const at = this.take(length);
+        return this.buffer.toString('utf8', at, at + length);
+    }
+
+    /** Guards counts read from the payload before allocating for them. */
+    count(bytesEach: number): number {
+        const count = this.u32();
+        if (count * bytesEach > this.buffer.length - this.offset) {
+            throw new Error('Hierarchy snapshot is truncated');
+        }
+        return count;
+    }
+
+    column<T>(count: number, read: () => T): T[] {
+        const values = new Array<T>(count);
+        for (let i = 0; i < count; i++) values[i] = read();
+        return values;
+    }
+}
+
+type NodeColumns = {
+    ids: number[];
+    parents: number[];
+    flags: number[];
+    nodes: JsonNode[];
+};
+
+function readScreen(reader: SnapshotReader) {
+    return { width: reader.f32(), height: reader.f32(), scale: reader.f32() };
+}
+
+function readStrings(reader: SnapshotReader): (id: number) => string {
+    const strings = reader.column(reader.count(4), () => reader.utf8(reader.u32()));
+    return (id: number): string => {
+        if (id >= strings.length) throw new Error(`Hierarchy snapshot string ${id} out of range`);
+        return strings[id];
+    };
+}
+
+/**
+ * Node columns of a snapshot (with parents, ids are indices) or of a delta
+ * (with ids, no parents). `withIds` adds each node's id to its JSON.
+ */
+function readNodes(
+    reader: SnapshotReader,
+    stringAt: (id: number) => string,
+    layout: 'snapshot' | 'delta',
+    withIds: boolean
+): NodeColumns {
+    const count = reader.count(30);
+    const parents = layout === 'snapshot' ? reader.column(count, () => reader.i32()) : [];
+    const ids = layout === 'delta'
+        ? reader.column(count, () => reader.u32())
+        : Array.from({ length: count }, (_, i) => i);
+    const types = reader.column(count, () => reader.u32());
+    const xs = reader.column(count, () => reader.f32());
+    const ys = reader.column(count, () => reader.f32());
+    const widths = reader.column(count, () => reader.f32());
+    const heights = reader.column(count, () => reader.f32());
+    const alphas = reader.column(count, () => reader.f32());
+    const flags = reader.column(count, () => reader.u16());
+
+    const nodes: JsonNode[] = new Array(count);
+    for (let i = 0; i < count; i++) {
+        const type = stringAt(types[i]);
+        const node: JsonNode = withIds ? { id: ids[i], type } : { type };
+        nodes[i] = node;
+        if (flags[i] & FLAG_BAILOUT) {
+            node.bailout = true;
+            continue;
+        }
+        node.frame = { x: xs[i], y: ys[i], w: widths[i], h: heights[i] };
+        if (flags[i] & FLAG_HIDDEN) node.hidden = true;
+        if (alphas[i] < 1) node.alpha = alphas[i];
+        if (flags[i] & FLAG_MASKED) node.masked = true;
+        if (flags[i] & FLAG_INTERACTIVE) node.interactive = true;
+        if (flags[i] & FLAG_HAS_ENABLED) node.enabled = Boolean(flags[i] & FLAG_ENABLED);
+        if (flags[i] & FLAG_HAS_IMAGE) node.hasImage = true;
+    }
+    return { ids, parents, flags, nodes };
+}
+
+/** Attribute and scroll side tables; `id` is a node index or delta id. */
+function readSideTables(reader: SnapshotReader, stringAt: (id: number) => string, columns: NodeColumns): void {
+    const indexById = new Map<number, number>();
+    columns.ids.forEach((id, index) => indexById.set(id, index));
+    const indexOf = (id: number): number => {
+        const index = indexById.get(id);
+        if (index === undefined) throw new Error(`Hierarchy snapshot node ${id} out of range`);
+        return index;
+    };
+
+    const attributeCount = reader.count(9);
+    for (let i = 0; i < attributeCount; i++) {
+        const node = columns.nodes[indexOf(reader.u32())];
+        const key = reader.u8();
+        const value = reader.u32();
+        if (key === ATTRIBUTE_TEXT_LENGTH) {
+            node.textLength = value;
+        } else if (STRING_ATTRIBUTES[key]) {
+            node[STRING_ATTRIBUTES[key]] = stringAt(value);
+        }
+    }
+
+    const scrollCount = reader.count(20);
+    for (let i = 0; i < scrollCount; i++) {
+        const index = indexOf(reader.u32());
+        const node = columns.nodes[index];
+        node.scrollEnabled = Boolean(columns.flags[index] & FLAG_SCROLL_ENABLED);
+        node.contentOffset = { x: reader.f32(), y: reader.f32() };
+        node.contentSize = { w: reader.f32(), h: reader.f32() };
+    }
+}
+
+/**
+ * Expand a binary snapshot into the nested `{ timestamp, screen, root }`
+ * tree older SDKs upload as JSON. Throws if the payload is malformed.
+ */
+export function decodeHierarchySnapshot(buffer: Buffer): HierarchySnapshotJson {
+    if (!isHierarchySnapshot(buffer)) {
+        throw new Error('Not a hierarchy snapshot');
+    }
+    const reader = new SnapshotReader(buffer.subarray(HIERARCHY_SNAPSHOT_MAGIC.length));
+    const version = reader.u8();
+    if (version !== 1 && version !== HIERARCHY_SNAPSHOT_VERSION) {
+        throw new Error(`Unsupported hierarchy snapshot version ${version}`);
+    }
+    const timestamp = reader.u64();
+    const screen = readScreen(reader);
+    const screenNameId = reader.u32();
+    const keyframeId = version >= 2 ? reader.u32() : undefined;
+    const stringAt = readStrings(reader);
+    const columns = readNodes(reader, stringAt, 'snapshot', keyframeId !== undefined);
+    readSideTables(reader, stringAt, columns);
+
+    const { nodes, parents } = columns;
+    for (let i = 1; i < nodes.length; i++) {
+        const parent = parents[i];
+        if (parent < 0 || parent >= i) {
+            throw new Error(`Hierarchy snapshot node ${i} has invalid parent ${parent}`);
+        }
+        const parentNode = nodes[parent];
+        const children = (parentNode.children as JsonNode[] | undefined) ?? [];
+        children.push(nodes[i]);
+        parentNode.children = children;
+    }
+
+    const result: HierarchySnapshotJson = {
+        timestamp,
+        screen,
+        root: nodes.length > 0 ? nodes[0] : {},
+    };
+    if (screenNameId !== NO_STRING) {
+        result.screenName = stringAt(screenNameId);
+    }
+    if (keyframeId !== undefined) {
+        result.keyframeId = keyframeId;
+    }
+    return result;
+}
+
+export function decodeHierarchyDelta(buffer: Buffer): HierarchyDelta {
+    if (!isHierarchyDelta(buffer)) {
+        throw new Error('Not a hierarchy delta');
+    }
+    const reader = new SnapshotReader(buffer.subarray(HIERARCHY_DELTA_MAGIC.length));
+    const version = reader.u8();
+    if (version !== HIERARCHY_DELTA_VERSION) {
+        throw new Error(`Unsupported hierarchy delta version ${version}`);
+    }
+    const keyframeId = reader.u32();
+    const timestamp = reader.u64();
+    const screen = readScreen(reader);
+    const screenNameId = reader.u32();
+    const stringAt = readStrings(reader);
+    const rootId = reader.u32();
+    const columns = readNodes(reader, stringAt, 'delta', true);
+    readSideTables(reader, stringAt, columns);
+
+    const childLists = new Map<number, number[]>();
+    const childListCount = reader.count(8);
+    for (let i = 0; i < childListCount; i++) {
+        const parentId = reader.u32();
+        childLists.set(parentId, reader.column(reader.count(4), () => reader.u32()));
+    }
+    const removed = reader.column(reader.count(4), () => reader.u32());
+
+    const delta: HierarchyDelta = {
+        keyframeId,
+        timestamp,
+        screen,
+        rootId,
+        upserts: new Map(columns.ids.map((id, index) => [id, columns.nodes[index]])),
+        childLists,
+        removed,
+    };
+    if (screenNameId !== NO_STRING) {
+        delta.screenName = stringAt(screenNameId);
+    }
+    return delta;
+}
+
+/**
+ * Rebuild the full snapshot a delta describes from its decoded keyframe.
+ * Nodes the delta does not mention are shared with `keyframe`.
+ */
+export function applyHierarchyDelta(keyframe: HierarchySnapshotJson, delta: HierarchyDelta): HierarchySnapshotJson {
+    const fields = new Map<number, JsonNode>();
+    const childIds = new Map<number, number[]>();
+    const pending: JsonNode[] = [keyframe.root];
+    while (pending.length > 0) {
+        const node = pending.pop()!;
+        if (typeof node.id !== 'number') continue;
+        const { children, ...rest } = node;
+        const childNodes = Array.isArray(children) ? (children as JsonNode[]) : [];
+        fields.set(node.id, rest);
+        childIds.set(node.id, childNodes.map((child) => child.id as number));
+        pending.push(...childNodes);
+    }
+
+    for (const id of delta.removed) {
+        fields.delete(id);
+        childIds.delete(id);
+    }
+    for (const [id, node] of delta.upserts) fields.set(id, node);
+    for (const [id, ids] of delta.childLists) childIds.set(id, ids);
+
+    const visited = new Set<number>();
+    const build = (id: number): JsonNode | null => {
+        const node = fields.get(id);
+        if (!node || visited.has(id)) return null;
+        visited.add(id);
+        const children = (childIds.get(id) ?? [])
+            .map(build)
+            .filter((child): child is JsonNode => child !== null);
+        return children.length > 0 ? { ...node, children } : node;
+    };
+
+    const result: HierarchySnapshotJson = {
+        timestamp: delta.timestamp,
+        screen: delta.screen,
+        root: build(delta.rootId) ?? {},
+        keyframeId: delta.keyframeId,
+    };
+    if (delta.screenName !== undefined) {
+        result.screenName = delta.screenName;
+    }
+    return result;
+}
+
+/** Decode a stored hierarchy artifact: legacy JSON, a binary snapshot or a delta. */
+export function parseHierarchyArtifactPayload(data: Buffer): HierarchyArtifactPayload {
+    let raw = data;
+    if (data.length > 2 && data[0] === 0x1f && data[1] === 0x8b) {
+        try {
+            raw = gunzipSync(data);
+        } catch {
+            // Mislabeled; parse as is.
+        }
+    }
+    if (isHierarchyDelta(raw)) return { kind: 'delta', delta: decodeHierarchyDelta(raw) };
+    if (isHierarchySnapshot(raw)) return { kind: 'snapshot', snapshot: decodeHierarchySnapshot(raw) };
+    return { kind: 'snapshot', snapshot: JSON.parse(raw.toString('utf8')) };
+}
+
+/**
+ * Replace every delta with the full snapshot it describes, using the
+ * keyframes among `payloads`. A delta whose keyframe is missing resolves to
+ * null. Keyframe ids restart with the app process, so a delta uses the
+ * latest matching keyframe taken before it.
+ */
+export function resolveHierarchyPayloads(payloads: Array<HierarchyArtifactPayload | null>): Array<any | null> {
+    const keyframes = new Map<number, HierarchySnapshotJson[]>();
+    for (const payload of payloads) {
+        if (payload?.kind !== 'snapshot' || typeof payload.snapshot?.keyframeId !== 'number') continue;
+        const candidates = keyframes.get(payload.snapshot.keyframeId) ?? [];
+        candidates.push(payload.snapshot);
+        keyframes.set(payload.snapshot.keyframeId, candidates);
+    }
+
+    return payloads.map((payload) => {
+        if (!payload) return null;
+        if (payload.kind === 'snapshot') return payload.snapshot;
+        const candidates = keyframes.get(payload.delta.keyframeId) ?? [];
+        let keyframe: HierarchySnapshotJson | null = null;
+        for (const candidate of candidates) {
+            if (candidate.timestamp > payload.delta.timestamp) continue;
+            if (!keyframe || candidate.timestamp > keyframe.timestamp) keyframe = candidate;
+        }
+        return keyframe ? applyHierarchyDelta(keyframe, payload.delta) : null;
+    });
+}
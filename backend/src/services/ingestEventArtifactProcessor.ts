@@ -1,8 +1,8 @@
 import { createHash } from 'crypto';
-import { gunzipSync } from 'zlib';
+import { gunzipSync, gzipSync } from 'zlib';
 import { and, eq, sql } from 'drizzle-orm';
 import { db, sessions, sessionMetrics, anrs, errors, recordingArtifacts } from '../db/client.js';
-import { downloadFromS3ForArtifact } from '../db/s3.js';
+import { downloadFromS3ForArtifact, uploadToS3ForArtifact } from '../db/s3.js';
 import { trackANRAsIssue, trackErrorAsIssue } from './issueTracker.js';
 import { normalizeIngestAppVersion, normalizeIngestSdkVersion } from './ingestSessionLifecycle.js';
 import { getUniqueScreenCount, mergeScreenPaths, normalizeScreenPath } from '../utils/screenPaths.js';
@@ -181,8 +181,215 @@ async function recomputeCanonicalMobileFrustrationCounts(params: {
 
 function parseMaybeGzippedJson(data: Buffer): any {
     const isGzipped = data.length >= 2 && data[0] === 0x1f && data[1] === 0x8b;
-    const raw = isGzipped ? gunzipSync(data).toString('utf8') : data.toString('utf8');
-    return JSON.parse(raw);
+    const raw = isGzipped ? gunzipSync(data) : data;
+    if (isBinaryEventBatch(raw)) {
+        return decodeBinaryEventBatch(raw);
+    }
+    return JSON.parse(raw.toString('utf8'));
+}
+
+// ─── Binary event batches ("RJEB") ───────────────────────────────────────────
+//
+// Native SDKs encode each event once when it is recorded and upload the
+// concatenated records (see packages/react-native/cpp/EventCodec.h):
+//
+//   "RJEB" u8 version, varint baseTimestampMs, varint metaLength + deviceInfo JSON,
+//   varint dictionaryCount x (varint length + UTF-8), varint eventCount x record
+//
+// Records are u8 flags (1 = timestamp, 2 = type), [zigzag varint timestamp delta],
+// [stringRef type], varint fieldCount x (stringRef key, value). A stringRef varint
+// is a dictionary index when even and an inline string of (v >> 1) bytes when odd.
+
+const BINARY_EVENT_BATCH_MAGIC = Buffer.from('RJEB', 'ascii');
+const BINARY_EVENT_BATCH_VERSION = 1;
+const RECORD_HAS_TIMESTAMP = 0x01;
+const RECORD_HAS_TYPE = 0x02;
+const MAX_BINARY_NESTING_DEPTH = 64;
+
+export type DecodedEventBatch = {
+    events: Record<string, unknown>[];
+    deviceInfo: Record<string, unknown>;
+};
+
+export function isBinaryEventBatch(data: Buffer): boolean {
+    return data.length >= 5 && data.subarray(0, 4).equals(BINARY_EVENT_BATCH_MAGIC);
+}
+
+class BinaryEventBatchReader {
+    private pos = 0;
+    readonly dictionary: string[] = [];
+
+    constructor(private readonly data: Buffer) {}
+
+    get done(): boolean {
+        return this.pos >= this.data.length;
+    }
+
+    byte(): number {
+        if (this.pos >= this.data.length) throw new Error('Truncated binary event batch');
+        return this.data[this.pos++];
+    }
+
+    varint(): number {
+        let value = 0;
+        let multiplier = 1;
+        for (let i = 0; i < 10; i++) {
+            const byte = this.byte();
+            value += (byte & 0x7f) * multiplier;
+            if ((byte & 0x80) === 0) return value;
+            multiplier *= 128;
+        }
+        throw new Error('Malformed varint in binary event batch');
+    }
+
+    zigzag(): number {
+        const value = this.varint();
+        return value % 2 === 0 ? value / 2 : -(value + 1) / 2;
+    }
+
+    utf8(length: number): string {
+        const end = this.pos + length;
+        if (end > this.data.length) throw new Error('Truncated binary event batch');
+        const value = this.data.toString('utf8', this.pos, end);
+        this.pos = end;
+        return value;
+    }
+
+    double(): number {
+        if (this.pos + 8 > this.data.length) throw new Error('Truncated binary event batch');
+        const value = this.data.readDoubleLE(this.pos);
+        this.pos += 8;
+        return value;
+    }
+
+    stringRef(): string {
+        const ref = this.varint();
+        if (ref % 2 === 1) return this.utf8((ref - 1) / 2);
+        const entry = this.dictionary[ref / 2];
+        if (entry === undefined) throw new Error('Binary event batch references unknown dictionary entry');
+        return entry;
+    }
+
+    value(depth: number): unknown {
+        if (depth > MAX_BINARY_NESTING_DEPTH) throw new Error('Binary event batch nests too deeply');
+        const tag = this.byte();
+        switch (tag) {
+            case 0: return null;
+            case 1: return false;
+            case 2: return true;
+            case 3: return this.zigzag();
+            case 4: return this.double();
+            case 5: return this.stringRef();
+            case 6: {
+                const count = this.varint();
+                const items: unknown[] = [];
+                for (let i = 0; i < count; i++) items.push(this.value(depth + 1));
+                return items;
+            }
+            case 7: return this.object(this.varint(), depth + 1);
+            default:
+                throw new Error(`Unknown value tag ${tag} in binary event batch`);
+        }
+    }
+
+    object(count: number, depth: number, target: Record<string, unknown> = {}): Record<string, unknown> {
+        for (let i = 0; i < count; i++) {
+            const key = this.stringRef();
+            target[key] = this.value(depth);
+        }
+        return target;
+    }
+}
+
+export function decodeBinaryEventBatch(data: Buffer): DecodedEventBatch {
+    if (!isBinaryEventBatch(data)) throw new Error('Not a binary event batch');
+    const reader = new BinaryEventBatchReader(data.subarray(4));
+    const version = reader.byte();
+    if (version !== BINARY_EVENT_BATCH_VERSION) {
+        throw new Error(`Unsupported binary event batch version ${version}`);
+    }
+
+    const baseTimestampMs = reader.varint();
+    const metaJson = reader.utf8(reader.varint());
+    const deviceInfo = metaJson ? JSON.parse(metaJson) : {};
+
+    const dictionaryCount = reader.varint();
+    for (let i = 0; i < dictionaryCount; i++) {
+        reader.dictionary.push(reader.utf8(reader.varint()));
+    }
+
+    const eventCount = reader.varint();
+    const events: Record<string, unknown>[] = [];
+    for (let i = 0; i < eventCount; i++) {
+        const flags = reader.byte();
+        const event: Record<string, unknown> = {};
+        if (flags & RECORD_HAS_TIMESTAMP) event.timestamp = baseTimestampMs + reader.zigzag();
+        if (flags & RECORD_HAS_TYPE) event.type = reader.stringRef();
+        reader.object(reader.varint(), 1, event);
+        events.push(event);
+    }
+
+    if (!reader.done) throw new Error('Trailing bytes after binary event batch');
+    return { events, deviceInfo };
+}
+
+/**
+ * Returns the JSON form of an events artifact, or null when it is already JSON.
+ * Accepts raw or gzipped bytes.
+ */
+export function transcodeBinaryEventsArtifact(data: Buffer): Buffer | null {
+    const isGzipped = data.length >= 2 && data[0] === 0x1f && data[1] === 0x8b;
+    const raw = isGzipped ? gunzipSync(data) : data;
+    if (!isBinaryEventBatch(raw)) return null;
+    return Buffer.from(JSON.stringify(decodeBinaryEventBatch(raw)), 'utf8');
+}
+
+/**
+ * Rewrites a binary events artifact as gzipped JSON in storage so replay,
+ * dashboard and clock-normalization readers keep consuming a single format.
+ */
+export async function ensureEventsArtifactJson(params: {
+    artifactId?: string | null;
+    data: Buffer;
+    endpointId?: string | null;
+    log?: { info: (payload: Record<string, unknown>, message: string) => void };
+    projectId: string;
+    s3Key: string;
+    sessionId?: string | null;
+}): Promise<{ data: Buffer; transcoded: boolean; uploadedSizeBytes: number | null }> {
+    const json = transcodeBinaryEventsArtifact(params.data);
+    if (!json) {
+        return { data: params.data, transcoded: false, uploadedSizeBytes: null };
+    }
+
+    const uploadBody = params.s3Key.endsWith('.gz') ? gzipSync(json, { level: 9 }) : json;
+    const uploadResult = await uploadToS3ForArtifact(
+        params.projectId,
+        params.s3Key,
+        uploadBody,
+        params.s3Key.endsWith('.gz') ? 'application/gzip' : 'application/json',
+        {
+            artifact_id: params.artifactId ?? '',
+            session_id: params.sessionId ?? '',
+            kind: 'events',
+            transcoded_from: 'rjeb',
+        },
+        params.endpointId,
+    );
+
+    if (!uploadResult.success) {
+        throw new Error(uploadResult.error || `Failed to transcode binary events artifact ${params.s3Key}`);
+    }
+
+    params.log?.info({
+        artifactId: params.artifactId ?? null,
+        binaryBytes: params.data.length,
+        jsonBytes: json.length,
+        s3Key: params.s3Key,
+        sessionId: params.sessionId ?? null,
+    }, 'Transcoded binary events artifact to JSON');
+
+    return { data: json, transcoded: true, uploadedSizeBytes: uploadBody.length };
 }
 
 function normalizeMetadataString(value: unknown, maxLength = 512): string | null {
@@ -120,6 +120,109 @@ export function parseSegmentId(segmentId: string): {
     throw ApiError.badRequest('Invalid segmentId format');
 }
 
+/** Most segments one /segment/presign/batch or /segment/complete/batch call may carry. */
+export const MAX_REPLAY_SEGMENT_BATCH = 16;
+
+export interface ReplaySegmentPresignItem {
+    sessionId: string;
+    kind: 'screenshots' | 'hierarchy';
+    startTime: unknown;
+    endTime?: unknown;
+    frameCount?: unknown;
+    sizeBytes: number;
+    compression?: unknown;
+}
+
+/**
+ * Validates a /segment/presign/batch body: one session and up to
+ * MAX_REPLAY_SEGMENT_BATCH segments, each carrying the fields a single
+ * /segment/presign body does.
+ */
+export function parseReplaySegmentPresignBatch(body: any): {
+    sessionId: string;
+    segments: ReplaySegmentPresignItem[];
+} {
+    const sessionId = body?.sessionId;
+    if (typeof sessionId !== 'string' || !sessionId) {
+        throw ApiError.badRequest('Missing required field: sessionId');
+    }
+    const segments = parseBatchItems(body?.segments);
+
+    return {
+        sessionId,
+        segments: segments.map((segment, index) => {
+            if (!segment || typeof segment !== 'object' || !segment.kind || segment.startTime === undefined || segment.sizeBytes === undefined) {
+                throw ApiError.badRequest(`segments[${index}]: missing required fields: kind, startTime, sizeBytes`);
+            }
+            if (segment.kind !== 'screenshots' && segment.kind !== 'hierarchy') {
+                throw ApiError.badRequest(`segments[${index}]: kind must be "screenshots" or "hierarchy"`);
+            }
+            return {
+                sessionId,
+                kind: segment.kind,
+                startTime: segment.startTime,
+                endTime: segment.endTime,
+                frameCount: segment.frameCount,
+                sizeBytes: parseRequestedSizeBytes(segment.sizeBytes),
+                compression: segment.compression,
+            };
+        }),
+    };
+}
+
+export interface ReplaySegmentCompletion {
+    segmentId: string;
+    actualSizeBytes: number | null;
+    frameCount: number | null;
+}
+
+/**
+ * Validates a /segment/complete/batch body. Every segment must belong to the
+ * same session, whose SDK telemetry the call carries.
+ */
+export function parseReplaySegmentCompleteBatch(body: any): {
+    sessionId: string;
+    segments: ReplaySegmentCompletion[];
+} {
+    const segments = parseBatchItems(body?.segments);
+    let sessionId = '';
+
+    const parsed = segments.map((segment, index) => {
+        const segmentId = segment?.segmentId;
+        if (typeof segmentId !== 'string' || !segmentId) {
+            throw ApiError.badRequest(`segments[${index}]: segmentId is required`);
+        }
+        const segmentSessionId = parseSegmentId(segmentId).sessionId;
+        if (sessionId && segmentSessionId !== sessionId) {
+            throw ApiError.badRequest('All segments in a batch must belong to one session');
+        }
+        sessionId = segmentSessionId;
+        return {
+            segmentId,
+            actualSizeBytes: optionalNumber(segment.actualSizeBytes),
+            frameCount: optionalNumber(segment.frameCount),
+        };
+    });
+
+    return { sessionId, segments: parsed };
+}
+
+function optionalNumber(value: unknown): number | null {
+    if (value === null || value === undefined) return null;
+    const parsed = Number(value);
+    return Number.isFinite(parsed) ? parsed : null;
+}
+
+function parseBatchItems(value: unknown): any[] {
+    if (!Array.isArray(value) || value.length === 0) {
+        throw ApiError.badRequest('segments must be a non-empty array');
+    }
+    if (value.length > MAX_REPLAY_SEGMENT_BATCH) {
+        throw ApiError.badRequest(`At most ${MAX_REPLAY_SEGMENT_BATCH} segments per batch`);
+    }
+    return value;
+}
+
 export function sanitizeIngestErrorMessage(err: unknown, maxLength = 1000): string {
     // eslint-disable-next-line no-control-regex
     return String(err).replace(/\x00/g, '').slice(0, maxLength);
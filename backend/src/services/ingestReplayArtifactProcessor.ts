@@ -1,4 +1,5 @@
 import { extractFramesFromArchive } from './screenshotFrames.js';
+import { decodeHierarchyDelta, isHierarchyDelta } from './hierarchySnapshot.js';
 
 type ReplayArtifactVerificationParams = {
     artifactId?: string | null;
@@ -10,6 +11,16 @@ type ReplayArtifactVerificationParams = {
 };
 
 function assertValidHierarchyPayload(data: Buffer): { nodeCount: number; rootType: string } {
+    if (isHierarchyDelta(data)) {
+        // Decoding checks the layout; a delta may legitimately carry only removals.
+        const delta = decodeHierarchyDelta(data);
+        const root = delta.upserts.get(delta.rootId);
+        return {
+            nodeCount: delta.upserts.size,
+            rootType: typeof root?.type === 'string' ? root.type : 'delta',
+        };
+    }
+
     const parsed = JSON.parse(data.toString('utf8'));
     const rootElement = parsed?.rootElement ?? parsed?.root ?? parsed;
 
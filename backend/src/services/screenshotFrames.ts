@@ -24,6 +24,7 @@
  * - Frame index for timeline-accurate playback
  */
 
+import { createRequire } from 'node:module';
 import { eq, and } from 'drizzle-orm';
 import { gzipSync, gunzipSync } from 'zlib';
 import { db, recordingArtifacts, sessions } from '../db/client.js';
@@ -36,6 +37,12 @@ import {
 import { getRedis } from '../db/redis.js';
 import { logger } from '../logger.js';
 
+const require = createRequire(import.meta.url);
+const jpeg = require('jpeg-js') as {
+    decode: (buffer: Buffer, options?: { maxMemoryUsageInMB?: number }) => DecodedImage;
+    encode: (image: DecodedImage, quality?: number) => { data: Buffer };
+};
+
 // ============================================================================
 // Types
 // ============================================================================
@@ -49,6 +56,8 @@ export interface ExtractedFrame {
     index: number;
     /** JPEG data */
     data: Buffer;
+    /** JPEG quality (1-100) the SDK's rate control encoded the frame at, when the bundle records it */
+    quality?: number;
 }
 
 export interface FrameMetadata {
@@ -149,6 +158,137 @@ async function mapWithConcurrency<T, R>(
 /** JPEG magic bytes: FF D8 FF */
 const JPEG_MAGIC = [0xFF, 0xD8, 0xFF];
 
+/**
+ * Tagged frame bundle written by the SDK's native core (cpp/FrameBundleWriter.h):
+ * "RJFB", u8 format version, u8 codec, then frames in the Android binary layout,
+ * either stored as-is or as one gzip member. The SDK stores batches whose JPEGs
+ * do not compress rather than spending device CPU on deflate. Version 2 puts a
+ * BE u16 frame count and one u8 JPEG quality per frame record (0 = unknown)
+ * between the header and the frames.
+ */
+const FRAME_BUNDLE_MAGIC = Buffer.from('RJFB', 'ascii');
+const FRAME_BUNDLE_HEADER_SIZE = 6;
+const FRAME_BUNDLE_VERSION = 1;
+const FRAME_BUNDLE_QUALITY_VERSION = 2;
+const FRAME_BUNDLE_CODEC_STORED = 0;
+const FRAME_BUNDLE_CODEC_DEFLATE_FAST = 1;
+const FRAME_BUNDLE_CODEC_DEFLATE = 2;
+
+function isTaggedFrameBundle(buf: Buffer): boolean {
+    return buf.length >= FRAME_BUNDLE_HEADER_SIZE &&
+        buf.subarray(0, FRAME_BUNDLE_MAGIC.length).equals(FRAME_BUNDLE_MAGIC);
+}
+
+/** Header size of a tagged bundle, including the version 2 quality table. */
+function frameBundleHeaderSize(buf: Buffer): number {
+    if (buf[4] !== FRAME_BUNDLE_QUALITY_VERSION) return FRAME_BUNDLE_HEADER_SIZE;
+    if (buf.length < FRAME_BUNDLE_HEADER_SIZE + 2) {
+        throw new Error('Truncated frame bundle quality table');
+    }
+    const size = FRAME_BUNDLE_HEADER_SIZE + 2 + buf.readUInt16BE(FRAME_BUNDLE_HEADER_SIZE);
+    if (size > buf.length) {
+        throw new Error('Truncated frame bundle quality table');
+    }
+    return size;
+}
+
+/** Per-record JPEG qualities of a version 2 tagged bundle, or null. */
+function frameBundleQualities(buf: Buffer): Uint8Array | null {
+    if (!isTaggedFrameBundle(buf) || buf[4] !== FRAME_BUNDLE_QUALITY_VERSION) return null;
+    return buf.subarray(FRAME_BUNDLE_HEADER_SIZE + 2, frameBundleHeaderSize(buf));
+}
+
+function isGzipArchive(buf: Buffer): boolean {
+    return buf.length >= 2 && buf[0] === 0x1f && buf[1] === 0x8b;
+}
+
+/**
+ * Returns the uncompressed frame archive for a tagged SDK bundle, a gzip
+ * archive, or an already-decompressed archive.
+ */
+function decompressScreenshotArchive(buf: Buffer): Buffer {
+    if (isTaggedFrameBundle(buf)) {
+        const version = buf[4];
+        const codec = buf[5];
+        if (version !== FRAME_BUNDLE_VERSION && version !== FRAME_BUNDLE_QUALITY_VERSION) {
+            throw new Error(`Unsupported frame bundle version ${version}`);
+        }
+        const body = buf.subarray(frameBundleHeaderSize(buf));
+        switch (codec) {
+            case FRAME_BUNDLE_CODEC_STORED:
+                return body;
+            case FRAME_BUNDLE_CODEC_DEFLATE_FAST:
+            case FRAME_BUNDLE_CODEC_DEFLATE:
+                return gunzipSync(body);
+            default:
+                throw new Error(`Unsupported frame bundle codec ${codec}`);
+        }
+    }
+    return isGzipArchive(buf) ? gunzipSync(buf) : buf;
+}
+
+/**
+ * Tile delta frame written by the SDK's native core (cpp/TileDeltaEncoder.h):
+ * "RJTD", u8 version, BE u16 tile size, frame width, frame height, atlas
+ * columns and tile count, then (column, row) u16 pairs and a JPEG atlas of
+ * the changed tiles. Tiles are relative to the latest full frame of the same
+ * archive.
+ */
+const TILE_DELTA_MAGIC = Buffer.from('RJTD', 'ascii');
+const TILE_DELTA_VERSION = 1;
+const TILE_DELTA_HEADER_SIZE = 15;
+const COMPOSITED_FRAME_JPEG_QUALITY = 80;
+const COMPOSITE_JPEG_MAX_MEMORY_MB = 192;
+
+type DecodedImage = { width: number; height: number; data: Uint8Array };
+
+function isTileDelta(payload: Buffer): boolean {
+    return payload.length >= TILE_DELTA_HEADER_SIZE &&
+        payload.subarray(0, TILE_DELTA_MAGIC.length).equals(TILE_DELTA_MAGIC);
+}
+
+/**
+ * Rebuild a full JPEG frame by copying a delta's changed tiles over its
+ * decoded keyframe. Returns null if the delta does not fit the keyframe.
+ */
+function compositeTileDelta(keyframe: DecodedImage, payload: Buffer): Buffer | null {
+    if (payload[4] !== TILE_DELTA_VERSION) return null;
+    const tileSize = payload.readUInt16BE(5);
+    const width = payload.readUInt16BE(7);
+    const height = payload.readUInt16BE(9);
+    const atlasColumns = payload.readUInt16BE(11);
+    const tileCount = payload.readUInt16BE(13);
+    const tilesEnd = TILE_DELTA_HEADER_SIZE + tileCount * 4;
+    if (tileSize === 0 || width !== keyframe.width || height !== keyframe.height || payload.length < tilesEnd) {
+        return null;
+    }
+
+    const output = Buffer.from(keyframe.data);
+    if (tileCount > 0) {
+        if (atlasColumns === 0) return null;
+        const atlas = jpeg.decode(payload.subarray(tilesEnd), { maxMemoryUsageInMB: COMPOSITE_JPEG_MAX_MEMORY_MB });
+        for (let i = 0; i < tileCount; i++) {
+            const column = payload.readUInt16BE(TILE_DELTA_HEADER_SIZE + i * 4);
+            const row = payload.readUInt16BE(TILE_DELTA_HEADER_SIZE + i * 4 + 2);
+            const dstX = column * tileSize;
+            const dstY = row * tileSize;
+            const srcX = (i % atlasColumns) * tileSize;
+            const srcY = Math.floor(i / atlasColumns) * tileSize;
+            const tileWidth = Math.min(tileSize, width - dstX);
+            const tileHeight = Math.min(tileSize, height - dstY);
+            if (tileWidth <= 0 || tileHeight <= 0 || srcX + tileWidth > atlas.width || srcY + tileHeight > atlas.height) {
+                return null;
+            }
+            for (let y = 0; y < tileHeight; y++) {
+                const src = ((srcY + y) * atlas.width + srcX) * 4;
+                const dst = ((dstY + y) * width + dstX) * 4;
+                output.set(atlas.data.subarray(src, src + tileWidth * 4), dst);
+            }
+        }
+    }
+    return jpeg.encode({ width, height, data: output }, COMPOSITED_FRAME_JPEG_QUALITY).data;
+}
+
 /**
  * Detect whether a decompressed buffer is a tar archive or Android binary format.
  * 
@@ -180,17 +320,30 @@ function isAndroidBinaryFormat(buf: Buffer): boolean {
 /**
  * Parse Android's custom binary screenshot format.
  * Format per frame: [8-byte BE timestamp offset][4-byte BE jpeg size][jpeg data]
+ * A jpeg size of 0 (no data) means the screen was unchanged; it repeats the
+ * previous frame of the same archive under a new timestamp. Data starting with
+ * "RJTD" is a tile delta, composited onto the archive's latest full frame.
  * 
  * @param buf - Decompressed binary data
  * @param sessionStartTime - Session start epoch ms, used to convert offsets to absolute timestamps
+ * @param qualities - Per-record JPEG qualities from a version 2 tagged bundle header
  */
 function parseAndroidBinaryArchive(
     buf: Buffer, 
-    sessionStartTime: number
+    sessionStartTime: number,
+    qualities: Uint8Array | null = null
 ): ExtractedFrame[] {
     const frames: ExtractedFrame[] = [];
     let offset = 0;
+    let record = 0;
+    const qualityOf = (index: number): { quality?: number } => {
+        const quality = qualities?.[index];
+        return quality ? { quality } : {};
+    };
     const HEADER_SIZE = 12; // 8 (timestamp) + 4 (size)
+    // Latest full frame, decoded lazily for tile deltas
+    let keyframeJpeg: Buffer | null = null;
+    let keyframeImage: DecodedImage | null = null;
     
     while (offset + HEADER_SIZE <= buf.length) {
         // Read 8-byte big-endian timestamp offset (ms from session epoch)
@@ -202,9 +355,27 @@ function parseAndroidBinaryArchive(
         const jpegSize = buf.readUInt32BE(offset + 8);
         
         offset += HEADER_SIZE;
+        const recordIndex = record++;
+        
+        if (jpegSize === 0) {
+            const previous = frames[frames.length - 1];
+            if (!previous) {
+                logger.warn({ offset }, '[screenshotFrames] Android binary: repeat record without a previous frame, skipping');
+                continue;
+            }
+            const absoluteTimestamp = sessionStartTime + tsOffset;
+            frames.push({
+                filename: `android_${absoluteTimestamp}.jpeg`,
+                timestamp: absoluteTimestamp,
+                index: frames.length,
+                data: previous.data,
+                ...qualityOf(recordIndex),
+            });
+            continue;
+        }
         
         // Sanity checks
-        if (jpegSize <= 0 || jpegSize > 10 * 1024 * 1024) { // max 10MB per frame
+        if (jpegSize > 10 * 1024 * 1024) { // max 10MB per frame
             logger.warn({ jpegSize, offset }, '[screenshotFrames] Android binary: invalid frame size, stopping');
             break;
         }
@@ -213,20 +384,50 @@ function parseAndroidBinaryArchive(
             break;
         }
         
+        const payload = buf.subarray(offset, offset + jpegSize);
+        if (isTileDelta(payload)) {
+            let composited: Buffer | null = null;
+            if (keyframeJpeg) {
+                try {
+                    keyframeImage ??= jpeg.decode(keyframeJpeg, { maxMemoryUsageInMB: COMPOSITE_JPEG_MAX_MEMORY_MB });
+                    composited = compositeTileDelta(keyframeImage, payload);
+                } catch (err) {
+                    logger.warn({ err, offset }, '[screenshotFrames] Android binary: tile delta failed to decode');
+                }
+            }
+            if (composited) {
+                const absoluteTimestamp = sessionStartTime + tsOffset;
+                frames.push({
+                    filename: `android_${absoluteTimestamp}.jpeg`,
+                    timestamp: absoluteTimestamp,
+                    index: frames.length,
+                    data: composited,
+                    ...qualityOf(recordIndex),
+                });
+            } else {
+                logger.warn({ offset, hasKeyframe: Boolean(keyframeJpeg) }, '[screenshotFrames] Android binary: skipping tile delta');
+            }
+            offset += jpegSize;
+            continue;
+        }
+        
         // Verify JPEG magic
         if (buf[offset] !== 0xFF || buf[offset + 1] !== 0xD8) {
             logger.warn({ byte0: buf[offset], byte1: buf[offset + 1], offset }, '[screenshotFrames] Android binary: not JPEG data, stopping');
             break;
         }
         
-        const jpegData = Buffer.from(buf.subarray(offset, offset + jpegSize));
+        const jpegData = Buffer.from(payload);
         const absoluteTimestamp = sessionStartTime + tsOffset;
+        keyframeJpeg = jpegData;
+        keyframeImage = null;
         
         frames.push({
             filename: `android_${absoluteTimestamp}.jpeg`,
             timestamp: absoluteTimestamp,
             index: frames.length,
             data: jpegData,
+            ...qualityOf(recordIndex),
         });
         
         offset += jpegSize;
@@ -362,11 +563,9 @@ export function normalizeScreenshotArchiveClockFields(
     options?: { s3Key?: string | null },
 ): ScreenshotArchiveClockNormalizationResult {
     try {
-        const isGzipped = archiveBuffer.length >= 2 &&
-            archiveBuffer[0] === 0x1f &&
-            archiveBuffer[1] === 0x8b;
-        const rawBuffer = isGzipped ? gunzipSync(archiveBuffer) : archiveBuffer;
-        if (isAndroidBinaryFormat(rawBuffer)) {
+        const isGzipped = isGzipArchive(archiveBuffer);
+        const rawBuffer = decompressScreenshotArchive(archiveBuffer);
+        if (isTaggedFrameBundle(archiveBuffer) || isAndroidBinaryFormat(rawBuffer)) {
             return {
                 data: archiveBuffer,
                 normalized: false,
@@ -523,11 +722,13 @@ function parseFrameTimestamp(filename: string, sessionStartTime: number = 0): nu
 /**
  * Extract all frames from a screenshot archive.
  * 
- * Supports two formats:
+ * Supports three formats:
  * 1. Legacy tar.gz — standard tar with named JPEG files
- * 2. Current binary.gz — custom binary: [8-byte ts offset][4-byte size][jpeg] per frame
+ * 2. binary.gz — custom binary: [8-byte ts offset][4-byte size][jpeg] per frame
+ * 3. Tagged SDK bundle — "RJFB" header naming the codec (and, from version 2,
+ *    each frame's JPEG quality), then the binary frames stored or gzipped
  * 
- * Format is auto-detected after gzip decompression.
+ * Format is auto-detected after decompression.
  * 
  * @param archiveBuffer - Raw archive data (gzipped or already decompressed)
  * @param sessionStartTime - Session start epoch ms (needed for Android format timestamp reconstruction)
@@ -537,28 +738,24 @@ export async function extractFramesFromArchive(
     sessionStartTime: number = 0
 ): Promise<ExtractedFrame[]> {
     try {
-        // Check if gzip compressed (magic bytes: 0x1f 0x8b)
-        const isGzipped = archiveBuffer.length >= 2 && 
-                          archiveBuffer[0] === 0x1f && 
-                          archiveBuffer[1] === 0x8b;
-        
-        // Decompress if needed
-        let rawBuffer: Buffer;
-        if (isGzipped) {
+        // Tagged SDK bundles carry their codec; otherwise check gzip magic (0x1f 0x8b)
+        const isTagged = isTaggedFrameBundle(archiveBuffer);
+        if (isTagged) {
+            logger.debug({ archiveSize: archiveBuffer.length, codec: archiveBuffer[5] }, '[screenshotFrames] Decoding tagged frame bundle');
+        } else if (isGzipArchive(archiveBuffer)) {
             logger.debug({ archiveSize: archiveBuffer.length }, '[screenshotFrames] Decompressing gzip archive');
-            rawBuffer = gunzipSync(archiveBuffer);
         } else {
             logger.debug({ archiveSize: archiveBuffer.length }, '[screenshotFrames] Archive is already decompressed');
-            rawBuffer = archiveBuffer;
         }
+        const rawBuffer = decompressScreenshotArchive(archiveBuffer);
         
         // ── Detect format and parse ──────────────────────────────────────
         let frames: ExtractedFrame[];
         
-        if (isAndroidBinaryFormat(rawBuffer)) {
+        if (isTagged || isAndroidBinaryFormat(rawBuffer)) {
             // Android custom binary format
             logger.info({ bufferSize: rawBuffer.length, sessionStartTime }, '[screenshotFrames] Detected Android binary format');
-            frames = parseAndroidBinaryArchive(rawBuffer, sessionStartTime);
+            frames = parseAndroidBinaryArchive(rawBuffer, sessionStartTime, isTagged ? frameBundleQualities(archiveBuffer) : null);
         } else {
             // Try standard tar parsing (iOS)
             const files = parseTarArchive(rawBuffer);
@@ -911,31 +1108,40 @@ export async function getSessionScreenshotFrames(
         // Extract frames (pass sessionStartTime for Android binary format)
         const frames = await extractFramesFromArchive(archiveData, sessionStartTime);
         
+        // Repeat records share their source frame's buffer; store that image
+        // once and point every repeat at the same object.
+        const uploadsByData = new Map<Buffer, Promise<{ s3Key: string; upload: Awaited<ReturnType<typeof uploadToS3ForArtifact>> }>>();
         const materializedFrames = MATERIALIZE_FRAME_OBJECTS
             ? await mapWithConcurrency(
                 frames,
                 FRAME_UPLOAD_CONCURRENCY,
                 async (frame) => {
-                    const s3Key = buildMaterializedFrameKey(sessionId, frame.timestamp);
-                    const upload = await uploadToS3ForArtifact(
-                        session.projectId,
-                        s3Key,
-                        frame.data,
-                        'image/jpeg',
-                        {
-                            session_id: sessionId,
-                            kind: 'screenshot_frame',
-                            timestamp: String(frame.timestamp),
-                        },
-                        segment.endpointId,
-                    );
-
-                    if (!upload.success) {
-                        logger.warn(
-                            { sessionId, s3Key, error: upload.error },
-                            '[screenshotFrames] Failed to materialize screenshot frame object; proxy fallback will be used'
-                        );
+                    let pending = uploadsByData.get(frame.data);
+                    if (!pending) {
+                        const key = buildMaterializedFrameKey(sessionId, frame.timestamp);
+                        pending = uploadToS3ForArtifact(
+                            session.projectId,
+                            key,
+                            frame.data,
+                            'image/jpeg',
+                            {
+                                session_id: sessionId,
+                                kind: 'screenshot_frame',
+                                timestamp: String(frame.timestamp),
+                            },
+                            segment.endpointId,
+                        ).then((upload) => {
+                            if (!upload.success) {
+                                logger.warn(
+                                    { sessionId, s3Key: key, error: upload.error },
+                                    '[screenshotFrames] Failed to materialize screenshot frame object; proxy fallback will be used'
+                                );
+                            }
+                            return { s3Key: key, upload };
+                        });
+                        uploadsByData.set(frame.data, pending);
                     }
+                    const { s3Key, upload } = await pending;
 
                     return {
                         timestamp: frame.timestamp,
@@ -36,6 +36,26 @@ android {
         // Pass new architecture flag to BuildConfig - read from root project (app)
         val isNewArchEnabled = isNewArchitectureEnabled()
         buildConfigField("boolean", "IS_NEW_ARCHITECTURE_ENABLED", isNewArchEnabled.toString())
+
+        externalNativeBuild {
+            cmake {
+                cppFlags("-std=c++17", "-O2")
+                arguments("-DANDROID_STL=c++_shared")
+            }
+        }
+    }
+
+    // Shared C++ core (../cpp) compiled into librejourney.so via the JNI bridge.
+    externalNativeBuild {
+        cmake {
+            path = file("src/main/cpp/CMakeLists.txt")
+        }
+    }
+
+    packaging {
+        jniLibs {
+            pickFirsts += "**/libc++_shared.so"
+        }
     }
 
     buildTypes {
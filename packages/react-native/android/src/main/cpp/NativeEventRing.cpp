@@ -0,0 +1,86 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include "EventRing.h"
+
+#include <string>
+#include <vector>
+
+using rejourney::EventRing;
+
+namespace {
+
+EventRing *ringFromHandle(jlong handle) {
+    return reinterpret_cast<EventRing *>(handle);
+}
+
+} // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_rejourney_core_NativeEventRing_nativeCreate(JNIEnv *, jclass, jint capacity) {
+    return reinterpret_cast<jlong>(new EventRing(static_cast<size_t>(capacity > 0 ? capacity : 1)));
+}
+
+JNIEXPORT void JNICALL
+Java_com_rejourney_core_NativeEventRing_nativeDestroy(JNIEnv *, jclass, jlong handle) {
+    delete ringFromHandle(handle);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_rejourney_core_NativeEventRing_nativePush(JNIEnv *env, jclass, jlong handle, jbyteArray record) {
+    jsize length = env->GetArrayLength(record);
+    std::string bytes(static_cast<size_t>(length), '\0');
+    env->GetByteArrayRegion(record, 0, length, reinterpret_cast<jbyte *>(&bytes[0]));
+    return ringFromHandle(handle)->push(std::move(bytes)) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_rejourney_core_NativeEventRing_nativeDrain(JNIEnv *env, jclass, jlong handle, jint maxBytes) {
+    std::vector<std::string> batch = ringFromHandle(handle)->drain(static_cast<size_t>(maxBytes));
+    jclass byteArrayClass = env->FindClass("[B");
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(batch.size()), byteArrayClass, nullptr);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const std::string &record = batch[i];
+        jbyteArray bytes = env->NewByteArray(static_cast<jsize>(record.size()));
+        env->SetByteArrayRegion(bytes, 0, static_cast<jsize>(record.size()),
+                                reinterpret_cast<const jbyte *>(record.data()));
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), bytes);
+        env->DeleteLocalRef(bytes);
+    }
+    env->DeleteLocalRef(byteArrayClass);
+    return result;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_rejourney_core_NativeEventRing_nativeClear(JNIEnv *, jclass, jlong handle) {
+    return static_cast<jint>(ringFromHandle(handle)->clear());
+}
+
+JNIEXPORT jint JNICALL
+Java_com_rejourney_core_NativeEventRing_nativeSize(JNIEnv *, jclass, jlong handle) {
+    return static_cast<jint>(ringFromHandle(handle)->size());
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_rejourney_core_NativeEventRing_nativeEvicted(JNIEnv *, jclass, jlong handle) {
+    return static_cast<jlong>(ringFromHandle(handle)->evicted());
+}
+
+} // extern "C"
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.rejourney.core
+
+/**
+ * Kotlin handle to the shared C++ event ring (cpp/EventRing.h).
+ * Pushes are lock-free and O(1); a full ring overwrites its oldest event.
+ * Only construct when [RejourneyCore.isAvailable] is true.
+ */
+class NativeEventRing(capacity: Int) {
+    private val handle: Long = nativeCreate(capacity)
+
+    fun push(record: ByteArray): Boolean = nativePush(handle, record)
+
+    fun drain(maxBytes: Int): List<ByteArray> = nativeDrain(handle, maxBytes).asList()
+
+    fun clear(): Int = nativeClear(handle)
+
+    fun size(): Int = nativeSize(handle)
+
+    fun evicted(): Long = nativeEvicted(handle)
+
+    protected fun finalize() {
+        nativeDestroy(handle)
+    }
+
+    private companion object {
+        @JvmStatic external fun nativeCreate(capacity: Int): Long
+        @JvmStatic external fun nativeDestroy(handle: Long)
+        @JvmStatic external fun nativePush(handle: Long, record: ByteArray): Boolean
+        @JvmStatic external fun nativeDrain(handle: Long, maxBytes: Int): Array<ByteArray>
+        @JvmStatic external fun nativeClear(handle: Long): Int
+        @JvmStatic external fun nativeSize(handle: Long): Int
+        @JvmStatic external fun nativeEvicted(handle: Long): Long
+    }
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.rejourney.core
+
+import com.rejourney.engine.DiagnosticLog
+
+/**
+ * Loads librejourney.so, the JNI bridge to the shared C++ core.
+ * Callers check [isAvailable] and keep a Kotlin fallback so a missing or
+ * incompatible native library never takes the host app down.
+ */
+object RejourneyCore {
+    val isAvailable: Boolean by lazy {
+        try {
+            System.loadLibrary("rejourney")
+            true
+        } catch (e: UnsatisfiedLinkError) {
+            DiagnosticLog.caution("[RejourneyCore] Native core unavailable, using Kotlin fallback: ${e.message}")
+            false
+        }
+    }
+}
@@ -21,13 +21,14 @@ import android.os.Build
 import android.os.Handler
 import android.os.Looper
 import com.rejourney.RejourneySdkInfo
+import com.rejourney.core.NativeEventRing
+import com.rejourney.core.RejourneyCore
 import com.rejourney.engine.DiagnosticLog
 import com.rejourney.engine.DeviceRegistrar
 import com.rejourney.utility.gzipCompress
 import org.json.JSONArray
 import org.json.JSONObject
 import java.util.*
-import java.util.concurrent.CopyOnWriteArrayList
 import java.util.concurrent.Executors
 import java.util.concurrent.locks.ReentrantLock
 import kotlin.concurrent.withLock
@@ -385,11 +386,11 @@ class TelemetryPipeline private constructor(private val context: Context) {
         }
     }
     
-    private fun serializeBatch(events: List<EventEntry>): ByteArray {
+    private fun serializeBatch(events: List<ByteArray>): ByteArray {
         val jsonEvents = JSONArray()
         for (e in events) {
             try {
-                var dataStr = String(e.data, Charsets.UTF_8)
+                var dataStr = String(e, Charsets.UTF_8)
                 if (dataStr.endsWith("\n")) {
                     dataStr = dataStr.dropLast(1)
                 }
@@ -723,52 +724,61 @@ class TelemetryPipeline private constructor(private val context: Context) {
         try {
             val json = JSONObject(dict)
             val data = (json.toString() + "\n").toByteArray(Charsets.UTF_8)
-            eventRing.push(EventEntry(data, data.size))
+            eventRing.push(data)
         } catch (_: Exception) { }
     }
     
     private fun ts(): Long = System.currentTimeMillis()
 }
 
-private data class EventEntry(
-    val data: ByteArray,
-    val size: Int
-)
-
+/**
+ * Event queue backed by the shared C++ ring when the native core is loaded,
+ * falling back to an ArrayDeque with the same overwrite-oldest policy.
+ */
 private class EventRingBuffer(private val capacity: Int) {
-    private val storage = CopyOnWriteArrayList<EventEntry>()
+    private val native: NativeEventRing? = if (RejourneyCore.isAvailable) NativeEventRing(capacity) else null
+    private val fallback = ArrayDeque<ByteArray>()
     private val lock = ReentrantLock()
     
-    fun push(entry: EventEntry) {
+    fun push(entry: ByteArray) {
+        native?.let {
+            it.push(entry)
+            return
+        }
         lock.withLock {
-            if (storage.size >= capacity) {
-                storage.removeAt(0)
+            if (fallback.size >= capacity) {
+                fallback.removeFirst()
             }
-            storage.add(entry)
+            fallback.addLast(entry)
         }
     }
     
-    fun drain(maxBytes: Int): List<EventEntry> {
+    fun drain(maxBytes: Int): List<ByteArray> {
+        native?.let { return it.drain(maxBytes) }
         lock.withLock {
-            val result = mutableListOf<EventEntry>()
+            val result = mutableListOf<ByteArray>()
             var total = 0
-            while (storage.isNotEmpty()) {
-                val next = storage.first()
-                if (total + next.size > maxBytes) break
+            while (fallback.isNotEmpty()) {
+                val next = fallback.first()
+                if (result.isNotEmpty() && total + next.size > maxBytes) break
                 result.add(next)
                 total += next.size
-                storage.removeAt(0)
+                fallback.removeFirst()
             }
             return result
         }
     }
     
-    fun size(): Int = storage.size
+    fun size(): Int {
+        native?.let { return it.size() }
+        return lock.withLock { fallback.size }
+    }
 
     fun clear(): Int {
+        native?.let { return it.clear() }
         lock.withLock {
-            val cleared = storage.size
-            storage.clear()
+            val cleared = fallback.size
+            fallback.clear()
             return cleared
         }
     }
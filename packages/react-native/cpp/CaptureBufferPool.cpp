@@ -0,0 +1,113 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CaptureBufferPool.h"
+
+#include <new>
+
+namespace rejourney {
+
+namespace {
+
+constexpr size_t kAlignment = 64;
+
+} // namespace
+
+CaptureBufferPool::~CaptureBufferPool() {
+    for (auto &buffer : idle_) {
+        free(*buffer);
+    }
+}
+
+CaptureBufferPool::Lease CaptureBufferPool::acquire(size_t width, size_t height) {
+    if (width == 0 || height == 0) {
+        return Lease();
+    }
+    const size_t bytesPerRow = (width * 4 + kAlignment - 1) / kAlignment * kAlignment;
+    const size_t bytes = bytesPerRow * height;
+
+    std::unique_ptr<Buffer> buffer;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (outstanding_ >= capacity_) {
+            ++exhausted_;
+            return Lease();
+        }
+        ++outstanding_;
+        if (!idle_.empty()) {
+            buffer = std::move(idle_.back());
+            idle_.pop_back();
+        }
+        if (!buffer || buffer->allocated < bytes) {
+            ++allocations_;
+        }
+    }
+
+    if (!buffer) {
+        buffer = std::make_unique<Buffer>();
+    }
+    if (buffer->allocated < bytes) {
+        free(*buffer);
+        buffer->pixels = static_cast<uint8_t *>(::operator new(bytes, std::align_val_t(kAlignment)));
+        buffer->allocated = bytes;
+    }
+    buffer->width = width;
+    buffer->height = height;
+    buffer->bytesPerRow = bytesPerRow;
+    return Lease(*this, std::move(buffer));
+}
+
+void CaptureBufferPool::setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> guard(lock_);
+    capacity_ = capacity;
+}
+
+size_t CaptureBufferPool::capacity() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return capacity_;
+}
+
+CaptureBufferPool::Stats CaptureBufferPool::stats() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    Stats stats;
+    stats.outstanding = outstanding_;
+    stats.idle = idle_.size();
+    stats.allocations = allocations_;
+    stats.exhausted = exhausted_;
+    return stats;
+}
+
+void CaptureBufferPool::release(std::unique_ptr<Buffer> buffer) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        --outstanding_;
+        if (idle_.size() < maxIdle_) {
+            idle_.push_back(std::move(buffer));
+            return;
+        }
+    }
+    free(*buffer);
+}
+
+void CaptureBufferPool::free(Buffer &buffer) {
+    if (buffer.pixels) {
+        ::operator delete(buffer.pixels, std::align_val_t(kAlignment));
+    }
+    buffer.pixels = nullptr;
+    buffer.allocated = 0;
+}
+
+} // namespace rejourney
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Recycles the 32bpp bitmaps frames are captured into, so steady-state
+ * capture stops allocating and freeing a full-screen bitmap per frame.
+ *
+ * At most `capacity` buffers are out at once; past that acquire() comes back
+ * empty and the caller skips the frame, which bounds the memory held by
+ * frames still waiting to be encoded. Up to `maxIdle` released buffers are
+ * kept for reuse; a buffer is reused for any size that fits its allocation,
+ * so only growing the screen (rotation, a larger window) allocates again.
+ *
+ * Rows are padded to 64 bytes. Thread-safe: buffers are usually acquired on
+ * the capture thread and released on the encode thread.
+ */
+class CaptureBufferPool {
+public:
+    struct Buffer {
+        uint8_t *pixels = nullptr;
+        size_t width = 0;
+        size_t height = 0;
+        size_t bytesPerRow = 0;
+        /// Bytes allocated; a buffer fits any size up to this.
+        size_t allocated = 0;
+    };
+
+    struct Stats {
+        size_t outstanding = 0;
+        size_t idle = 0;
+        uint64_t allocations = 0;
+        /// acquire() calls refused because `capacity` buffers were out.
+        uint64_t exhausted = 0;
+    };
+
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(CaptureBufferPool &pool, std::unique_ptr<Buffer> buffer) : pool_(&pool), buffer_(std::move(buffer)) {}
+        Lease(Lease &&other) noexcept = default;
+        Lease &operator=(Lease &&) = delete;
+        ~Lease() {
+            if (buffer_) {
+                pool_->release(std::move(buffer_));
+            }
+        }
+
+        explicit operator bool() const { return buffer_ != nullptr; }
+        Buffer *operator->() const { return buffer_.get(); }
+        Buffer &operator*() const { return *buffer_; }
+
+    private:
+        CaptureBufferPool *pool_ = nullptr;
+        std::unique_ptr<Buffer> buffer_;
+    };
+
+    explicit CaptureBufferPool(size_t capacity, size_t maxIdle = 2) : capacity_(capacity), maxIdle_(maxIdle) {}
+    ~CaptureBufferPool();
+    CaptureBufferPool(const CaptureBufferPool &) = delete;
+    CaptureBufferPool &operator=(const CaptureBufferPool &) = delete;
+
+    /// A buffer of `width` x `height` pixels with undefined contents, or an
+    /// empty lease when `capacity` buffers are out or the size is empty. The
+    /// pool must outlive its leases.
+    Lease acquire(size_t width, size_t height);
+
+    /// Takes effect for later acquires; buffers already out stay out.
+    void setCapacity(size_t capacity);
+    size_t capacity() const;
+
+    Stats stats() const;
+
+private:
+    void release(std::unique_ptr<Buffer> buffer);
+    static void free(Buffer &buffer);
+
+    size_t capacity_;
+    const size_t maxIdle_;
+    mutable std::mutex lock_;
+    std::vector<std::unique_ptr<Buffer>> idle_;
+    size_t outstanding_ = 0;
+    uint64_t allocations_ = 0;
+    uint64_t exhausted_ = 0;
+};
+
+} // namespace rejourney
@@ -0,0 +1,177 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CaptureScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rejourney {
+
+CaptureScheduler::CaptureScheduler() : CaptureScheduler(Options()) {}
+
+CaptureScheduler::CaptureScheduler(Options options) : options_(options) {}
+
+void CaptureScheduler::setOptions(const Options &options) {
+    options_ = options;
+    tokens_ = std::min(tokens_, static_cast<double>(options_.burstFrames));
+}
+
+void CaptureScheduler::start(uint64_t nowMs) {
+    captured_ = false;
+    hasActivity_ = false;
+    hasInteraction_ = false;
+    firstActivityMs_ = kNoRequest;
+    requestMs_ = kNoRequest;
+    restMs_ = kNoRequest;
+    requestForced_ = false;
+    requestCritical_ = false;
+    tokens_ = options_.burstFrames;
+    refilledMs_ = nowMs;
+    request(nowMs, true, true, true, nowMs);
+}
+
+void CaptureScheduler::onInteraction(uint64_t nowMs) {
+    const bool onset = !hasInteraction_ || nowMs > lastInteractionMs_ + options_.gestureGapMs;
+    lastInteractionMs_ = nowMs;
+    hasInteraction_ = true;
+    if (onset) {
+        request(nowMs + options_.interactionDelayMs, false, false, true, nowMs);
+    } else {
+        noteActivity(nowMs);
+        restMs_ = nowMs + options_.gestureGapMs;
+    }
+}
+
+void CaptureScheduler::onScreenChange(uint64_t nowMs) {
+    request(nowMs + options_.screenChangeDelayMs, false, false, true, nowMs);
+}
+
+void CaptureScheduler::onVisualChange(Importance importance, uint64_t nowMs) {
+    switch (importance) {
+    case Importance::Low:
+        request(nowMs + options_.lowDelayMs, false, false, false, nowMs);
+        break;
+    case Importance::Medium:
+        request(nowMs + options_.mediumDelayMs, false, false, true, nowMs);
+        break;
+    case Importance::High:
+        request(nowMs, true, false, true, nowMs);
+        break;
+    case Importance::Critical:
+        request(nowMs, true, true, true, nowMs);
+        break;
+    }
+}
+
+void CaptureScheduler::reportFrameCost(float costMs) {
+    if (!std::isfinite(costMs) || costMs < 0) {
+        return;
+    }
+    costMs_ = costMs_ == 0 ? costMs : costMs_ * 0.8f + costMs * 0.2f;
+}
+
+void CaptureScheduler::request(uint64_t atMs, bool forced, bool critical, bool activity, uint64_t nowMs) {
+    if (activity) {
+        noteActivity(nowMs);
+    }
+    requestMs_ = std::min(requestMs_, atMs);
+    requestForced_ = requestForced_ || forced;
+    requestCritical_ = requestCritical_ || critical;
+}
+
+void CaptureScheduler::noteActivity(uint64_t nowMs) {
+    lastActivityMs_ = nowMs;
+    hasActivity_ = true;
+    firstActivityMs_ = std::min(firstActivityMs_, nowMs);
+}
+
+uint32_t CaptureScheduler::minIntervalMs() const {
+    uint32_t interval = options_.minIntervalMs;
+    if (options_.maxCaptureShare > 0 && costMs_ > 0) {
+        const float stretched = std::min(costMs_ / options_.maxCaptureShare, 60000.0f);
+        interval = std::max(interval, static_cast<uint32_t>(std::ceil(stretched)));
+    }
+    return interval;
+}
+
+double CaptureScheduler::tokensAt(uint64_t ms) const {
+    const double elapsed = ms > refilledMs_ ? static_cast<double>(ms - refilledMs_) : 0.0;
+    return std::min(static_cast<double>(options_.burstFrames),
+                    tokens_ + elapsed * options_.framesPerMinute / 60000.0);
+}
+
+uint64_t CaptureScheduler::withBudget(uint64_t dueMs, double tokens) const {
+    if (options_.framesPerMinute == 0 || tokensAt(dueMs) >= tokens) {
+        return dueMs;
+    }
+    const double missing = tokens - tokensAt(refilledMs_);
+    const double waitMs = std::ceil(missing * 60000.0 / options_.framesPerMinute);
+    return std::max(dueMs, refilledMs_ + static_cast<uint64_t>(waitMs));
+}
+
+uint64_t CaptureScheduler::nextCaptureMs(uint64_t nowMs) const {
+    if (requestCritical_ && requestMs_ != kNoRequest) {
+        return requestMs_;
+    }
+    if (!captured_) {
+        return withBudget(nowMs, 1.0);
+    }
+    const uint64_t earliest = lastCaptureMs_ + minIntervalMs();
+
+    // The active cadence holds while its next frame still falls inside the
+    // active window. Activity after an idle stretch is covered by its own
+    // request, so the cadence restarts from it rather than firing late.
+    const uint64_t activeFrom = firstActivityMs_ == kNoRequest ? lastCaptureMs_ : std::max(lastCaptureMs_, firstActivityMs_);
+    const uint64_t activeDue = activeFrom + options_.activeIntervalMs;
+    const bool active = hasActivity_ && activeDue <= lastActivityMs_ + options_.activeWindowMs;
+    const uint64_t cadenceDue = active ? activeDue : lastCaptureMs_ + options_.idleIntervalMs;
+    // Cadence frames leave half the bucket to frames that answer a signal.
+    const double reserve = 1.0 + options_.burstFrames / 2;
+    uint64_t due = withBudget(std::max(cadenceDue, earliest), std::min<double>(reserve, options_.burstFrames));
+
+    const uint64_t requested = std::min(requestMs_, restMs_);
+    if (requested != kNoRequest) {
+        due = std::min(due, withBudget(std::max(requested, earliest), 1.0));
+    }
+    return due;
+}
+
+CaptureScheduler::Decision CaptureScheduler::poll(uint64_t nowMs) {
+    Decision decision;
+    if (nowMs >= nextCaptureMs(nowMs)) {
+        const bool requestDue = requestMs_ <= nowMs;
+        decision.capture = true;
+        decision.forced = requestDue && requestForced_;
+        if (requestDue) {
+            requestMs_ = kNoRequest;
+            requestForced_ = false;
+            requestCritical_ = false;
+        }
+        if (restMs_ <= nowMs) {
+            restMs_ = kNoRequest;
+        }
+        firstActivityMs_ = kNoRequest;
+        tokens_ = std::max(0.0, tokensAt(nowMs) - 1.0);
+        refilledMs_ = nowMs;
+        lastCaptureMs_ = nowMs;
+        captured_ = true;
+    }
+    decision.nextMs = nextCaptureMs(nowMs);
+    return decision;
+}
+
+} // namespace rejourney
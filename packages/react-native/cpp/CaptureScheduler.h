@@ -0,0 +1,135 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace rejourney {
+
+/**
+ * Decides when the next frame is captured, instead of a fixed timer.
+ *
+ * Signals ask for a frame within a per-signal delay: an interaction shortly
+ * after the touch so the frame shows its effect, a screen change once the
+ * transition has settled, a visual change according to its importance. A
+ * gesture streams interactions, so only its first one asks for a prompt
+ * frame; the rest push back one more frame for when it comes to rest.
+ * Interactions, screen changes and medium or higher visual changes also
+ * open an active window during which frames follow `activeIntervalMs`;
+ * after it closes the scheduler backs off to `idleIntervalMs`.
+ *
+ * Two limits apply to everything but critical changes. Frames are at least
+ * `minIntervalMs` apart, stretched so capture keeps to `maxCaptureShare` of
+ * the capture thread given the measured per-frame cost. And a token bucket
+ * holds the long-run rate to `framesPerMinute` while letting up to
+ * `burstFrames` go out back to back around activity. Cadence frames only
+ * spend the top half of the bucket, keeping the rest for signals.
+ *
+ * Times are milliseconds on any monotonic clock. Deterministic and not
+ * thread-safe: the capture thread owns the scheduler, and the simulator in
+ * tools/ replays recorded sessions through the same code.
+ */
+class CaptureScheduler {
+public:
+    enum class Importance : uint8_t {
+        Low,
+        Medium,
+        High,
+        /// Captured at once and never deferred by the limits.
+        Critical,
+    };
+
+    struct Options {
+        uint32_t activeIntervalMs = 1000;
+        uint32_t idleIntervalMs = 5000;
+        /// How long activity keeps the active cadence.
+        uint32_t activeWindowMs = 3000;
+        uint32_t minIntervalMs = 100;
+        float maxCaptureShare = 0.1f;
+        uint32_t framesPerMinute = 60;
+        uint32_t burstFrames = 8;
+        uint32_t interactionDelayMs = 80;
+        /// Interactions closer than this belong to one gesture; its
+        /// resting frame follows this long after the last one.
+        uint32_t gestureGapMs = 300;
+        uint32_t screenChangeDelayMs = 350;
+        uint32_t lowDelayMs = 1000;
+        uint32_t mediumDelayMs = 150;
+    };
+
+    struct Decision {
+        bool capture = false;
+        /// High and critical changes: skip repeat detection for this frame.
+        bool forced = false;
+        /// When to ask again.
+        uint64_t nextMs = 0;
+    };
+
+    CaptureScheduler();
+    explicit CaptureScheduler(Options options);
+
+    /// Keeps the token balance and the measured cost.
+    void setOptions(const Options &options);
+    const Options &options() const { return options_; }
+
+    /// Starts a session: a frame is due at once and the bucket is full.
+    void start(uint64_t nowMs);
+
+    void onInteraction(uint64_t nowMs);
+    void onScreenChange(uint64_t nowMs);
+    void onVisualChange(Importance importance, uint64_t nowMs);
+
+    /// Main-thread cost of the last frame, folded into a moving average.
+    void reportFrameCost(float costMs);
+
+    /// Earliest time a frame is due, for arming a one-shot timer.
+    uint64_t nextCaptureMs(uint64_t nowMs) const;
+
+    /// Whether to capture now. A yes counts as a frame taken at `nowMs`
+    /// whether or not the caller manages to capture it.
+    Decision poll(uint64_t nowMs);
+
+    float averageFrameCostMs() const { return costMs_; }
+
+private:
+    static constexpr uint64_t kNoRequest = UINT64_MAX;
+
+    void request(uint64_t atMs, bool forced, bool critical, bool activity, uint64_t nowMs);
+    void noteActivity(uint64_t nowMs);
+    double tokensAt(uint64_t ms) const;
+    uint64_t withBudget(uint64_t dueMs, double tokens) const;
+    uint32_t minIntervalMs() const;
+
+    Options options_;
+    uint64_t lastCaptureMs_ = 0;
+    bool captured_ = false;
+    uint64_t lastActivityMs_ = 0;
+    bool hasActivity_ = false;
+    /// First activity since the last frame.
+    uint64_t firstActivityMs_ = kNoRequest;
+    uint64_t requestMs_ = kNoRequest;
+    uint64_t restMs_ = kNoRequest;
+    uint64_t lastInteractionMs_ = 0;
+    bool hasInteraction_ = false;
+    bool requestForced_ = false;
+    bool requestCritical_ = false;
+    double tokens_ = 0;
+    uint64_t refilledMs_ = 0;
+    float costMs_ = 0;
+};
+
+} // namespace rejourney
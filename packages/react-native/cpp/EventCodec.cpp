@@ -0,0 +1,348 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EventCodec.h"
+
+#include <cstring>
+#include <limits>
+
+namespace rejourney {
+
+namespace {
+
+constexpr uint32_t kUnmapped = std::numeric_limits<uint32_t>::max();
+constexpr int kMaxValueDepth = 64;
+
+/// Copies records into a batch, renumbering their dictionary references so
+/// the batch carries only the entries it uses, in order of first use.
+class RecordRemapper {
+public:
+    explicit RecordRemapper(const std::vector<std::string> &dictionary)
+        : dictionary_(dictionary), remap_(dictionary.size(), kUnmapped) {}
+
+    /// Appends `record` to `out` with remapped references. On a malformed
+    /// record `out` is left as it was and false is returned.
+    bool copyRecord(std::string_view record, std::string &out) {
+        in_ = record;
+        pos_ = 0;
+        out_ = &out;
+        const size_t start = out.size();
+        const size_t usedBefore = used_.size();
+        if (!copyRecordBody()) {
+            out.resize(start);
+            for (size_t i = usedBefore; i < used_.size(); ++i) {
+                remap_[used_[i]] = kUnmapped;
+            }
+            used_.resize(usedBefore);
+            return false;
+        }
+        return true;
+    }
+
+    /// Old dictionary indices referenced so far, by new index.
+    const std::vector<uint32_t> &used() const { return used_; }
+
+private:
+    bool copyRecordBody() {
+        if (pos_ >= in_.size()) {
+            return false;
+        }
+        const uint8_t flags = static_cast<uint8_t>(in_[pos_++]);
+        out_->push_back(static_cast<char>(flags));
+        uint64_t fields = 0;
+        if ((flags & kRecordHasTimestamp) && !copyVarint(nullptr)) {
+            return false;
+        }
+        if ((flags & kRecordHasType) && !copyStringRef()) {
+            return false;
+        }
+        if (!copyVarint(&fields)) {
+            return false;
+        }
+        for (uint64_t i = 0; i < fields; ++i) {
+            if (!copyStringRef() || !copyValue(0)) {
+                return false;
+            }
+        }
+        return pos_ == in_.size();
+    }
+
+    bool copyVarint(uint64_t *value) {
+        uint64_t v = 0;
+        if (!readVarint(in_, pos_, v)) {
+            return false;
+        }
+        appendVarint(*out_, v);
+        if (value) {
+            *value = v;
+        }
+        return true;
+    }
+
+    bool copyStringRef() {
+        uint64_t ref = 0;
+        if (!readVarint(in_, pos_, ref)) {
+            return false;
+        }
+        if (ref & 1) {
+            const uint64_t length = ref >> 1;
+            if (length > in_.size() - pos_) {
+                return false;
+            }
+            appendVarint(*out_, ref);
+            out_->append(in_.data() + pos_, length);
+            pos_ += length;
+            return true;
+        }
+        const uint64_t index = ref >> 1;
+        if (index >= dictionary_.size()) {
+            return false;
+        }
+        if (remap_[index] == kUnmapped) {
+            remap_[index] = static_cast<uint32_t>(used_.size());
+            used_.push_back(static_cast<uint32_t>(index));
+        }
+        appendVarint(*out_, static_cast<uint64_t>(remap_[index]) << 1);
+        return true;
+    }
+
+    bool copyValue(int depth) {
+        if (pos_ >= in_.size() || depth > kMaxValueDepth) {
+            return false;
+        }
+        const auto tag = static_cast<ValueTag>(in_[pos_++]);
+        out_->push_back(static_cast<char>(tag));
+        uint64_t count = 0;
+        switch (tag) {
+        case ValueTag::Null:
+        case ValueTag::False:
+        case ValueTag::True:
+            return true;
+        case ValueTag::Int:
+            return copyVarint(nullptr);
+        case ValueTag::Double:
+            if (in_.size() - pos_ < 8) {
+                return false;
+            }
+            out_->append(in_.data() + pos_, 8);
+            pos_ += 8;
+            return true;
+        case ValueTag::String:
+            return copyStringRef();
+        case ValueTag::Array:
+            if (!copyVarint(&count)) {
+                return false;
+            }
+            for (uint64_t i = 0; i < count; ++i) {
+                if (!copyValue(depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        case ValueTag::Object:
+            if (!copyVarint(&count)) {
+                return false;
+            }
+            for (uint64_t i = 0; i < count; ++i) {
+                if (!copyStringRef() || !copyValue(depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    const std::vector<std::string> &dictionary_;
+    std::vector<uint32_t> remap_;
+    std::vector<uint32_t> used_;
+    std::string_view in_;
+    size_t pos_ = 0;
+    std::string *out_ = nullptr;
+};
+
+} // namespace
+
+void appendVarint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool readVarint(std::string_view in, size_t &pos, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) {
+            return false;
+        }
+        uint8_t byte = static_cast<uint8_t>(in[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+EventRecordWriter::EventRecordWriter(EventEncoder &encoder, std::unique_lock<std::mutex> lock)
+    : encoder_(encoder), lock_(std::move(lock)) {}
+
+void EventRecordWriter::stringRef(std::string_view value, bool internable) {
+    int64_t index = internable ? encoder_.intern(value) : -1;
+    if (index >= 0) {
+        appendVarint(out_, static_cast<uint64_t>(index) << 1);
+    } else {
+        appendVarint(out_, (static_cast<uint64_t>(value.size()) << 1) | 1);
+        out_.append(value.data(), value.size());
+    }
+}
+
+void EventRecordWriter::key(std::string_view name) { stringRef(name, true); }
+
+void EventRecordWriter::nullValue() { out_.push_back(static_cast<char>(ValueTag::Null)); }
+
+void EventRecordWriter::boolValue(bool value) {
+    out_.push_back(static_cast<char>(value ? ValueTag::True : ValueTag::False));
+}
+
+void EventRecordWriter::intValue(int64_t value) {
+    out_.push_back(static_cast<char>(ValueTag::Int));
+    appendVarint(out_, zigzagEncode(value));
+}
+
+void EventRecordWriter::doubleValue(double value) {
+    out_.push_back(static_cast<char>(ValueTag::Double));
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        out_.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+    }
+}
+
+void EventRecordWriter::stringValue(std::string_view value) {
+    out_.push_back(static_cast<char>(ValueTag::String));
+    stringRef(value, true);
+}
+
+void EventRecordWriter::beginArray(size_t count) {
+    out_.push_back(static_cast<char>(ValueTag::Array));
+    appendVarint(out_, count);
+}
+
+void EventRecordWriter::beginObject(size_t count) {
+    out_.push_back(static_cast<char>(ValueTag::Object));
+    appendVarint(out_, count);
+}
+
+std::string EventRecordWriter::finish() {
+    if (lock_.owns_lock()) {
+        lock_.unlock();
+    }
+    return std::move(out_);
+}
+
+EventEncoder::EventEncoder(int64_t baseTimestampMs, size_t maxDictionaryEntries, size_t maxInternedLength)
+    : baseTimestampMs_(baseTimestampMs),
+      maxDictionaryEntries_(maxDictionaryEntries),
+      maxInternedLength_(maxInternedLength) {
+    dictionary_.reserve(256);
+}
+
+EventRecordWriter EventEncoder::beginRecord(const int64_t *timestampMs,
+                                            const std::string_view *type,
+                                            size_t fieldCount) {
+    EventRecordWriter writer(*this, std::unique_lock<std::mutex>(lock_));
+    uint8_t flags = (timestampMs ? kRecordHasTimestamp : 0) | (type ? kRecordHasType : 0);
+    writer.out_.push_back(static_cast<char>(flags));
+    if (timestampMs) {
+        appendVarint(writer.out_, zigzagEncode(*timestampMs - baseTimestampMs_));
+    }
+    if (type) {
+        writer.stringRef(*type, true);
+    }
+    appendVarint(writer.out_, fieldCount);
+    return writer;
+}
+
+int64_t EventEncoder::intern(std::string_view value) {
+    if (value.size() > maxInternedLength_) {
+        return -1;
+    }
+    std::string key(value);
+    auto it = indices_.find(key);
+    if (it != indices_.end()) {
+        return it->second;
+    }
+    if (dictionary_.size() >= maxDictionaryEntries_) {
+        return -1;
+    }
+    uint32_t index = static_cast<uint32_t>(dictionary_.size());
+    dictionary_.push_back(key);
+    indices_.emplace(std::move(key), index);
+    return index;
+}
+
+size_t EventEncoder::dictionarySize() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return dictionary_.size();
+}
+
+std::string EventEncoder::buildBatch(const std::vector<std::string_view> &records,
+                                     std::string_view deviceInfoJson) const {
+    size_t recordBytes = 0;
+    for (const auto &record : records) {
+        recordBytes += record.size();
+    }
+
+    std::string out;
+    out.reserve(recordBytes + deviceInfoJson.size() + 64);
+    out.append("RJEB", 4);
+    out.push_back(static_cast<char>(kEventBatchVersion));
+    appendVarint(out, static_cast<uint64_t>(baseTimestampMs_));
+    appendVarint(out, deviceInfoJson.size());
+    out.append(deviceInfoJson.data(), deviceInfoJson.size());
+
+    // Every record was encoded against a prefix of the current dictionary,
+    // so the snapshot taken here resolves all of them. The batch carries
+    // only the entries its records use: the process-wide dictionary keeps
+    // growing, and shipping all of it would repeat every string ever
+    // interned in every batch.
+    std::string body;
+    body.reserve(recordBytes);
+    size_t copied = 0;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        RecordRemapper remapper(dictionary_);
+        for (const auto &record : records) {
+            if (remapper.copyRecord(record, body)) {
+                ++copied;
+            }
+        }
+        appendVarint(out, remapper.used().size());
+        for (uint32_t index : remapper.used()) {
+            appendVarint(out, dictionary_[index].size());
+            out.append(dictionary_[index]);
+        }
+    }
+
+    appendVarint(out, copied);
+    out.append(body);
+    return out;
+}
+
+} // namespace rejourney
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Compact binary encoding for telemetry events ("RJEB").
+ *
+ * Events are encoded once, when they are recorded, and an upload batch is
+ * those records behind a small header. Batching only walks each record to
+ * renumber its dictionary references, so a batch carries just the entries
+ * it uses; values are copied as they are. The backend decoder lives in
+ * backend/src/services/ingestEventArtifactProcessor.ts.
+ *
+ * Batch layout:
+ *   "RJEB" u8 version
+ *   varint baseTimestampMs
+ *   varint metaLength, metaLength bytes of deviceInfo JSON
+ *   varint dictionaryCount, dictionaryCount x (varint length, UTF-8 bytes)
+ *   varint eventCount, eventCount x record
+ *
+ * Record layout:
+ *   u8 flags (bit 0: has timestamp, bit 1: has type)
+ *   [zigzag varint timestampMs - baseTimestampMs] [stringRef type]
+ *   varint fieldCount, fieldCount x (stringRef key, value)
+ *
+ * A stringRef is a varint v: an even v is dictionary index v >> 1, an odd v
+ * is followed by (v >> 1) bytes of inline UTF-8. Values are a u8 tag followed
+ * by the payload described by ValueTag.
+ */
+enum class ValueTag : uint8_t {
+    Null = 0,
+    False = 1,
+    True = 2,
+    Int = 3,    // zigzag varint
+    Double = 4, // 8 bytes, little-endian IEEE 754
+    String = 5, // stringRef
+    Array = 6,  // varint count, count x value
+    Object = 7, // varint count, count x (stringRef key, value)
+};
+
+constexpr uint8_t kEventBatchVersion = 1;
+constexpr uint8_t kRecordHasTimestamp = 0x01;
+constexpr uint8_t kRecordHasType = 0x02;
+
+void appendVarint(std::string &out, uint64_t value);
+inline uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+inline int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/// Reads a varint at `pos`, advancing it. Returns false on truncated input.
+bool readVarint(std::string_view in, size_t &pos, uint64_t &value);
+
+class EventEncoder;
+
+/**
+ * Builds one record. Holds the encoder's dictionary lock for its lifetime,
+ * so keep it scoped to a single event. Containers take their element count
+ * up front; the caller must then write exactly that many keys/values.
+ */
+class EventRecordWriter {
+public:
+    EventRecordWriter(EventRecordWriter &&) = default;
+    EventRecordWriter(const EventRecordWriter &) = delete;
+    EventRecordWriter &operator=(const EventRecordWriter &) = delete;
+
+    void key(std::string_view name);
+    void nullValue();
+    void boolValue(bool value);
+    void intValue(int64_t value);
+    void doubleValue(double value);
+    void stringValue(std::string_view value);
+    void beginArray(size_t count);
+    void beginObject(size_t count);
+
+    /// Returns the encoded record and leaves the writer empty.
+    std::string finish();
+
+private:
+    friend class EventEncoder;
+    EventRecordWriter(EventEncoder &encoder, std::unique_lock<std::mutex> lock);
+
+    void stringRef(std::string_view value, bool internable);
+
+    EventEncoder &encoder_;
+    std::unique_lock<std::mutex> lock_;
+    std::string out_;
+};
+
+class EventEncoder {
+public:
+    /// Strings longer than `maxInternedLength` are always written inline, and
+    /// the dictionary stops growing at `maxDictionaryEntries`. The dictionary
+    /// only ever grows, so records encoded earlier stay valid in later batches.
+    explicit EventEncoder(int64_t baseTimestampMs,
+                          size_t maxDictionaryEntries = 4096,
+                          size_t maxInternedLength = 48);
+
+    EventRecordWriter beginRecord(const int64_t *timestampMs,
+                                  const std::string_view *type,
+                                  size_t fieldCount);
+
+    /// Builds a batch payload from pre-encoded records, with a dictionary of
+    /// only the entries they reference. Malformed records are left out.
+    std::string buildBatch(const std::vector<std::string_view> &records,
+                           std::string_view deviceInfoJson) const;
+
+    int64_t baseTimestampMs() const { return baseTimestampMs_; }
+    size_t dictionarySize() const;
+
+private:
+    friend class EventRecordWriter;
+
+    /// Returns the dictionary index for `value`, or -1 if it must be inlined.
+    int64_t intern(std::string_view value);
+
+    const int64_t baseTimestampMs_;
+    const size_t maxDictionaryEntries_;
+    const size_t maxInternedLength_;
+    mutable std::mutex lock_;
+    std::vector<std::string> dictionary_;
+    std::unordered_map<std::string, uint32_t> indices_;
+};
+
+} // namespace rejourney
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EventRing.h"
+
+namespace rejourney {
+
+EventRing::EventRing(size_t capacity) : ring_(capacity) {}
+
+bool EventRing::push(std::string record) {
+    return ring_.push(std::move(record));
+}
+
+std::vector<std::string> EventRing::drain(size_t maxBytes) {
+    std::lock_guard<std::mutex> guard(consumerLock_);
+    std::vector<std::string> batch;
+    size_t total = 0;
+
+    if (hasCarry_.load(std::memory_order_relaxed)) {
+        total += carry_.size();
+        batch.push_back(std::move(carry_));
+        carry_.clear();
+        hasCarry_.store(false, std::memory_order_release);
+    }
+
+    std::string next;
+    while (ring_.tryPop(next)) {
+        if (!batch.empty() && total + next.size() > maxBytes) {
+            carry_ = std::move(next);
+            hasCarry_.store(true, std::memory_order_release);
+            break;
+        }
+        total += next.size();
+        batch.push_back(std::move(next));
+    }
+    return batch;
+}
+
+size_t EventRing::clear() {
+    std::lock_guard<std::mutex> guard(consumerLock_);
+    size_t cleared = 0;
+    if (hasCarry_.load(std::memory_order_relaxed)) {
+        carry_.clear();
+        hasCarry_.store(false, std::memory_order_release);
+        ++cleared;
+    }
+    std::string discarded;
+    while (ring_.tryPop(discarded)) {
+        ++cleared;
+    }
+    return cleared;
+}
+
+size_t EventRing::size() const {
+    return ring_.size() + (hasCarry_.load(std::memory_order_acquire) ? 1 : 0);
+}
+
+} // namespace rejourney
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "MpscRing.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * In-memory queue of serialized telemetry events, shared by the iOS and
+ * Android pipelines.
+ *
+ * Any thread may push; draining is done by the upload worker. Appends never
+ * block or shift storage, and a full ring overwrites its oldest event.
+ */
+class EventRing {
+public:
+    explicit EventRing(size_t capacity);
+
+    /// Appends one encoded event. Returns true if the oldest event was evicted.
+    bool push(std::string record);
+
+    /// Removes events in FIFO order until adding the next one would exceed
+    /// `maxBytes`. At least one event is returned when the ring is non-empty,
+    /// so a single oversized event cannot stall the queue.
+    std::vector<std::string> drain(size_t maxBytes);
+
+    /// Discards every pending event and returns how many were dropped.
+    size_t clear();
+
+    size_t size() const;
+    size_t capacity() const { return ring_.capacity(); }
+    uint64_t evicted() const { return ring_.dropped(); }
+
+private:
+    MpscRing<std::string> ring_;
+
+    // Consumer-side state. An event that did not fit the last drain budget is
+    // parked here and returned first by the next drain.
+    mutable std::mutex consumerLock_;
+    std::string carry_;
+    std::atomic<bool> hasCarry_{false};
+};
+
+} // namespace rejourney
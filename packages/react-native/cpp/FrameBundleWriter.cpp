@@ -0,0 +1,310 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameBundleWriter.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+
+namespace rejourney {
+
+namespace {
+
+constexpr size_t kOutputChunk = 64 * 1024;
+constexpr int kGzipWindowBits = MAX_WBITS + 16;
+
+void putU64BE(uint8_t *out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+    }
+}
+
+void putU32BE(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (24 - 8 * i));
+    }
+}
+
+/// Runs deflate over `input` with `flush`, appending everything it produces
+/// to `output`.
+bool deflateInto(z_stream &zs, const uint8_t *input, size_t length, int flush, std::string &output) {
+    zs.next_in = const_cast<Bytef *>(input);
+    zs.avail_in = static_cast<uInt>(length);
+    while (true) {
+        const size_t start = output.size();
+        output.resize(start + kOutputChunk);
+        zs.next_out = reinterpret_cast<Bytef *>(&output[start]);
+        zs.avail_out = static_cast<uInt>(kOutputChunk);
+        int rc = deflate(&zs, flush);
+        output.resize(start + kOutputChunk - zs.avail_out);
+        if (rc == Z_STREAM_ERROR) {
+            return false;
+        }
+        if (flush == Z_FINISH) {
+            if (rc == Z_STREAM_END) {
+                return true;
+            }
+        } else if (zs.avail_in == 0 && zs.avail_out != 0) {
+            return true;
+        }
+    }
+}
+
+int deflateLevel(FrameBundleWriter::Codec codec) {
+    return codec == FrameBundleWriter::Codec::DeflateFast ? 1 : 6;
+}
+
+} // namespace
+
+struct FrameBundleWriter::Stream {
+    Codec codec = Codec::Stored;
+    bool deflating = false;
+    z_stream zs{};
+    /// Bundle header followed by the stored frames or the gzip member.
+    std::string output;
+
+    ~Stream() {
+        if (deflating) {
+            deflateEnd(&zs);
+        }
+    }
+};
+
+FrameBundleWriter::FrameBundleWriter() : FrameBundleWriter(Options()) {}
+
+FrameBundleWriter::FrameBundleWriter(Options options) : options_(options) {}
+
+FrameBundleWriter::~FrameBundleWriter() = default;
+
+FrameBundleWriter::Codec FrameBundleWriter::chooseCodec(const uint8_t *jpeg, size_t length, const Options &options) {
+    if (!jpeg || length == 0) {
+        return options.codec;
+    }
+    // Sample from the middle: the start of a JPEG is quantization and Huffman
+    // tables, which compress far better than the entropy-coded scan data.
+    const size_t sampleLength = std::min(length, options.sampleBytes);
+    const uint8_t *sample = jpeg + (length - sampleLength) / 2;
+
+    uLongf compressedLength = compressBound(static_cast<uLong>(sampleLength));
+    std::string scratch(compressedLength, '\0');
+    if (compress2(reinterpret_cast<Bytef *>(&scratch[0]), &compressedLength, sample,
+                  static_cast<uLong>(sampleLength), 1) != Z_OK) {
+        return options.codec;
+    }
+    const double ratio = static_cast<double>(compressedLength) / static_cast<double>(sampleLength);
+    if (ratio >= options.storeRatio) {
+        return Codec::Stored;
+    }
+    return ratio >= options.fastRatio ? Codec::DeflateFast : Codec::Deflate;
+}
+
+void FrameBundleWriter::reset(uint64_t sessionEpochMs) {
+    std::lock_guard<std::mutex> guard(lock_);
+    discardLocked();
+    lastJpeg_.clear();
+    lastWasDelta_ = false;
+    lastQuality_ = 0;
+    sessionEpochMs_ = sessionEpochMs;
+}
+
+bool FrameBundleWriter::openStreamLocked(Codec codec) {
+    auto stream = std::make_unique<Stream>();
+    stream->codec = codec;
+    if (codec != Codec::Stored) {
+        if (deflateInit2(&stream->zs, deflateLevel(codec), Z_DEFLATED, kGzipWindowBits, 8, Z_DEFAULT_STRATEGY) !=
+            Z_OK) {
+            return false;
+        }
+        stream->deflating = true;
+    }
+    stream->output.append("RJFB", 4);
+    stream->output.push_back(static_cast<char>(kFormatVersion));
+    stream->output.push_back(static_cast<char>(codec));
+    stream_ = std::move(stream);
+    return true;
+}
+
+bool FrameBundleWriter::writeLocked(const uint8_t *data, size_t length) {
+    if (!stream_->deflating) {
+        stream_->output.append(reinterpret_cast<const char *>(data), length);
+        return true;
+    }
+    return deflateInto(stream_->zs, data, length, Z_NO_FLUSH, stream_->output);
+}
+
+bool FrameBundleWriter::append(const uint8_t *jpeg, size_t length, uint64_t timestampMs, uint8_t quality) {
+    if (!jpeg || length == 0 || length > UINT32_MAX) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!appendLocked(jpeg, length, timestampMs, quality)) {
+        return false;
+    }
+    lastJpeg_.assign(reinterpret_cast<const char *>(jpeg), length);
+    lastWasDelta_ = false;
+    lastQuality_ = quality;
+    return true;
+}
+
+bool FrameBundleWriter::appendDelta(const uint8_t *payload, size_t length, uint64_t timestampMs, uint8_t quality) {
+    if (!payload || length == 0 || length > UINT32_MAX) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    if (frameCount_ == 0 || !appendLocked(payload, length, timestampMs, quality)) {
+        return false;
+    }
+    lastWasDelta_ = true;
+    lastQuality_ = quality;
+    return true;
+}
+
+bool FrameBundleWriter::appendRepeat(uint64_t timestampMs) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (lastJpeg_.empty()) {
+        return false;
+    }
+    if (frameCount_ == 0) {
+        if (lastWasDelta_) {
+            return false;
+        }
+        return appendLocked(reinterpret_cast<const uint8_t *>(lastJpeg_.data()), lastJpeg_.size(), timestampMs,
+                            lastQuality_);
+    }
+    if (frameCount_ >= kMaxFrames) {
+        return false;
+    }
+
+    uint8_t header[12];
+    putU64BE(header, timestampMs > sessionEpochMs_ ? timestampMs - sessionEpochMs_ : 0);
+    putU32BE(header + 8, 0);
+    if (!writeLocked(header, sizeof(header))) {
+        discardLocked();
+        return false;
+    }
+    lastTimestampMs_ = timestampMs;
+    ++frameCount_;
+    ++repeatCount_;
+    rawBytes_ += sizeof(header);
+    qualities_.push_back(static_cast<char>(lastQuality_));
+    return true;
+}
+
+bool FrameBundleWriter::appendLocked(const uint8_t *jpeg, size_t length, uint64_t timestampMs, uint8_t quality) {
+    if (frameCount_ >= kMaxFrames) {
+        return false;
+    }
+    if (!stream_) {
+        Codec codec = options_.adaptive ? chooseCodec(jpeg, length, options_) : options_.codec;
+        if (!openStreamLocked(codec)) {
+            return false;
+        }
+    }
+
+    uint8_t header[12];
+    putU64BE(header, timestampMs > sessionEpochMs_ ? timestampMs - sessionEpochMs_ : 0);
+    putU32BE(header + 8, static_cast<uint32_t>(length));
+    if (!writeLocked(header, sizeof(header)) || !writeLocked(jpeg, length)) {
+        discardLocked();
+        return false;
+    }
+
+    if (frameCount_ == 0) {
+        firstTimestampMs_ = timestampMs;
+    }
+    lastTimestampMs_ = timestampMs;
+    ++frameCount_;
+    rawBytes_ += sizeof(header) + length;
+    qualities_.push_back(static_cast<char>(quality));
+    return true;
+}
+
+bool FrameBundleWriter::finish(Bundle &bundle) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (frameCount_ == 0 || !stream_) {
+        return false;
+    }
+    bool ok = !stream_->deflating || deflateInto(stream_->zs, nullptr, 0, Z_FINISH, stream_->output);
+    if (ok) {
+        fillBundleLocked(bundle);
+        bundle.payload = std::move(stream_->output);
+        spliceQualitiesLocked(bundle.payload);
+    }
+    discardLocked();
+    return ok;
+}
+
+bool FrameBundleWriter::snapshot(Bundle &bundle) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (frameCount_ == 0 || !stream_) {
+        return false;
+    }
+    std::string payload = stream_->output;
+    if (stream_->deflating) {
+        Stream copy;
+        if (deflateCopy(&copy.zs, const_cast<z_stream *>(&stream_->zs)) != Z_OK) {
+            return false;
+        }
+        copy.deflating = true;
+        if (!deflateInto(copy.zs, nullptr, 0, Z_FINISH, payload)) {
+            return false;
+        }
+    }
+    fillBundleLocked(bundle);
+    bundle.payload = std::move(payload);
+    spliceQualitiesLocked(bundle.payload);
+    return true;
+}
+
+size_t FrameBundleWriter::frameCount() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return frameCount_;
+}
+
+uint64_t FrameBundleWriter::firstTimestampMs() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return firstTimestampMs_;
+}
+
+void FrameBundleWriter::fillBundleLocked(Bundle &bundle) const {
+    bundle.codec = stream_->codec;
+    bundle.frameCount = frameCount_;
+    bundle.repeatCount = repeatCount_;
+    bundle.firstTimestampMs = firstTimestampMs_;
+    bundle.lastTimestampMs = lastTimestampMs_;
+    bundle.rawBytes = rawBytes_;
+}
+
+void FrameBundleWriter::spliceQualitiesLocked(std::string &payload) const {
+    std::string table(2, '\0');
+    table[0] = static_cast<char>(frameCount_ >> 8);
+    table[1] = static_cast<char>(frameCount_ & 0xFF);
+    table += qualities_;
+    payload.insert(kHeaderSize, table);
+}
+
+void FrameBundleWriter::discardLocked() {
+    stream_.reset();
+    frameCount_ = 0;
+    repeatCount_ = 0;
+    firstTimestampMs_ = 0;
+    lastTimestampMs_ = 0;
+    rawBytes_ = 0;
+    qualities_.clear();
+}
+
+} // namespace rejourney
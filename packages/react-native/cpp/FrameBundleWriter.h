@@ -0,0 +1,158 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace rejourney {
+
+/**
+ * Builds frame bundles incrementally.
+ *
+ * Each frame is written into the open batch as soon as it is encoded, so a
+ * batch is never held both as raw JPEGs and as a concatenated archive, and
+ * finishing a batch only flushes the tail of the stream. The frames use the
+ * layout the backend already decodes (`isAndroidBinaryFormat` in
+ * backend/src/services/screenshotFrames.ts): per frame, an 8-byte big-endian
+ * timestamp offset from the session epoch, a 4-byte big-endian JPEG length,
+ * then the JPEG bytes. A zero length with no bytes repeats the previous frame
+ * of the same bundle, and a payload starting with "RJTD" is a tile delta
+ * against the bundle's latest full frame (TileDeltaEncoder.h). A bundle
+ * always starts with a full frame, so bundles decode independently.
+ *
+ * A finished bundle is "RJFB", a u8 format version, a u8 Codec, a
+ * big-endian u16 frame count and one u8 JPEG quality per frame (0 when the
+ * caller did not say; a repeat carries the quality of the frame it repeats),
+ * then the frames either as-is (Stored) or as one gzip member. The quality
+ * table is only known once the batch closes, so it is spliced in behind the
+ * fixed header when the bundle is finished. JPEG data is already
+ * entropy coded and rarely shrinks under deflate, so in adaptive mode the
+ * codec is picked per batch by deflating a sample of the batch's first frame
+ * and looking at the ratio.
+ *
+ * Thread-safe; appends from the encoder and flushes from lifecycle or crash
+ * paths may race.
+ */
+class FrameBundleWriter {
+public:
+    static constexpr uint8_t kFormatVersion = 2;
+    /// Fixed part of the header; the quality table follows it.
+    static constexpr size_t kHeaderSize = 6;
+    static constexpr size_t kMaxFrames = UINT16_MAX;
+
+    enum class Codec : uint8_t {
+        Stored = 0,
+        DeflateFast = 1,
+        Deflate = 2,
+    };
+
+    struct Options {
+        /// Pick the codec per batch; otherwise always use `codec`.
+        bool adaptive = true;
+        Codec codec = Codec::Deflate;
+        /// Bytes of the first frame deflated to estimate the batch's ratio.
+        size_t sampleBytes = 16 * 1024;
+        /// Sample ratios (compressed / raw) at or above this are stored.
+        double storeRatio = 0.97;
+        /// Sample ratios at or above this use fast deflate.
+        double fastRatio = 0.90;
+    };
+
+    struct Bundle {
+        std::string payload;
+        Codec codec = Codec::Stored;
+        size_t frameCount = 0;
+        /// Frames among `frameCount` written as repeat records.
+        size_t repeatCount = 0;
+        uint64_t firstTimestampMs = 0;
+        uint64_t lastTimestampMs = 0;
+        /// Size of the frames before compression.
+        size_t rawBytes = 0;
+    };
+
+    FrameBundleWriter();
+    explicit FrameBundleWriter(Options options);
+    ~FrameBundleWriter();
+
+    FrameBundleWriter(const FrameBundleWriter &) = delete;
+    FrameBundleWriter &operator=(const FrameBundleWriter &) = delete;
+
+    /// Codec adaptive mode would pick for a batch starting with `jpeg`.
+    static Codec chooseCodec(const uint8_t *jpeg, size_t length, const Options &options);
+
+    /// Discards the open batch and sets the epoch later frames are relative to.
+    void reset(uint64_t sessionEpochMs);
+
+    /// Appends a JPEG encoded at `quality` (1...100, 0 if unknown). Returns
+    /// false once the batch holds kMaxFrames frames.
+    bool append(const uint8_t *jpeg, size_t length, uint64_t timestampMs, uint8_t quality = 0);
+
+    /// Appends a TileDeltaEncoder payload whose atlas was encoded at
+    /// `quality`. Returns false if the batch is empty, since a delta cannot
+    /// open a bundle; ship a full frame instead.
+    bool appendDelta(const uint8_t *payload, size_t length, uint64_t timestampMs, uint8_t quality = 0);
+
+    /// Records that the screen still shows the last appended frame. Writes
+    /// that frame in full if the batch is empty. Returns false if no frame
+    /// has been appended since reset(), or if the batch is empty and the last
+    /// frame was a delta.
+    bool appendRepeat(uint64_t timestampMs);
+
+    /// Closes the open batch into `bundle` and starts a new one with the same
+    /// epoch. Returns false if no frame was appended.
+    bool finish(Bundle &bundle);
+
+    /// Produces a complete bundle of the frames appended so far while leaving
+    /// the batch open, for persisting it before a crash.
+    bool snapshot(Bundle &bundle) const;
+
+    size_t frameCount() const;
+    uint64_t firstTimestampMs() const;
+
+private:
+    struct Stream;
+
+    bool appendLocked(const uint8_t *jpeg, size_t length, uint64_t timestampMs, uint8_t quality);
+    bool openStreamLocked(Codec codec);
+    bool writeLocked(const uint8_t *data, size_t length);
+    void fillBundleLocked(Bundle &bundle) const;
+    /// Puts the frame count and quality table behind the fixed header.
+    void spliceQualitiesLocked(std::string &payload) const;
+    void discardLocked();
+
+    const Options options_;
+    mutable std::mutex lock_;
+    std::unique_ptr<Stream> stream_;
+    uint64_t sessionEpochMs_ = 0;
+    size_t frameCount_ = 0;
+    size_t repeatCount_ = 0;
+    uint64_t firstTimestampMs_ = 0;
+    uint64_t lastTimestampMs_ = 0;
+    size_t rawBytes_ = 0;
+    /// Quality of each frame record in the open batch.
+    std::string qualities_;
+    /// Last JPEG appended, kept to open a batch that starts with a repeat.
+    std::string lastJpeg_;
+    bool lastWasDelta_ = false;
+    uint8_t lastQuality_ = 0;
+};
+
+} // namespace rejourney
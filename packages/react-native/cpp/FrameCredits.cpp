@@ -0,0 +1,121 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameCredits.h"
+
+#include <algorithm>
+
+namespace rejourney {
+
+FrameCredits::FrameCredits() : FrameCredits(Options()) {}
+
+FrameCredits::FrameCredits(Options options) : options_(options) {}
+
+void FrameCredits::setOptions(const Options &options) {
+    std::lock_guard<std::mutex> guard(lock_);
+    options_ = options;
+}
+
+FrameCredits::Options FrameCredits::options() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return options_;
+}
+
+size_t FrameCredits::freeFramesLocked() const {
+    const size_t slots = options_.uploadSlots + options_.queueSlots;
+    const size_t used = queued_ + uploading_;
+    if (used >= slots) {
+        return 0;
+    }
+    const size_t frames = (slots - used) * std::max<size_t>(1, options_.framesPerBundle);
+    return frames > reserved_ ? frames - reserved_ : 0;
+}
+
+bool FrameCredits::acquireFrame() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (freeFramesLocked() == 0) {
+        ++denied_;
+        return false;
+    }
+    ++reserved_;
+    ++granted_;
+    return true;
+}
+
+void FrameCredits::releaseFrames(size_t frames) {
+    std::lock_guard<std::mutex> guard(lock_);
+    reserved_ -= std::min(frames, reserved_);
+}
+
+void FrameCredits::resetFrames() {
+    std::lock_guard<std::mutex> guard(lock_);
+    reserved_ = 0;
+}
+
+size_t FrameCredits::frameCredits() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return freeFramesLocked();
+}
+
+void FrameCredits::bundleQueued(size_t frames) {
+    std::lock_guard<std::mutex> guard(lock_);
+    reserved_ -= std::min(frames, reserved_);
+    ++queued_;
+}
+
+void FrameCredits::clearBundles() {
+    std::lock_guard<std::mutex> guard(lock_);
+    queued_ = 0;
+}
+
+void FrameCredits::setUploadSlots(size_t slots) {
+    std::lock_guard<std::mutex> guard(lock_);
+    options_.uploadSlots = slots;
+}
+
+bool FrameCredits::startUpload() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (queued_ == 0 || uploading_ >= options_.uploadSlots) {
+        return false;
+    }
+    --queued_;
+    ++uploading_;
+    return true;
+}
+
+void FrameCredits::uploadFinished(bool requeued) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (uploading_ > 0) {
+        --uploading_;
+    }
+    if (requeued) {
+        ++queued_;
+    }
+}
+
+FrameCredits::Stats FrameCredits::stats() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    Stats stats;
+    stats.reservedFrames = reserved_;
+    stats.queuedBundles = queued_;
+    stats.uploadingBundles = uploading_;
+    stats.uploadSlots = options_.uploadSlots;
+    stats.grantedFrames = granted_;
+    stats.deniedFrames = denied_;
+    return stats;
+}
+
+} // namespace rejourney
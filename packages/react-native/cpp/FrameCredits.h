@@ -0,0 +1,113 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace rejourney {
+
+/**
+ * Credit-based backpressure from frame uploads back to capture, so a frame
+ * that could not be shipped is never rendered or encoded.
+ *
+ * The uploader grants `uploadSlots` (none while it refuses uploads) and the
+ * pipeline may hold `queueSlots` bundles waiting behind them. Each free slot
+ * is worth `framesPerBundle` frame credits. Capture takes one credit before
+ * it renders a frame and keeps it until the frame's bundle is queued, or
+ * gives it back if the frame never makes it into a bundle. Credits come back
+ * as uploads finish; a failed upload goes back to the queue and keeps its
+ * slot.
+ *
+ * A bundle is always accepted into the queue, even past `queueSlots` (a
+ * bundle flushed at shutdown, frames captured before a slot was lost), so
+ * nothing already encoded is thrown away; capture just waits longer.
+ *
+ * Thread-safe: capture, encode and upload callbacks each run on their own
+ * queue.
+ */
+class FrameCredits {
+public:
+    struct Options {
+        size_t uploadSlots = 2;
+        size_t queueSlots = 32;
+        size_t framesPerBundle = 3;
+    };
+
+    struct Stats {
+        /// Frames holding a credit that are not in a queued bundle yet.
+        size_t reservedFrames = 0;
+        size_t queuedBundles = 0;
+        size_t uploadingBundles = 0;
+        size_t uploadSlots = 0;
+        uint64_t grantedFrames = 0;
+        /// acquireFrame() calls refused for want of credit.
+        uint64_t deniedFrames = 0;
+    };
+
+    FrameCredits();
+    explicit FrameCredits(Options options);
+
+    /// Takes effect for later acquires; reservations stay.
+    void setOptions(const Options &options);
+    Options options() const;
+
+    // Capture side.
+
+    /// Takes a credit for one frame. False when uploads are too far behind.
+    bool acquireFrame();
+    /// Gives back credits of frames that will not be queued.
+    void releaseFrames(size_t frames = 1);
+    /// Drops every reservation, at the start of a session.
+    void resetFrames();
+    /// Frame credits free right now.
+    size_t frameCredits() const;
+
+    // Pipeline side.
+
+    /// `frames` captured frames went into a bundle that is now queued.
+    void bundleQueued(size_t frames);
+    /// Forgets queued bundles the pipeline discarded; uploads stay in flight.
+    void clearBundles();
+
+    // Upload side.
+
+    /// Slots the uploader grants right now.
+    void setUploadSlots(size_t slots);
+    /// Moves the next queued bundle into an upload slot. False when nothing
+    /// is queued or every slot is taken.
+    bool startUpload();
+    /// An upload started by startUpload() is over. `requeued` when the
+    /// bundle went back to the front of the queue.
+    void uploadFinished(bool requeued);
+
+    Stats stats() const;
+
+private:
+    size_t freeFramesLocked() const;
+
+    Options options_;
+    mutable std::mutex lock_;
+    size_t reserved_ = 0;
+    size_t queued_ = 0;
+    size_t uploading_ = 0;
+    uint64_t granted_ = 0;
+    uint64_t denied_ = 0;
+};
+
+} // namespace rejourney
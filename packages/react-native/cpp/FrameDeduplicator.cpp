@@ -0,0 +1,99 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameDeduplicator.h"
+
+#include "SimdBytes.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace rejourney {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+} // namespace
+
+FrameDeduplicator::FrameDeduplicator() : FrameDeduplicator(Options()) {}
+
+FrameDeduplicator::FrameDeduplicator(Options options) : options_(options) {}
+
+bool FrameDeduplicator::computeSignature(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow,
+                                         const Options &options, std::vector<uint8_t> &signature) {
+    const size_t gridWidth = options.gridWidth;
+    const size_t gridHeight = options.gridHeight;
+    const size_t rowStep = options.rowStep ? options.rowStep : 1;
+    if (!pixels || gridWidth == 0 || gridHeight == 0 || width < gridWidth || height < gridHeight ||
+        bytesPerRow < width * kBytesPerPixel) {
+        return false;
+    }
+
+    signature.assign(gridWidth * gridHeight, 0);
+    std::vector<uint64_t> sums(gridWidth);
+    for (size_t cy = 0; cy < gridHeight; ++cy) {
+        const size_t rowBegin = cy * height / gridHeight;
+        const size_t rowEnd = (cy + 1) * height / gridHeight;
+        std::fill(sums.begin(), sums.end(), 0);
+        size_t rows = 0;
+        for (size_t y = rowBegin; y < rowEnd; y += rowStep, ++rows) {
+            const uint8_t *row = pixels + y * bytesPerRow;
+            for (size_t cx = 0; cx < gridWidth; ++cx) {
+                const size_t begin = cx * width / gridWidth * kBytesPerPixel;
+                const size_t end = (cx + 1) * width / gridWidth * kBytesPerPixel;
+                sums[cx] += simd::sumBytes(row + begin, end - begin);
+            }
+        }
+        for (size_t cx = 0; cx < gridWidth; ++cx) {
+            const size_t cellBytes = ((cx + 1) * width / gridWidth - cx * width / gridWidth) * kBytesPerPixel * rows;
+            signature[cy * gridWidth + cx] = static_cast<uint8_t>(sums[cx] / cellBytes);
+        }
+    }
+    return true;
+}
+
+bool FrameDeduplicator::isRepeat(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!computeSignature(pixels, width, height, bytesPerRow, options_, scratch_)) {
+        reference_.clear();
+        repeats_ = 0;
+        return false;
+    }
+
+    bool same = !reference_.empty() && width == referenceWidth_ && height == referenceHeight_ &&
+                repeats_ < options_.maxRepeats;
+    for (size_t i = 0; same && i < scratch_.size(); ++i) {
+        same = std::abs(static_cast<int>(scratch_[i]) - static_cast<int>(reference_[i])) <= options_.cellTolerance;
+    }
+    if (same) {
+        ++repeats_;
+        return true;
+    }
+    reference_.swap(scratch_);
+    referenceWidth_ = width;
+    referenceHeight_ = height;
+    repeats_ = 0;
+    return false;
+}
+
+void FrameDeduplicator::reset() {
+    std::lock_guard<std::mutex> guard(lock_);
+    reference_.clear();
+    repeats_ = 0;
+}
+
+} // namespace rejourney
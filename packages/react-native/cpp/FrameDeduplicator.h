@@ -0,0 +1,74 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Detects captured frames that look the same as the last frame kept.
+ *
+ * A frame is reduced to a coarse signature: the mean byte value of each cell
+ * of a grid laid over the bitmap, summed with SIMD over every `rowStep`th
+ * row. A frame whose cells all stay within `cellTolerance` of the reference
+ * signature is a repeat; the reference only moves when a frame is not a
+ * repeat, so slow drift cannot accumulate. After `maxRepeats` consecutive
+ * repeats the next frame is reported as changed to refresh the keyframe.
+ *
+ * Bitmaps must be 32 bits per pixel; anything else is never a repeat.
+ * Thread-safe.
+ */
+class FrameDeduplicator {
+public:
+    struct Options {
+        uint32_t gridWidth = 32;
+        uint32_t gridHeight = 64;
+        uint32_t rowStep = 2;
+        uint8_t cellTolerance = 2;
+        uint32_t maxRepeats = 30;
+    };
+
+    FrameDeduplicator();
+    explicit FrameDeduplicator(Options options);
+
+    /// Returns true if `pixels` matches the reference frame. Otherwise the
+    /// frame becomes the new reference.
+    bool isRepeat(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow);
+
+    /// Forgets the reference so the next frame is never a repeat.
+    void reset();
+
+    /// Cell means for a 32bpp bitmap, row-major, gridWidth * gridHeight bytes.
+    /// Returns false if the bitmap is smaller than the grid.
+    static bool computeSignature(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow,
+                                 const Options &options, std::vector<uint8_t> &signature);
+
+private:
+    const Options options_;
+    std::mutex lock_;
+    std::vector<uint8_t> reference_;
+    std::vector<uint8_t> scratch_;
+    size_t referenceWidth_ = 0;
+    size_t referenceHeight_ = 0;
+    uint32_t repeats_ = 0;
+};
+
+} // namespace rejourney
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GroupCommitLog.h"
+
+namespace rejourney {
+
+GroupCommitLog::GroupCommitLog(SegmentedLog &log, Options options)
+    : log_(log), options_(options), writer_([this] { run(); }) {}
+
+GroupCommitLog::~GroupCommitLog() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+}
+
+bool GroupCommitLog::append(std::string payload, int64_t timestampMs) {
+    if (payload.empty()) {
+        return false;
+    }
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (staged_.empty()) {
+            oldestStagedAt_ = std::chrono::steady_clock::now();
+            wake = true;
+        }
+        stagedBytes_ += payload.size();
+        staged_.push_back({std::move(payload), timestampMs});
+        ++appendedSeq_;
+        wake = wake || stagedBytes_ >= options_.maxStagedBytes;
+    }
+    if (wake) {
+        wake_.notify_one();
+    }
+    return true;
+}
+
+bool GroupCommitLog::flush(bool durable, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(lock_);
+    const uint64_t target = appendedSeq_;
+    if (writtenSeq_ < target) {
+        flushRequested_ = true;
+        wake_.notify_one();
+        if (!written_.wait_for(lock, timeout, [&] { return writtenSeq_ >= target; })) {
+            return false;
+        }
+    }
+    const bool ok = !writeFailed_;
+    writeFailed_ = false;
+    lock.unlock();
+    return (!durable || log_.sync()) && ok;
+}
+
+size_t GroupCommitLog::pending() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return static_cast<size_t>(appendedSeq_ - writtenSeq_);
+}
+
+void GroupCommitLog::run() {
+    std::vector<SegmentedLog::Record> batch;
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+        if (staged_.empty()) {
+            if (stopping_) {
+                break;
+            }
+            wake_.wait_for(lock, std::chrono::hours(1), [&] { return stopping_ || !staged_.empty(); });
+            continue;
+        }
+
+        const auto deadline = oldestStagedAt_ + std::chrono::milliseconds(options_.maxDelayMs);
+        wake_.wait_until(lock, deadline, [&] {
+            return stopping_ || flushRequested_ || stagedBytes_ >= options_.maxStagedBytes;
+        });
+
+        batch.swap(staged_);
+        stagedBytes_ = 0;
+        flushRequested_ = false;
+        const uint64_t seq = appendedSeq_;
+
+        lock.unlock();
+        const bool failed = log_.appendBatch(batch) < batch.size();
+        batch.clear();
+        lock.lock();
+
+        writeFailed_ = writeFailed_ || failed;
+        writtenSeq_ = seq;
+        written_.notify_all();
+    }
+}
+
+} // namespace rejourney
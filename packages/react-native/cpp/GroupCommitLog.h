@@ -0,0 +1,88 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "SegmentedLog.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Group-commit front end for a SegmentedLog.
+ *
+ * Appends only stage the record in memory. A background writer hands
+ * everything staged to SegmentedLog::appendBatch, which is one write per
+ * segment, once the oldest staged record is `maxDelayMs` old or
+ * `maxStagedBytes` have accumulated. A crash loses at most `maxDelayMs` of
+ * events. Crash handlers and shutdown paths call flush() to write everything
+ * staged before returning.
+ *
+ * The log must be open for the lifetime of this object. Destruction flushes.
+ */
+class GroupCommitLog {
+public:
+    struct Options {
+        uint32_t maxDelayMs = 100;
+        size_t maxStagedBytes = 64 * 1024;
+    };
+
+    GroupCommitLog(SegmentedLog &log, Options options);
+    ~GroupCommitLog();
+
+    GroupCommitLog(const GroupCommitLog &) = delete;
+    GroupCommitLog &operator=(const GroupCommitLog &) = delete;
+
+    /// Stages one record. Returns false for an empty payload.
+    bool append(std::string payload, int64_t timestampMs);
+
+    /// Blocks until every record appended before the call has been written.
+    /// With `durable`, also forces the log to stable storage. Returns false if
+    /// a write failed since the previous flush, or if `timeout` expired first
+    /// (crash handlers must not hang on a stuck disk).
+    bool flush(bool durable, std::chrono::milliseconds timeout = std::chrono::seconds(2));
+
+    /// Records appended but not yet written.
+    size_t pending() const;
+
+private:
+    void run();
+
+    SegmentedLog &log_;
+    const Options options_;
+
+    mutable std::mutex lock_;
+    std::condition_variable wake_;
+    std::condition_variable written_;
+    std::vector<SegmentedLog::Record> staged_;
+    size_t stagedBytes_ = 0;
+    std::chrono::steady_clock::time_point oldestStagedAt_;
+    uint64_t appendedSeq_ = 0;
+    uint64_t writtenSeq_ = 0;
+    bool writeFailed_ = false;
+    bool flushRequested_ = false;
+    bool stopping_ = false;
+    std::thread writer_;
+};
+
+} // namespace rejourney
@@ -0,0 +1,368 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HierarchyDelta.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rejourney {
+
+namespace {
+
+using Attribute = HierarchySnapshotBuilder::Attribute;
+
+constexpr uint64_t kNodeSeed = 0x6a09e667f3bcc908ull;
+constexpr uint64_t kChildSeed = 0xbb67ae8584caa73bull;
+
+uint64_t mix(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+uint64_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void putU8(std::string &out, uint32_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+}
+
+void putU16BE(std::string &out, uint32_t value) {
+    const char bytes[2] = {static_cast<char>((value >> 8) & 0xFF), static_cast<char>(value & 0xFF)};
+    out.append(bytes, sizeof(bytes));
+}
+
+void putU32BE(std::string &out, uint32_t value) {
+    const char bytes[4] = {static_cast<char>((value >> 24) & 0xFF), static_cast<char>((value >> 16) & 0xFF),
+                           static_cast<char>((value >> 8) & 0xFF), static_cast<char>(value & 0xFF)};
+    out.append(bytes, sizeof(bytes));
+}
+
+void putU64BE(std::string &out, uint64_t value) {
+    putU32BE(out, static_cast<uint32_t>(value >> 32));
+    putU32BE(out, static_cast<uint32_t>(value));
+}
+
+void putF32BE(std::string &out, float value) {
+    putU32BE(out, static_cast<uint32_t>(floatBits(value)));
+}
+
+} // namespace
+
+HierarchyDeltaEncoder::HierarchyDeltaEncoder() : HierarchyDeltaEncoder(Options()) {}
+
+HierarchyDeltaEncoder::HierarchyDeltaEncoder(Options options) : options_(options) {}
+
+void HierarchyDeltaEncoder::reset() {
+    std::lock_guard<std::mutex> guard(lock_);
+    hasKeyframe_ = false;
+    idsByKey_.clear();
+    keyframeNodeHashes_.clear();
+    keyframeSubtreeHashes_.clear();
+    keyframeChildHashes_.clear();
+}
+
+HierarchyDeltaEncoder::Result HierarchyDeltaEncoder::encode(const HierarchySnapshotBuilder &builder,
+                                                            uint64_t timestampMs, bool forceKeyframe,
+                                                            std::string &out) {
+    std::lock_guard<std::mutex> guard(lock_);
+    const size_t nodes = builder.nodeCount();
+    bool keyframe = forceKeyframe || !hasKeyframe_ || nodes == 0 || keyframeNodeHashes_.empty() ||
+                    builder.parents_[0] != -1 || snapshotsSinceKeyframe_ + 1 >= options_.keyframeInterval;
+    // The keyframe root always has id 0; a different root view means a new screen.
+    if (!keyframe && (!assignIdsLocked(builder) || ids_[0] != 0)) {
+        keyframe = true;
+    }
+    if (!keyframe) {
+        hashNodesLocked(builder);
+        bool unchanged = false;
+        if (encodeDeltaLocked(builder, timestampMs, out, unchanged)) {
+            ++snapshotsSinceKeyframe_;
+            return unchanged ? Result::Unchanged : Result::Delta;
+        }
+    }
+    storeKeyframeLocked(builder);
+    out = builder.serialize(timestampMs, keyframeId_);
+    return Result::Keyframe;
+}
+
+bool HierarchyDeltaEncoder::assignIdsLocked(const HierarchySnapshotBuilder &builder) {
+    const size_t nodes = builder.nodeCount();
+    ids_.resize(nodes);
+    if (seen_.size() < nextId_) {
+        seen_.resize(nextId_, 0);
+    }
+    if (++seenStamp_ == 0) {
+        std::fill(seen_.begin(), seen_.end(), 0);
+        seenStamp_ = 1;
+    }
+    for (size_t i = 0; i < nodes; ++i) {
+        auto inserted = idsByKey_.emplace(builder.keys_[i], nextId_);
+        if (inserted.second) {
+            ++nextId_;
+        }
+        const uint32_t id = inserted.first->second;
+        if (seen_.size() <= id) {
+            seen_.resize(std::max<size_t>(id + 1, seen_.size() * 2), 0);
+        }
+        if (seen_[id] == seenStamp_) {
+            return false; // two views with the same key
+        }
+        seen_[id] = seenStamp_;
+        ids_[i] = id;
+    }
+    return true;
+}
+
+void HierarchyDeltaEncoder::hashNodesLocked(const HierarchySnapshotBuilder &builder) {
+    const size_t nodes = builder.nodeCount();
+    const auto &strings = builder.stringHashes_;
+
+    nodeHashes_.resize(nodes);
+    for (size_t i = 0; i < nodes; ++i) {
+        const auto &frame = builder.frames_[i];
+        uint64_t hash = mix(kNodeSeed, strings[builder.types_[i]]);
+        hash = mix(hash, floatBits(frame.x) << 32 | floatBits(frame.y));
+        hash = mix(hash, floatBits(frame.width) << 32 | floatBits(frame.height));
+        hash = mix(hash, floatBits(builder.alphas_[i]) << 16 | builder.flags_[i]);
+        nodeHashes_[i] = hash;
+    }
+    for (const auto &attribute : builder.attributes_) {
+        const uint64_t value =
+            attribute.key == Attribute::TextLength ? attribute.value : strings[attribute.value];
+        auto &hash = nodeHashes_[attribute.node];
+        hash = mix(mix(hash, static_cast<uint64_t>(attribute.key)), value);
+    }
+    for (const auto &scroll : builder.scrolls_) {
+        auto &hash = nodeHashes_[scroll.node];
+        hash = mix(hash, floatBits(scroll.offsetX) << 32 | floatBits(scroll.offsetY));
+        hash = mix(hash, floatBits(scroll.contentWidth) << 32 | floatBits(scroll.contentHeight));
+    }
+
+    // Children of each node in scan order, as offsets into children_.
+    childStarts_.assign(nodes + 1, 0);
+    for (size_t i = 1; i < nodes; ++i) {
+        const int32_t parent = builder.parents_[i];
+        if (parent >= 0) {
+            ++childStarts_[parent + 1];
+        }
+    }
+    for (size_t i = 0; i < nodes; ++i) {
+        childStarts_[i + 1] += childStarts_[i];
+    }
+    children_.resize(childStarts_[nodes]);
+    stack_.assign(childStarts_.begin(), childStarts_.end() - 1);
+    for (size_t i = 1; i < nodes; ++i) {
+        const int32_t parent = builder.parents_[i];
+        if (parent >= 0) {
+            children_[stack_[parent]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // Parents precede children, so walking backwards sees every subtree
+    // before the node that contains it.
+    childHashes_.resize(nodes);
+    subtreeHashes_.resize(nodes);
+    for (size_t i = nodes; i-- > 0;) {
+        uint64_t childHash = mix(kChildSeed, childStarts_[i + 1] - childStarts_[i]);
+        uint64_t subtreeHash = nodeHashes_[i];
+        for (uint32_t c = childStarts_[i]; c < childStarts_[i + 1]; ++c) {
+            childHash = mix(childHash, ids_[children_[c]]);
+            subtreeHash = mix(subtreeHash, subtreeHashes_[children_[c]]);
+        }
+        childHashes_[i] = childHash;
+        subtreeHashes_[i] = mix(subtreeHash, childHash);
+    }
+}
+
+void HierarchyDeltaEncoder::storeKeyframeLocked(const HierarchySnapshotBuilder &builder) {
+    const size_t nodes = builder.nodeCount();
+    idsByKey_.clear();
+    ids_.resize(nodes);
+    for (size_t i = 0; i < nodes; ++i) {
+        ids_[i] = static_cast<uint32_t>(i);
+        idsByKey_[builder.keys_[i]] = static_cast<uint32_t>(i);
+    }
+    nextId_ = static_cast<uint32_t>(nodes);
+    hashNodesLocked(builder);
+    keyframeNodeHashes_ = nodeHashes_;
+    keyframeSubtreeHashes_ = subtreeHashes_;
+    keyframeChildHashes_ = childHashes_;
+    keyframeScreenWidth_ = builder.screenWidth_;
+    keyframeScreenHeight_ = builder.screenHeight_;
+    keyframeScreenScale_ = builder.screenScale_;
+    keyframeScreenNameHash_ = builder.screenName_ == HierarchySnapshotBuilder::kNoString
+                                  ? 0
+                                  : builder.stringHashes_[builder.screenName_];
+    hasKeyframe_ = true;
+    if (++keyframeId_ == 0) {
+        keyframeId_ = 1;
+    }
+    snapshotsSinceKeyframe_ = 0;
+}
+
+bool HierarchyDeltaEncoder::encodeDeltaLocked(const HierarchySnapshotBuilder &builder, uint64_t timestampMs,
+                                              std::string &out, bool &unchanged) {
+    const size_t nodes = builder.nodeCount();
+    const size_t keyframeNodes = keyframeNodeHashes_.size();
+
+    upserts_.clear();
+    childLists_.clear();
+    removed_.clear();
+    upserted_.assign(nodes, 0);
+    stack_.assign(1, 0);
+    while (!stack_.empty()) {
+        const uint32_t i = stack_.back();
+        stack_.pop_back();
+        const uint32_t id = ids_[i];
+        const bool inKeyframe = id < keyframeNodes;
+        if (inKeyframe && subtreeHashes_[i] == keyframeSubtreeHashes_[id]) {
+            continue;
+        }
+        if (!inKeyframe || nodeHashes_[i] != keyframeNodeHashes_[id]) {
+            upserts_.push_back(i);
+            upserted_[i] = 1;
+        }
+        const bool hasChildren = childStarts_[i + 1] > childStarts_[i];
+        if (inKeyframe ? childHashes_[i] != keyframeChildHashes_[id] : hasChildren) {
+            childLists_.push_back(i);
+        }
+        for (uint32_t c = childStarts_[i + 1]; c-- > childStarts_[i];) {
+            stack_.push_back(children_[c]);
+        }
+    }
+    for (uint32_t id = 0; id < keyframeNodes; ++id) {
+        if (seen_[id] != seenStamp_) {
+            removed_.push_back(id);
+        }
+    }
+
+    const size_t changed = upserts_.size() + removed_.size();
+    if (static_cast<double>(changed) > options_.maxChangedFraction * static_cast<double>(std::max(nodes, keyframeNodes))) {
+        return false;
+    }
+
+    const uint64_t screenNameHash = builder.screenName_ == HierarchySnapshotBuilder::kNoString
+                                        ? 0
+                                        : builder.stringHashes_[builder.screenName_];
+    unchanged = upserts_.empty() && childLists_.empty() && removed_.empty() &&
+                builder.screenWidth_ == keyframeScreenWidth_ && builder.screenHeight_ == keyframeScreenHeight_ &&
+                builder.screenScale_ == keyframeScreenScale_ && screenNameHash == keyframeScreenNameHash_;
+
+    // Only the strings this delta refers to are sent.
+    deltaStringIds_.assign(builder.stringOffsets_.size(), HierarchySnapshotBuilder::kNoString);
+    deltaStrings_.clear();
+    auto deltaString = [this](uint32_t stringId) {
+        if (stringId == HierarchySnapshotBuilder::kNoString) {
+            return stringId;
+        }
+        if (deltaStringIds_[stringId] == HierarchySnapshotBuilder::kNoString) {
+            deltaStringIds_[stringId] = static_cast<uint32_t>(deltaStrings_.size());
+            deltaStrings_.push_back(stringId);
+        }
+        return deltaStringIds_[stringId];
+    };
+    const uint32_t screenName = deltaString(builder.screenName_);
+    for (uint32_t i : upserts_) {
+        deltaString(builder.types_[i]);
+    }
+    attributeRows_.clear();
+    for (uint32_t row = 0; row < builder.attributes_.size(); ++row) {
+        const auto &attribute = builder.attributes_[row];
+        if (upserted_[attribute.node]) {
+            attributeRows_.push_back(row);
+            if (attribute.key != Attribute::TextLength) {
+                deltaString(attribute.value);
+            }
+        }
+    }
+    scrollRows_.clear();
+    for (uint32_t row = 0; row < builder.scrolls_.size(); ++row) {
+        if (upserted_[builder.scrolls_[row].node]) {
+            scrollRows_.push_back(row);
+        }
+    }
+
+    out.clear();
+    out.append("RJHD", 4);
+    putU8(out, kFormatVersion);
+    putU32BE(out, keyframeId_);
+    putU64BE(out, timestampMs);
+    putF32BE(out, builder.screenWidth_);
+    putF32BE(out, builder.screenHeight_);
+    putF32BE(out, builder.screenScale_);
+    putU32BE(out, screenName);
+
+    putU32BE(out, static_cast<uint32_t>(deltaStrings_.size()));
+    for (uint32_t stringId : deltaStrings_) {
+        const auto value = builder.stringAt(stringId);
+        putU32BE(out, static_cast<uint32_t>(value.size()));
+        out.append(value);
+    }
+
+    putU32BE(out, ids_[0]);
+
+    putU32BE(out, static_cast<uint32_t>(upserts_.size()));
+    for (uint32_t i : upserts_) putU32BE(out, ids_[i]);
+    for (uint32_t i : upserts_) putU32BE(out, deltaStringIds_[builder.types_[i]]);
+    for (uint32_t i : upserts_) putF32BE(out, builder.frames_[i].x);
+    for (uint32_t i : upserts_) putF32BE(out, builder.frames_[i].y);
+    for (uint32_t i : upserts_) putF32BE(out, builder.frames_[i].width);
+    for (uint32_t i : upserts_) putF32BE(out, builder.frames_[i].height);
+    for (uint32_t i : upserts_) putF32BE(out, builder.alphas_[i]);
+    for (uint32_t i : upserts_) putU16BE(out, builder.flags_[i]);
+
+    putU32BE(out, static_cast<uint32_t>(attributeRows_.size()));
+    for (uint32_t row : attributeRows_) {
+        const auto &attribute = builder.attributes_[row];
+        putU32BE(out, ids_[attribute.node]);
+        putU8(out, static_cast<uint8_t>(attribute.key));
+        putU32BE(out, attribute.key == Attribute::TextLength ? attribute.value : deltaStringIds_[attribute.value]);
+    }
+
+    putU32BE(out, static_cast<uint32_t>(scrollRows_.size()));
+    for (uint32_t row : scrollRows_) {
+        const auto &scroll = builder.scrolls_[row];
+        putU32BE(out, ids_[scroll.node]);
+        putF32BE(out, scroll.offsetX);
+        putF32BE(out, scroll.offsetY);
+        putF32BE(out, scroll.contentWidth);
+        putF32BE(out, scroll.contentHeight);
+    }
+
+    putU32BE(out, static_cast<uint32_t>(childLists_.size()));
+    for (uint32_t i : childLists_) {
+        putU32BE(out, ids_[i]);
+        putU32BE(out, childStarts_[i + 1] - childStarts_[i]);
+        for (uint32_t c = childStarts_[i]; c < childStarts_[i + 1]; ++c) {
+            putU32BE(out, ids_[children_[c]]);
+        }
+    }
+
+    putU32BE(out, static_cast<uint32_t>(removed_.size()));
+    for (uint32_t id : removed_) putU32BE(out, id);
+    return true;
+}
+
+} // namespace rejourney
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "HierarchySnapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Encodes successive hierarchy snapshots as deltas against the last
+ * keyframe.
+ *
+ * A keyframe is the full snapshot (HierarchySnapshot.h); its node indices
+ * become the stable ids later deltas refer to. Views are matched across scans
+ * by their builder key, and views that appear after the keyframe get fresh
+ * ids that stay put until the next one. Every node carries a content hash and
+ * a subtree hash; a subtree whose hash matches the keyframe is skipped
+ * without visiting it, so a delta only walks the parts of the screen that
+ * changed.
+ *
+ * Every delta is relative to the keyframe, not to the previous delta, so a
+ * lost delta never breaks the ones after it. A keyframe is sent instead
+ * when the caller forces one, on the first snapshot, when the root view
+ * changes, after `keyframeInterval` snapshots, or when more than
+ * `maxChangedFraction` of the nodes would be sent.
+ *
+ * Delta layout (big-endian):
+ *   "RJHD" u8 version, u32 keyframeId
+ *   u64 timestampMs, f32 screenWidth, f32 screenHeight, f32 screenScale,
+ *   u32 screenName string id
+ *   u32 stringCount, then per string: u32 byte length, UTF-8 bytes
+ *   u32 rootId
+ *   u32 upsertCount, then columns: u32 id, u32 type, f32 x, f32 y,
+ *     f32 width, f32 height, f32 alpha, u16 flags
+ *   u32 attributeCount, then per attribute: u32 id, u8 key, u32 value
+ *   u32 scrollCount, then per scroll: u32 id, f32 offsetX, f32 offsetY,
+ *     f32 contentWidth, f32 contentHeight
+ *   u32 childListCount, then per list: u32 parentId, u32 count, u32 ids
+ *   u32 removedCount, then u32 ids
+ * Upserted nodes replace the keyframe node with that id (or add it);
+ * child lists replace a node's ordered children; removed ids are gone.
+ * Nodes and child lists not mentioned are as in the keyframe.
+ *
+ * Thread-safe.
+ */
+class HierarchyDeltaEncoder {
+public:
+    static constexpr uint8_t kFormatVersion = 1;
+
+    struct Options {
+        uint32_t keyframeInterval = 30;
+        double maxChangedFraction = 0.5;
+    };
+
+    enum class Result {
+        Keyframe,
+        Delta,
+        /// A delta that changes nothing but the timestamp.
+        Unchanged,
+    };
+
+    HierarchyDeltaEncoder();
+    explicit HierarchyDeltaEncoder(Options options);
+
+    /// Encodes the snapshot in `builder` into `out`.
+    Result encode(const HierarchySnapshotBuilder &builder, uint64_t timestampMs, bool forceKeyframe,
+                  std::string &out);
+
+    /// Forgets the keyframe so the next snapshot is one.
+    void reset();
+
+private:
+    bool assignIdsLocked(const HierarchySnapshotBuilder &builder);
+    void hashNodesLocked(const HierarchySnapshotBuilder &builder);
+    bool encodeDeltaLocked(const HierarchySnapshotBuilder &builder, uint64_t timestampMs, std::string &out,
+                           bool &unchanged);
+    void storeKeyframeLocked(const HierarchySnapshotBuilder &builder);
+
+    const Options options_;
+    std::mutex lock_;
+
+    bool hasKeyframe_ = false;
+    uint32_t keyframeId_ = 0;
+    uint32_t snapshotsSinceKeyframe_ = 0;
+    uint32_t nextId_ = 0;
+    std::unordered_map<uint64_t, uint32_t> idsByKey_;
+    // Per keyframe id.
+    std::vector<uint64_t> keyframeNodeHashes_;
+    std::vector<uint64_t> keyframeSubtreeHashes_;
+    std::vector<uint64_t> keyframeChildHashes_;
+    float keyframeScreenWidth_ = 0;
+    float keyframeScreenHeight_ = 0;
+    float keyframeScreenScale_ = 0;
+    uint64_t keyframeScreenNameHash_ = 0;
+
+    // Scratch, per node of the snapshot being encoded.
+    std::vector<uint32_t> ids_;
+    std::vector<uint64_t> nodeHashes_;
+    std::vector<uint64_t> subtreeHashes_;
+    std::vector<uint64_t> childHashes_;
+    std::vector<uint32_t> childStarts_;
+    std::vector<uint32_t> children_;
+    std::vector<uint32_t> seen_;
+    uint32_t seenStamp_ = 0;
+    std::vector<uint32_t> stack_;
+    std::vector<uint8_t> upserted_;
+    std::vector<uint32_t> upserts_;
+    std::vector<uint32_t> childLists_;
+    std::vector<uint32_t> removed_;
+    std::vector<uint32_t> attributeRows_;
+    std::vector<uint32_t> scrollRows_;
+    /// Snapshot string id -> delta string id, and the reverse.
+    std::vector<uint32_t> deltaStringIds_;
+    std::vector<uint32_t> deltaStrings_;
+};
+
+} // namespace rejourney
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HierarchySnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rejourney {
+
+namespace {
+
+constexpr size_t kMinInternSlots = 64;
+
+uint64_t hashBytes(std::string_view value) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : value) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+void putU8(std::string &out, uint32_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+}
+
+void putU16BE(std::string &out, uint32_t value) {
+    const char bytes[2] = {static_cast<char>((value >> 8) & 0xFF), static_cast<char>(value & 0xFF)};
+    out.append(bytes, sizeof(bytes));
+}
+
+void putU32BE(std::string &out, uint32_t value) {
+    const char bytes[4] = {static_cast<char>((value >> 24) & 0xFF), static_cast<char>((value >> 16) & 0xFF),
+                           static_cast<char>((value >> 8) & 0xFF), static_cast<char>(value & 0xFF)};
+    out.append(bytes, sizeof(bytes));
+}
+
+void putU64BE(std::string &out, uint64_t value) {
+    putU32BE(out, static_cast<uint32_t>(value >> 32));
+    putU32BE(out, static_cast<uint32_t>(value));
+}
+
+void putF32BE(std::string &out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32BE(out, bits);
+}
+
+} // namespace
+
+HierarchySnapshotBuilder::HierarchySnapshotBuilder(size_t expectedNodes) {
+    parents_.reserve(expectedNodes);
+    keys_.reserve(expectedNodes);
+    types_.reserve(expectedNodes);
+    frames_.reserve(expectedNodes);
+    alphas_.reserve(expectedNodes);
+    flags_.reserve(expectedNodes);
+    internSlots_.assign(kMinInternSlots, 0);
+}
+
+void HierarchySnapshotBuilder::reset() {
+    screenWidth_ = 0;
+    screenHeight_ = 0;
+    screenScale_ = 0;
+    screenName_ = kNoString;
+    parents_.clear();
+    keys_.clear();
+    types_.clear();
+    frames_.clear();
+    alphas_.clear();
+    flags_.clear();
+    attributes_.clear();
+    scrolls_.clear();
+    arena_.clear();
+    stringOffsets_.clear();
+    stringLengths_.clear();
+    stringHashes_.clear();
+    std::fill(internSlots_.begin(), internSlots_.end(), 0);
+}
+
+void HierarchySnapshotBuilder::setScreen(float width, float height, float scale, std::string_view screenName) {
+    screenWidth_ = width;
+    screenHeight_ = height;
+    screenScale_ = scale;
+    screenName_ = screenName.empty() ? kNoString : intern(screenName);
+}
+
+int32_t HierarchySnapshotBuilder::addNode(int32_t parent, uint64_t key, std::string_view type, Frame frame,
+                                          float alpha, uint16_t flags) {
+    if (parent < -1 || (parent >= 0 && static_cast<size_t>(parent) >= parents_.size())) {
+        return -1;
+    }
+    const auto index = static_cast<int32_t>(parents_.size());
+    parents_.push_back(parent);
+    keys_.push_back(key);
+    types_.push_back(intern(type));
+    frames_.push_back(frame);
+    alphas_.push_back(alpha);
+    flags_.push_back(flags);
+    return index;
+}
+
+void HierarchySnapshotBuilder::setString(int32_t node, Attribute key, std::string_view value) {
+    if (node < 0 || static_cast<size_t>(node) >= parents_.size() || key == Attribute::TextLength) {
+        return;
+    }
+    attributes_.push_back({static_cast<uint32_t>(node), key, intern(value)});
+}
+
+void HierarchySnapshotBuilder::setTextLength(int32_t node, uint32_t length) {
+    if (node < 0 || static_cast<size_t>(node) >= parents_.size()) {
+        return;
+    }
+    attributes_.push_back({static_cast<uint32_t>(node), Attribute::TextLength, length});
+}
+
+void HierarchySnapshotBuilder::setScroll(int32_t node, float offsetX, float offsetY, float contentWidth,
+                                         float contentHeight) {
+    if (node < 0 || static_cast<size_t>(node) >= parents_.size()) {
+        return;
+    }
+    scrolls_.push_back({static_cast<uint32_t>(node), offsetX, offsetY, contentWidth, contentHeight});
+}
+
+size_t HierarchySnapshotBuilder::childCount(int32_t node) const {
+    size_t count = 0;
+    for (int32_t parent : parents_) {
+        if (parent == node) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::string_view HierarchySnapshotBuilder::stringAt(uint32_t id) const {
+    return std::string_view(arena_.data() + stringOffsets_[id], stringLengths_[id]);
+}
+
+void HierarchySnapshotBuilder::growInternTable() {
+    std::vector<uint32_t> slots(internSlots_.size() * 2, 0);
+    const size_t mask = slots.size() - 1;
+    for (uint32_t id = 0; id < stringHashes_.size(); ++id) {
+        size_t slot = stringHashes_[id] & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id + 1;
+    }
+    internSlots_.swap(slots);
+}
+
+uint32_t HierarchySnapshotBuilder::intern(std::string_view value) {
+    const uint64_t hash = hashBytes(value);
+    const size_t mask = internSlots_.size() - 1;
+    size_t slot = hash & mask;
+    while (internSlots_[slot] != 0) {
+        const uint32_t id = internSlots_[slot] - 1;
+        if (stringHashes_[id] == hash && stringAt(id) == value) {
+            return id;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    const auto id = static_cast<uint32_t>(stringOffsets_.size());
+    stringOffsets_.push_back(static_cast<uint32_t>(arena_.size()));
+    stringLengths_.push_back(static_cast<uint32_t>(value.size()));
+    stringHashes_.push_back(hash);
+    arena_.append(value.data(), value.size());
+    internSlots_[slot] = id + 1;
+    // Keep the table at most half full so probes stay short.
+    if (stringHashes_.size() * 2 > internSlots_.size()) {
+        growInternTable();
+    }
+    return id;
+}
+
+std::string HierarchySnapshotBuilder::serialize(uint64_t timestampMs, uint32_t keyframeId) const {
+    const size_t nodes = parents_.size();
+    std::string out;
+    out.reserve(32 + arena_.size() + stringOffsets_.size() * 4 + nodes * 30 + attributes_.size() * 9 +
+                scrolls_.size() * 20);
+
+    out.append("RJHS", 4);
+    putU8(out, kFormatVersion);
+    putU64BE(out, timestampMs);
+    putF32BE(out, screenWidth_);
+    putF32BE(out, screenHeight_);
+    putF32BE(out, screenScale_);
+    putU32BE(out, screenName_);
+    putU32BE(out, keyframeId);
+
+    putU32BE(out, static_cast<uint32_t>(stringOffsets_.size()));
+    for (uint32_t id = 0; id < stringOffsets_.size(); ++id) {
+        putU32BE(out, stringLengths_[id]);
+        out.append(stringAt(id));
+    }
+
+    putU32BE(out, static_cast<uint32_t>(nodes));
+    for (int32_t parent : parents_) putU32BE(out, static_cast<uint32_t>(parent));
+    for (uint32_t type : types_) putU32BE(out, type);
+    for (const auto &frame : frames_) putF32BE(out, frame.x);
+    for (const auto &frame : frames_) putF32BE(out, frame.y);
+    for (const auto &frame : frames_) putF32BE(out, frame.width);
+    for (const auto &frame : frames_) putF32BE(out, frame.height);
+    for (float alpha : alphas_) putF32BE(out, alpha);
+    for (uint16_t flags : flags_) putU16BE(out, flags);
+
+    putU32BE(out, static_cast<uint32_t>(attributes_.size()));
+    for (const auto &attribute : attributes_) {
+        putU32BE(out, attribute.node);
+        putU8(out, static_cast<uint8_t>(attribute.key));
+        putU32BE(out, attribute.value);
+    }
+
+    putU32BE(out, static_cast<uint32_t>(scrolls_.size()));
+    for (const auto &scroll : scrolls_) {
+        putU32BE(out, scroll.node);
+        putF32BE(out, scroll.offsetX);
+        putF32BE(out, scroll.offsetY);
+        putF32BE(out, scroll.contentWidth);
+        putF32BE(out, scroll.contentHeight);
+    }
+    return out;
+}
+
+} // namespace rejourney
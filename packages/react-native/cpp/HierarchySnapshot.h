@@ -0,0 +1,159 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Flat, table-based view hierarchy snapshot.
+ *
+ * A scan appends one row per view to a set of parallel columns (parent
+ * index, view key, interned type name, frame, alpha, flag bits). Sparse
+ * attributes live in side tables: strings and counts go in `attributes`,
+ * scroll geometry in `scrolls`. All strings are interned into a single
+ * arena, so a scan allocates nothing per node once the columns have grown
+ * to the size of the screen. `reset()` keeps every buffer's capacity so the
+ * builder can be reused across scans. View keys identify the same view
+ * across scans (HierarchyDeltaEncoder uses them) and are never serialized.
+ *
+ * Serialized layout (big-endian), column-major so it gzips well:
+ *   "RJHS" u8 version
+ *   u64 timestampMs, f32 screenWidth, f32 screenHeight, f32 screenScale,
+ *   u32 screenName string id, u32 keyframeId
+ *   u32 stringCount, then per string: u32 byte length, UTF-8 bytes
+ *   u32 nodeCount, then columns: i32 parent, u32 type, f32 x, f32 y,
+ *     f32 width, f32 height, f32 alpha, u16 flags
+ *   u32 attributeCount, then per attribute: u32 node, u8 key, u32 value
+ *   u32 scrollCount, then per scroll: u32 node, f32 offsetX, f32 offsetY,
+ *     f32 contentWidth, f32 contentHeight
+ * Node 0 is the root and has parent -1; parents always precede children.
+ * A node's index is its id for deltas against this keyframe
+ * (HierarchyDelta.h). String id `kNoString` means absent. Version 1 had no
+ * keyframeId.
+ *
+ * Not thread-safe: a builder belongs to the thread that scans the views.
+ */
+class HierarchySnapshotBuilder {
+public:
+    static constexpr uint8_t kFormatVersion = 2;
+    static constexpr uint32_t kNoString = 0xFFFFFFFF;
+
+    enum Flag : uint16_t {
+        Hidden = 1 << 0,
+        Masked = 1 << 1,
+        Interactive = 1 << 2,
+        Enabled = 1 << 3,
+        ScrollEnabled = 1 << 4,
+        HasImage = 1 << 5,
+        Bailout = 1 << 6,
+        /// `Enabled` carries a value; otherwise the view has no enabled state.
+        HasEnabled = 1 << 7,
+    };
+
+    /// Keys of the sparse attribute table. String keys hold a string id;
+    /// `TextLength` holds the count itself.
+    enum class Attribute : uint8_t {
+        TestId = 1,
+        Label = 2,
+        Background = 3,
+        Text = 4,
+        TextLength = 5,
+        Placeholder = 6,
+        ButtonTitle = 7,
+    };
+
+    struct Frame {
+        float x = 0;
+        float y = 0;
+        float width = 0;
+        float height = 0;
+    };
+
+    explicit HierarchySnapshotBuilder(size_t expectedNodes = 512);
+
+    /// Drops all nodes and strings, keeping allocated capacity.
+    void reset();
+
+    void setScreen(float width, float height, float scale, std::string_view screenName);
+
+    /// Appends a node and returns its index. `parent` is -1 for the root
+    /// and must otherwise be an index already returned. `key` identifies
+    /// the view across scans. Returns -1 if the parent is out of range.
+    int32_t addNode(int32_t parent, uint64_t key, std::string_view type, Frame frame, float alpha, uint16_t flags);
+
+    void setString(int32_t node, Attribute key, std::string_view value);
+    void setTextLength(int32_t node, uint32_t length);
+    void setScroll(int32_t node, float offsetX, float offsetY, float contentWidth, float contentHeight);
+
+    size_t nodeCount() const { return parents_.size(); }
+    /// Number of direct children of `node`.
+    size_t childCount(int32_t node) const;
+
+    /// Interns `value` and returns its id.
+    uint32_t intern(std::string_view value);
+
+    std::string serialize(uint64_t timestampMs, uint32_t keyframeId) const;
+
+private:
+    friend class HierarchyDeltaEncoder;
+
+    struct AttributeEntry {
+        uint32_t node;
+        Attribute key;
+        uint32_t value;
+    };
+
+    struct ScrollEntry {
+        uint32_t node;
+        float offsetX;
+        float offsetY;
+        float contentWidth;
+        float contentHeight;
+    };
+
+    std::string_view stringAt(uint32_t id) const;
+    void growInternTable();
+
+    float screenWidth_ = 0;
+    float screenHeight_ = 0;
+    float screenScale_ = 0;
+    uint32_t screenName_ = kNoString;
+
+    std::vector<int32_t> parents_;
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> types_;
+    std::vector<Frame> frames_;
+    std::vector<float> alphas_;
+    std::vector<uint16_t> flags_;
+    std::vector<AttributeEntry> attributes_;
+    std::vector<ScrollEntry> scrolls_;
+
+    std::string arena_;
+    std::vector<uint32_t> stringOffsets_;
+    std::vector<uint32_t> stringLengths_;
+    std::vector<uint64_t> stringHashes_;
+    /// Open-addressed: slot holds string id + 1, 0 is empty.
+    std::vector<uint32_t> internSlots_;
+};
+
+} // namespace rejourney
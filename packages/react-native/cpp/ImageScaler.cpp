@@ -0,0 +1,231 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImageScaler.h"
+
+#include "SimdBytes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace rejourney {
+
+namespace {
+
+constexpr int kWeightBits = 14;
+constexpr int32_t kWeightOne = 1 << kWeightBits;
+// The intermediate row keeps 7 fractional bits: 255 << 7 still fits int16,
+// and so does every weight, which SSE2's multiply-add needs.
+constexpr int kRowBits = 7;
+constexpr int kVerticalShift = kWeightBits - kRowBits;
+constexpr int kHorizontalShift = kWeightBits + kRowBits;
+
+/// Blends `count` source rows, `bytes` bytes each, into `out`.
+void blendRows(const uint8_t *const *rows, const int16_t *weights, size_t count, size_t bytes, int16_t *out) {
+    size_t i = 0;
+#if defined(RJ_SIMD_NEON)
+    for (; bytes - i >= 16; i += 16) {
+        uint32x4_t acc0 = vdupq_n_u32(0), acc1 = vdupq_n_u32(0), acc2 = vdupq_n_u32(0), acc3 = vdupq_n_u32(0);
+        for (size_t k = 0; k < count; ++k) {
+            const uint8x16_t px = vld1q_u8(rows[k] + i);
+            const uint16x8_t lo = vmovl_u8(vget_low_u8(px));
+            const uint16x8_t hi = vmovl_u8(vget_high_u8(px));
+            const uint16_t w = static_cast<uint16_t>(weights[k]);
+            acc0 = vmlal_n_u16(acc0, vget_low_u16(lo), w);
+            acc1 = vmlal_n_u16(acc1, vget_high_u16(lo), w);
+            acc2 = vmlal_n_u16(acc2, vget_low_u16(hi), w);
+            acc3 = vmlal_n_u16(acc3, vget_high_u16(hi), w);
+        }
+        uint16_t *dst = reinterpret_cast<uint16_t *>(out + i);
+        vst1q_u16(dst, vcombine_u16(vrshrn_n_u32(acc0, kVerticalShift), vrshrn_n_u32(acc1, kVerticalShift)));
+        vst1q_u16(dst + 8, vcombine_u16(vrshrn_n_u32(acc2, kVerticalShift), vrshrn_n_u32(acc3, kVerticalShift)));
+    }
+#elif defined(RJ_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << (kVerticalShift - 1));
+    for (; bytes - i >= 16; i += 16) {
+        __m128i acc0 = round, acc1 = round, acc2 = round, acc3 = round;
+        // Two rows per multiply-add: interleave their channels and weights.
+        for (size_t k = 0; k < count; k += 2) {
+            const bool pair = k + 1 < count;
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + i));
+            const __m128i b = pair ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k + 1] + i)) : zero;
+            const uint32_t wa = static_cast<uint16_t>(weights[k]);
+            const uint32_t wb = pair ? static_cast<uint16_t>(weights[k + 1]) : 0;
+            const __m128i w = _mm_set1_epi32(static_cast<int>(wa | (wb << 16)));
+            const __m128i aLo = _mm_unpacklo_epi8(a, zero), aHi = _mm_unpackhi_epi8(a, zero);
+            const __m128i bLo = _mm_unpacklo_epi8(b, zero), bHi = _mm_unpackhi_epi8(b, zero);
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi16(aLo, bLo), w));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi16(aLo, bLo), w));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi16(aHi, bHi), w));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi16(aHi, bHi), w));
+        }
+        __m128i *dst = reinterpret_cast<__m128i *>(out + i);
+        _mm_storeu_si128(dst, _mm_packs_epi32(_mm_srai_epi32(acc0, kVerticalShift), _mm_srai_epi32(acc1, kVerticalShift)));
+        _mm_storeu_si128(dst + 1,
+                         _mm_packs_epi32(_mm_srai_epi32(acc2, kVerticalShift), _mm_srai_epi32(acc3, kVerticalShift)));
+    }
+#endif
+    for (; i < bytes; ++i) {
+        int32_t sum = 1 << (kVerticalShift - 1);
+        for (size_t k = 0; k < count; ++k) {
+            sum += static_cast<int32_t>(rows[k][i]) * weights[k];
+        }
+        out[i] = static_cast<int16_t>(sum >> kVerticalShift);
+    }
+}
+
+/// Blends `count` (even) consecutive intermediate pixels into one output
+/// pixel.
+inline void blendPixels(const int16_t *px, const int16_t *weights, size_t count, uint8_t *out) {
+#if defined(RJ_SIMD_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (size_t k = 0; k < count; ++k) {
+        acc = vmlal_n_s16(acc, vld1_s16(px + k * 4), weights[k]);
+    }
+    const uint16x4_t narrow = vqmovun_s32(vrshrq_n_s32(acc, kHorizontalShift));
+    const uint8x8_t bytes = vqmovn_u16(vcombine_u16(narrow, narrow));
+    vst1_lane_u32(reinterpret_cast<uint32_t *>(out), vreinterpret_u32_u8(bytes), 0);
+#elif defined(RJ_SIMD_SSE2)
+    __m128i acc = _mm_set1_epi32(1 << (kHorizontalShift - 1));
+    for (size_t k = 0; k < count; k += 2) {
+        // Pixels k and k + 1 sit side by side; pair their channels up.
+        const __m128i two = _mm_loadu_si128(reinterpret_cast<const __m128i *>(px + k * 4));
+        const __m128i paired = _mm_unpacklo_epi16(two, _mm_srli_si128(two, 8));
+        const uint32_t wa = static_cast<uint16_t>(weights[k]);
+        const uint32_t wb = static_cast<uint16_t>(weights[k + 1]);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(paired, _mm_set1_epi32(static_cast<int>(wa | (wb << 16)))));
+    }
+    const __m128i words = _mm_packs_epi32(_mm_srai_epi32(acc, kHorizontalShift), acc);
+    const int value = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    std::memcpy(out, &value, 4);
+#else
+    for (int c = 0; c < 4; ++c) {
+        int32_t sum = 1 << (kHorizontalShift - 1);
+        for (size_t k = 0; k < count; ++k) {
+            sum += static_cast<int32_t>(px[k * 4 + c]) * weights[k];
+        }
+        out[c] = static_cast<uint8_t>(std::clamp(sum >> kHorizontalShift, 0, 255));
+    }
+#endif
+}
+
+} // namespace
+
+void ImageScaler::Axis::build(size_t src, size_t dst, Filter f, bool pairs) {
+    if (srcLength == src && dstLength == dst && filter == f && padToPairs == pairs && !start.empty()) {
+        return;
+    }
+    srcLength = src;
+    dstLength = dst;
+    filter = f;
+    padToPairs = pairs;
+    start.assign(dst, 0);
+    count.assign(dst, 0);
+    offset.assign(dst, 0);
+    weights.clear();
+
+    const double ratio = static_cast<double>(src) / static_cast<double>(dst);
+    std::vector<double> taps;
+    for (size_t i = 0; i < dst; ++i) {
+        size_t first;
+        taps.clear();
+        if (f == Filter::Box) {
+            const double lo = static_cast<double>(i) * ratio;
+            const double hi = std::min(static_cast<double>(i + 1) * ratio, static_cast<double>(src));
+            first = std::min(static_cast<size_t>(lo), src - 1);
+            for (size_t j = first; j < src && static_cast<double>(j) < hi; ++j) {
+                const double overlap = std::min(hi, static_cast<double>(j + 1)) - std::max(lo, static_cast<double>(j));
+                taps.push_back(std::max(0.0, overlap) / (hi - lo));
+            }
+        } else {
+            const double center =
+                std::clamp((static_cast<double>(i) + 0.5) * ratio - 0.5, 0.0, static_cast<double>(src - 1));
+            first = static_cast<size_t>(center);
+            const double frac = center - static_cast<double>(first);
+            taps.push_back(1.0 - frac);
+            if (first + 1 < src) {
+                taps.push_back(frac);
+            }
+        }
+
+        // Quantize so the weights sum to exactly one; the rounding error
+        // goes to the heaviest tap.
+        std::vector<int16_t> quantized(taps.size());
+        int32_t sum = 0;
+        size_t heaviest = 0;
+        for (size_t k = 0; k < taps.size(); ++k) {
+            quantized[k] = static_cast<int16_t>(std::lround(taps[k] * kWeightOne));
+            sum += quantized[k];
+            if (quantized[k] > quantized[heaviest]) {
+                heaviest = k;
+            }
+        }
+        quantized[heaviest] = static_cast<int16_t>(quantized[heaviest] + (kWeightOne - sum));
+        // Taps that rounded to nothing are skipped.
+        size_t lo = 0, hi = quantized.size();
+        while (hi - lo > 1 && quantized[lo] == 0) {
+            ++lo;
+        }
+        while (hi - lo > 1 && quantized[hi - 1] == 0) {
+            --hi;
+        }
+
+        start[i] = static_cast<uint32_t>(first + lo);
+        offset[i] = static_cast<uint32_t>(weights.size());
+        weights.insert(weights.end(), quantized.begin() + static_cast<ptrdiff_t>(lo),
+                       quantized.begin() + static_cast<ptrdiff_t>(hi));
+        size_t n = hi - lo;
+        if (pairs && n % 2 != 0) {
+            // Reads one pixel past the taps, at worst the zero padding pixel.
+            weights.push_back(0);
+            ++n;
+        }
+        count[i] = static_cast<uint32_t>(n);
+    }
+}
+
+bool ImageScaler::scale(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcBytesPerRow, uint8_t *dst,
+                        size_t dstWidth, size_t dstHeight, size_t dstBytesPerRow, Filter filter) {
+    if (!src || !dst || srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0 ||
+        srcBytesPerRow < srcWidth * 4 || dstBytesPerRow < dstWidth * 4) {
+        return false;
+    }
+    horizontal_.build(srcWidth, dstWidth, filter, true);
+    vertical_.build(srcHeight, dstHeight, filter, false);
+    row_.resize((srcWidth + 1) * 4);
+    std::fill(row_.end() - 4, row_.end(), 0);
+
+    std::vector<const uint8_t *> &rows = rowPointers_;
+    for (size_t y = 0; y < dstHeight; ++y) {
+        const size_t taps = vertical_.count[y];
+        rows.resize(taps);
+        for (size_t k = 0; k < taps; ++k) {
+            rows[k] = src + (vertical_.start[y] + k) * srcBytesPerRow;
+        }
+        blendRows(rows.data(), vertical_.weights.data() + vertical_.offset[y], taps, srcWidth * 4, row_.data());
+
+        uint8_t *out = dst + y * dstBytesPerRow;
+        for (size_t x = 0; x < dstWidth; ++x, out += 4) {
+            blendPixels(row_.data() + horizontal_.start[x] * 4, horizontal_.weights.data() + horizontal_.offset[x],
+                        horizontal_.count[x], out);
+        }
+    }
+    return true;
+}
+
+} // namespace rejourney
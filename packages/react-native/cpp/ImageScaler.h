@@ -0,0 +1,81 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Resamples a captured 32bpp bitmap to an arbitrary smaller size, so the
+ * capture can render once at full resolution and the encoder input size can
+ * change per frame without drawing again.
+ *
+ * The filter is separable: each output row first blends the source rows it
+ * covers into a 16-bit intermediate row, then each output pixel blends the
+ * intermediate pixels it covers. Weights are 14-bit fixed point and summed
+ * with NEON or SSE2, four channels at a time; channels are treated alike,
+ * so any byte order works and premultiplied alpha stays premultiplied.
+ *
+ * Weight tables depend only on the two sizes and the filter and are kept
+ * until one of them changes, which for a capture loop is almost never.
+ *
+ * Not thread-safe: a scaler belongs to the thread that encodes frames.
+ */
+class ImageScaler {
+public:
+    enum class Filter : uint8_t {
+        /// Area average of every source pixel the output pixel covers.
+        /// Keeps thin text and 1 px lines at any ratio.
+        Box,
+        /// Two taps per axis. Cheaper, but aliases below half size.
+        Bilinear,
+    };
+
+    /// Resamples `src` into `dst`. Both are 4 bytes per pixel; rows may be
+    /// padded. Returns false for empty sizes or strides shorter than a row.
+    bool scale(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcBytesPerRow, uint8_t *dst,
+               size_t dstWidth, size_t dstHeight, size_t dstBytesPerRow, Filter filter = Filter::Box);
+
+private:
+    /// Source taps of each output pixel along one axis: output `i` reads
+    /// `count[i]` consecutive source pixels from `start[i]`, weighted by
+    /// `weights[offset[i] ...]`, which sum to 1 << 14.
+    struct Axis {
+        size_t srcLength = 0;
+        size_t dstLength = 0;
+        Filter filter = Filter::Box;
+        bool padToPairs = false;
+        std::vector<uint32_t> start;
+        std::vector<uint32_t> count;
+        std::vector<uint32_t> offset;
+        std::vector<int16_t> weights;
+
+        void build(size_t src, size_t dst, Filter f, bool pairs);
+    };
+
+    Axis horizontal_;
+    Axis vertical_;
+    // One source-width row of 16-bit channels, plus one zero pixel that
+    // padded taps read.
+    std::vector<int16_t> row_;
+    std::vector<const uint8_t *> rowPointers_;
+};
+
+} // namespace rejourney
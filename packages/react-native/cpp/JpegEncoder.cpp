@@ -0,0 +1,205 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JpegEncoder.h"
+
+#if REJOURNEY_WITH_LIBJPEG
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+
+#include <jpeglib.h>
+
+namespace rejourney {
+
+namespace {
+
+constexpr size_t kInitialOutputBytes = 64 * 1024;
+
+struct ErrorManager {
+    jpeg_error_mgr base;
+    std::jmp_buf jump;
+};
+
+[[noreturn]] void onError(j_common_ptr cinfo) {
+    std::longjmp(reinterpret_cast<ErrorManager *>(cinfo->err)->jump, 1);
+}
+
+void onMessage(j_common_ptr) {}
+
+/// Input colour space libjpeg reads `format` in.
+J_COLOR_SPACE colorSpaceFor(JpegEncoder::PixelFormat format) {
+#if defined(JCS_EXTENSIONS)
+    switch (format) {
+        case JpegEncoder::PixelFormat::RGBX: return JCS_EXT_RGBX;
+        case JpegEncoder::PixelFormat::XRGB: return JCS_EXT_XRGB;
+        case JpegEncoder::PixelFormat::XBGR: return JCS_EXT_XBGR;
+        case JpegEncoder::PixelFormat::BGRX: break;
+    }
+    return JCS_EXT_BGRX;
+#else
+    (void)format;
+    return JCS_RGB;
+#endif
+}
+
+} // namespace
+
+/// The compressor and a destination that writes into `output`.
+struct JpegEncoder::State {
+    jpeg_compress_struct cinfo{};
+    ErrorManager errors{};
+    jpeg_destination_mgr destination{};
+    std::string *output = nullptr;
+    size_t outputHint = 0;
+
+    static State &of(j_compress_ptr cinfo) { return *static_cast<State *>(cinfo->client_data); }
+
+    static void initDestination(j_compress_ptr cinfo) {
+        State &state = of(cinfo);
+        std::string &out = *state.output;
+        out.resize(std::max({out.capacity(), kInitialOutputBytes, state.outputHint}));
+        cinfo->dest->next_output_byte = reinterpret_cast<JOCTET *>(&out[0]);
+        cinfo->dest->free_in_buffer = out.size();
+    }
+
+    static boolean emptyOutputBuffer(j_compress_ptr cinfo) {
+        std::string &out = *of(cinfo).output;
+        const size_t used = out.size();
+        out.resize(used * 2);
+        cinfo->dest->next_output_byte = reinterpret_cast<JOCTET *>(&out[used]);
+        cinfo->dest->free_in_buffer = out.size() - used;
+        return TRUE;
+    }
+
+    static void termDestination(j_compress_ptr cinfo) {
+        std::string &out = *of(cinfo).output;
+        out.resize(out.size() - cinfo->dest->free_in_buffer);
+    }
+};
+
+JpegEncoder::JpegEncoder() : state_(std::make_unique<State>()) {
+    State &s = *state_;
+    s.cinfo.err = jpeg_std_error(&s.errors.base);
+    s.errors.base.error_exit = onError;
+    s.errors.base.output_message = onMessage;
+    jpeg_create_compress(&s.cinfo);
+    s.cinfo.client_data = &s;
+    s.destination.init_destination = State::initDestination;
+    s.destination.empty_output_buffer = State::emptyOutputBuffer;
+    s.destination.term_destination = State::termDestination;
+    s.cinfo.dest = &s.destination;
+}
+
+JpegEncoder::~JpegEncoder() {
+    jpeg_destroy_compress(&state_->cinfo);
+}
+
+bool JpegEncoder::encode(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow,
+                         PixelFormat format, const Options &options) {
+    output_.clear();
+    if (!pixels || width == 0 || height == 0 || width > JPEG_MAX_DIMENSION || height > JPEG_MAX_DIMENSION ||
+        bytesPerRow < width * 4) {
+        return false;
+    }
+    State &s = *state_;
+    jpeg_compress_struct &cinfo = s.cinfo;
+    s.output = &output_;
+    s.outputHint = outputHint_;
+
+#if defined(JCS_EXTENSIONS)
+    constexpr bool convertRows = false;
+#else
+    constexpr bool convertRows = true;
+    row_.resize(width * 3);
+#endif
+    // Offsets of R, G and B within a pixel, for the conversion fallback.
+    const size_t r = format == PixelFormat::BGRX ? 2 : format == PixelFormat::RGBX ? 0 : format == PixelFormat::XRGB ? 1 : 3;
+    const size_t g = format == PixelFormat::BGRX || format == PixelFormat::RGBX ? 1 : 2;
+    const size_t b = format == PixelFormat::BGRX ? 0 : format == PixelFormat::RGBX ? 2 : format == PixelFormat::XRGB ? 3 : 1;
+
+    // Set before setjmp, so no local holds it across the longjmp.
+    cinfo.in_color_space = colorSpaceFor(format);
+    if (setjmp(s.errors.jump)) {
+        jpeg_abort_compress(&cinfo);
+        output_.clear();
+        return false;
+    }
+
+    cinfo.image_width = static_cast<JDIMENSION>(width);
+    cinfo.image_height = static_cast<JDIMENSION>(height);
+    cinfo.input_components = convertRows ? 3 : 4;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, std::max(1, std::min(100, options.quality)), TRUE);
+    cinfo.optimize_coding = options.optimizeHuffman ? TRUE : FALSE;
+    cinfo.restart_in_rows = static_cast<int>(std::min<uint32_t>(options.restartRows, 65535));
+    cinfo.comp_info[0].h_samp_factor = options.subsampling == Subsampling::S444 ? 1 : 2;
+    cinfo.comp_info[0].v_samp_factor = options.subsampling == Subsampling::S420 ? 2 : 1;
+
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        const uint8_t *line = pixels + static_cast<size_t>(cinfo.next_scanline) * bytesPerRow;
+        JSAMPROW row;
+        if (convertRows) {
+            for (size_t x = 0; x < width; ++x) {
+                row_[x * 3] = line[x * 4 + r];
+                row_[x * 3 + 1] = line[x * 4 + g];
+                row_[x * 3 + 2] = line[x * 4 + b];
+            }
+            row = row_.data();
+        } else {
+            row = const_cast<JSAMPROW>(line);
+        }
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    return true;
+}
+
+std::string JpegEncoder::takeOutput() {
+    // A little slack: consecutive frames of one screen vary in size.
+    outputHint_ = output_.size() + output_.size() / 4;
+    std::string out = std::move(output_);
+    output_ = std::string();
+    return out;
+}
+
+JpegEncoderPool::Lease JpegEncoderPool::acquire() {
+    std::unique_ptr<JpegEncoder> encoder;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!idle_.empty()) {
+            encoder = std::move(idle_.back());
+            idle_.pop_back();
+        }
+    }
+    if (!encoder) {
+        encoder = std::make_unique<JpegEncoder>();
+    }
+    return Lease(*this, std::move(encoder));
+}
+
+void JpegEncoderPool::release(std::unique_ptr<JpegEncoder> encoder) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (idle_.size() < maxIdle_) {
+        idle_.push_back(std::move(encoder));
+    }
+}
+
+} // namespace rejourney
+
+#endif // REJOURNEY_WITH_LIBJPEG
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Built only when the build links libjpeg(-turbo) and says so:
+// CMake defines REJOURNEY_WITH_LIBJPEG after find_package(JPEG), and the
+// podspec when REJOURNEY_LIBJPEG_POD names the pod that provides it. A
+// <jpeglib.h> that merely happens to be on the include path is ignored.
+
+#if REJOURNEY_WITH_LIBJPEG
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * JPEG-encodes captured 32bpp bitmaps with libjpeg(-turbo).
+ *
+ * One compressor is set up per encoder and reused for every frame, and the
+ * output lands in a buffer that keeps its capacity, so steady-state encoding
+ * allocates nothing. Unlike the platform encoders it exposes chroma
+ * subsampling, Huffman optimization and restart markers. The alpha byte is
+ * ignored.
+ *
+ * Not thread-safe; JpegEncoderPool hands encoders out to concurrent callers.
+ */
+class JpegEncoder {
+public:
+    /// Byte order of a pixel in memory; X is the ignored alpha byte.
+    enum class PixelFormat {
+        BGRX,
+        RGBX,
+        XRGB,
+        XBGR,
+    };
+
+    enum class Subsampling {
+        S444,
+        S422,
+        S420,
+    };
+
+    struct Options {
+        /// libjpeg quality, 1...100.
+        int quality = 50;
+        Subsampling subsampling = Subsampling::S420;
+        /// Two-pass Huffman tables: a few percent smaller, somewhat slower.
+        bool optimizeHuffman = false;
+        /// Restart marker every this many MCU rows; 0 for none.
+        uint32_t restartRows = 0;
+    };
+
+    JpegEncoder();
+    ~JpegEncoder();
+    JpegEncoder(const JpegEncoder &) = delete;
+    JpegEncoder &operator=(const JpegEncoder &) = delete;
+
+    /// Encodes one bitmap; the JPEG stays valid in output() until the next
+    /// call. False if libjpeg reports an error.
+    bool encode(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, PixelFormat format,
+                const Options &options);
+
+    const std::string &output() const { return output_; }
+
+    /// Hands over the JPEG without copying it. The next encode starts from
+    /// a buffer sized after this one, so it rarely has to grow.
+    std::string takeOutput();
+
+private:
+    struct State;
+
+    std::unique_ptr<State> state_;
+    std::string output_;
+    size_t outputHint_ = 0;
+    /// Row converted to RGB when libjpeg lacks the extended color spaces.
+    std::vector<uint8_t> row_;
+};
+
+/**
+ * Idle encoders kept for reuse. Thread-safe.
+ */
+class JpegEncoderPool {
+public:
+    class Lease {
+    public:
+        Lease(JpegEncoderPool &pool, std::unique_ptr<JpegEncoder> encoder)
+            : pool_(&pool), encoder_(std::move(encoder)) {}
+        Lease(Lease &&other) noexcept = default;
+        Lease &operator=(Lease &&) = delete;
+        ~Lease() {
+            if (encoder_) {
+                pool_->release(std::move(encoder_));
+            }
+        }
+
+        JpegEncoder *operator->() const { return encoder_.get(); }
+        JpegEncoder &operator*() const { return *encoder_; }
+
+    private:
+        JpegEncoderPool *pool_;
+        std::unique_ptr<JpegEncoder> encoder_;
+    };
+
+    explicit JpegEncoderPool(size_t maxIdle = 2) : maxIdle_(maxIdle) {}
+
+    /// An idle encoder, or a new one when all are in use.
+    Lease acquire();
+
+private:
+    void release(std::unique_ptr<JpegEncoder> encoder);
+
+    const size_t maxIdle_;
+    std::mutex lock_;
+    std::vector<std::unique_ptr<JpegEncoder>> idle_;
+};
+
+} // namespace rejourney
+
+#endif // REJOURNEY_WITH_LIBJPEG
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PendingEventReader.h"
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rejourney {
+
+namespace {
+
+constexpr std::string_view kPayloadPrefix = "{\"events\":[";
+constexpr std::string_view kPayloadSuffix = "],\"deviceInfo\":";
+
+std::string_view trim(std::string_view line) {
+    while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+        line.remove_prefix(1);
+    }
+    while (!line.empty() && (line.back() == ' ' || line.back() == '\t' || line.back() == '\r')) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+} // namespace
+
+struct PendingEventReader::LegacyFile {
+    const char *data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+
+    explicit LegacyFile(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *mapped = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = static_cast<const char *>(mapped);
+                size = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~LegacyFile() {
+        if (data) {
+            ::munmap(const_cast<char *>(data), size);
+        }
+    }
+};
+
+PendingEventReader::PendingEventReader(std::string logDirectory,
+                                       std::string legacyJsonlPath,
+                                       size_t maxBatchBytes,
+                                       std::string deviceInfoJson)
+    : maxBatchBytes_(maxBatchBytes),
+      deviceInfoJson_(deviceInfoJson.empty() ? "{}" : std::move(deviceInfoJson)),
+      legacy_(legacyJsonlPath.empty() ? nullptr : std::make_unique<LegacyFile>(legacyJsonlPath)),
+      cursor_(std::move(logDirectory)) {}
+
+PendingEventReader::~PendingEventReader() = default;
+
+bool PendingEventReader::nextLegacyLine(std::string_view &event) {
+    LegacyFile &file = *legacy_;
+    while (file.offset < file.size) {
+        std::string_view rest(file.data + file.offset, file.size - file.offset);
+        size_t end = rest.find('\n');
+        std::string_view line = rest.substr(0, end);
+        file.offset += end == std::string_view::npos ? rest.size() : end + 1;
+
+        // Lines are not parsed, only checked to look like an object so a torn
+        // last line cannot corrupt the payload.
+        line = trim(line);
+        if (line.size() >= 2 && line.front() == '{' && line.back() == '}') {
+            event = line;
+            return true;
+        }
+    }
+    legacy_.reset();
+    return false;
+}
+
+bool PendingEventReader::nextEvent(std::string_view &event) {
+    if (hasLookahead_) {
+        hasLookahead_ = false;
+        event = lookahead_;
+        return true;
+    }
+    if (legacy_ && nextLegacyLine(event)) {
+        return true;
+    }
+    int64_t timestampMs = 0;
+    return cursor_.next(event, timestampMs);
+}
+
+bool PendingEventReader::next(std::string &payload, size_t &eventCount) {
+    payload.clear();
+    eventCount = 0;
+
+    const size_t overhead = kPayloadPrefix.size() + kPayloadSuffix.size() + deviceInfoJson_.size() + 1;
+    size_t budget = maxBatchBytes_ > overhead ? maxBatchBytes_ - overhead : 0;
+
+    std::string_view event;
+    while (nextEvent(event)) {
+        const size_t cost = event.size() + (eventCount > 0 ? 1 : 0);
+        if (eventCount > 0 && cost > budget) {
+            // Hold the event for the next payload. Its bytes stay mapped
+            // because nothing advances until the next call.
+            lookahead_ = event;
+            hasLookahead_ = true;
+            break;
+        }
+        if (eventCount == 0) {
+            payload.reserve(std::min(maxBatchBytes_, overhead + event.size() * 64));
+            payload.append(kPayloadPrefix);
+        } else {
+            payload.push_back(',');
+        }
+        payload.append(event);
+        budget = cost > budget ? 0 : budget - cost;
+        ++eventCount;
+    }
+
+    if (eventCount == 0) {
+        return false;
+    }
+    payload.append(kPayloadSuffix);
+    payload.append(deviceInfoJson_);
+    payload.push_back('}');
+    return true;
+}
+
+size_t PendingEventReader::skip(size_t events) {
+    size_t skipped = 0;
+    std::string_view event;
+    while (skipped < events && nextEvent(event)) {
+        ++skipped;
+    }
+    return skipped;
+}
+
+} // namespace rejourney
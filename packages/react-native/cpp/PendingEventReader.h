@@ -0,0 +1,72 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "SegmentedLog.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace rejourney {
+
+/**
+ * Slices the events a session persisted to disk into upload-sized JSON
+ * payloads without parsing them.
+ *
+ * Events come from a legacy JSONL file (one object per line) followed by the
+ * session's SegmentedLog, both read through mmap. Each payload is
+ *   {"events":[<event>,<event>,...],"deviceInfo":<deviceInfoJson>}
+ * and holds as many events as fit in `maxBatchBytes`; an event larger than
+ * that is sent on its own. Peak memory is one payload, not the whole log.
+ */
+class PendingEventReader {
+public:
+    PendingEventReader(std::string logDirectory,
+                       std::string legacyJsonlPath,
+                       size_t maxBatchBytes,
+                       std::string deviceInfoJson);
+    ~PendingEventReader();
+
+    PendingEventReader(const PendingEventReader &) = delete;
+    PendingEventReader &operator=(const PendingEventReader &) = delete;
+
+    /// Builds the next payload into `payload`. Returns false once every event
+    /// has been returned.
+    bool next(std::string &payload, size_t &eventCount);
+
+    /// Passes over up to `events` events without returning them, to resume
+    /// after batches an earlier attempt already delivered. Returns how many
+    /// were skipped.
+    size_t skip(size_t events);
+
+private:
+    bool nextEvent(std::string_view &event);
+    bool nextLegacyLine(std::string_view &event);
+
+    struct LegacyFile;
+
+    const size_t maxBatchBytes_;
+    const std::string deviceInfoJson_;
+    std::unique_ptr<LegacyFile> legacy_;
+    SegmentedLog::Cursor cursor_;
+    std::string_view lookahead_;
+    bool hasLookahead_ = false;
+};
+
+} // namespace rejourney
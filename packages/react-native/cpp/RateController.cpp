@@ -0,0 +1,190 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RateController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rejourney {
+
+namespace {
+
+struct QualityPoint {
+    int quality;
+    double size;
+};
+
+/// Mean libjpeg output size relative to quality 50, measured on the demo
+/// session frames (dashboard/web-ui/public/demo).
+constexpr QualityPoint kQualityCurve[] = {
+    {1, 0.30},    {10, 0.456},  {20, 0.626}, {30, 0.755}, {40, 0.877},  {50, 1.0},
+    {60, 1.144},  {70, 1.290},  {80, 1.451}, {90, 1.865}, {95, 2.381},  {100, 3.723},
+};
+
+constexpr double kScaleExponent = 1.45;
+constexpr double kUplinkAlpha = 0.3;
+/// Floor on the measured span, so a burst of frames does not read as a
+/// sustained rate.
+constexpr uint64_t kMinSpanMs = 1000;
+
+double qualitySize(int quality) {
+    quality = std::max(1, std::min(100, quality));
+    const QualityPoint *upper = std::begin(kQualityCurve);
+    while (upper->quality < quality) {
+        ++upper;
+    }
+    if (upper->quality == quality) {
+        return upper->size;
+    }
+    const QualityPoint *lower = upper - 1;
+    const double t = static_cast<double>(quality - lower->quality) / (upper->quality - lower->quality);
+    return lower->size + t * (upper->size - lower->size);
+}
+
+} // namespace
+
+RateController::RateController() : RateController(Options()) {}
+
+RateController::RateController(Options options) : options_(options) { buildLadder(); }
+
+double RateController::cost(int quality, float scale) {
+    return qualitySize(quality) * std::pow(std::max(1.0f, scale), -kScaleExponent);
+}
+
+void RateController::setOptions(const Options &options) {
+    options_ = options;
+    buildLadder();
+}
+
+void RateController::buildLadder() {
+    ladder_.clear();
+    const int top = std::max(1, std::min(100, options_.maxQuality));
+    const int floor = std::max(1, std::min(top, options_.minQuality));
+    const int step = std::max(1, options_.qualityStep);
+    const float minScale = std::max(1.0f, options_.minScale);
+    const float maxScale = std::max(minScale, options_.maxScale);
+    const float scaleStep = std::max(1.01f, options_.scaleStep);
+
+    for (int q = top;; q -= step) {
+        q = std::max(q, floor);
+        ladder_.push_back({{q, minScale}, cost(q, minScale)});
+        if (q == floor) {
+            break;
+        }
+    }
+    for (float s = minScale; s < maxScale;) {
+        s = std::min(s * scaleStep, maxScale);
+        ladder_.push_back({{floor, s}, cost(floor, s)});
+    }
+    rung_ = 0;
+}
+
+void RateController::start(uint64_t nowMs) {
+    window_.clear();
+    windowSum_ = 0;
+    changedMs_ = nowMs;
+    uplinkBps_ = 0;
+    rung_ = 0;
+}
+
+RateController::Setting RateController::setting() const { return ladder_[rung_].setting; }
+
+void RateController::onFrameEncoded(const Setting &setting, size_t bytes, uint64_t nowMs) {
+    const double normalized = static_cast<double>(bytes) / cost(setting.quality, setting.scale);
+    window_.push_back({nowMs, normalized});
+    windowSum_ += normalized;
+    expire(nowMs);
+
+    const double rate = normalizedRate(nowMs);
+    const double target = targetBytesPerSecond();
+    size_t desired = ladder_.size() - 1;
+    for (size_t i = 0; i < ladder_.size(); ++i) {
+        if (rate * ladder_[i].cost <= target) {
+            desired = i;
+            break;
+        }
+    }
+
+    if (desired > rung_) {
+        rung_ = std::min(desired, rung_ + std::max<uint32_t>(1, options_.maxStepDown));
+        changedMs_ = nowMs;
+    } else if (desired < rung_ && nowMs >= changedMs_ + options_.holdMs &&
+               rate * ladder_[rung_ - 1].cost <= target * options_.upHeadroom) {
+        --rung_;
+        changedMs_ = nowMs;
+    }
+}
+
+void RateController::onUploadCompleted(size_t bytes, uint64_t durationMs) {
+    if (bytes == 0) {
+        return;
+    }
+    const double bps = static_cast<double>(bytes) * 1000.0 / static_cast<double>(std::max<uint64_t>(1, durationMs));
+    uplinkBps_ = uplinkBps_ > 0 ? uplinkBps_ + kUplinkAlpha * (bps - uplinkBps_) : bps;
+}
+
+void RateController::setConstrained(bool constrained) { constrained_ = constrained; }
+
+bool RateController::onBacklog(uint64_t nowMs) {
+    if (rung_ + 1 >= ladder_.size()) {
+        return false;
+    }
+    ++rung_;
+    changedMs_ = nowMs;
+    return true;
+}
+
+uint32_t RateController::targetBytesPerSecond() const {
+    double target = options_.targetBytesPerSecond;
+    if (constrained_) {
+        target = std::min(target, static_cast<double>(options_.constrainedBytesPerSecond));
+    }
+    if (uplinkBps_ > 0) {
+        target = std::min(target, uplinkBps_ * options_.uplinkShare);
+    }
+    return static_cast<uint32_t>(std::max(1.0, target));
+}
+
+double RateController::encodedBytesPerSecond(uint64_t nowMs) const {
+    return normalizedRate(nowMs) * ladder_[rung_].cost;
+}
+
+void RateController::expire(uint64_t nowMs) {
+    while (!window_.empty() && window_.front().ms + options_.windowMs <= nowMs) {
+        windowSum_ -= window_.front().normalized;
+        window_.pop_front();
+    }
+    if (window_.empty()) {
+        windowSum_ = 0;
+    }
+}
+
+double RateController::normalizedRate(uint64_t nowMs) const {
+    if (window_.empty()) {
+        return 0;
+    }
+    // A lone frame (idle heartbeats, the start of a session) stands for the
+    // whole window. Otherwise the oldest frame only marks where the span
+    // starts, so frames at a steady interval measure exactly.
+    if (window_.size() == 1) {
+        return windowSum_ * 1000.0 / std::max<uint32_t>(1, options_.windowMs);
+    }
+    const uint64_t span = std::max<uint64_t>(kMinSpanMs, nowMs - window_.front().ms);
+    return (windowSum_ - window_.front().normalized) * 1000.0 / static_cast<double>(span);
+}
+
+} // namespace rejourney
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Picks JPEG quality and capture scale so encoded frames stay near a target
+ * upload rate.
+ *
+ * Settings form a ladder from the configured quality at the configured scale
+ * down to `minQuality`, then on to coarser scales. Each rung has a relative
+ * cost from a size model fitted on captured frames (libjpeg output against
+ * quality, and bytes falling as scale^-1.45 rather than with the pixel
+ * count). Every encoded frame's size is divided by the cost of the rung it
+ * was encoded at, so the window holds the screen's complexity independent of
+ * the setting, and the controller moves to the best rung whose predicted
+ * rate fits the target. It steps down at most `maxStepDown` rungs per frame
+ * and up one rung per `holdMs`, with headroom, so quality drifts rather than
+ * oscillating between frames.
+ *
+ * The target is the configured rate, lowered on constrained networks and to
+ * a share of the throughput uploads actually achieve.
+ *
+ * Times are milliseconds on any monotonic clock. Not thread-safe: the encode
+ * queue owns the controller.
+ */
+class RateController {
+public:
+    struct Options {
+        uint32_t targetBytesPerSecond = 40 * 1024;
+        /// Target while the network is constrained (Low Data Mode).
+        uint32_t constrainedBytesPerSecond = 12 * 1024;
+        /// Share of measured upload throughput frames may use.
+        float uplinkShare = 0.5f;
+        /// libjpeg quality, 1...100; the ladder starts at `maxQuality`.
+        int maxQuality = 50;
+        int minQuality = 20;
+        int qualityStep = 5;
+        /// Capture scale divisors; the ladder starts at `minScale`.
+        float minScale = 1.25f;
+        float maxScale = 2.0f;
+        float scaleStep = 1.15f;
+        /// Span of encoded frames the rate is measured over.
+        uint32_t windowMs = 5000;
+        uint32_t holdMs = 2000;
+        uint32_t maxStepDown = 2;
+        /// Stepping up needs the better rung to fit in this share of the target.
+        float upHeadroom = 0.85f;
+    };
+
+    struct Setting {
+        int quality = 50;
+        float scale = 1.25f;
+    };
+
+    RateController();
+    explicit RateController(Options options);
+
+    /// Rebuilds the ladder and goes back to its top; keeps measurements.
+    void setOptions(const Options &options);
+    const Options &options() const { return options_; }
+
+    /// Forgets measurements and returns to the top of the ladder.
+    void start(uint64_t nowMs);
+
+    /// Setting the next frame should be encoded at.
+    Setting setting() const;
+
+    /// Reports a frame encoded at `setting` (as returned by setting()) as
+    /// `bytes`, and moves along the ladder.
+    void onFrameEncoded(const Setting &setting, size_t bytes, uint64_t nowMs);
+
+    /// Reports an upload of `bytes` that took `durationMs` end to end.
+    void onUploadCompleted(size_t bytes, uint64_t durationMs);
+
+    void setConstrained(bool constrained);
+    bool constrained() const { return constrained_; }
+
+    /// Uploads are backing up: steps one rung down at once. Returns false if
+    /// already on the last rung.
+    bool onBacklog(uint64_t nowMs);
+
+    uint32_t targetBytesPerSecond() const;
+    /// Encoded bytes per second over the window at the current setting.
+    double encodedBytesPerSecond(uint64_t nowMs) const;
+    double uplinkBytesPerSecond() const { return uplinkBps_; }
+    size_t rung() const { return rung_; }
+    size_t rungCount() const { return ladder_.size(); }
+
+    /// Relative encoded size of a frame at `quality` and `scale`.
+    static double cost(int quality, float scale);
+
+private:
+    struct Rung {
+        Setting setting;
+        double cost;
+    };
+
+    struct Sample {
+        uint64_t ms;
+        /// Bytes divided by the cost of the rung the frame was encoded at.
+        double normalized;
+    };
+
+    void buildLadder();
+    void expire(uint64_t nowMs);
+    double normalizedRate(uint64_t nowMs) const;
+
+    Options options_;
+    std::vector<Rung> ladder_;
+    size_t rung_ = 0;
+    std::deque<Sample> window_;
+    double windowSum_ = 0;
+    uint64_t changedMs_ = 0;
+    double uplinkBps_ = 0;
+    bool constrained_ = false;
+};
+
+} // namespace rejourney
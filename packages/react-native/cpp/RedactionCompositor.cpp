@@ -0,0 +1,155 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RedactionCompositor.h"
+
+#include "SimdBytes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace rejourney {
+
+namespace {
+
+int32_t clampEdge(double value) {
+    constexpr double kMax = static_cast<double>(std::numeric_limits<int32_t>::max());
+    return static_cast<int32_t>(std::max(-kMax, std::min(kMax, value)));
+}
+
+} // namespace
+
+void RedactionCompositor::reset() {
+    regions_.clear();
+    rects_.clear();
+    outermost_.clear();
+}
+
+void RedactionCompositor::add(float x, float y, float width, float height) {
+    if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(width) || !std::isfinite(height) || width <= 0 ||
+        height <= 0) {
+        regions_.push_back({0, 0, 0, 0});
+        return;
+    }
+    regions_.push_back({clampEdge(std::floor(x)), clampEdge(std::floor(y)),
+                        clampEdge(std::ceil(static_cast<double>(x) + width)),
+                        clampEdge(std::ceil(static_cast<double>(y) + height))});
+}
+
+const std::vector<RedactionCompositor::Rect> &RedactionCompositor::coalesce(int32_t width, int32_t height) {
+    rects_.clear();
+    clipped_.clear();
+    bandEdges_.clear();
+    for (const Edges &r : regions_) {
+        Edges c{std::max(r.x0, 0), std::max(r.y0, 0), std::min(r.x1, width), std::min(r.y1, height)};
+        clipped_.push_back(c);
+    }
+    computeOutermost();
+
+    // Nested regions add nothing to the union.
+    size_t live = 0;
+    for (size_t i = 0; i < clipped_.size(); ++i) {
+        if (outermost_[i]) {
+            clipped_[live] = clipped_[i];
+            bandEdges_.push_back(clipped_[live].y0);
+            bandEdges_.push_back(clipped_[live].y1);
+            ++live;
+        }
+    }
+    clipped_.resize(live);
+    std::sort(bandEdges_.begin(), bandEdges_.end());
+    bandEdges_.erase(std::unique(bandEdges_.begin(), bandEdges_.end()), bandEdges_.end());
+
+    previousSpans_.clear();
+    openRects_.clear();
+    for (size_t b = 0; b + 1 < bandEdges_.size(); ++b) {
+        const int32_t top = bandEdges_[b];
+        const int32_t bottom = bandEdges_[b + 1];
+        spans_.clear();
+        for (const Edges &r : clipped_) {
+            if (r.y0 <= top && r.y1 >= bottom) {
+                spans_.emplace_back(r.x0, r.x1);
+            }
+        }
+        std::sort(spans_.begin(), spans_.end());
+        size_t merged = 0;
+        for (size_t i = 0; i < spans_.size(); ++i) {
+            if (merged > 0 && spans_[i].first <= spans_[merged - 1].second) {
+                spans_[merged - 1].second = std::max(spans_[merged - 1].second, spans_[i].second);
+            } else {
+                spans_[merged++] = spans_[i];
+            }
+        }
+        spans_.resize(merged);
+
+        if (spans_ == previousSpans_) {
+            for (size_t index : openRects_) {
+                rects_[index].height = bottom - rects_[index].y;
+            }
+            continue;
+        }
+        openRects_.clear();
+        for (const auto &span : spans_) {
+            openRects_.push_back(rects_.size());
+            rects_.push_back({span.first, top, span.second - span.first, bottom - top});
+        }
+        std::swap(previousSpans_, spans_);
+    }
+    return rects_;
+}
+
+size_t RedactionCompositor::paint(uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, uint32_t pixel) {
+    const auto &rects = coalesce(static_cast<int32_t>(std::min<size_t>(width, std::numeric_limits<int32_t>::max())),
+                                 static_cast<int32_t>(std::min<size_t>(height, std::numeric_limits<int32_t>::max())));
+    for (const Rect &r : rects) {
+        for (int32_t row = r.y; row < r.y + r.height; ++row) {
+            auto *line = reinterpret_cast<uint32_t *>(pixels + static_cast<size_t>(row) * bytesPerRow);
+            simd::fill32(line + r.x, static_cast<size_t>(r.width), pixel);
+        }
+    }
+    return rects.size();
+}
+
+bool RedactionCompositor::isOutermost(size_t index) const {
+    return index < outermost_.size() && outermost_[index];
+}
+
+void RedactionCompositor::computeOutermost() {
+    const size_t n = clipped_.size();
+    outermost_.assign(n, true);
+    for (size_t i = 0; i < n; ++i) {
+        const Edges &a = clipped_[i];
+        if (a.empty()) {
+            outermost_[i] = false;
+            continue;
+        }
+        for (size_t j = 0; j < n; ++j) {
+            const Edges &b = clipped_[j];
+            if (j == i || b.empty()) {
+                continue;
+            }
+            const bool inside = b.x0 <= a.x0 && b.y0 <= a.y0 && b.x1 >= a.x1 && b.y1 >= a.y1;
+            const bool identical = b.x0 == a.x0 && b.y0 == a.y0 && b.x1 == a.x1 && b.y1 == a.y1;
+            if (inside && (!identical || j < i)) {
+                outermost_[i] = false;
+                break;
+            }
+        }
+    }
+}
+
+} // namespace rejourney
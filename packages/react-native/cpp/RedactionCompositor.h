@@ -0,0 +1,97 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Paints privacy masks straight into a captured 32bpp bitmap.
+ *
+ * Regions are added in pixel coordinates (top-left origin) and rounded
+ * outward so partially covered pixels are masked too. Before painting they
+ * are clipped to the bitmap and coalesced into disjoint rectangles: the
+ * union is swept in horizontal bands, overlapping or touching spans within a
+ * band are merged, and bands with identical spans are joined vertically. So
+ * nested and overlapping regions (a masked form inside a masked screen, a
+ * grid of adjacent images) cost one fill per covered pixel rather than one
+ * per region, and each row of a rectangle is a single vectorized fill.
+ *
+ * `isOutermost()` tells the caller which regions still deserve their own
+ * indicator after painting: a region inside another is hidden by it.
+ *
+ * Not thread-safe: a compositor belongs to the thread that captures frames.
+ */
+class RedactionCompositor {
+public:
+    struct Rect {
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+    };
+
+    /// Forgets every region; keeps buffer capacity for the next frame.
+    void reset();
+
+    /// Adds a region; non-finite or empty regions are kept (so indices line
+    /// up with the caller's) but never painted.
+    void add(float x, float y, float width, float height);
+
+    size_t regionCount() const { return regions_.size(); }
+
+    /// Clips the regions to `width` x `height` and merges them into disjoint
+    /// rectangles, ordered top to bottom.
+    const std::vector<Rect> &coalesce(int32_t width, int32_t height);
+
+    /// Coalesces and fills every covered pixel with `pixel`, given in the
+    /// bitmap's own memory order. Rows must be 4-byte aligned. Returns the
+    /// number of rectangles filled.
+    size_t paint(uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, uint32_t pixel);
+
+    /// After coalesce(): false if region `index` is empty after clipping or
+    /// lies inside another region (the first of identical regions wins).
+    bool isOutermost(size_t index) const;
+
+private:
+    struct Edges {
+        int32_t x0;
+        int32_t y0;
+        int32_t x1;
+        int32_t y1;
+
+        bool empty() const { return x0 >= x1 || y0 >= y1; }
+    };
+
+    void computeOutermost();
+
+    std::vector<Edges> regions_;
+    // Scratch, reused across frames.
+    std::vector<Edges> clipped_;
+    std::vector<int32_t> bandEdges_;
+    std::vector<std::pair<int32_t, int32_t>> spans_;
+    std::vector<std::pair<int32_t, int32_t>> previousSpans_;
+    std::vector<size_t> openRects_;
+    std::vector<Rect> rects_;
+    std::vector<bool> outermost_;
+};
+
+} // namespace rejourney
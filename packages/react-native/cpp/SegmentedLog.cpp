@@ -0,0 +1,553 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SegmentedLog.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rejourney {
+
+namespace {
+
+constexpr char kSegmentMagic[4] = {'R', 'J', 'W', 'L'};
+constexpr char kFooterMagic[4] = {'R', 'J', 'W', 'F'};
+constexpr uint32_t kSegmentVersion = 1;
+constexpr size_t kSegmentHeaderBytes = 8;
+constexpr size_t kRecordHeaderBytes = 16;
+constexpr size_t kFooterBytes = 32;
+
+uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc = 0) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void putU32(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void putU64(uint8_t *out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint32_t getU32(const uint8_t *in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t getU64(const uint8_t *in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+bool writeFully(int fd, const uint8_t *data, size_t length, off_t offset) {
+    while (length > 0) {
+        ssize_t written = ::pwrite(fd, data, length, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+        offset += written;
+    }
+    return true;
+}
+
+bool makeDirectories(const std::string &path) {
+    if (path.empty()) {
+        return false;
+    }
+    for (size_t pos = 1; pos <= path.size(); ++pos) {
+        if (pos == path.size() || path[pos] == '/') {
+            std::string prefix = path.substr(0, pos);
+            if (::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string segmentPath(const std::string &directory, uint32_t index) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "%08u.seg", index);
+    return directory + "/" + name;
+}
+
+std::vector<uint32_t> listSegments(const std::string &directory) {
+    std::vector<uint32_t> indices;
+    DIR *dir = ::opendir(directory.c_str());
+    if (!dir) {
+        return indices;
+    }
+    while (dirent *entry = ::readdir(dir)) {
+        const char *name = entry->d_name;
+        if (std::strlen(name) != 12 || std::strcmp(name + 8, ".seg") != 0) {
+            continue;
+        }
+        uint32_t index = 0;
+        bool digits = true;
+        for (int i = 0; i < 8 && digits; ++i) {
+            digits = name[i] >= '0' && name[i] <= '9';
+            index = index * 10 + static_cast<uint32_t>(name[i] - '0');
+        }
+        if (digits && index > 0) {
+            indices.push_back(index);
+        }
+    }
+    ::closedir(dir);
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+/// Read-only mapping of a whole segment file.
+class MappedSegment {
+public:
+    explicit MappedSegment(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(kSegmentHeaderBytes + kFooterBytes)) {
+            void *mapped = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data_ = static_cast<const uint8_t *>(mapped);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedSegment() {
+        if (data_) {
+            ::munmap(const_cast<uint8_t *>(data_), size_);
+        }
+    }
+
+    MappedSegment(const MappedSegment &) = delete;
+    MappedSegment &operator=(const MappedSegment &) = delete;
+
+    bool valid() const {
+        return data_ && std::memcmp(data_, kSegmentMagic, 4) == 0 && getU32(data_ + 4) == kSegmentVersion;
+    }
+    const uint8_t *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+struct SegmentSummary {
+    bool sealed = false;
+    uint32_t count = 0;
+    int64_t maxTimestampMs = 0;
+    size_t dataEnd = kSegmentHeaderBytes;
+};
+
+bool readFooter(const MappedSegment &segment, SegmentSummary &summary) {
+    const uint8_t *footer = segment.data() + segment.size() - kFooterBytes;
+    if (std::memcmp(footer, kFooterMagic, 4) != 0 || getU32(footer + 24) != crc32(footer, 24)) {
+        return false;
+    }
+    uint64_t dataEnd = getU64(footer + 16);
+    if (dataEnd < kSegmentHeaderBytes || dataEnd > segment.size() - kFooterBytes) {
+        return false;
+    }
+    summary.sealed = true;
+    summary.count = getU32(footer + 4);
+    summary.maxTimestampMs = static_cast<int64_t>(getU64(footer + 8));
+    summary.dataEnd = static_cast<size_t>(dataEnd);
+    return true;
+}
+
+/// Decodes the record at `offset` if its header and CRC are valid and it ends
+/// before `limit`. An invalid record marks a torn write or the zero fill.
+bool readRecord(const MappedSegment &segment, size_t offset, size_t limit,
+                std::string_view &payload, int64_t &timestampMs) {
+    const uint8_t *base = segment.data();
+    if (offset + kRecordHeaderBytes > limit) {
+        return false;
+    }
+    uint32_t length = getU32(base + offset);
+    if (length == 0 || length > limit - offset - kRecordHeaderBytes) {
+        return false;
+    }
+    const uint8_t *stamped = base + offset + 8;
+    if (crc32(stamped, 8 + length) != getU32(base + offset + 4)) {
+        return false;
+    }
+    timestampMs = static_cast<int64_t>(getU64(stamped));
+    payload = std::string_view(reinterpret_cast<const char *>(stamped + 8), length);
+    return true;
+}
+
+void scanRecords(const MappedSegment &segment, size_t limit, SegmentSummary &summary) {
+    size_t offset = kSegmentHeaderBytes;
+    summary.count = 0;
+    summary.maxTimestampMs = 0;
+    std::string_view payload;
+    int64_t timestampMs = 0;
+    while (readRecord(segment, offset, limit, payload, timestampMs)) {
+        ++summary.count;
+        summary.maxTimestampMs = std::max(summary.maxTimestampMs, timestampMs);
+        offset += kRecordHeaderBytes + payload.size();
+    }
+    summary.dataEnd = offset;
+}
+
+SegmentSummary summarizeSegment(const MappedSegment &segment) {
+    SegmentSummary summary;
+    if (!segment.valid()) {
+        return summary;
+    }
+    if (!readFooter(segment, summary)) {
+        scanRecords(segment, segment.size() - kFooterBytes, summary);
+    }
+    return summary;
+}
+
+bool writeFooter(int fd, size_t segmentSize, const SegmentSummary &summary) {
+    uint8_t footer[kFooterBytes] = {};
+    std::memcpy(footer, kFooterMagic, 4);
+    putU32(footer + 4, summary.count);
+    putU64(footer + 8, static_cast<uint64_t>(summary.maxTimestampMs));
+    putU64(footer + 16, summary.dataEnd);
+    putU32(footer + 24, crc32(footer, 24));
+    return writeFully(fd, footer, kFooterBytes, static_cast<off_t>(segmentSize - kFooterBytes));
+}
+
+void encodeRecord(std::string &out, std::string_view payload, int64_t timestampMs) {
+    const size_t start = out.size();
+    out.resize(start + kRecordHeaderBytes);
+    out.append(payload.data(), payload.size());
+    auto *bytes = reinterpret_cast<uint8_t *>(&out[start]);
+    putU32(bytes, static_cast<uint32_t>(payload.size()));
+    putU64(bytes + 8, static_cast<uint64_t>(timestampMs));
+    putU32(bytes + 4, crc32(bytes + 8, 8 + payload.size()));
+}
+
+} // namespace
+
+SegmentedLog::SegmentedLog(std::string directory, size_t segmentBytes)
+    : directory_(std::move(directory)),
+      segmentBytes_(std::max(segmentBytes, kSegmentHeaderBytes + kRecordHeaderBytes + kFooterBytes + 1)) {}
+
+SegmentedLog::~SegmentedLog() { close(); }
+
+bool SegmentedLog::open() {
+    std::lock_guard<std::mutex> guard(lock_);
+    closeLocked();
+    stats_ = Stats();
+    activeIndex_ = 0;
+
+    open_ = false;
+    if (!makeDirectories(directory_)) {
+        return false;
+    }
+
+    std::vector<uint32_t> indices = listSegments(directory_);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const uint32_t index = indices[i];
+        const std::string path = segmentPath(directory_, index);
+        MappedSegment segment(path);
+        SegmentSummary summary = summarizeSegment(segment);
+        stats_.count += summary.count;
+        stats_.lastTimestampMs = std::max(stats_.lastTimestampMs, summary.maxTimestampMs);
+        stats_.segments += 1;
+        activeIndex_ = index;
+
+        if (summary.sealed || !segment.valid()) {
+            continue;
+        }
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        if (i + 1 < indices.size()) {
+            // A writer died between filling this segment and sealing it; seal
+            // it now so the next recovery only reads its footer.
+            writeFooter(fd, segment.size(), summary);
+            ::close(fd);
+        } else {
+            fd_ = fd;
+            activeSize_ = segment.size();
+            writeOffset_ = summary.dataEnd;
+            activeCount_ = summary.count;
+            activeMaxTimestampMs_ = summary.maxTimestampMs;
+        }
+    }
+    open_ = true;
+    return true;
+}
+
+bool SegmentedLog::append(std::string_view payload, int64_t timestampMs) {
+    if (payload.empty() || payload.size() > UINT32_MAX) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!ensureRoomLocked(kRecordHeaderBytes + payload.size())) {
+        return false;
+    }
+    scratch_.clear();
+    encodeRecord(scratch_, payload, timestampMs);
+    return writeStagedLocked(1, timestampMs);
+}
+
+size_t SegmentedLog::appendBatch(const std::vector<Record> &records) {
+    std::lock_guard<std::mutex> guard(lock_);
+    size_t written = 0;
+    size_t staged = 0;
+    int64_t stagedMaxTimestampMs = std::numeric_limits<int64_t>::min();
+    scratch_.clear();
+
+    for (const Record &record : records) {
+        if (record.payload.empty() || record.payload.size() > UINT32_MAX) {
+            continue;
+        }
+        const size_t recordBytes = kRecordHeaderBytes + record.payload.size();
+        if (staged > 0 && writeOffset_ + scratch_.size() + recordBytes > activeSize_ - kFooterBytes) {
+            if (!writeStagedLocked(staged, stagedMaxTimestampMs)) {
+                return written;
+            }
+            written += staged;
+            staged = 0;
+            stagedMaxTimestampMs = std::numeric_limits<int64_t>::min();
+            scratch_.clear();
+        }
+        if (staged == 0 && !ensureRoomLocked(recordBytes)) {
+            return written;
+        }
+        encodeRecord(scratch_, record.payload, record.timestampMs);
+        stagedMaxTimestampMs = std::max(stagedMaxTimestampMs, record.timestampMs);
+        ++staged;
+    }
+
+    if (staged > 0 && writeStagedLocked(staged, stagedMaxTimestampMs)) {
+        written += staged;
+    }
+    if (scratch_.capacity() > 2 * segmentBytes_) {
+        std::string().swap(scratch_);
+    }
+    return written;
+}
+
+bool SegmentedLog::sync() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return fd_ < 0 || ::fsync(fd_) == 0;
+}
+
+void SegmentedLog::close() {
+    std::lock_guard<std::mutex> guard(lock_);
+    closeLocked();
+    open_ = false;
+}
+
+bool SegmentedLog::clear() {
+    std::lock_guard<std::mutex> guard(lock_);
+    closeLocked();
+    bool ok = true;
+    for (uint32_t index : listSegments(directory_)) {
+        if (::unlink(segmentPath(directory_, index).c_str()) != 0 && errno != ENOENT) {
+            ok = false;
+        }
+    }
+    stats_ = Stats();
+    activeIndex_ = 0;
+    return ok;
+}
+
+SegmentedLog::Stats SegmentedLog::stats() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return stats_;
+}
+
+bool SegmentedLog::ensureRoomLocked(size_t recordBytes) {
+    if (!open_) {
+        return false;
+    }
+    if (fd_ >= 0 && writeOffset_ + recordBytes <= activeSize_ - kFooterBytes) {
+        return true;
+    }
+    if (fd_ >= 0) {
+        sealActiveLocked();
+    }
+    return openSegmentLocked(activeIndex_ + 1, kSegmentHeaderBytes + recordBytes + kFooterBytes);
+}
+
+bool SegmentedLog::writeStagedLocked(size_t recordCount, int64_t maxTimestampMs) {
+    auto *bytes = reinterpret_cast<const uint8_t *>(scratch_.data());
+    ++stats_.writes;
+    if (!writeFully(fd_, bytes, scratch_.size(), static_cast<off_t>(writeOffset_))) {
+        return false;
+    }
+    writeOffset_ += scratch_.size();
+    activeCount_ += static_cast<uint32_t>(recordCount);
+    activeMaxTimestampMs_ = std::max(activeMaxTimestampMs_, maxTimestampMs);
+    stats_.count += recordCount;
+    stats_.lastTimestampMs = std::max(stats_.lastTimestampMs, maxTimestampMs);
+    return true;
+}
+
+bool SegmentedLog::openSegmentLocked(uint32_t index, size_t minimumBytes) {
+    const size_t size = std::max(segmentBytes_, minimumBytes);
+    const std::string path = segmentPath(directory_, index);
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    uint8_t header[kSegmentHeaderBytes];
+    std::memcpy(header, kSegmentMagic, 4);
+    putU32(header + 4, kSegmentVersion);
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0 || !writeFully(fd, header, sizeof(header), 0)) {
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    fd_ = fd;
+    activeIndex_ = index;
+    activeSize_ = size;
+    writeOffset_ = kSegmentHeaderBytes;
+    activeCount_ = 0;
+    activeMaxTimestampMs_ = 0;
+    stats_.segments += 1;
+    return true;
+}
+
+bool SegmentedLog::sealActiveLocked() {
+    SegmentSummary summary;
+    summary.count = activeCount_;
+    summary.maxTimestampMs = activeMaxTimestampMs_;
+    summary.dataEnd = writeOffset_;
+    bool ok = writeFooter(fd_, activeSize_, summary);
+    ::close(fd_);
+    fd_ = -1;
+    return ok;
+}
+
+void SegmentedLog::closeLocked() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool SegmentedLog::forEach(const std::string &directory, const RecordVisitor &visitor) {
+    Cursor cursor(directory);
+    std::string_view payload;
+    int64_t timestampMs = 0;
+    while (cursor.next(payload, timestampMs)) {
+        if (!visitor(payload, timestampMs)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct SegmentedLog::Cursor::State {
+    std::string directory;
+    std::vector<uint32_t> indices;
+    size_t nextIndex = 0;
+    std::unique_ptr<MappedSegment> segment;
+    size_t offset = 0;
+    size_t limit = 0;
+};
+
+SegmentedLog::Cursor::Cursor(std::string directory) : state_(std::make_unique<State>()) {
+    state_->indices = listSegments(directory);
+    state_->directory = std::move(directory);
+}
+
+SegmentedLog::Cursor::~Cursor() = default;
+
+bool SegmentedLog::Cursor::next(std::string_view &payload, int64_t &timestampMs) {
+    State &state = *state_;
+    while (true) {
+        if (state.segment && readRecord(*state.segment, state.offset, state.limit, payload, timestampMs)) {
+            state.offset += kRecordHeaderBytes + payload.size();
+            return true;
+        }
+        state.segment.reset();
+        if (state.nextIndex >= state.indices.size()) {
+            return false;
+        }
+        auto segment = std::make_unique<MappedSegment>(segmentPath(state.directory, state.indices[state.nextIndex++]));
+        if (!segment->valid()) {
+            continue;
+        }
+        SegmentSummary summary;
+        state.limit = readFooter(*segment, summary) ? summary.dataEnd : segment->size() - kFooterBytes;
+        state.offset = kSegmentHeaderBytes;
+        state.segment = std::move(segment);
+    }
+}
+
+SegmentedLog::Stats SegmentedLog::inspect(const std::string &directory) {
+    Stats stats;
+    for (uint32_t index : listSegments(directory)) {
+        MappedSegment segment(segmentPath(directory, index));
+        SegmentSummary summary = summarizeSegment(segment);
+        stats.count += summary.count;
+        stats.lastTimestampMs = std::max(stats.lastTimestampMs, summary.maxTimestampMs);
+        stats.segments += 1;
+    }
+    return stats;
+}
+
+} // namespace rejourney
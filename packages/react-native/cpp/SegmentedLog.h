@@ -0,0 +1,144 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Append-only, segmented write-ahead log used for crash-safe event
+ * persistence.
+ *
+ * The log is a directory of fixed-size, preallocated segment files named
+ * `00000001.seg`, `00000002.seg`, ... Each record carries a length, a CRC32
+ * and the event timestamp, so a torn tail write is detected and truncated on
+ * recovery. When a segment fills up it is sealed with a footer holding its
+ * record count and newest timestamp; recovery reads one footer per sealed
+ * segment and only scans the active one.
+ *
+ * Segment layout:
+ *   "RJWL" u32 version
+ *   records: u32 length, u32 crc32(timestamp + payload), i64 timestampMs, payload
+ *   zero fill
+ *   footer (last 32 bytes): "RJWF" u32 recordCount, i64 maxTimestampMs,
+ *                           u64 dataEnd, u32 crc32(preceding 24 bytes), u32 0
+ *
+ * All integers are little-endian. A record larger than a segment gets a
+ * segment of its own, sized to fit.
+ */
+class SegmentedLog {
+public:
+    static constexpr size_t kDefaultSegmentBytes = 1 << 20;
+
+    struct Stats {
+        uint64_t count = 0;
+        int64_t lastTimestampMs = 0;
+        size_t segments = 0;
+        /// Record write syscalls issued since open().
+        uint64_t writes = 0;
+    };
+
+    struct Record {
+        std::string payload;
+        int64_t timestampMs = 0;
+    };
+
+    /// Called for every valid record in order. Return false to stop early.
+    using RecordVisitor = std::function<bool(std::string_view payload, int64_t timestampMs)>;
+
+    explicit SegmentedLog(std::string directory, size_t segmentBytes = kDefaultSegmentBytes);
+    ~SegmentedLog();
+
+    SegmentedLog(const SegmentedLog &) = delete;
+    SegmentedLog &operator=(const SegmentedLog &) = delete;
+
+    /// Creates the directory if needed and recovers count, newest timestamp
+    /// and the write position from existing segments.
+    bool open();
+
+    /// Appends fail until open() has succeeded, and after close().
+    bool append(std::string_view payload, int64_t timestampMs);
+
+    /// Appends records with one write per segment touched. Returns how many
+    /// were written; empty payloads are skipped.
+    size_t appendBatch(const std::vector<Record> &records);
+
+    /// Forces appended records to stable storage.
+    bool sync();
+
+    void close();
+
+    /// Deletes every segment and starts an empty log.
+    bool clear();
+
+    Stats stats() const;
+
+    /// Sequential reader over the log in `directory`, one mapped segment at a
+    /// time. A returned payload points into the mapping and stays valid until
+    /// the next call to next().
+    class Cursor {
+    public:
+        explicit Cursor(std::string directory);
+        ~Cursor();
+
+        Cursor(const Cursor &) = delete;
+        Cursor &operator=(const Cursor &) = delete;
+
+        bool next(std::string_view &payload, int64_t &timestampMs);
+
+    private:
+        struct State;
+        std::unique_ptr<State> state_;
+    };
+
+    /// Reads every valid record of the log in `directory` through mmap.
+    /// Safe to call on a log that is not open.
+    static bool forEach(const std::string &directory, const RecordVisitor &visitor);
+
+    /// Recovers count and newest timestamp without opening the log for writing.
+    static Stats inspect(const std::string &directory);
+
+private:
+    bool openSegmentLocked(uint32_t index, size_t minimumBytes);
+    bool ensureRoomLocked(size_t recordBytes);
+    bool writeStagedLocked(size_t recordCount, int64_t maxTimestampMs);
+    bool sealActiveLocked();
+    void closeLocked();
+
+    const std::string directory_;
+    const size_t segmentBytes_;
+
+    mutable std::mutex lock_;
+    bool open_ = false;
+    int fd_ = -1;
+    uint32_t activeIndex_ = 0;
+    size_t activeSize_ = 0;
+    size_t writeOffset_ = 0;
+    uint32_t activeCount_ = 0;
+    int64_t activeMaxTimestampMs_ = 0;
+    Stats stats_;
+    std::string scratch_;
+};
+
+} // namespace rejourney
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RJ_SIMD_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RJ_SIMD_SSE2 1
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace rejourney {
+namespace simd {
+
+/// Sum of `length` bytes.
+inline uint64_t sumBytes(const uint8_t *data, size_t length) {
+    uint64_t total = 0;
+    size_t i = 0;
+#if defined(RJ_SIMD_NEON)
+    while (length - i >= 16) {
+        // Each pairwise add grows a u16 lane by at most 510, so 128 steps
+        // cannot overflow before widening.
+        uint16x8_t acc16 = vdupq_n_u16(0);
+        const size_t blocks = std::min<size_t>((length - i) / 16, 128);
+        for (size_t b = 0; b < blocks; ++b, i += 16) {
+            acc16 = vpadalq_u8(acc16, vld1q_u8(data + i));
+        }
+        uint64x2_t acc64 = vpaddlq_u32(vpaddlq_u16(acc16));
+        total += vgetq_lane_u64(acc64, 0) + vgetq_lane_u64(acc64, 1);
+    }
+#elif defined(RJ_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (; length - i >= 16; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(bytes, zero));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+    total += lanes[0] + lanes[1];
+#endif
+    for (; i < length; ++i) {
+        total += data[i];
+    }
+    return total;
+}
+
+/// True if any byte of `a` and `b` differs by more than `tolerance`.
+inline bool bytesDiffer(const uint8_t *a, const uint8_t *b, size_t length, uint8_t tolerance) {
+    size_t i = 0;
+#if defined(RJ_SIMD_NEON)
+    const uint8x16_t tol = vdupq_n_u8(tolerance);
+    for (; length - i >= 16; i += 16) {
+        uint8x16_t over = vqsubq_u8(vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i)), tol);
+        uint64x2_t lanes = vreinterpretq_u64_u8(over);
+        if (vgetq_lane_u64(lanes, 0) | vgetq_lane_u64(lanes, 1)) {
+            return true;
+        }
+    }
+#elif defined(RJ_SIMD_SSE2)
+    const __m128i tol = _mm_set1_epi8(static_cast<char>(tolerance));
+    const __m128i zero = _mm_setzero_si128();
+    for (; length - i >= 16; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        __m128i diff = _mm_or_si128(_mm_subs_epu8(x, y), _mm_subs_epu8(y, x));
+        __m128i over = _mm_subs_epu8(diff, tol);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(over, zero)) != 0xFFFF) {
+            return true;
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        const int diff = static_cast<int>(a[i]) - static_cast<int>(b[i]);
+        if (diff > tolerance || -diff > tolerance) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Stores `value` into `count` consecutive 32-bit pixels.
+inline void fill32(uint32_t *dst, size_t count, uint32_t value) {
+    size_t i = 0;
+#if defined(RJ_SIMD_NEON)
+    const uint32x4_t v = vdupq_n_u32(value);
+    for (; count - i >= 16; i += 16) {
+        vst1q_u32(dst + i, v);
+        vst1q_u32(dst + i + 4, v);
+        vst1q_u32(dst + i + 8, v);
+        vst1q_u32(dst + i + 12, v);
+    }
+    for (; count - i >= 4; i += 4) {
+        vst1q_u32(dst + i, v);
+    }
+#elif defined(RJ_SIMD_SSE2)
+    const __m128i v = _mm_set1_epi32(static_cast<int>(value));
+    for (; count - i >= 16; i += 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 12), v);
+    }
+    for (; count - i >= 4; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+} // namespace simd
+} // namespace rejourney
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TileDeltaEncoder.h"
+
+#include "SimdBytes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace rejourney {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+constexpr uint32_t kMaxDimension = 0xFFFF;
+
+void putU16BE(std::string &out, uint32_t value) {
+    out.push_back(static_cast<char>((value >> 8) & 0xFF));
+    out.push_back(static_cast<char>(value & 0xFF));
+}
+
+} // namespace
+
+std::string TileDeltaEncoder::Delta::header() const {
+    std::string out("RJTD", 4);
+    out.push_back(static_cast<char>(kFormatVersion));
+    putU16BE(out, tileSize);
+    putU16BE(out, frameWidth);
+    putU16BE(out, frameHeight);
+    putU16BE(out, atlasColumns);
+    putU16BE(out, static_cast<uint32_t>(tiles.size()));
+    for (const auto &tile : tiles) {
+        putU16BE(out, tile.first);
+        putU16BE(out, tile.second);
+    }
+    return out;
+}
+
+TileDeltaEncoder::TileDeltaEncoder() : TileDeltaEncoder(Options()) {}
+
+TileDeltaEncoder::TileDeltaEncoder(Options options) : options_(options) {}
+
+void TileDeltaEncoder::storeKeyframeLocked(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow) {
+    const size_t rowBytes = width * kBytesPerPixel;
+    keyframe_.resize(rowBytes * height);
+    for (size_t y = 0; y < height; ++y) {
+        std::memcpy(keyframe_.data() + y * rowBytes, pixels + y * bytesPerRow, rowBytes);
+    }
+    width_ = width;
+    height_ = height;
+    framesSinceKeyframe_ = 0;
+}
+
+TileDeltaEncoder::Result TileDeltaEncoder::encode(const uint8_t *pixels, size_t width, size_t height,
+                                                  size_t bytesPerRow, bool forceKeyframe, Delta &delta) {
+    std::lock_guard<std::mutex> guard(lock_);
+    const size_t tileSize = std::max<uint32_t>(options_.tileSize, 1);
+    const size_t rowBytes = width * kBytesPerPixel;
+    if (!pixels || width == 0 || height == 0 || width > kMaxDimension || height > kMaxDimension ||
+        bytesPerRow < rowBytes) {
+        keyframe_.clear();
+        return Result::Keyframe;
+    }
+    if (forceKeyframe || keyframe_.empty() || width != width_ || height != height_ ||
+        framesSinceKeyframe_ + 1 >= options_.keyframeInterval) {
+        storeKeyframeLocked(pixels, width, height, bytesPerRow);
+        return Result::Keyframe;
+    }
+
+    const size_t columns = (width + tileSize - 1) / tileSize;
+    const size_t rows = (height + tileSize - 1) / tileSize;
+    const size_t maxChanged = static_cast<size_t>(options_.maxChangedFraction * static_cast<double>(columns * rows));
+
+    delta.tiles.clear();
+    for (size_t row = 0; row < rows; ++row) {
+        const size_t y0 = row * tileSize;
+        const size_t tileRows = std::min(tileSize, height - y0);
+        for (size_t col = 0; col < columns; ++col) {
+            const size_t x0 = col * tileSize * kBytesPerPixel;
+            const size_t tileBytes = std::min(tileSize, width - col * tileSize) * kBytesPerPixel;
+            for (size_t y = y0; y < y0 + tileRows; ++y) {
+                if (simd::bytesDiffer(pixels + y * bytesPerRow + x0, keyframe_.data() + y * rowBytes + x0,
+                                      tileBytes, options_.tolerance)) {
+                    delta.tiles.emplace_back(static_cast<uint16_t>(col), static_cast<uint16_t>(row));
+                    break;
+                }
+            }
+        }
+        if (delta.tiles.size() > maxChanged) {
+            storeKeyframeLocked(pixels, width, height, bytesPerRow);
+            return Result::Keyframe;
+        }
+    }
+
+    const size_t count = delta.tiles.size();
+    delta.tileSize = static_cast<uint32_t>(tileSize);
+    delta.frameWidth = static_cast<uint32_t>(width);
+    delta.frameHeight = static_cast<uint32_t>(height);
+    delta.atlasColumns = count ? static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count)))) : 0;
+    const size_t atlasRows = count ? (count + delta.atlasColumns - 1) / delta.atlasColumns : 0;
+    delta.atlasWidth = static_cast<uint32_t>(delta.atlasColumns * tileSize);
+    delta.atlasHeight = static_cast<uint32_t>(atlasRows * tileSize);
+    delta.atlasPixels.assign(delta.atlasBytesPerRow() * delta.atlasHeight, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const size_t col = delta.tiles[i].first;
+        const size_t row = delta.tiles[i].second;
+        const size_t tileBytes = std::min(tileSize, width - col * tileSize) * kBytesPerPixel;
+        const size_t tileRows = std::min(tileSize, height - row * tileSize);
+        uint8_t *dst = delta.atlasPixels.data() + (i / delta.atlasColumns) * tileSize * delta.atlasBytesPerRow() +
+                       (i % delta.atlasColumns) * tileSize * kBytesPerPixel;
+        const uint8_t *src = pixels + row * tileSize * bytesPerRow + col * tileSize * kBytesPerPixel;
+        for (size_t y = 0; y < tileRows; ++y) {
+            std::memcpy(dst + y * delta.atlasBytesPerRow(), src + y * bytesPerRow, tileBytes);
+        }
+    }
+    ++framesSinceKeyframe_;
+    return Result::Delta;
+}
+
+void TileDeltaEncoder::reset() {
+    std::lock_guard<std::mutex> guard(lock_);
+    keyframe_.clear();
+    framesSinceKeyframe_ = 0;
+}
+
+} // namespace rejourney
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Splits captured frames into tiles and keeps only the tiles that changed
+ * since the last keyframe.
+ *
+ * A keyframe is shipped as a full JPEG. Every later frame is compared with
+ * the keyframe tile by tile, and the changed tiles are packed into an atlas
+ * bitmap for the caller to JPEG-encode. Deltas are relative to the keyframe
+ * rather than to the previous frame, so any delta decodes from the keyframe
+ * alone. A new keyframe is taken when forced, when the frame size changes,
+ * every `keyframeInterval` frames, or once more than `maxChangedFraction` of
+ * the tiles differ (a full JPEG is smaller at that point).
+ *
+ * In a frame bundle a delta frame's payload is the header returned by
+ * Delta::header() followed by the atlas JPEG (absent when no tile changed):
+ * "RJTD", u8 version, then big-endian u16 tile size, frame width, frame
+ * height, atlas columns and tile count, then (column, row) u16 pairs. Tile i
+ * sits in the atlas at column i % atlasColumns, row i / atlasColumns; edge
+ * tiles are clipped to the frame. The backend compositor lives in
+ * backend/src/services/screenshotFrames.ts.
+ *
+ * Bitmaps are 32 bits per pixel. Thread-safe.
+ */
+class TileDeltaEncoder {
+public:
+    static constexpr uint8_t kFormatVersion = 1;
+
+    struct Options {
+        uint32_t tileSize = 32;
+        /// Largest per-byte difference that still counts as unchanged.
+        uint8_t tolerance = 8;
+        double maxChangedFraction = 0.4;
+        uint32_t keyframeInterval = 30;
+    };
+
+    enum class Result {
+        Keyframe,
+        Delta,
+    };
+
+    struct Delta {
+        uint32_t tileSize = 0;
+        uint32_t frameWidth = 0;
+        uint32_t frameHeight = 0;
+        uint32_t atlasColumns = 0;
+        /// (column, row) of each changed tile, in atlas order.
+        std::vector<std::pair<uint16_t, uint16_t>> tiles;
+        uint32_t atlasWidth = 0;
+        uint32_t atlasHeight = 0;
+        /// Tightly packed 32bpp atlas, same channel order as the input.
+        std::vector<uint8_t> atlasPixels;
+
+        size_t atlasBytesPerRow() const { return static_cast<size_t>(atlasWidth) * 4; }
+        std::string header() const;
+    };
+
+    TileDeltaEncoder();
+    explicit TileDeltaEncoder(Options options);
+
+    /// Classifies one frame. On Keyframe the frame becomes the reference and
+    /// the caller ships it whole; on Delta, `delta` holds the changed tiles.
+    Result encode(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, bool forceKeyframe,
+                  Delta &delta);
+
+    /// Drops the keyframe so the next frame becomes one.
+    void reset();
+
+private:
+    void storeKeyframeLocked(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow);
+
+    const Options options_;
+    std::mutex lock_;
+    std::vector<uint8_t> keyframe_;
+    size_t width_ = 0;
+    size_t height_ = 0;
+    uint32_t framesSinceKeyframe_ = 0;
+};
+
+} // namespace rejourney
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UploadLanes.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace rejourney {
+
+UploadLanes::UploadLanes() : UploadLanes(Options()) {}
+
+UploadLanes::UploadLanes(Options options) : options_(options) {}
+
+void UploadLanes::setOptions(const Options &options) {
+    std::lock_guard<std::mutex> guard(lock_);
+    options_ = options;
+}
+
+UploadLanes::Options UploadLanes::options() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return options_;
+}
+
+uint64_t UploadLanes::enqueue(Lane lane, bool retry) {
+    std::lock_guard<std::mutex> guard(lock_);
+    const uint64_t ticket = nextTicket_++;
+    const auto i = static_cast<size_t>(lane);
+    if (retry) {
+        queued_[i].insert(queued_[i].begin() + static_cast<std::ptrdiff_t>(retriesQueued_[i]), ticket);
+        ++retriesQueued_[i];
+    } else {
+        queued_[i].push_back(ticket);
+    }
+    return ticket;
+}
+
+bool UploadLanes::next(uint64_t &ticket, Lane &lane) {
+    std::lock_guard<std::mutex> guard(lock_);
+    // A zero window would stall every lane for good.
+    if (running_.size() >= std::max<size_t>(1, options_.window)) {
+        return false;
+    }
+    for (size_t i = 0; i < kLaneCount; ++i) {
+        if (queued_[i].empty() || runningPerLane_[i] >= std::max<size_t>(1, options_.laneLimit[i])) {
+            continue;
+        }
+        ticket = queued_[i].front();
+        queued_[i].pop_front();
+        if (retriesQueued_[i] > 0) {
+            --retriesQueued_[i];
+        }
+        lane = static_cast<Lane>(i);
+        running_.emplace(ticket, lane);
+        ++runningPerLane_[i];
+        peakInFlight_ = std::max(peakInFlight_, running_.size());
+        return true;
+    }
+    return false;
+}
+
+void UploadLanes::finished(uint64_t ticket) {
+    std::lock_guard<std::mutex> guard(lock_);
+    const auto it = running_.find(ticket);
+    if (it == running_.end()) {
+        return;
+    }
+    const auto i = static_cast<size_t>(it->second);
+    running_.erase(it);
+    --runningPerLane_[i];
+}
+
+size_t UploadLanes::clearQueued() {
+    std::lock_guard<std::mutex> guard(lock_);
+    size_t cleared = 0;
+    for (auto &lane : queued_) {
+        cleared += lane.size();
+        lane.clear();
+    }
+    retriesQueued_.fill(0);
+    return cleared;
+}
+
+UploadLanes::Stats UploadLanes::stats() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    Stats stats;
+    stats.inFlight = running_.size();
+    for (size_t i = 0; i < kLaneCount; ++i) {
+        stats.queued[i] = queued_[i].size();
+        stats.running[i] = runningPerLane_[i];
+    }
+    stats.peakInFlight = peakInFlight_;
+    return stats;
+}
+
+} // namespace rejourney
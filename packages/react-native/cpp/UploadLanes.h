@@ -0,0 +1,101 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace rejourney {
+
+/**
+ * Decides which queued upload starts next, so uploads run as a pipeline of
+ * up to `window` requests instead of one at a time.
+ *
+ * Each kind of upload has its own lane. Lanes are ordered by priority
+ * (events, then hierarchy, then frames): whenever a place in the window
+ * frees up it goes to the first lane with work that is below its own
+ * limit. Within a lane, uploads start in the order they were enqueued;
+ * retries are queued ahead of fresh uploads of their kind, in the order
+ * they were retried, so older data goes out first.
+ *
+ * Uploads are identified by tickets; the caller keeps the payload and
+ * completion keyed by ticket. Thread-safe: uploads are enqueued from the
+ * pipelines and finish on network callbacks.
+ */
+class UploadLanes {
+public:
+    enum class Lane : uint8_t { Events = 0, Hierarchy = 1, Frames = 2 };
+    static constexpr size_t kLaneCount = 3;
+
+    struct Options {
+        /// Uploads in flight across all lanes.
+        size_t window = 4;
+        /// Uploads in flight per lane, by Lane. Events and hierarchy default
+        /// to one at a time so batches land in sequence.
+        std::array<size_t, kLaneCount> laneLimit = {1, 1, 4};
+    };
+
+    struct Stats {
+        size_t inFlight = 0;
+        std::array<size_t, kLaneCount> queued = {};
+        std::array<size_t, kLaneCount> running = {};
+        /// Most uploads ever in flight at once.
+        size_t peakInFlight = 0;
+    };
+
+    UploadLanes();
+    explicit UploadLanes(Options options);
+
+    /// Takes effect for the next start; uploads in flight stay.
+    void setOptions(const Options &options);
+    Options options() const;
+
+    /// Queues an upload in `lane` and returns its ticket: at the back, or
+    /// behind the retries already queued when `retry` is set.
+    uint64_t enqueue(Lane lane, bool retry = false);
+
+    /// Starts the next upload the window and lane limits allow. False when
+    /// nothing can start yet.
+    bool next(uint64_t &ticket, Lane &lane);
+
+    /// An upload returned by next() is over, however it went. Unknown
+    /// tickets are ignored.
+    void finished(uint64_t ticket);
+
+    /// Drops every upload that has not started and returns how many there
+    /// were. Uploads in flight still need finished().
+    size_t clearQueued();
+
+    Stats stats() const;
+
+private:
+    Options options_;
+    mutable std::mutex lock_;
+    std::array<std::deque<uint64_t>, kLaneCount> queued_;
+    /// Leading entries of each queued_ lane that are retries.
+    std::array<size_t, kLaneCount> retriesQueued_ = {};
+    std::unordered_map<uint64_t, Lane> running_;
+    std::array<size_t, kLaneCount> runningPerLane_ = {};
+    uint64_t nextTicket_ = 1;
+    size_t peakInFlight_ = 0;
+};
+
+} // namespace rejourney
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UploadPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rejourney {
+
+namespace {
+
+double smooth(double average, double sample, double weight) {
+    return average > 0 ? average + weight * (sample - average) : sample;
+}
+
+} // namespace
+
+UploadPolicy::UploadPolicy() : UploadPolicy(Options()) {}
+
+UploadPolicy::UploadPolicy(Options options) : options_(options) {}
+
+void UploadPolicy::setOptions(const Options &options) {
+    std::lock_guard<std::mutex> guard(lock_);
+    options_ = options;
+}
+
+UploadPolicy::Options UploadPolicy::options() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return options_;
+}
+
+bool UploadPolicy::setPath(Path path, bool expensive, bool constrained) {
+    std::lock_guard<std::mutex> guard(lock_);
+    Kind before = Kind::Crash;
+    const bool sentBefore = lowestSendableLocked(before);
+
+    if (path != stats_.path) {
+        stats_.throughputBytesPerSecond = 0;
+        stats_.throughputSamples = 0;
+    }
+    stats_.path = path;
+    stats_.expensive = expensive;
+    stats_.constrained = constrained;
+
+    Kind after = Kind::Crash;
+    if (!lowestSendableLocked(after) || (sentBefore && after >= before)) {
+        return false;
+    }
+    ++stats_.releases;
+    return true;
+}
+
+bool UploadPolicy::shouldSend(Kind kind) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    Kind lowest = Kind::Crash;
+    return lowestSendableLocked(lowest) && kind >= lowest;
+}
+
+bool UploadPolicy::lowestSendable(Kind &kind) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return lowestSendableLocked(kind);
+}
+
+void UploadPolicy::onUploadCompleted(uint64_t bytes, double durationMs) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (bytes < options_.minSampleBytes || !(durationMs > 0)) {
+        return;
+    }
+    const double sample = static_cast<double>(bytes) * 1000.0 / durationMs;
+    stats_.throughputBytesPerSecond = smooth(stats_.throughputBytesPerSecond, sample, options_.smoothing);
+    ++stats_.throughputSamples;
+}
+
+void UploadPolicy::onFrameBundle(uint64_t bytes, uint32_t frames) {
+    if (frames == 0 || bytes == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    const double sample = static_cast<double>(bytes) / frames;
+    stats_.bundleBytesPerFrame = smooth(stats_.bundleBytesPerFrame, sample, options_.smoothing);
+}
+
+uint32_t UploadPolicy::bundleFrames() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return bundleFramesLocked();
+}
+
+uint64_t UploadPolicy::bundleAgeLimitMs(uint32_t frameIntervalMs) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    const uint64_t base = static_cast<uint64_t>(std::max<uint32_t>(1, options_.baseBundleFrames)) * frameIntervalMs;
+    const uint64_t full = static_cast<uint64_t>(bundleFramesLocked()) * frameIntervalMs;
+    return std::max(base, std::min<uint64_t>(full, options_.maxBundleAgeMs));
+}
+
+uint32_t UploadPolicy::bundleFramesLocked() const {
+    const uint32_t base = std::max<uint32_t>(1, options_.baseBundleFrames);
+    const bool unmetered = (stats_.path == Path::Wifi || stats_.path == Path::Wired) && !meteredLocked();
+    if (!unmetered || stats_.throughputSamples < options_.minSamples || stats_.bundleBytesPerFrame <= 0) {
+        return base;
+    }
+    const double budget = stats_.throughputBytesPerSecond * options_.targetUploadMs / 1000.0;
+    const double frames = std::floor(budget / stats_.bundleBytesPerFrame);
+    const uint32_t most = std::max(base, options_.maxBundleFrames);
+    return static_cast<uint32_t>(std::clamp(frames, static_cast<double>(base), static_cast<double>(most)));
+}
+
+UploadPolicy::Stats UploadPolicy::stats() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return stats_;
+}
+
+bool UploadPolicy::meteredLocked() const {
+    return stats_.expensive || stats_.constrained;
+}
+
+bool UploadPolicy::lowestSendableLocked(Kind &kind) const {
+    if (stats_.path == Path::None) {
+        return false;
+    }
+    kind = options_.deferOnMetered && meteredLocked() ? options_.meteredFloor : Kind::Frames;
+    return true;
+}
+
+} // namespace rejourney
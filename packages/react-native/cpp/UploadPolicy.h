@@ -0,0 +1,133 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "UploadSpool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace rejourney {
+
+/**
+ * Decides, from the network path, which uploads go out now and which wait
+ * in the spool, and how many frames a bundle should hold.
+ *
+ * On an expensive or constrained path (cellular, a personal hotspot, Low
+ * Data Mode) uploads below `meteredFloor` are deferred: frame bundles go to
+ * the spool while events, hierarchy and crash reports still ship right away.
+ * Without a path nothing is sent. setPath() reports when a path change lets
+ * deferred kinds go again, so the caller can drain the spool. Until the
+ * first path arrives everything is sent, as if no policy were in place.
+ *
+ * On an unmetered path (Wi-Fi or wired, neither expensive nor constrained)
+ * bundles grow so one upload takes about `targetUploadMs` at the measured
+ * throughput: fewer, larger objects amortise the per-upload round trips.
+ * Throughput and bundle size per frame are moving averages over completed
+ * uploads; throughput is forgotten on a path change, since one link says
+ * little about the next. Elsewhere bundles keep `baseBundleFrames`.
+ *
+ * A bundle that fills slowly (an idle screen) ships short once it has been
+ * open for bundleAgeLimitMs(): the time bundleFrames() frames take at the
+ * given interval, so larger bundles are not cut back to the base size, but
+ * never more than `maxBundleAgeMs`. That cap is the added replay latency
+ * larger bundles may cost.
+ *
+ * Thread-safe: path updates arrive from the path monitor, measurements
+ * from network callbacks and queries from the capture pipeline.
+ */
+class UploadPolicy {
+public:
+    using Kind = UploadSpool::Kind;
+
+    enum class Path : uint8_t { Unknown = 0, None = 1, Wifi = 2, Wired = 3, Cellular = 4, Other = 5 };
+
+    struct Options {
+        /// Defer on expensive and constrained paths at all.
+        bool deferOnMetered = true;
+        /// Lowest kind sent on a metered path; lower kinds wait in the spool.
+        Kind meteredFloor = Kind::Hierarchy;
+        /// Frames per bundle off unmetered paths, and the least on them.
+        uint32_t baseBundleFrames = 3;
+        uint32_t maxBundleFrames = 30;
+        /// Time one bundle upload should take on an unmetered path.
+        uint32_t targetUploadMs = 3000;
+        /// Longest a grown bundle stays open; a base-sized one may take longer.
+        uint32_t maxBundleAgeMs = 60000;
+        /// Uploads smaller than this are dominated by round trips and say
+        /// little about throughput.
+        uint64_t minSampleBytes = 16 * 1024;
+        /// Throughput samples needed before bundles grow.
+        uint32_t minSamples = 2;
+        /// Weight of the newest sample in the moving averages.
+        double smoothing = 0.3;
+    };
+
+    struct Stats {
+        Path path = Path::Unknown;
+        bool expensive = false;
+        bool constrained = false;
+        double throughputBytesPerSecond = 0;
+        double bundleBytesPerFrame = 0;
+        uint32_t throughputSamples = 0;
+        /// setPath() calls that released deferred kinds.
+        uint64_t releases = 0;
+    };
+
+    UploadPolicy();
+    explicit UploadPolicy(Options options);
+
+    void setOptions(const Options &options);
+    Options options() const;
+
+    /// Records the current path. True when kinds that were deferred may be
+    /// sent now.
+    bool setPath(Path path, bool expensive, bool constrained);
+
+    /// Whether an upload of `kind` should go out now rather than be spooled.
+    bool shouldSend(Kind kind) const;
+
+    /// Lowest kind that may be sent now. False when nothing may.
+    bool lowestSendable(Kind &kind) const;
+
+    /// A successful upload of `bytes` that took `durationMs`.
+    void onUploadCompleted(uint64_t bytes, double durationMs);
+
+    /// A frame bundle of `bytes` holding `frames` frames was handed over.
+    void onFrameBundle(uint64_t bytes, uint32_t frames);
+
+    /// Frames the next bundle should hold.
+    uint32_t bundleFrames() const;
+
+    /// How long a bundle may stay open when frames arrive `frameIntervalMs`
+    /// apart before it ships with fewer than bundleFrames().
+    uint64_t bundleAgeLimitMs(uint32_t frameIntervalMs) const;
+
+    Stats stats() const;
+
+private:
+    uint32_t bundleFramesLocked() const;
+    bool meteredLocked() const;
+    bool lowestSendableLocked(Kind &kind) const;
+
+    Options options_;
+    mutable std::mutex lock_;
+    Stats stats_;
+};
+
+} // namespace rejourney
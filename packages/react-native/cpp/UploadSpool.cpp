@@ -0,0 +1,487 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UploadSpool.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rejourney {
+
+namespace {
+
+constexpr size_t kIndexSegmentBytes = 64 * 1024;
+constexpr char kAddRecord = 'A';
+constexpr char kDoneRecord = 'D';
+constexpr char kFailedRecord = 'F';
+constexpr size_t kAddHeaderBytes = 1 + 8 + 1 + 8 + 4 + 8;
+constexpr size_t kIdRecordBytes = 1 + 8;
+constexpr const char *kPayloadSuffix = ".up";
+constexpr const char *kTempSuffix = ".tmp";
+/// Dead index records tolerated before a rewrite, on top of one per entry.
+constexpr size_t kCompactSlack = 64;
+
+void putU32(std::string &out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+void putU64(std::string &out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+uint32_t getU32(const char *in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t getU64(const char *in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+std::string encodeAdd(const UploadSpool::Entry &entry) {
+    std::string out;
+    out.reserve(kAddHeaderBytes + entry.meta.size());
+    out.push_back(kAddRecord);
+    putU64(out, entry.id);
+    out.push_back(static_cast<char>(entry.kind));
+    putU64(out, entry.bytes);
+    putU32(out, entry.attempts);
+    putU64(out, static_cast<uint64_t>(entry.createdMs));
+    out.append(entry.meta);
+    return out;
+}
+
+std::string encodeId(char type, uint64_t id) {
+    std::string out;
+    out.reserve(kIdRecordBytes);
+    out.push_back(type);
+    putU64(out, id);
+    return out;
+}
+
+bool makeDirectories(const std::string &path) {
+    if (path.empty()) {
+        return false;
+    }
+    for (size_t pos = 1; pos <= path.size(); ++pos) {
+        if (pos == path.size() || path[pos] == '/') {
+            std::string prefix = path.substr(0, pos);
+            if (::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool exists(const std::string &path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0;
+}
+
+std::vector<std::string> listFiles(const std::string &directory) {
+    std::vector<std::string> names;
+    DIR *dir = ::opendir(directory.c_str());
+    if (!dir) {
+        return names;
+    }
+    while (struct dirent *entry = ::readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+            names.emplace_back(entry->d_name);
+        }
+    }
+    ::closedir(dir);
+    return names;
+}
+
+/// Deletes a flat directory such as a SegmentedLog's.
+void removeDirectory(const std::string &directory) {
+    for (const auto &name : listFiles(directory)) {
+        ::unlink((directory + "/" + name).c_str());
+    }
+    ::rmdir(directory.c_str());
+}
+
+bool endsWith(const std::string &name, const char *suffix) {
+    const size_t length = std::strlen(suffix);
+    return name.size() > length && name.compare(name.size() - length, length, suffix) == 0;
+}
+
+bool writeFile(const std::string &path, std::string_view data) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    const char *cursor = data.data();
+    size_t remaining = data.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, cursor, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ::close(fd);
+            return false;
+        }
+        cursor += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    return ::close(fd) == 0;
+}
+
+} // namespace
+
+UploadSpool::UploadSpool(std::string directory, Options options)
+    : directory_(std::move(directory)), options_(options) {}
+
+UploadSpool::~UploadSpool() { close(); }
+
+bool UploadSpool::open() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (open_) {
+        return true;
+    }
+    if (!makeDirectories(directory_)) {
+        return false;
+    }
+
+    // Finish or roll back an index rewrite a crash interrupted.
+    const std::string indexDir = directory_ + "/index";
+    const std::string nextDir = directory_ + "/index.next";
+    if (!exists(indexDir) && exists(nextDir)) {
+        ::rename(nextDir.c_str(), indexDir.c_str());
+    }
+    removeDirectory(nextDir);
+    removeDirectory(directory_ + "/index.old");
+
+    entries_.clear();
+    indexRecords_ = 0;
+    uint64_t maxId = 0;
+    SegmentedLog::forEach(indexDir, [&](std::string_view record, int64_t) {
+        ++indexRecords_;
+        if (record.empty()) {
+            return true;
+        }
+        if (record[0] == kAddRecord && record.size() >= kAddHeaderBytes) {
+            Entry entry;
+            entry.id = getU64(record.data() + 1);
+            entry.kind = static_cast<Kind>(std::min<uint8_t>(static_cast<uint8_t>(record[9]), 3));
+            entry.bytes = getU64(record.data() + 10);
+            entry.attempts = getU32(record.data() + 18);
+            entry.createdMs = static_cast<int64_t>(getU64(record.data() + 22));
+            entry.meta.assign(record.substr(kAddHeaderBytes));
+            maxId = std::max(maxId, entry.id);
+            entries_[entry.id] = std::move(entry);
+        } else if (record.size() >= kIdRecordBytes) {
+            const uint64_t id = getU64(record.data() + 1);
+            auto it = entries_.find(id);
+            if (it == entries_.end()) {
+                return true;
+            }
+            if (record[0] == kDoneRecord) {
+                entries_.erase(it);
+            } else if (record[0] == kFailedRecord) {
+                ++it->second.attempts;
+            }
+        }
+        return true;
+    });
+    nextId_ = maxId + 1;
+
+    // Payloads must be on disk at the size the index recorded; files the
+    // index does not know are leftovers of a crash mid-put.
+    stats_.bytes = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        struct stat st;
+        const std::string path = payloadPath(it->first);
+        if (::stat(path.c_str(), &st) != 0 || static_cast<uint64_t>(st.st_size) != it->second.bytes) {
+            ::unlink(path.c_str());
+            it = entries_.erase(it);
+        } else {
+            stats_.bytes += it->second.bytes;
+            ++it;
+        }
+    }
+    for (const auto &name : listFiles(directory_)) {
+        if (endsWith(name, kTempSuffix)) {
+            ::unlink((directory_ + "/" + name).c_str());
+        } else if (endsWith(name, kPayloadSuffix)) {
+            const uint64_t id = std::strtoull(name.c_str(), nullptr, 10);
+            if (entries_.find(id) == entries_.end()) {
+                ::unlink((directory_ + "/" + name).c_str());
+            }
+        }
+    }
+
+    index_ = std::make_unique<SegmentedLog>(indexDir, kIndexSegmentBytes);
+    if (!index_->open()) {
+        index_.reset();
+        entries_.clear();
+        stats_.bytes = 0;
+        return false;
+    }
+    open_ = true;
+    // Applies a budget lowered since the spool was written.
+    makeRoomLocked(Kind::Crash, 0);
+    maybeCompactLocked();
+    return true;
+}
+
+void UploadSpool::close() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (index_) {
+        index_->close();
+        index_.reset();
+    }
+    open_ = false;
+}
+
+uint64_t UploadSpool::put(Kind kind, std::string_view meta, std::string_view payload, int64_t nowMs) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!open_) {
+        return 0;
+    }
+    if (!makeRoomLocked(kind, payload.size())) {
+        ++stats_.refusedPuts;
+        return 0;
+    }
+
+    Entry entry;
+    entry.id = nextId_++;
+    entry.kind = kind;
+    entry.bytes = payload.size();
+    entry.createdMs = nowMs;
+    entry.meta.assign(meta);
+
+    // Written under a temporary name so a torn write never looks like a
+    // payload; the size check on open() catches what the rename cannot.
+    const std::string path = payloadPath(entry.id);
+    const std::string tempPath = path + kTempSuffix;
+    if (!writeFile(tempPath, payload) || ::rename(tempPath.c_str(), path.c_str()) != 0) {
+        ::unlink(tempPath.c_str());
+        return 0;
+    }
+    if (!appendIndexLocked(encodeAdd(entry))) {
+        ::unlink(path.c_str());
+        return 0;
+    }
+    stats_.bytes += entry.bytes;
+    const uint64_t id = entry.id;
+    entries_[id] = std::move(entry);
+    maybeCompactLocked();
+    return id;
+}
+
+std::vector<UploadSpool::Entry> UploadSpool::pending(size_t limit, const std::vector<uint64_t> &exclude,
+                                                     Kind lowest) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    std::vector<Entry> result;
+    for (const auto &[id, entry] : entries_) {
+        if (result.size() >= limit) {
+            break;
+        }
+        if (entry.kind >= lowest && std::find(exclude.begin(), exclude.end(), id) == exclude.end()) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+bool UploadSpool::read(uint64_t id, std::string &payload) const {
+    uint64_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto it = entries_.find(id);
+        if (it == entries_.end()) {
+            return false;
+        }
+        bytes = it->second.bytes;
+    }
+    // Read outside the lock; an eviction racing this unlinks the file, and
+    // an open descriptor still reads the whole payload.
+    int fd = ::open(payloadPath(id).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    payload.resize(bytes);
+    size_t done = 0;
+    while (done < bytes) {
+        ssize_t n = ::read(fd, &payload[done], bytes - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    ::close(fd);
+    return done == bytes;
+}
+
+void UploadSpool::complete(uint64_t id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!open_ || entries_.find(id) == entries_.end()) {
+        return;
+    }
+    removeLocked(id, true);
+    maybeCompactLocked();
+}
+
+bool UploadSpool::failed(uint64_t id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(id);
+    if (!open_ || it == entries_.end()) {
+        return false;
+    }
+    if (++it->second.attempts >= options_.maxAttempts) {
+        ++stats_.exhaustedEntries;
+        removeLocked(id, true);
+        maybeCompactLocked();
+        return false;
+    }
+    appendIndexLocked(encodeId(kFailedRecord, id));
+    maybeCompactLocked();
+    return true;
+}
+
+UploadSpool::Stats UploadSpool::stats() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    Stats stats = stats_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+std::string UploadSpool::payloadPath(uint64_t id) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%020llu%s", static_cast<unsigned long long>(id), kPayloadSuffix);
+    return directory_ + "/" + name;
+}
+
+bool UploadSpool::appendIndexLocked(std::string_view record) {
+    if (!index_->append(record, 0)) {
+        return false;
+    }
+    ++indexRecords_;
+    return true;
+}
+
+bool UploadSpool::makeRoomLocked(Kind kind, uint64_t bytes) {
+    if (bytes > options_.byteBudget) {
+        return false;
+    }
+    const uint64_t needed = stats_.bytes + bytes;
+    if (needed <= options_.byteBudget) {
+        return true;
+    }
+    // Refuse before evicting anything if the kinds this upload may displace
+    // cannot free enough.
+    uint64_t evictable = 0;
+    for (const auto &[id, entry] : entries_) {
+        if (entry.kind <= kind) {
+            evictable += entry.bytes;
+        }
+    }
+    if (needed - evictable > options_.byteBudget) {
+        return false;
+    }
+    for (uint8_t k = 0; k <= static_cast<uint8_t>(kind) && stats_.bytes + bytes > options_.byteBudget; ++k) {
+        for (auto it = entries_.begin(); it != entries_.end() && stats_.bytes + bytes > options_.byteBudget;) {
+            if (static_cast<uint8_t>(it->second.kind) != k) {
+                ++it;
+                continue;
+            }
+            const uint64_t id = it->first;
+            ++it;
+            ++stats_.evictedEntries;
+            stats_.evictedBytes += entries_[id].bytes;
+            removeLocked(id, true);
+        }
+    }
+    return true;
+}
+
+void UploadSpool::removeLocked(uint64_t id, bool writeIndex) {
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return;
+    }
+    stats_.bytes -= it->second.bytes;
+    entries_.erase(it);
+    ::unlink(payloadPath(id).c_str());
+    if (writeIndex) {
+        appendIndexLocked(encodeId(kDoneRecord, id));
+    }
+}
+
+void UploadSpool::maybeCompactLocked() {
+    if (indexRecords_ <= entries_.size() * 2 + kCompactSlack) {
+        return;
+    }
+    const std::string indexDir = directory_ + "/index";
+    const std::string nextDir = directory_ + "/index.next";
+    const std::string oldDir = directory_ + "/index.old";
+    removeDirectory(nextDir);
+
+    std::vector<SegmentedLog::Record> records;
+    records.reserve(entries_.size());
+    for (const auto &[id, entry] : entries_) {
+        records.push_back({encodeAdd(entry), entry.createdMs});
+    }
+    {
+        SegmentedLog fresh(nextDir, kIndexSegmentBytes);
+        if (!fresh.open() || fresh.appendBatch(records) != records.size() || !fresh.sync()) {
+            fresh.close();
+            removeDirectory(nextDir);
+            return;
+        }
+    }
+
+    index_->close();
+    if (::rename(indexDir.c_str(), oldDir.c_str()) == 0 && ::rename(nextDir.c_str(), indexDir.c_str()) == 0) {
+        indexRecords_ = records.size();
+    } else if (!exists(indexDir)) {
+        // The first rename went through: put the old index back.
+        ::rename(oldDir.c_str(), indexDir.c_str());
+    }
+    removeDirectory(oldDir);
+    removeDirectory(nextDir);
+    if (!index_->open()) {
+        open_ = false;
+    }
+}
+
+} // namespace rejourney
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "SegmentedLog.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rejourney {
+
+/**
+ * Disk spool for uploads that could not be delivered yet.
+ *
+ * Each payload is written to its own file in the spool directory; an
+ * append-only index (a SegmentedLog in `index/`) records which payloads are
+ * pending, their kind, size, attempt count and an opaque caller-owned
+ * description. Only the index entries live in memory, and the byte budget
+ * bounds how many there can be, so memory does not grow with the time spent
+ * offline. On open() the index is replayed, payloads whose file is missing
+ * or the wrong size are dropped, and files the index does not know are
+ * deleted.
+ *
+ * When a put() would go over the byte budget, entries are evicted by kind in
+ * the order Frames, Hierarchy, Events, Crash, oldest first within a kind. An
+ * upload never evicts a kind ranked above its own; if that is not enough
+ * room, the put is refused.
+ *
+ * Index records ("A" add, "D" done, "F" failed attempt) accumulate until
+ * they outnumber live entries, then the index is rewritten into
+ * `index.next` and swapped in with two renames. Thread-safe.
+ */
+class UploadSpool {
+public:
+    /// Eviction order: lower kinds are dropped first.
+    enum class Kind : uint8_t { Frames = 0, Hierarchy = 1, Events = 2, Crash = 3 };
+
+    struct Options {
+        /// Applied on open() too, so a lowered budget trims an existing spool.
+        uint64_t byteBudget = 50ull * 1024 * 1024;
+        /// Failed attempts after which an entry is dropped.
+        uint32_t maxAttempts = 10;
+    };
+
+    struct Entry {
+        uint64_t id = 0;
+        Kind kind = Kind::Frames;
+        uint64_t bytes = 0;
+        uint32_t attempts = 0;
+        int64_t createdMs = 0;
+        std::string meta;
+    };
+
+    struct Stats {
+        size_t entries = 0;
+        uint64_t bytes = 0;
+        uint64_t evictedEntries = 0;
+        uint64_t evictedBytes = 0;
+        /// Entries dropped after maxAttempts failures.
+        uint64_t exhaustedEntries = 0;
+        /// Puts refused for lack of room.
+        uint64_t refusedPuts = 0;
+    };
+
+    UploadSpool(std::string directory, Options options);
+    ~UploadSpool();
+
+    UploadSpool(const UploadSpool &) = delete;
+    UploadSpool &operator=(const UploadSpool &) = delete;
+
+    /// Creates the directory if needed and recovers pending entries.
+    bool open();
+    void close();
+
+    /// Stores `payload` and returns its id, or 0 when it does not fit the
+    /// budget, the write failed, or the spool is not open.
+    uint64_t put(Kind kind, std::string_view meta, std::string_view payload, int64_t nowMs);
+
+    /// Up to `limit` pending entries of kind `lowest` or above, oldest
+    /// first, skipping `exclude` (ids the caller already has in flight).
+    std::vector<Entry> pending(size_t limit, const std::vector<uint64_t> &exclude = {},
+                               Kind lowest = Kind::Frames) const;
+
+    /// Reads the payload of a pending entry. False if it was evicted.
+    bool read(uint64_t id, std::string &payload) const;
+
+    /// The entry was delivered; forgets it and deletes its file.
+    void complete(uint64_t id);
+
+    /// A delivery attempt failed. Returns false when that was the last
+    /// attempt and the entry was dropped.
+    bool failed(uint64_t id);
+
+    Stats stats() const;
+
+private:
+    std::string payloadPath(uint64_t id) const;
+    bool appendIndexLocked(std::string_view record);
+    bool makeRoomLocked(Kind kind, uint64_t bytes);
+    void removeLocked(uint64_t id, bool writeIndex);
+    void maybeCompactLocked();
+
+    const std::string directory_;
+    const Options options_;
+
+    mutable std::mutex lock_;
+    bool open_ = false;
+    std::unique_ptr<SegmentedLog> index_;
+    std::map<uint64_t, Entry> entries_;
+    uint64_t nextId_ = 1;
+    size_t indexRecords_ = 0;
+    Stats stats_;
+};
+
+} // namespace rejourney
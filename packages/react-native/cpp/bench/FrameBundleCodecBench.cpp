@@ -0,0 +1,174 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares CPU time and output size of the frame bundle codecs on a corpus of
+// captured JPEG frames. Frames are read from $RJ_FRAME_CORPUS, or from the
+// dashboard demo sessions when unset:
+//   ./_gate_build/rejourney_core_bench --benchmark_filter=FrameBundle
+
+#include "FrameBundleWriter.h"
+
+#include <benchmark/benchmark.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using rejourney::FrameBundleWriter;
+
+namespace {
+
+constexpr size_t kBatchSize = 3;
+
+struct Corpus {
+    std::vector<std::string> frames;
+    size_t totalBytes = 0;
+};
+
+const Corpus &corpus() {
+    static const Corpus loaded = [] {
+        Corpus result;
+        const char *env = std::getenv("RJ_FRAME_CORPUS");
+        std::filesystem::path root = env ? env : REJOURNEY_FRAME_CORPUS_DIR;
+        std::error_code ec;
+        std::vector<std::filesystem::path> paths;
+        for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            auto ext = it->path().extension();
+            if (ext == ".jpg" || ext == ".jpeg") {
+                paths.push_back(it->path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        for (const auto &path : paths) {
+            std::ifstream in(path, std::ios::binary);
+            std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            result.totalBytes += data.size();
+            result.frames.push_back(std::move(data));
+        }
+        return result;
+    }();
+    return loaded;
+}
+
+/// `rawBytes` and `outBytes` cover one pass over the corpus.
+void reportSizes(benchmark::State &state, size_t rawBytes, size_t outBytes, size_t frames) {
+    state.SetBytesProcessed(static_cast<int64_t>(rawBytes) * state.iterations());
+    state.counters["ratio"] = rawBytes ? static_cast<double>(outBytes) / static_cast<double>(rawBytes) : 0;
+    state.counters["bytes_per_frame"] = static_cast<double>(outBytes) / static_cast<double>(frames);
+}
+
+void runWriter(benchmark::State &state, const FrameBundleWriter::Options &options) {
+    const Corpus &frames = corpus();
+    if (frames.frames.empty()) {
+        state.SkipWithError("no frames in corpus");
+        return;
+    }
+    FrameBundleWriter writer(options);
+    writer.reset(0);
+    size_t rawBytes = 0;
+    size_t outBytes = 0;
+    for (auto _ : state) {
+        rawBytes = 0;
+        outBytes = 0;
+        uint64_t ts = 0;
+        for (size_t i = 0; i < frames.frames.size(); ++i) {
+            const std::string &jpeg = frames.frames[i];
+            writer.append(reinterpret_cast<const uint8_t *>(jpeg.data()), jpeg.size(), ts += 1000);
+            if ((i + 1) % kBatchSize == 0 || i + 1 == frames.frames.size()) {
+                FrameBundleWriter::Bundle bundle;
+                writer.finish(bundle);
+                rawBytes += bundle.rawBytes;
+                outBytes += bundle.payload.size();
+                benchmark::DoNotOptimize(bundle.payload.data());
+            }
+        }
+    }
+    reportSizes(state, rawBytes, outBytes, frames.frames.size());
+}
+
+void BM_FrameBundleStored(benchmark::State &state) {
+    FrameBundleWriter::Options options;
+    options.adaptive = false;
+    options.codec = FrameBundleWriter::Codec::Stored;
+    runWriter(state, options);
+}
+
+void BM_FrameBundleDeflateFast(benchmark::State &state) {
+    FrameBundleWriter::Options options;
+    options.adaptive = false;
+    options.codec = FrameBundleWriter::Codec::DeflateFast;
+    runWriter(state, options);
+}
+
+void BM_FrameBundleDeflate(benchmark::State &state) {
+    FrameBundleWriter::Options options;
+    options.adaptive = false;
+    options.codec = FrameBundleWriter::Codec::Deflate;
+    runWriter(state, options);
+}
+
+void BM_FrameBundleAdaptive(benchmark::State &state) {
+    runWriter(state, FrameBundleWriter::Options());
+}
+
+/// The previous client behaviour: concatenate a batch, then gzip -9 it.
+void BM_FrameBundleLegacyGzip9(benchmark::State &state) {
+    const Corpus &frames = corpus();
+    if (frames.frames.empty()) {
+        state.SkipWithError("no frames in corpus");
+        return;
+    }
+    size_t rawBytes = 0;
+    size_t outBytes = 0;
+    for (auto _ : state) {
+        rawBytes = 0;
+        outBytes = 0;
+        for (size_t start = 0; start < frames.frames.size(); start += kBatchSize) {
+            std::string archive;
+            for (size_t i = start; i < std::min(start + kBatchSize, frames.frames.size()); ++i) {
+                archive.append(12, '\0');
+                archive += frames.frames[i];
+            }
+            z_stream zs{};
+            deflateInit2(&zs, 9, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+            std::string out(deflateBound(&zs, archive.size()), '\0');
+            zs.next_in = reinterpret_cast<Bytef *>(&archive[0]);
+            zs.avail_in = static_cast<uInt>(archive.size());
+            zs.next_out = reinterpret_cast<Bytef *>(&out[0]);
+            zs.avail_out = static_cast<uInt>(out.size());
+            deflate(&zs, Z_FINISH);
+            rawBytes += archive.size();
+            outBytes += zs.total_out;
+            deflateEnd(&zs);
+            benchmark::DoNotOptimize(out.data());
+        }
+    }
+    reportSizes(state, rawBytes, outBytes, frames.frames.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_FrameBundleStored)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FrameBundleDeflateFast)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FrameBundleDeflate)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FrameBundleAdaptive)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FrameBundleLegacyGzip9)->Unit(benchmark::kMillisecond);
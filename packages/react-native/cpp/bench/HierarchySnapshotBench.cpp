@@ -0,0 +1,99 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Time to build and serialize a snapshot of a synthetic screen, the part of a
+// hierarchy scan the native core owns, and to delta-encode it against the
+// previous scan:
+//   ./_gate_build/rejourney_core_bench --benchmark_filter=HierarchySnapshot
+
+#include "HierarchyDelta.h"
+#include "HierarchySnapshot.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using rejourney::HierarchyDeltaEncoder;
+using rejourney::HierarchySnapshotBuilder;
+
+namespace {
+
+const std::vector<std::string> &typeNames() {
+    static const std::vector<std::string> names = {
+        "UIView", "RCTViewComponentView", "RCTParagraphComponentView", "UILabel", "UIImageView",
+        "RCTScrollViewComponentView", "UIButton", "RCTTextInputComponentView",
+    };
+    return names;
+}
+
+void buildScreen(HierarchySnapshotBuilder &builder, int64_t views) {
+    builder.reset();
+    builder.setScreen(390, 844, 3, "Feed");
+    const auto &names = typeNames();
+    builder.addNode(-1, 1, "UIWindow", {0, 0, 390, 844}, 1, 0);
+    for (int64_t i = 1; i < views; ++i) {
+        // Roughly eight children per container, like a list of rows.
+        const auto parent = static_cast<int32_t>((i - 1) / 8);
+        const auto node = builder.addNode(parent, static_cast<uint64_t>(i + 1), names[i % names.size()],
+                                          {static_cast<float>(i % 390), static_cast<float>(i % 844), 120, 44}, 1,
+                                          HierarchySnapshotBuilder::Interactive);
+        if (i % 3 == 0) {
+            builder.setString(node, HierarchySnapshotBuilder::Attribute::Text, "Row title " + std::to_string(i % 40));
+            builder.setTextLength(node, 12);
+        }
+        if (i % 5 == 0) {
+            builder.setString(node, HierarchySnapshotBuilder::Attribute::TestId, "row-" + std::to_string(i));
+        }
+    }
+}
+
+void BM_HierarchySnapshot(benchmark::State &state) {
+    HierarchySnapshotBuilder builder;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        buildScreen(builder, state.range(0));
+        std::string payload = builder.serialize(0, 1);
+        bytes = payload.size();
+        benchmark::DoNotOptimize(payload);
+    }
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+/// Unchanged screen: the delta encoder hashes every node but the subtree
+/// check stops at the root.
+void BM_HierarchyDelta(benchmark::State &state) {
+    HierarchySnapshotBuilder builder;
+    HierarchyDeltaEncoder::Options options;
+    options.keyframeInterval = UINT32_MAX;
+    HierarchyDeltaEncoder encoder(options);
+    std::string payload;
+    buildScreen(builder, state.range(0));
+    encoder.encode(builder, 0, true, payload);
+    const size_t keyframeBytes = payload.size();
+    for (auto _ : state) {
+        buildScreen(builder, state.range(0));
+        encoder.encode(builder, 0, false, payload);
+        benchmark::DoNotOptimize(payload);
+    }
+    state.counters["keyframeBytes"] = static_cast<double>(keyframeBytes);
+    state.counters["bytes"] = static_cast<double>(payload.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_HierarchySnapshot)->Arg(200)->Arg(2000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_HierarchyDelta)->Arg(200)->Arg(2000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Time to resample a full-resolution capture (390x844 pt at 1 px per pt) to
+// the encoder's input size, by downscale factor x100 and filter:
+//   ./_gate_build/rejourney_core_bench --benchmark_filter=ImageScaler
+
+#include "ImageScaler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using rejourney::ImageScaler;
+
+namespace {
+
+constexpr size_t kWidth = 390;
+constexpr size_t kHeight = 844;
+
+void BM_ImageScaler(benchmark::State &state) {
+    const double factor = static_cast<double>(state.range(0)) / 100.0;
+    const auto filter = state.range(1) == 0 ? ImageScaler::Filter::Box : ImageScaler::Filter::Bilinear;
+    std::vector<uint8_t> src(kWidth * kHeight * 4);
+    std::mt19937 rng(7);
+    for (auto &p : src) {
+        p = static_cast<uint8_t>(rng());
+    }
+    const size_t dstWidth = static_cast<size_t>(kWidth / factor);
+    const size_t dstHeight = static_cast<size_t>(kHeight / factor);
+    std::vector<uint8_t> dst(dstWidth * dstHeight * 4);
+    ImageScaler scaler;
+    for (auto _ : state) {
+        scaler.scale(src.data(), kWidth, kHeight, kWidth * 4, dst.data(), dstWidth, dstHeight, dstWidth * 4, filter);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_ImageScaler)->Args({125, 0})->Args({200, 0})->Args({300, 0})->Args({125, 1})->Args({200, 1});
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Encode time per frame and output size of JpegEncoder on a corpus of
+// captured frames, decoded to BGRX once up front. Frames are read from
+// $RJ_FRAME_CORPUS, or from the dashboard demo sessions when unset:
+//   ./_gate_build/rejourney_core_bench --benchmark_filter=JpegEncoder
+
+#include "JpegEncoder.h"
+
+#if REJOURNEY_WITH_LIBJPEG
+
+#include <benchmark/benchmark.h>
+#include <jpeglib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using rejourney::JpegEncoder;
+
+namespace {
+
+struct Frame {
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+bool decodeBgrx(const std::string &jpeg, Frame &frame) {
+    jpeg_decompress_struct cinfo;
+    jpeg_error_mgr errors;
+    cinfo.err = jpeg_std_error(&errors);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, reinterpret_cast<const unsigned char *>(jpeg.data()), static_cast<unsigned long>(jpeg.size()));
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+    cinfo.out_color_space = JCS_EXT_BGRX;
+    jpeg_start_decompress(&cinfo);
+    frame.width = cinfo.output_width;
+    frame.height = cinfo.output_height;
+    frame.pixels.resize(frame.width * frame.height * 4);
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = frame.pixels.data() + static_cast<size_t>(cinfo.output_scanline) * frame.width * 4;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+
+const std::vector<Frame> &corpus() {
+    static const std::vector<Frame> loaded = [] {
+        std::vector<Frame> frames;
+        const char *env = std::getenv("RJ_FRAME_CORPUS");
+        std::filesystem::path root = env ? env : REJOURNEY_FRAME_CORPUS_DIR;
+        std::error_code ec;
+        std::vector<std::filesystem::path> paths;
+        for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            auto ext = it->path().extension();
+            if (ext == ".jpg" || ext == ".jpeg") {
+                paths.push_back(it->path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        for (const auto &path : paths) {
+            std::ifstream in(path, std::ios::binary);
+            std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            Frame frame;
+            if (decodeBgrx(data, frame)) {
+                frames.push_back(std::move(frame));
+            }
+        }
+        return frames;
+    }();
+    return loaded;
+}
+
+void runEncoder(benchmark::State &state, const JpegEncoder::Options &options) {
+    const auto &frames = corpus();
+    if (frames.empty()) {
+        state.SkipWithError("no frames in corpus");
+        return;
+    }
+    JpegEncoder encoder;
+    size_t outBytes = 0;
+    for (auto _ : state) {
+        outBytes = 0;
+        for (const Frame &frame : frames) {
+            encoder.encode(frame.pixels.data(), frame.width, frame.height, frame.width * 4,
+                           JpegEncoder::PixelFormat::BGRX, options);
+            outBytes += encoder.output().size();
+            benchmark::DoNotOptimize(encoder.output().data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(frames.size()) * state.iterations());
+    state.counters["time_per_frame"] =
+        benchmark::Counter(static_cast<double>(frames.size()),
+                           benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["bytes_per_frame"] = static_cast<double>(outBytes) / static_cast<double>(frames.size());
+}
+
+void BM_JpegEncoder420(benchmark::State &state) {
+    JpegEncoder::Options options;
+    runEncoder(state, options);
+}
+
+void BM_JpegEncoder444(benchmark::State &state) {
+    JpegEncoder::Options options;
+    options.subsampling = JpegEncoder::Subsampling::S444;
+    runEncoder(state, options);
+}
+
+void BM_JpegEncoder420Optimized(benchmark::State &state) {
+    JpegEncoder::Options options;
+    options.optimizeHuffman = true;
+    runEncoder(state, options);
+}
+
+} // namespace
+
+BENCHMARK(BM_JpegEncoder420)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JpegEncoder444)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JpegEncoder420Optimized)->Unit(benchmark::kMillisecond);
+
+#endif // REJOURNEY_WITH_LIBJPEG
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Time to paint the masks of synthetic screens into a capture-sized bitmap,
+// against filling every region on its own the way a draw call per region
+// does:
+//   ./_gate_build/rejourney_core_bench --benchmark_filter=Redaction
+
+#include "RedactionCompositor.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using rejourney::RedactionCompositor;
+
+namespace {
+
+// 390x844 pt at the default 1.25 capture scale.
+constexpr size_t kWidth = 312;
+constexpr size_t kHeight = 676;
+constexpr uint32_t kMask = 0xFFFFFFFFu;
+
+struct Region {
+    float x, y, width, height;
+};
+
+/// 0: payment form, each field masked along with the card block around it.
+/// 1: chat or gallery, a grid of adjacent image tiles plus overlapping
+///    bubbles.
+std::vector<Region> screen(int64_t kind, int64_t count) {
+    std::vector<Region> regions;
+    for (int64_t i = 0; i < count; ++i) {
+        if (kind == 0) {
+            const float y = 40.0f + static_cast<float>(i % 12) * 52.0f;
+            regions.push_back({16, y - 4, 280, 48});
+            regions.push_back({24, y, 264, 40});
+            regions.push_back({28, y + 4, 120, 16});
+        } else {
+            const float x = static_cast<float>(i % 4) * 78.0f;
+            const float y = static_cast<float>((i / 4) % 9) * 75.0f;
+            regions.push_back({x, y, 78, 75});
+            regions.push_back({x + 10, y + 20, 120, 30});
+        }
+    }
+    return regions;
+}
+
+void BM_RedactionCompositor(benchmark::State &state) {
+    const auto regions = screen(state.range(0), state.range(1));
+    std::vector<uint8_t> pixels(kWidth * kHeight * 4);
+    RedactionCompositor compositor;
+    size_t rects = 0;
+    for (auto _ : state) {
+        compositor.reset();
+        for (const Region &r : regions) {
+            compositor.add(r.x, r.y, r.width, r.height);
+        }
+        rects = compositor.paint(pixels.data(), kWidth, kHeight, kWidth * 4, kMask);
+        benchmark::ClobberMemory();
+    }
+    state.counters["regions"] = static_cast<double>(regions.size());
+    state.counters["rects"] = static_cast<double>(rects);
+}
+
+/// One fill per region, overlaps painted again.
+void BM_RedactionPerRegion(benchmark::State &state) {
+    const auto regions = screen(state.range(0), state.range(1));
+    std::vector<uint8_t> pixels(kWidth * kHeight * 4);
+    for (auto _ : state) {
+        for (const Region &r : regions) {
+            const size_t x0 = static_cast<size_t>(std::max(0.0f, r.x));
+            const size_t y0 = static_cast<size_t>(std::max(0.0f, r.y));
+            const size_t x1 = std::min(kWidth, static_cast<size_t>(r.x + r.width));
+            const size_t y1 = std::min(kHeight, static_cast<size_t>(r.y + r.height));
+            for (size_t y = y0; y < y1; ++y) {
+                auto *row = reinterpret_cast<uint32_t *>(pixels.data() + y * kWidth * 4);
+                std::fill(row + x0, row + std::max(x0, x1), kMask);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.counters["regions"] = static_cast<double>(regions.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_RedactionCompositor)->Args({0, 12})->Args({0, 48})->Args({1, 36})->Args({1, 144});
+BENCHMARK(BM_RedactionPerRegion)->Args({0, 12})->Args({0, 48})->Args({1, 36})->Args({1, 144});
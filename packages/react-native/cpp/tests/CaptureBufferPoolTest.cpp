@@ -0,0 +1,119 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CaptureBufferPool.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using rejourney::CaptureBufferPool;
+
+TEST(CaptureBufferPoolTest, ReleasedBuffersAreReused) {
+    CaptureBufferPool pool(4);
+    uint8_t *first = nullptr;
+    for (int frame = 0; frame < 10; ++frame) {
+        auto lease = pool.acquire(390, 844);
+        ASSERT_TRUE(lease);
+        if (!first) {
+            first = lease->pixels;
+        }
+        EXPECT_EQ(lease->pixels, first);
+        EXPECT_EQ(lease->width, 390u);
+        EXPECT_EQ(lease->height, 844u);
+        EXPECT_EQ(lease->bytesPerRow % 64, 0u);
+        EXPECT_GE(lease->bytesPerRow, 390u * 4);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(lease->pixels) % 64, 0u);
+        std::memset(lease->pixels, frame, lease->bytesPerRow * lease->height);
+    }
+    const auto stats = pool.stats();
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.outstanding, 0u);
+    EXPECT_EQ(stats.idle, 1u);
+}
+
+TEST(CaptureBufferPoolTest, CapacityBoundsBuffersOut) {
+    CaptureBufferPool pool(2);
+    auto a = pool.acquire(10, 10);
+    auto b = pool.acquire(10, 10);
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    EXPECT_NE(a->pixels, b->pixels);
+    EXPECT_FALSE(pool.acquire(10, 10));
+    EXPECT_EQ(pool.stats().exhausted, 1u);
+    EXPECT_EQ(pool.stats().outstanding, 2u);
+
+    { auto released = std::move(a); }
+    EXPECT_TRUE(pool.acquire(10, 10));
+
+    pool.setCapacity(3);
+    EXPECT_EQ(pool.capacity(), 3u);
+    auto c = pool.acquire(10, 10);
+    EXPECT_TRUE(c);
+    EXPECT_FALSE(pool.acquire(0, 10));
+}
+
+TEST(CaptureBufferPoolTest, OnlyGrowingAllocates) {
+    CaptureBufferPool pool(2);
+    { auto lease = pool.acquire(390, 844); }
+    { auto lease = pool.acquire(844, 390); }
+    { auto lease = pool.acquire(100, 100); }
+    EXPECT_EQ(pool.stats().allocations, 1u);
+    { auto lease = pool.acquire(1024, 1366); }
+    EXPECT_EQ(pool.stats().allocations, 2u);
+}
+
+TEST(CaptureBufferPoolTest, KeepsAtMostMaxIdle) {
+    CaptureBufferPool pool(8, 2);
+    {
+        std::vector<CaptureBufferPool::Lease> leases;
+        for (int i = 0; i < 5; ++i) {
+            leases.push_back(pool.acquire(16, 16));
+        }
+    }
+    EXPECT_EQ(pool.stats().idle, 2u);
+    EXPECT_EQ(pool.stats().outstanding, 0u);
+}
+
+TEST(CaptureBufferPoolTest, BuffersCanBeReleasedOnAnotherThread) {
+    CaptureBufferPool pool(3, 3);
+    std::vector<std::thread> encoders;
+    int captured = 0;
+    for (int frame = 0; frame < 200; ++frame) {
+        auto lease = pool.acquire(64, 64);
+        if (!lease) {
+            continue;
+        }
+        ++captured;
+        encoders.emplace_back([lease = std::move(lease)]() mutable { std::memset(lease->pixels, 1, 64 * 4); });
+        if (encoders.size() == 3) {
+            for (auto &t : encoders) {
+                t.join();
+            }
+            encoders.clear();
+        }
+    }
+    for (auto &t : encoders) {
+        t.join();
+    }
+    EXPECT_EQ(captured, 200);
+    EXPECT_EQ(pool.stats().outstanding, 0u);
+    EXPECT_LE(pool.stats().allocations, 3u);
+}
@@ -0,0 +1,210 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CaptureScheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using rejourney::CaptureScheduler;
+using Importance = CaptureScheduler::Importance;
+
+namespace {
+
+enum class Kind { Tap, Screen, Low, Medium, High, Critical };
+
+struct Signal {
+    uint64_t ms;
+    Kind kind;
+};
+
+struct Frame {
+    uint64_t ms;
+    bool forced;
+};
+
+/// Drives the scheduler like a one-shot timer would, from 0 to `endMs`.
+std::vector<Frame> run(CaptureScheduler &scheduler, const std::vector<Signal> &signals, uint64_t endMs,
+                       float costMs = 10) {
+    std::vector<Frame> frames;
+    scheduler.start(0);
+    size_t next = 0;
+    uint64_t now = 0;
+    while (now <= endMs) {
+        for (; next < signals.size() && signals[next].ms <= now; ++next) {
+            switch (signals[next].kind) {
+            case Kind::Tap:
+                scheduler.onInteraction(now);
+                break;
+            case Kind::Screen:
+                scheduler.onScreenChange(now);
+                break;
+            case Kind::Low:
+                scheduler.onVisualChange(Importance::Low, now);
+                break;
+            case Kind::Medium:
+                scheduler.onVisualChange(Importance::Medium, now);
+                break;
+            case Kind::High:
+                scheduler.onVisualChange(Importance::High, now);
+                break;
+            case Kind::Critical:
+                scheduler.onVisualChange(Importance::Critical, now);
+                break;
+            }
+        }
+        const auto decision = scheduler.poll(now);
+        if (decision.capture) {
+            frames.push_back({now, decision.forced});
+            scheduler.reportFrameCost(costMs);
+        }
+        uint64_t wake = decision.nextMs;
+        if (next < signals.size()) {
+            wake = std::min(wake, signals[next].ms);
+        }
+        now = std::max(now + 1, wake);
+    }
+    return frames;
+}
+
+std::vector<Signal> every(uint64_t fromMs, uint64_t toMs, uint64_t stepMs, Kind kind) {
+    std::vector<Signal> signals;
+    for (uint64_t ms = fromMs; ms < toMs; ms += stepMs) {
+        signals.push_back({ms, kind});
+    }
+    return signals;
+}
+
+const Frame *firstFrameAtOrAfter(const std::vector<Frame> &frames, uint64_t ms) {
+    for (const auto &f : frames) {
+        if (f.ms >= ms) {
+            return &f;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(CaptureSchedulerTest, IdleSessionBacksOffToHeartbeat) {
+    CaptureScheduler scheduler;
+    const auto frames = run(scheduler, {}, 60000);
+    ASSERT_GE(frames.size(), 2u);
+    EXPECT_EQ(frames[0].ms, 0u);
+    EXPECT_TRUE(frames[0].forced);
+    // The session start counts as activity, then the heartbeat takes over.
+    EXPECT_EQ(frames[1].ms, 1000u);
+    for (size_t i = 1; i < frames.size(); ++i) {
+        const uint64_t gap = frames[i].ms - frames[i - 1].ms;
+        EXPECT_EQ(gap, frames[i].ms <= 3000 ? 1000u : 5000u) << frames[i].ms;
+    }
+    EXPECT_LE(frames.size(), 16u);
+}
+
+TEST(CaptureSchedulerTest, InteractionIsCapturedShortlyAfterwards) {
+    CaptureScheduler scheduler;
+    const auto frames = run(scheduler, {{20000, Kind::Tap}}, 30000);
+    const Frame *frame = firstFrameAtOrAfter(frames, 20000);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->ms, 20080u);
+    EXPECT_FALSE(frame->forced);
+    // Activity brings back the active cadence.
+    const Frame *following = firstFrameAtOrAfter(frames, 20081);
+    ASSERT_NE(following, nullptr);
+    EXPECT_EQ(following->ms, 21080u);
+}
+
+TEST(CaptureSchedulerTest, ScreenChangeWaitsForTheTransition) {
+    CaptureScheduler scheduler;
+    const auto frames = run(scheduler, {{30000, Kind::Screen}}, 32000);
+    const Frame *frame = firstFrameAtOrAfter(frames, 30000);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->ms, 30350u);
+}
+
+TEST(CaptureSchedulerTest, BudgetHoldsUnderContinuousActivity) {
+    CaptureScheduler scheduler;
+    const auto frames = run(scheduler, every(0, 120000, 50, Kind::Tap), 120000);
+    // Two minutes at 60 frames per minute plus one full bucket.
+    EXPECT_LE(frames.size(), 120u + 8u + 1u);
+    EXPECT_GE(frames.size(), 110u);
+    for (size_t i = 1; i < frames.size(); ++i) {
+        EXPECT_GE(frames[i].ms - frames[i - 1].ms, 100u);
+    }
+}
+
+TEST(CaptureSchedulerTest, FrameCostStretchesTheMinimumInterval) {
+    CaptureScheduler::Options options;
+    options.framesPerMinute = 6000;
+    CaptureScheduler scheduler(options);
+    const auto frames = run(scheduler, every(0, 10000, 20, Kind::Tap), 10000, 50);
+    ASSERT_GE(frames.size(), 10u);
+    for (size_t i = 2; i < frames.size(); ++i) {
+        EXPECT_GE(frames[i].ms - frames[i - 1].ms, 500u);
+    }
+    EXPECT_FLOAT_EQ(scheduler.averageFrameCostMs(), 50);
+}
+
+TEST(CaptureSchedulerTest, CriticalChangesBypassTheLimits) {
+    CaptureScheduler scheduler;
+    // Drain the bucket, then ask for critical frames back to back.
+    std::vector<Signal> signals = every(0, 2000, 50, Kind::Tap);
+    signals.push_back({2000, Kind::Critical});
+    signals.push_back({2010, Kind::Critical});
+    signals.push_back({2020, Kind::High});
+    const auto frames = run(scheduler, signals, 4000);
+    const Frame *first = firstFrameAtOrAfter(frames, 2000);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->ms, 2000u);
+    EXPECT_TRUE(first->forced);
+    const Frame *second = firstFrameAtOrAfter(frames, 2001);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second->ms, 2010u);
+    // High is forced too but waits for the minimum interval and a token.
+    const Frame *third = firstFrameAtOrAfter(frames, 2011);
+    ASSERT_NE(third, nullptr);
+    EXPECT_GE(third->ms, 2110u);
+    EXPECT_TRUE(third->forced);
+}
+
+TEST(CaptureSchedulerTest, LowImportanceDoesNotOpenTheActiveWindow) {
+    CaptureScheduler scheduler;
+    const auto frames = run(scheduler, {{20000, Kind::Low}}, 30000);
+    const Frame *frame = firstFrameAtOrAfter(frames, 20000);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_LE(frame->ms, 21000u);
+    const Frame *following = firstFrameAtOrAfter(frames, frame->ms + 1);
+    ASSERT_NE(following, nullptr);
+    EXPECT_EQ(following->ms, frame->ms + 5000);
+}
+
+TEST(CaptureSchedulerTest, GestureGetsOnsetAndRestingFrames) {
+    CaptureScheduler scheduler;
+    const auto frames = run(scheduler, every(20000, 22000, 50, Kind::Tap), 24000);
+    const Frame *onset = firstFrameAtOrAfter(frames, 20000);
+    ASSERT_NE(onset, nullptr);
+    EXPECT_EQ(onset->ms, 20080u);
+    size_t during = 0;
+    for (const auto &f : frames) {
+        during += f.ms > 20080 && f.ms < 22000;
+    }
+    EXPECT_EQ(during, 1u);
+    // 300 ms after the last touch at 21950.
+    EXPECT_TRUE(std::any_of(frames.begin(), frames.end(), [](const Frame &f) { return f.ms == 22250; }));
+}
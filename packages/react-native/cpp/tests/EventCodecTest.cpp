@@ -0,0 +1,265 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EventCodec.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+using namespace rejourney;
+
+namespace {
+
+// Minimal reader over a batch, enough to check the layout the backend decodes.
+struct BatchReader {
+    std::string_view in;
+    size_t pos = 0;
+    std::vector<std::string> dictionary;
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        EXPECT_TRUE(readVarint(in, pos, value));
+        return value;
+    }
+
+    std::string bytes(size_t length) {
+        std::string out(in.substr(pos, length));
+        pos += length;
+        return out;
+    }
+
+    std::string stringRef() {
+        uint64_t ref = varint();
+        if (ref & 1) {
+            return bytes(ref >> 1);
+        }
+        return dictionary.at(ref >> 1);
+    }
+
+    ValueTag tag() { return static_cast<ValueTag>(in[pos++]); }
+};
+
+} // namespace
+
+TEST(EventCodecTest, VarintRoundTrips) {
+    for (uint64_t value : {0ull, 1ull, 127ull, 128ull, 300ull, 1700000000000ull, ~0ull}) {
+        std::string out;
+        appendVarint(out, value);
+        size_t pos = 0;
+        uint64_t decoded = 0;
+        ASSERT_TRUE(readVarint(out, pos, decoded));
+        EXPECT_EQ(decoded, value);
+        EXPECT_EQ(pos, out.size());
+    }
+    for (int64_t value : std::initializer_list<int64_t>{0, -1, 1, -64, 64, INT64_MIN, INT64_MAX}) {
+        EXPECT_EQ(zigzagDecode(zigzagEncode(value)), value);
+    }
+}
+
+TEST(EventCodecTest, TruncatedVarintFails) {
+    std::string out;
+    appendVarint(out, 1u << 20);
+    out.pop_back();
+    size_t pos = 0;
+    uint64_t value = 0;
+    EXPECT_FALSE(readVarint(out, pos, value));
+}
+
+TEST(EventCodecTest, BatchRoundTripsRecords) {
+    EventEncoder encoder(1'700'000'000'000);
+
+    int64_t ts = 1'700'000'000'250;
+    std::string_view type = "tap";
+    auto writer = encoder.beginRecord(&ts, &type, 4);
+    writer.key("label");
+    writer.stringValue("Buy");
+    writer.key("x");
+    writer.intValue(-12);
+    writer.key("ratio");
+    writer.doubleValue(0.5);
+    writer.key("touches");
+    writer.beginArray(2);
+    writer.beginObject(1);
+    writer.key("ok");
+    writer.boolValue(true);
+    writer.nullValue();
+    std::string first = writer.finish();
+
+    auto second = encoder.beginRecord(nullptr, nullptr, 0).finish();
+
+    std::string batch = encoder.buildBatch({first, second}, "{\"platform\":\"ios\"}");
+
+    BatchReader r{batch};
+    ASSERT_EQ(r.bytes(4), "RJEB");
+    EXPECT_EQ(static_cast<uint8_t>(r.bytes(1)[0]), kEventBatchVersion);
+    EXPECT_EQ(r.varint(), 1'700'000'000'000ull);
+    EXPECT_EQ(r.bytes(r.varint()), "{\"platform\":\"ios\"}");
+    uint64_t dictCount = r.varint();
+    for (uint64_t i = 0; i < dictCount; ++i) {
+        r.dictionary.push_back(r.bytes(r.varint()));
+    }
+    EXPECT_EQ(dictCount, encoder.dictionarySize());
+    ASSERT_EQ(r.varint(), 2u);
+
+    EXPECT_EQ(static_cast<uint8_t>(r.bytes(1)[0]), kRecordHasTimestamp | kRecordHasType);
+    EXPECT_EQ(zigzagDecode(r.varint()), 250);
+    EXPECT_EQ(r.stringRef(), "tap");
+    ASSERT_EQ(r.varint(), 4u);
+
+    EXPECT_EQ(r.stringRef(), "label");
+    ASSERT_EQ(r.tag(), ValueTag::String);
+    EXPECT_EQ(r.stringRef(), "Buy");
+
+    EXPECT_EQ(r.stringRef(), "x");
+    ASSERT_EQ(r.tag(), ValueTag::Int);
+    EXPECT_EQ(zigzagDecode(r.varint()), -12);
+
+    EXPECT_EQ(r.stringRef(), "ratio");
+    ASSERT_EQ(r.tag(), ValueTag::Double);
+    std::string raw = r.bytes(8);
+    double ratio = 0;
+    std::memcpy(&ratio, raw.data(), sizeof(ratio));
+    EXPECT_EQ(ratio, 0.5);
+
+    EXPECT_EQ(r.stringRef(), "touches");
+    ASSERT_EQ(r.tag(), ValueTag::Array);
+    ASSERT_EQ(r.varint(), 2u);
+    ASSERT_EQ(r.tag(), ValueTag::Object);
+    ASSERT_EQ(r.varint(), 1u);
+    EXPECT_EQ(r.stringRef(), "ok");
+    EXPECT_EQ(r.tag(), ValueTag::True);
+    EXPECT_EQ(r.tag(), ValueTag::Null);
+
+    EXPECT_EQ(static_cast<uint8_t>(r.bytes(1)[0]), 0);
+    EXPECT_EQ(r.varint(), 0u);
+    EXPECT_EQ(r.pos, batch.size());
+}
+
+TEST(EventCodecTest, RepeatedStringsAreInternedOnce) {
+    EventEncoder encoder(0);
+    int64_t ts = 10;
+    std::string_view type = "scroll";
+    std::string a, b;
+    {
+        auto w = encoder.beginRecord(&ts, &type, 1);
+        w.key("direction");
+        w.stringValue("down");
+        a = w.finish();
+    }
+    {
+        auto w = encoder.beginRecord(&ts, &type, 1);
+        w.key("direction");
+        w.stringValue("down");
+        b = w.finish();
+    }
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(encoder.dictionarySize(), 3u);
+    // flags + ts + three single-byte refs + field count + tag
+    EXPECT_EQ(a.size(), 7u);
+}
+
+TEST(EventCodecTest, LongStringsAndFullDictionaryFallBackToInline) {
+    EventEncoder encoder(0, 2, 8);
+    std::string longValue(64, 'u');
+    auto w = encoder.beginRecord(nullptr, nullptr, 2);
+    w.key("url");
+    w.stringValue(longValue);
+    w.key("method");
+    w.stringValue("GET");
+    std::string record = w.finish();
+    EXPECT_EQ(encoder.dictionarySize(), 2u); // "url", "method"; "GET" no longer fits
+
+    std::string batch = encoder.buildBatch({record}, "{}");
+    BatchReader r{batch};
+    r.pos = 5;
+    r.varint();
+    r.bytes(r.varint());
+    uint64_t dictCount = r.varint();
+    for (uint64_t i = 0; i < dictCount; ++i) {
+        r.dictionary.push_back(r.bytes(r.varint()));
+    }
+    ASSERT_EQ(r.varint(), 1u);
+    r.bytes(1);
+    ASSERT_EQ(r.varint(), 2u);
+    EXPECT_EQ(r.stringRef(), "url");
+    ASSERT_EQ(r.tag(), ValueTag::String);
+    EXPECT_EQ(r.stringRef(), longValue);
+    EXPECT_EQ(r.stringRef(), "method");
+    ASSERT_EQ(r.tag(), ValueTag::String);
+    EXPECT_EQ(r.stringRef(), "GET");
+}
+
+TEST(EventCodecTest, BatchCarriesOnlyTheEntriesItsRecordsUse) {
+    EventEncoder encoder(0);
+    std::string_view type = "network";
+    auto record = [&](const std::string &id) {
+        auto w = encoder.beginRecord(nullptr, &type, 1);
+        w.key("requestId");
+        w.stringValue(id);
+        return w.finish();
+    };
+    const std::string firstRecord = record("req-0");
+    const std::string firstBatch = encoder.buildBatch({firstRecord}, "{}");
+
+    // Many unrelated ids interned since do not reach a later batch.
+    for (int i = 1; i < 1000; ++i) {
+        record("req-" + std::to_string(i));
+    }
+    EXPECT_EQ(encoder.dictionarySize(), 1002u);
+    const std::string lastRecord = record("req-last");
+    const std::string lastBatch = encoder.buildBatch({lastRecord}, "{}");
+    EXPECT_LE(lastBatch.size(), firstBatch.size() + 8);
+
+    BatchReader r{lastBatch};
+    r.pos = 5;
+    r.varint();
+    r.bytes(r.varint());
+    ASSERT_EQ(r.varint(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        r.dictionary.push_back(r.bytes(r.varint()));
+    }
+    ASSERT_EQ(r.varint(), 1u);
+    EXPECT_EQ(static_cast<uint8_t>(r.bytes(1)[0]), kRecordHasType);
+    EXPECT_EQ(r.stringRef(), "network");
+    ASSERT_EQ(r.varint(), 1u);
+    EXPECT_EQ(r.stringRef(), "requestId");
+    ASSERT_EQ(r.tag(), ValueTag::String);
+    EXPECT_EQ(r.stringRef(), "req-last");
+    EXPECT_EQ(r.pos, lastBatch.size());
+}
+
+TEST(EventCodecTest, MalformedRecordsAreLeftOutOfTheBatch) {
+    EventEncoder encoder(0);
+    auto w = encoder.beginRecord(nullptr, nullptr, 1);
+    w.key("ok");
+    w.boolValue(true);
+    const std::string good = w.finish();
+    std::string truncated = good.substr(0, good.size() - 1);
+    const std::string dangling = std::string("\x00\x01\x7e\x00", 4); // ref to entry 63
+
+    const std::string batch = encoder.buildBatch({truncated, good, dangling}, "{}");
+    BatchReader r{batch};
+    r.pos = 5;
+    r.varint();
+    r.bytes(r.varint());
+    ASSERT_EQ(r.varint(), 1u);
+    r.dictionary.push_back(r.bytes(r.varint()));
+    ASSERT_EQ(r.varint(), 1u);
+    EXPECT_EQ(batch.substr(r.pos), good);
+}
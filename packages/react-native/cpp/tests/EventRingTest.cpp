@@ -0,0 +1,189 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EventRing.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+using rejourney::EventRing;
+using rejourney::MpscRing;
+
+TEST(MpscRingTest, PopsInFifoOrder) {
+    MpscRing<int> ring(4);
+    ring.push(1);
+    ring.push(2);
+    ring.push(3);
+
+    int value = 0;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST(MpscRingTest, OverwritesOldestWhenFull) {
+    MpscRing<int> ring(3);
+    EXPECT_FALSE(ring.push(1));
+    EXPECT_FALSE(ring.push(2));
+    EXPECT_FALSE(ring.push(3));
+    EXPECT_TRUE(ring.push(4));
+    EXPECT_EQ(ring.size(), 3u);
+    EXPECT_EQ(ring.dropped(), 1u);
+
+    int value = 0;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 2);
+}
+
+TEST(MpscRingTest, WrapsAroundManyTimes) {
+    MpscRing<int> ring(5);
+    int value = 0;
+    for (int i = 0; i < 1000; ++i) {
+        ring.push(i);
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(EventRingTest, DrainRespectsByteBudget) {
+    EventRing ring(16);
+    ring.push(std::string(40, 'a'));
+    ring.push(std::string(40, 'b'));
+    ring.push(std::string(40, 'c'));
+
+    auto first = ring.drain(100);
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first[0][0], 'a');
+    EXPECT_EQ(first[1][0], 'b');
+    EXPECT_EQ(ring.size(), 1u);
+
+    auto second = ring.drain(100);
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(second[0][0], 'c');
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(EventRingTest, OversizedEventStillDrains) {
+    EventRing ring(4);
+    ring.push(std::string(500, 'x'));
+    ring.push("small");
+
+    auto batch = ring.drain(100);
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch[0].size(), 500u);
+
+    batch = ring.drain(100);
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch[0], "small");
+}
+
+TEST(EventRingTest, CarriedEventKeepsOrderAheadOfNewPushes) {
+    EventRing ring(8);
+    ring.push(std::string(60, '1'));
+    ring.push(std::string(60, '2'));
+    ASSERT_EQ(ring.drain(100).size(), 1u);
+
+    ring.push(std::string(10, '3'));
+    auto batch = ring.drain(100);
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0][0], '2');
+    EXPECT_EQ(batch[1][0], '3');
+}
+
+TEST(EventRingTest, ClearCountsCarriedEvent) {
+    EventRing ring(8);
+    ring.push(std::string(60, 'a'));
+    ring.push(std::string(60, 'b'));
+    ring.push(std::string(60, 'c'));
+    ring.drain(100);
+
+    EXPECT_EQ(ring.clear(), 2u);
+    EXPECT_EQ(ring.size(), 0u);
+    EXPECT_TRUE(ring.drain(100).empty());
+}
+
+TEST(EventRingTest, ConcurrentProducersLoseNothingBelowCapacity) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 2000;
+    EventRing ring(kProducers * kPerProducer);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                ring.push(std::to_string(p) + ":" + std::to_string(i));
+            }
+        });
+    }
+
+    for (auto &t : producers) t.join();
+
+    std::vector<std::string> received;
+    for (auto batch = ring.drain(4096); !batch.empty(); batch = ring.drain(4096)) {
+        received.insert(received.end(), batch.begin(), batch.end());
+    }
+
+    std::set<std::string> unique(received.begin(), received.end());
+    EXPECT_EQ(unique.size(), static_cast<size_t>(kProducers * kPerProducer));
+    EXPECT_EQ(ring.evicted(), 0u);
+}
+
+TEST(EventRingTest, ConcurrentOverflowKeepsPerProducerOrder) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+    EventRing ring(64);
+
+    std::atomic<bool> stop{false};
+    std::vector<std::string> received;
+    std::thread consumer([&] {
+        while (!stop.load()) {
+            auto batch = ring.drain(512);
+            received.insert(received.end(), batch.begin(), batch.end());
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                ring.push(std::to_string(p) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto &t : producers) t.join();
+    stop.store(true);
+    consumer.join();
+    auto rest = ring.drain(SIZE_MAX);
+    received.insert(received.end(), rest.begin(), rest.end());
+
+    std::vector<int> last(kProducers, -1);
+    for (const auto &record : received) {
+        auto sep = record.find(':');
+        int producer = std::stoi(record.substr(0, sep));
+        int seq = std::stoi(record.substr(sep + 1));
+        EXPECT_GT(seq, last[producer]);
+        last[producer] = seq;
+    }
+    EXPECT_EQ(received.size() + ring.evicted(), static_cast<size_t>(kProducers * kPerProducer));
+}
@@ -0,0 +1,349 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameBundleWriter.h"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <string>
+#include <vector>
+
+using rejourney::FrameBundleWriter;
+
+namespace {
+
+struct Frame {
+    uint64_t offsetMs;
+    std::string jpeg;
+};
+
+std::string gunzip(const std::string &payload) {
+    z_stream zs{};
+    EXPECT_EQ(inflateInit2(&zs, MAX_WBITS + 16), Z_OK);
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(payload.data()));
+    zs.avail_in = static_cast<uInt>(payload.size());
+    std::string out;
+    char chunk[4096];
+    int rc;
+    do {
+        zs.next_out = reinterpret_cast<Bytef *>(chunk);
+        zs.avail_out = sizeof(chunk);
+        rc = inflate(&zs, Z_NO_FLUSH);
+        out.append(chunk, sizeof(chunk) - zs.avail_out);
+    } while (rc == Z_OK);
+    EXPECT_EQ(rc, Z_STREAM_END);
+    inflateEnd(&zs);
+    return out;
+}
+
+/// Size of the header including the quality table.
+size_t headerSize(const std::string &payload) {
+    EXPECT_GE(payload.size(), FrameBundleWriter::kHeaderSize + 2);
+    const size_t frames = static_cast<uint8_t>(payload[6]) << 8 | static_cast<uint8_t>(payload[7]);
+    return FrameBundleWriter::kHeaderSize + 2 + frames;
+}
+
+std::vector<uint8_t> qualities(const std::string &payload) {
+    return std::vector<uint8_t>(payload.begin() + FrameBundleWriter::kHeaderSize + 2,
+                                payload.begin() + headerSize(payload));
+}
+
+/// Strips the bundle header and returns the uncompressed frames.
+std::string decodeBundle(const std::string &payload) {
+    EXPECT_EQ(payload.compare(0, 4, "RJFB"), 0);
+    EXPECT_EQ(static_cast<uint8_t>(payload[4]), FrameBundleWriter::kFormatVersion);
+    std::string body = payload.substr(headerSize(payload));
+    if (static_cast<FrameBundleWriter::Codec>(payload[5]) == FrameBundleWriter::Codec::Stored) {
+        return body;
+    }
+    return gunzip(body);
+}
+
+std::vector<Frame> parseBundle(const std::string &raw) {
+    std::vector<Frame> frames;
+    size_t pos = 0;
+    while (pos + 12 <= raw.size()) {
+        uint64_t offset = 0;
+        for (int i = 0; i < 8; ++i) {
+            offset = (offset << 8) | static_cast<uint8_t>(raw[pos + i]);
+        }
+        uint32_t length = 0;
+        for (int i = 8; i < 12; ++i) {
+            length = (length << 8) | static_cast<uint8_t>(raw[pos + i]);
+        }
+        pos += 12;
+        frames.push_back({offset, raw.substr(pos, length)});
+        pos += length;
+    }
+    EXPECT_EQ(pos, raw.size());
+    return frames;
+}
+
+std::string fakeJpeg(char fill, size_t length) {
+    std::string jpeg(length, fill);
+    jpeg[0] = static_cast<char>(0xFF);
+    jpeg[1] = static_cast<char>(0xD8);
+    return jpeg;
+}
+
+/// Stands in for entropy-coded scan data, which deflate cannot shrink.
+std::string noisyJpeg(size_t length, uint32_t seed) {
+    std::string jpeg(length, '\0');
+    uint32_t state = seed;
+    for (auto &byte : jpeg) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<char>(state >> 24);
+    }
+    jpeg[0] = static_cast<char>(0xFF);
+    jpeg[1] = static_cast<char>(0xD8);
+    return jpeg;
+}
+
+bool append(FrameBundleWriter &writer, const std::string &jpeg, uint64_t timestampMs) {
+    return writer.append(reinterpret_cast<const uint8_t *>(jpeg.data()), jpeg.size(), timestampMs);
+}
+
+} // namespace
+
+TEST(FrameBundleWriterTest, FinishProducesBackendBundleFormat) {
+    FrameBundleWriter writer;
+    writer.reset(1000);
+    std::string a = fakeJpeg('a', 5000);
+    std::string b = fakeJpeg('b', 70000);
+    ASSERT_TRUE(append(writer, a, 1250));
+    ASSERT_TRUE(append(writer, b, 2000));
+    EXPECT_EQ(writer.frameCount(), 2u);
+    EXPECT_EQ(writer.firstTimestampMs(), 1250u);
+
+    FrameBundleWriter::Bundle bundle;
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(bundle.frameCount, 2u);
+    EXPECT_EQ(bundle.firstTimestampMs, 1250u);
+    EXPECT_EQ(bundle.lastTimestampMs, 2000u);
+    EXPECT_EQ(bundle.rawBytes, 24 + a.size() + b.size());
+    EXPECT_LT(bundle.payload.size(), bundle.rawBytes);
+
+    auto frames = parseBundle(decodeBundle(bundle.payload));
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].offsetMs, 250u);
+    EXPECT_EQ(frames[0].jpeg, a);
+    EXPECT_EQ(frames[1].offsetMs, 1000u);
+    EXPECT_EQ(frames[1].jpeg, b);
+}
+
+TEST(FrameBundleWriterTest, FinishStartsANewBatch) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    FrameBundleWriter::Bundle bundle;
+    EXPECT_FALSE(writer.finish(bundle));
+
+    ASSERT_TRUE(append(writer, fakeJpeg('x', 100), 10));
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(writer.frameCount(), 0u);
+
+    ASSERT_TRUE(append(writer, fakeJpeg('y', 100), 20));
+    FrameBundleWriter::Bundle second;
+    ASSERT_TRUE(writer.finish(second));
+    auto frames = parseBundle(decodeBundle(second.payload));
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].offsetMs, 20u);
+}
+
+TEST(FrameBundleWriterTest, SnapshotLeavesBatchOpen) {
+    FrameBundleWriter writer;
+    writer.reset(100);
+    ASSERT_TRUE(append(writer, fakeJpeg('a', 300), 150));
+
+    FrameBundleWriter::Bundle snapshot;
+    ASSERT_TRUE(writer.snapshot(snapshot));
+    EXPECT_EQ(parseBundle(decodeBundle(snapshot.payload)).size(), 1u);
+
+    ASSERT_TRUE(append(writer, fakeJpeg('b', 300), 160));
+    FrameBundleWriter::Bundle bundle;
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(parseBundle(decodeBundle(bundle.payload)).size(), 2u);
+}
+
+TEST(FrameBundleWriterTest, ClampsFramesBeforeEpochAndRejectsEmpty) {
+    FrameBundleWriter writer;
+    writer.reset(5000);
+    EXPECT_FALSE(writer.append(nullptr, 0, 6000));
+    ASSERT_TRUE(append(writer, fakeJpeg('a', 10), 4000));
+
+    FrameBundleWriter::Bundle bundle;
+    ASSERT_TRUE(writer.finish(bundle));
+    auto frames = parseBundle(decodeBundle(bundle.payload));
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].offsetMs, 0u);
+}
+
+TEST(FrameBundleWriterTest, ResetDiscardsOpenBatch) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    ASSERT_TRUE(append(writer, fakeJpeg('a', 10), 1));
+    writer.reset(0);
+    EXPECT_EQ(writer.frameCount(), 0u);
+    FrameBundleWriter::Bundle bundle;
+    EXPECT_FALSE(writer.finish(bundle));
+}
+
+TEST(FrameBundleWriterTest, AdaptiveStoresIncompressibleFrames) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    std::string a = noisyJpeg(40000, 1);
+    std::string b = noisyJpeg(40000, 2);
+    ASSERT_TRUE(append(writer, a, 10));
+    ASSERT_TRUE(append(writer, b, 20));
+
+    FrameBundleWriter::Bundle bundle;
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(bundle.codec, FrameBundleWriter::Codec::Stored);
+    EXPECT_EQ(static_cast<uint8_t>(bundle.payload[5]), 0u);
+    EXPECT_EQ(bundle.payload.size(), FrameBundleWriter::kHeaderSize + 2 + bundle.frameCount + bundle.rawBytes);
+
+    auto frames = parseBundle(decodeBundle(bundle.payload));
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[1].jpeg, b);
+}
+
+TEST(FrameBundleWriterTest, AdaptiveDeflatesCompressibleFrames) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    ASSERT_TRUE(append(writer, fakeJpeg('a', 40000), 10));
+
+    FrameBundleWriter::Bundle bundle;
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(bundle.codec, FrameBundleWriter::Codec::Deflate);
+    EXPECT_LT(bundle.payload.size(), bundle.rawBytes / 10);
+}
+
+TEST(FrameBundleWriterTest, ChoosesCodecPerBatch) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    FrameBundleWriter::Bundle bundle;
+
+    ASSERT_TRUE(append(writer, noisyJpeg(20000, 3), 10));
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(bundle.codec, FrameBundleWriter::Codec::Stored);
+
+    ASSERT_TRUE(append(writer, fakeJpeg('z', 20000), 20));
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(bundle.codec, FrameBundleWriter::Codec::Deflate);
+}
+
+TEST(FrameBundleWriterTest, FixedCodecSkipsSampling) {
+    FrameBundleWriter::Options options;
+    options.adaptive = false;
+    options.codec = FrameBundleWriter::Codec::DeflateFast;
+    FrameBundleWriter writer(options);
+    writer.reset(0);
+    std::string noisy = noisyJpeg(20000, 4);
+    ASSERT_TRUE(append(writer, noisy, 10));
+
+    FrameBundleWriter::Bundle snapshot;
+    ASSERT_TRUE(writer.snapshot(snapshot));
+    EXPECT_EQ(snapshot.codec, FrameBundleWriter::Codec::DeflateFast);
+    auto frames = parseBundle(decodeBundle(snapshot.payload));
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].jpeg, noisy);
+}
+
+TEST(FrameBundleWriterTest, RepeatRecordsReferenceThePreviousFrame) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    FrameBundleWriter::Bundle bundle;
+    EXPECT_FALSE(writer.appendRepeat(5));
+
+    std::string a = fakeJpeg('a', 1000);
+    ASSERT_TRUE(append(writer, a, 10));
+    ASSERT_TRUE(writer.appendRepeat(20));
+    ASSERT_TRUE(writer.appendRepeat(30));
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(bundle.frameCount, 3u);
+    EXPECT_EQ(bundle.repeatCount, 2u);
+    EXPECT_EQ(bundle.lastTimestampMs, 30u);
+    EXPECT_EQ(bundle.rawBytes, 36 + a.size());
+
+    auto frames = parseBundle(decodeBundle(bundle.payload));
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0].jpeg, a);
+    EXPECT_TRUE(frames[1].jpeg.empty());
+    EXPECT_EQ(frames[2].offsetMs, 30u);
+
+    // A batch opened by a repeat carries the frame in full.
+    ASSERT_TRUE(writer.appendRepeat(40));
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(bundle.repeatCount, 0u);
+    frames = parseBundle(decodeBundle(bundle.payload));
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].jpeg, a);
+    EXPECT_EQ(frames[0].offsetMs, 40u);
+
+    writer.reset(0);
+    EXPECT_FALSE(writer.appendRepeat(50));
+}
+
+TEST(FrameBundleWriterTest, DeltasFollowAFullFrame) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    std::string delta = "RJTD-payload";
+    EXPECT_FALSE(writer.appendDelta(reinterpret_cast<const uint8_t *>(delta.data()), delta.size(), 5));
+
+    std::string key = fakeJpeg('k', 500);
+    ASSERT_TRUE(append(writer, key, 10));
+    ASSERT_TRUE(writer.appendDelta(reinterpret_cast<const uint8_t *>(delta.data()), delta.size(), 20));
+    ASSERT_TRUE(writer.appendRepeat(30));
+    FrameBundleWriter::Bundle bundle;
+    ASSERT_TRUE(writer.finish(bundle));
+    auto frames = parseBundle(decodeBundle(bundle.payload));
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[1].jpeg, delta);
+    EXPECT_TRUE(frames[2].jpeg.empty());
+
+    // The last frame was a delta, so a new batch cannot open with a repeat
+    // of the stale keyframe.
+    EXPECT_FALSE(writer.appendRepeat(40));
+    EXPECT_FALSE(writer.appendDelta(reinterpret_cast<const uint8_t *>(delta.data()), delta.size(), 40));
+    ASSERT_TRUE(append(writer, key, 40));
+    EXPECT_TRUE(writer.appendRepeat(50));
+}
+
+TEST(FrameBundleWriterTest, HeaderRecordsQualityPerFrame) {
+    FrameBundleWriter writer;
+    writer.reset(0);
+    std::string key = fakeJpeg('k', 500);
+    std::string delta = "RJTD-payload";
+    ASSERT_TRUE(writer.append(reinterpret_cast<const uint8_t *>(key.data()), key.size(), 10, 50));
+    ASSERT_TRUE(writer.appendRepeat(20));
+    ASSERT_TRUE(writer.appendDelta(reinterpret_cast<const uint8_t *>(delta.data()), delta.size(), 30, 35));
+    FrameBundleWriter::Bundle snapshot;
+    ASSERT_TRUE(writer.snapshot(snapshot));
+    EXPECT_EQ(qualities(snapshot.payload), (std::vector<uint8_t>{50, 50, 35}));
+
+    ASSERT_TRUE(writer.append(reinterpret_cast<const uint8_t *>(key.data()), key.size(), 40, 20));
+    FrameBundleWriter::Bundle bundle;
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(qualities(bundle.payload), (std::vector<uint8_t>{50, 50, 35, 20}));
+    auto frames = parseBundle(decodeBundle(bundle.payload));
+    ASSERT_EQ(frames.size(), 4u);
+    EXPECT_EQ(frames[3].jpeg, key);
+
+    // A batch opened by a repeat keeps the repeated frame's quality.
+    ASSERT_TRUE(writer.appendRepeat(50));
+    ASSERT_TRUE(writer.finish(bundle));
+    EXPECT_EQ(qualities(bundle.payload), (std::vector<uint8_t>{20}));
+}
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameCredits.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using rejourney::FrameCredits;
+
+namespace {
+
+FrameCredits::Options options(size_t uploadSlots, size_t queueSlots, size_t framesPerBundle) {
+    FrameCredits::Options options;
+    options.uploadSlots = uploadSlots;
+    options.queueSlots = queueSlots;
+    options.framesPerBundle = framesPerBundle;
+    return options;
+}
+
+/// Captures frames until credit runs out, queuing a bundle every
+/// `framesPerBundle` frames. Returns the frames captured.
+size_t captureUntilDenied(FrameCredits &credits, size_t framesPerBundle) {
+    size_t captured = 0;
+    size_t open = 0;
+    while (credits.acquireFrame()) {
+        ++captured;
+        if (++open == framesPerBundle) {
+            credits.bundleQueued(open);
+            open = 0;
+        }
+    }
+    return captured;
+}
+
+} // namespace
+
+TEST(FrameCreditsTest, StalledUploadsStopCaptureOnceTheQueueIsFull) {
+    FrameCredits credits(options(2, 4, 3));
+    EXPECT_EQ(credits.frameCredits(), 18u);
+
+    // Uploads are granted but never finish.
+    EXPECT_EQ(captureUntilDenied(credits, 3), 18u);
+    EXPECT_TRUE(credits.startUpload());
+    EXPECT_TRUE(credits.startUpload());
+    EXPECT_FALSE(credits.startUpload());
+    EXPECT_FALSE(credits.acquireFrame());
+
+    auto stats = credits.stats();
+    EXPECT_EQ(stats.queuedBundles, 4u);
+    EXPECT_EQ(stats.uploadingBundles, 2u);
+    EXPECT_EQ(stats.reservedFrames, 0u);
+    EXPECT_EQ(stats.grantedFrames, 18u);
+    EXPECT_EQ(stats.deniedFrames, 2u);
+
+    // Each finished upload is worth one more bundle of frames.
+    credits.uploadFinished(false);
+    EXPECT_EQ(credits.frameCredits(), 3u);
+    EXPECT_EQ(captureUntilDenied(credits, 3), 3u);
+}
+
+TEST(FrameCreditsTest, ClosedUploaderGrantsOnlyTheQueue) {
+    FrameCredits credits(options(2, 2, 3));
+    credits.setUploadSlots(0);
+    EXPECT_EQ(captureUntilDenied(credits, 3), 6u);
+    EXPECT_FALSE(credits.startUpload());
+
+    credits.setUploadSlots(2);
+    EXPECT_EQ(credits.frameCredits(), 6u);
+    EXPECT_TRUE(credits.startUpload());
+    EXPECT_EQ(credits.frameCredits(), 6u);
+
+    // A failed upload goes back to the queue and keeps its slot.
+    credits.uploadFinished(true);
+    EXPECT_EQ(credits.stats().queuedBundles, 2u);
+    EXPECT_EQ(credits.frameCredits(), 6u);
+}
+
+TEST(FrameCreditsTest, OpenBundleFramesHoldCreditUntilQueued) {
+    FrameCredits credits(options(1, 1, 4));
+    EXPECT_EQ(credits.frameCredits(), 8u);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(credits.acquireFrame());
+    }
+    EXPECT_EQ(credits.frameCredits(), 3u);
+
+    // A frame that fails to encode gives its credit back.
+    credits.releaseFrames();
+    EXPECT_EQ(credits.frameCredits(), 4u);
+
+    // A bundle larger than framesPerBundle is still accepted.
+    credits.bundleQueued(4);
+    EXPECT_EQ(credits.stats().reservedFrames, 0u);
+    EXPECT_EQ(credits.frameCredits(), 4u);
+    credits.bundleQueued(1);
+    credits.bundleQueued(1);
+    EXPECT_EQ(credits.stats().queuedBundles, 3u);
+    EXPECT_EQ(credits.frameCredits(), 0u);
+    EXPECT_FALSE(credits.acquireFrame());
+}
+
+TEST(FrameCreditsTest, NewSessionDropsReservationsAndQueuedBundles) {
+    FrameCredits credits(options(1, 2, 2));
+    EXPECT_EQ(captureUntilDenied(credits, 2), 6u);
+    ASSERT_TRUE(credits.startUpload());
+
+    credits.clearBundles();
+    credits.resetFrames();
+    // The upload in flight still holds its slot.
+    EXPECT_EQ(credits.frameCredits(), 4u);
+    credits.uploadFinished(false);
+    EXPECT_EQ(credits.frameCredits(), 6u);
+    // Stale releases after the reset do not mint credit.
+    credits.releaseFrames(3);
+    EXPECT_EQ(credits.frameCredits(), 6u);
+}
+
+TEST(FrameCreditsTest, ConcurrentCaptureAndUploadBalance) {
+    FrameCredits credits(options(2, 8, 3));
+    constexpr size_t kBundles = 2000;
+    std::thread uploader([&] {
+        size_t shipped = 0;
+        while (shipped < kBundles) {
+            if (credits.startUpload()) {
+                credits.uploadFinished(false);
+                ++shipped;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    size_t open = 0;
+    for (size_t queued = 0; queued < kBundles;) {
+        if (!credits.acquireFrame()) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (++open == 3) {
+            credits.bundleQueued(open);
+            open = 0;
+            ++queued;
+        }
+    }
+    uploader.join();
+
+    const auto stats = credits.stats();
+    EXPECT_EQ(stats.reservedFrames, 0u);
+    EXPECT_EQ(stats.queuedBundles, 0u);
+    EXPECT_EQ(stats.uploadingBundles, 0u);
+    EXPECT_EQ(stats.grantedFrames, kBundles * 3);
+    EXPECT_EQ(credits.frameCredits(), 30u);
+}
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameDeduplicator.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using rejourney::FrameDeduplicator;
+
+namespace {
+
+struct Bitmap {
+    size_t width;
+    size_t height;
+    size_t bytesPerRow;
+    std::vector<uint8_t> pixels;
+
+    Bitmap(size_t w, size_t h, uint8_t fill) : width(w), height(h), bytesPerRow(w * 4 + 16), pixels(bytesPerRow * h, fill) {}
+
+    void fillRect(size_t x, size_t y, size_t w, size_t h, uint8_t value) {
+        for (size_t row = y; row < y + h; ++row) {
+            for (size_t col = x * 4; col < (x + w) * 4; ++col) {
+                pixels[row * bytesPerRow + col] = value;
+            }
+        }
+    }
+
+    bool isRepeat(FrameDeduplicator &dedup) const { return dedup.isRepeat(pixels.data(), width, height, bytesPerRow); }
+};
+
+} // namespace
+
+TEST(FrameDeduplicatorTest, SignatureMatchesScalarCellMeans) {
+    Bitmap bitmap(130, 270, 0);
+    for (size_t y = 0; y < bitmap.height; ++y) {
+        for (size_t x = 0; x < bitmap.width * 4; ++x) {
+            bitmap.pixels[y * bitmap.bytesPerRow + x] = static_cast<uint8_t>((x * 7 + y * 13) & 0xFF);
+        }
+    }
+    FrameDeduplicator::Options options;
+    options.gridWidth = 8;
+    options.gridHeight = 16;
+    options.rowStep = 1;
+    std::vector<uint8_t> signature;
+    ASSERT_TRUE(FrameDeduplicator::computeSignature(bitmap.pixels.data(), bitmap.width, bitmap.height,
+                                                    bitmap.bytesPerRow, options, signature));
+    ASSERT_EQ(signature.size(), 8u * 16u);
+
+    for (size_t cy = 0; cy < 16; ++cy) {
+        for (size_t cx = 0; cx < 8; ++cx) {
+            uint64_t sum = 0;
+            uint64_t count = 0;
+            for (size_t y = cy * bitmap.height / 16; y < (cy + 1) * bitmap.height / 16; ++y) {
+                for (size_t x = cx * bitmap.width / 8 * 4; x < (cx + 1) * bitmap.width / 8 * 4; ++x) {
+                    sum += bitmap.pixels[y * bitmap.bytesPerRow + x];
+                    ++count;
+                }
+            }
+            EXPECT_EQ(signature[cy * 8 + cx], sum / count) << cx << "," << cy;
+        }
+    }
+}
+
+TEST(FrameDeduplicatorTest, IdenticalFramesRepeat) {
+    FrameDeduplicator dedup;
+    Bitmap frame(390, 844, 200);
+    EXPECT_FALSE(frame.isRepeat(dedup));
+    EXPECT_TRUE(frame.isRepeat(dedup));
+    EXPECT_TRUE(frame.isRepeat(dedup));
+}
+
+TEST(FrameDeduplicatorTest, SmallChangeIsNotARepeat) {
+    FrameDeduplicator dedup;
+    Bitmap frame(390, 844, 255);
+    EXPECT_FALSE(frame.isRepeat(dedup));
+    // Roughly one glyph of dark text.
+    frame.fillRect(100, 300, 7, 10, 0);
+    EXPECT_FALSE(frame.isRepeat(dedup));
+    EXPECT_TRUE(frame.isRepeat(dedup));
+}
+
+TEST(FrameDeduplicatorTest, NoiseWithinToleranceRepeats) {
+    FrameDeduplicator dedup;
+    Bitmap frame(390, 844, 128);
+    EXPECT_FALSE(frame.isRepeat(dedup));
+    frame.pixels[5000] = 129;
+    frame.pixels[90000] = 127;
+    EXPECT_TRUE(frame.isRepeat(dedup));
+}
+
+TEST(FrameDeduplicatorTest, ComparesAgainstLastKeptFrame) {
+    FrameDeduplicator::Options options;
+    options.cellTolerance = 1;
+    options.gridWidth = 1;
+    options.gridHeight = 1;
+    FrameDeduplicator dedup(options);
+    Bitmap frame(64, 64, 100);
+    EXPECT_FALSE(frame.isRepeat(dedup));
+    std::fill(frame.pixels.begin(), frame.pixels.end(), 101);
+    EXPECT_TRUE(frame.isRepeat(dedup));
+    std::fill(frame.pixels.begin(), frame.pixels.end(), 102);
+    EXPECT_FALSE(frame.isRepeat(dedup));
+}
+
+TEST(FrameDeduplicatorTest, MaxRepeatsForcesKeyframe) {
+    FrameDeduplicator::Options options;
+    options.maxRepeats = 2;
+    FrameDeduplicator dedup(options);
+    Bitmap frame(100, 100, 50);
+    EXPECT_FALSE(frame.isRepeat(dedup));
+    EXPECT_TRUE(frame.isRepeat(dedup));
+    EXPECT_TRUE(frame.isRepeat(dedup));
+    EXPECT_FALSE(frame.isRepeat(dedup));
+    EXPECT_TRUE(frame.isRepeat(dedup));
+}
+
+TEST(FrameDeduplicatorTest, SizeChangeAndResetBreakRepeats) {
+    FrameDeduplicator dedup;
+    Bitmap portrait(390, 844, 10);
+    Bitmap landscape(844, 390, 10);
+    EXPECT_FALSE(portrait.isRepeat(dedup));
+    EXPECT_FALSE(landscape.isRepeat(dedup));
+    EXPECT_TRUE(landscape.isRepeat(dedup));
+    dedup.reset();
+    EXPECT_FALSE(landscape.isRepeat(dedup));
+}
+
+TEST(FrameDeduplicatorTest, TinyBitmapsNeverRepeat) {
+    FrameDeduplicator dedup;
+    Bitmap tiny(8, 8, 0);
+    EXPECT_FALSE(tiny.isRepeat(dedup));
+    EXPECT_FALSE(tiny.isRepeat(dedup));
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GroupCommitLog.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using rejourney::GroupCommitLog;
+using rejourney::SegmentedLog;
+
+namespace {
+
+class GroupCommitLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/rj_gc_XXXXXX";
+        ASSERT_NE(::mkdtemp(pattern), nullptr);
+        dir_ = pattern;
+    }
+
+    void TearDown() override {
+        std::string command = "rm -rf '" + dir_ + "'";
+        std::system(command.c_str());
+    }
+
+    size_t recordsOnDisk() {
+        size_t count = 0;
+        SegmentedLog::forEach(dir_, [&](std::string_view, int64_t) {
+            ++count;
+            return true;
+        });
+        return count;
+    }
+
+    std::string dir_;
+};
+
+} // namespace
+
+TEST_F(GroupCommitLogTest, FlushWritesStagedRecordsInFewSyscalls) {
+    SegmentedLog log(dir_);
+    ASSERT_TRUE(log.open());
+    GroupCommitLog group(log, {60'000, 1 << 20});
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(group.append("{\"i\":" + std::to_string(i) + "}", i));
+    }
+    EXPECT_FALSE(group.append("", 0));
+    EXPECT_EQ(recordsOnDisk(), 0u);
+
+    ASSERT_TRUE(group.flush(true));
+    EXPECT_EQ(group.pending(), 0u);
+    EXPECT_EQ(recordsOnDisk(), 1000u);
+    EXPECT_EQ(log.stats().count, 1000u);
+    EXPECT_EQ(log.stats().lastTimestampMs, 999);
+    EXPECT_LE(log.stats().writes, 2u);
+}
+
+TEST_F(GroupCommitLogTest, WritesWithinDelayBound) {
+    SegmentedLog log(dir_);
+    ASSERT_TRUE(log.open());
+    GroupCommitLog group(log, {10, 1 << 20});
+
+    ASSERT_TRUE(group.append("event", 1));
+    for (int i = 0; i < 200 && recordsOnDisk() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(recordsOnDisk(), 1u);
+}
+
+TEST_F(GroupCommitLogTest, SizeThresholdTriggersWriteBeforeDelay) {
+    SegmentedLog log(dir_);
+    ASSERT_TRUE(log.open());
+    GroupCommitLog group(log, {60'000, 64});
+
+    ASSERT_TRUE(group.append(std::string(100, 'x'), 1));
+    for (int i = 0; i < 200 && recordsOnDisk() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(recordsOnDisk(), 1u);
+}
+
+TEST_F(GroupCommitLogTest, SpansSegmentsAndPreservesOrder) {
+    SegmentedLog log(dir_, 256);
+    ASSERT_TRUE(log.open());
+    {
+        GroupCommitLog group(log, {60'000, 1 << 20});
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(group.append("event-" + std::to_string(i), i));
+        }
+        // Destruction flushes.
+    }
+
+    std::vector<std::string> records;
+    SegmentedLog::forEach(dir_, [&](std::string_view payload, int64_t) {
+        records.emplace_back(payload);
+        return true;
+    });
+    ASSERT_EQ(records.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(records[i], "event-" + std::to_string(i));
+    }
+    EXPECT_EQ(log.stats().writes, log.stats().segments);
+}
+
+TEST_F(GroupCommitLogTest, ConcurrentAppendersAreAllPersisted) {
+    SegmentedLog log(dir_);
+    ASSERT_TRUE(log.open());
+    GroupCommitLog group(log, {5, 4096});
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&group, t] {
+            for (int i = 0; i < 500; ++i) {
+                group.append("t" + std::to_string(t) + "-" + std::to_string(i), i);
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    ASSERT_TRUE(group.flush(false));
+    EXPECT_EQ(recordsOnDisk(), 2000u);
+}
+
+TEST_F(GroupCommitLogTest, ReportsFailedWritesOnFlush) {
+    SegmentedLog log(dir_);
+    GroupCommitLog group(log, {60'000, 1 << 20});
+    ASSERT_TRUE(group.append("never-opened", 1));
+    EXPECT_FALSE(group.flush(false));
+    EXPECT_TRUE(group.flush(false));
+}
@@ -0,0 +1,365 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HierarchyDelta.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using rejourney::HierarchyDeltaEncoder;
+using rejourney::HierarchySnapshotBuilder;
+using Attribute = HierarchySnapshotBuilder::Attribute;
+using Result = HierarchyDeltaEncoder::Result;
+
+namespace {
+
+struct Reader {
+    const std::string &data;
+    size_t pos = 0;
+
+    uint32_t u8() { return static_cast<uint8_t>(data.at(pos++)); }
+    uint32_t u16() {
+        uint32_t value = u8() << 8;
+        return value | u8();
+    }
+    uint32_t u32() {
+        uint32_t value = u16() << 16;
+        return value | u16();
+    }
+    uint64_t u64() {
+        uint64_t value = static_cast<uint64_t>(u32()) << 32;
+        return value | u32();
+    }
+    float f32() {
+        uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::string bytes(size_t length) {
+        std::string value = data.substr(pos, length);
+        pos += length;
+        return value;
+    }
+    std::vector<std::string> strings() {
+        std::vector<std::string> values(u32());
+        for (auto &value : values) {
+            value = bytes(u32());
+        }
+        return values;
+    }
+};
+
+/// Decoded hierarchy keyed by node id, as a backend would rebuild it.
+struct Tree {
+    struct Node {
+        std::string type;
+        float frame[5] = {};
+        uint32_t flags = 0;
+        std::map<uint32_t, std::string> attributes;
+        std::vector<float> scroll;
+        std::vector<uint32_t> children;
+    };
+
+    uint32_t keyframeId = 0;
+    uint32_t root = 0;
+    std::string screenName;
+    std::map<uint32_t, Node> nodes;
+
+    std::string dump(uint32_t id) const {
+        auto it = nodes.find(id);
+        if (it == nodes.end()) return "<missing " + std::to_string(id) + ">";
+        const Node &node = it->second;
+        std::string out = node.type;
+        for (float value : node.frame) out += " " + std::to_string(value);
+        out += " f" + std::to_string(node.flags);
+        for (const auto &attribute : node.attributes) {
+            out += " a" + std::to_string(attribute.first) + "=" + attribute.second;
+        }
+        for (float value : node.scroll) out += " s" + std::to_string(value);
+        out += " [";
+        for (uint32_t child : node.children) out += dump(child) + ",";
+        return out + "]";
+    }
+
+    std::string dump() const { return screenName + ":" + (nodes.empty() ? "" : dump(root)); }
+};
+
+/// Reads node records; `ids` null means node index is the id.
+void readNodes(Reader &in, Tree &tree, const std::vector<std::string> &strings, bool keyframe) {
+    const uint32_t count = in.u32();
+    std::vector<uint32_t> ids(count);
+    std::vector<int32_t> parents(count, -1);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (keyframe) {
+            ids[i] = i;
+            parents[i] = static_cast<int32_t>(in.u32());
+        } else {
+            ids[i] = in.u32();
+        }
+    }
+    std::vector<Tree::Node> records(count);
+    for (auto &record : records) record.type = strings.at(in.u32());
+    for (int column = 0; column < 5; ++column) {
+        for (auto &record : records) record.frame[column] = in.f32();
+    }
+    for (auto &record : records) record.flags = in.u16();
+    for (uint32_t i = 0; i < count; ++i) {
+        auto &node = tree.nodes[ids[i]];
+        auto children = keyframe ? std::vector<uint32_t>() : node.children;
+        node = records[i];
+        node.children = children;
+    }
+    if (keyframe) {
+        for (uint32_t i = 1; i < count; ++i) tree.nodes[static_cast<uint32_t>(parents[i])].children.push_back(i);
+    }
+    for (uint32_t n = in.u32(); n > 0; --n) {
+        const uint32_t id = in.u32();
+        const uint32_t key = in.u8();
+        const uint32_t value = in.u32();
+        tree.nodes[id].attributes[key] =
+            key == static_cast<uint32_t>(Attribute::TextLength) ? std::to_string(value) : strings.at(value);
+    }
+    for (uint32_t n = in.u32(); n > 0; --n) {
+        auto &scroll = tree.nodes[in.u32()].scroll;
+        scroll.clear();
+        for (int i = 0; i < 4; ++i) scroll.push_back(in.f32());
+    }
+}
+
+Tree parseKeyframe(const std::string &data) {
+    Reader in{data};
+    EXPECT_EQ(in.bytes(4), "RJHS");
+    EXPECT_EQ(in.u8(), HierarchySnapshotBuilder::kFormatVersion);
+    in.u64();
+    in.bytes(12);
+    const uint32_t screenName = in.u32();
+    Tree tree;
+    tree.keyframeId = in.u32();
+    const auto strings = in.strings();
+    if (screenName != HierarchySnapshotBuilder::kNoString) tree.screenName = strings.at(screenName);
+    readNodes(in, tree, strings, true);
+    EXPECT_EQ(in.pos, data.size());
+    return tree;
+}
+
+struct DeltaCounts {
+    uint32_t upserts = 0;
+    uint32_t removed = 0;
+};
+
+Tree applyDelta(const Tree &keyframe, const std::string &data, DeltaCounts *counts = nullptr) {
+    Reader in{data};
+    EXPECT_EQ(in.bytes(4), "RJHD");
+    EXPECT_EQ(in.u8(), HierarchyDeltaEncoder::kFormatVersion);
+    Tree tree = keyframe;
+    EXPECT_EQ(in.u32(), keyframe.keyframeId);
+    in.u64();
+    in.bytes(12);
+    const uint32_t screenName = in.u32();
+    const auto strings = in.strings();
+    tree.screenName = screenName == HierarchySnapshotBuilder::kNoString ? "" : strings.at(screenName);
+    tree.root = in.u32();
+    const size_t upsertsAt = in.pos;
+    readNodes(in, tree, strings, false);
+    if (counts) counts->upserts = Reader{data, upsertsAt}.u32();
+    for (uint32_t n = in.u32(); n > 0; --n) {
+        auto &children = tree.nodes[in.u32()].children;
+        children.assign(in.u32(), 0);
+        for (auto &child : children) child = in.u32();
+    }
+    const uint32_t removed = in.u32();
+    if (counts) counts->removed = removed;
+    for (uint32_t n = removed; n > 0; --n) tree.nodes.erase(in.u32());
+    EXPECT_EQ(in.pos, data.size());
+    return tree;
+}
+
+struct View {
+    uint64_t key;
+    std::string type;
+    float y = 0;
+    std::string text;
+    std::vector<View> children;
+};
+
+void addView(HierarchySnapshotBuilder &builder, const View &view, int32_t parent) {
+    const int32_t node = builder.addNode(parent, view.key, view.type, {0, view.y, 390, 44}, 1, 0);
+    if (!view.text.empty()) {
+        builder.setString(node, Attribute::Text, view.text);
+        builder.setTextLength(node, static_cast<uint32_t>(view.text.size()));
+    }
+    if (view.type == "UIScrollView") builder.setScroll(node, 0, view.y, 390, 4000);
+    for (const auto &child : view.children) addView(builder, child, node);
+}
+
+void build(HierarchySnapshotBuilder &builder, const View &root, const std::string &screen = "Feed") {
+    builder.reset();
+    builder.setScreen(390, 844, 3, screen);
+    addView(builder, root, -1);
+}
+
+View feed(size_t rows) {
+    View list{2, "UIScrollView"};
+    for (size_t i = 0; i < rows; ++i) {
+        View row{100 + i, "Row", 44.0f * i};
+        row.children.push_back({10000 + i, "UILabel", 0, "Row " + std::to_string(i)});
+        row.children.push_back({20000 + i, "UIImageView", 0});
+        list.children.push_back(row);
+    }
+    View root{1, "UIWindow"};
+    root.children.push_back(list);
+    return root;
+}
+
+/// Encodes the builder's snapshot and checks it decodes back to the same tree.
+Result encodeAndCheck(HierarchyDeltaEncoder &encoder, HierarchySnapshotBuilder &builder, Tree &keyframe,
+                      uint64_t timestampMs, DeltaCounts *counts = nullptr, bool force = false) {
+    std::string out;
+    const Result result = encoder.encode(builder, timestampMs, force, out);
+    const std::string expected = parseKeyframe(builder.serialize(timestampMs, 0)).dump();
+    if (result == Result::Keyframe) {
+        keyframe = parseKeyframe(out);
+        EXPECT_EQ(keyframe.dump(), expected);
+    } else {
+        EXPECT_EQ(applyDelta(keyframe, out, counts).dump(), expected);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(HierarchyDeltaTest, UnchangedScreenSendsAnEmptyDelta) {
+    HierarchySnapshotBuilder builder;
+    HierarchyDeltaEncoder encoder;
+    Tree keyframe;
+    build(builder, feed(50));
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 1000), Result::Keyframe);
+    build(builder, feed(50));
+    DeltaCounts counts;
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 2000, &counts), Result::Unchanged);
+    EXPECT_EQ(counts.upserts, 0u);
+    EXPECT_EQ(counts.removed, 0u);
+
+    build(builder, feed(50), "Settings");
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 3000), Result::Delta);
+}
+
+TEST(HierarchyDeltaTest, DeltaCarriesOnlyChangedNodes) {
+    HierarchySnapshotBuilder builder;
+    HierarchyDeltaEncoder encoder;
+    Tree keyframe;
+    View root = feed(200);
+    build(builder, root);
+    std::string full;
+    encoder.encode(builder, 1000, false, full);
+    keyframe = parseKeyframe(full);
+
+    root.children[0].children[7].children[0].text = "Edited";
+    root.children[0].children.erase(root.children[0].children.begin() + 20);
+    build(builder, root);
+    DeltaCounts counts;
+    std::string delta;
+    ASSERT_EQ(encoder.encode(builder, 2000, false, delta), Result::Delta);
+    EXPECT_EQ(applyDelta(keyframe, delta, &counts).dump(), parseKeyframe(builder.serialize(2000, 0)).dump());
+    EXPECT_EQ(counts.upserts, 1u);
+    EXPECT_EQ(counts.removed, 3u);
+    EXPECT_LT(delta.size() * 10, full.size());
+}
+
+TEST(HierarchyDeltaTest, KeyframeTriggers) {
+    HierarchyDeltaEncoder::Options options;
+    options.keyframeInterval = 4;
+    options.maxChangedFraction = 0.5;
+    HierarchySnapshotBuilder builder;
+    HierarchyDeltaEncoder encoder(options);
+    Tree keyframe;
+    View root = feed(10);
+    build(builder, root);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 1), Result::Keyframe);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 2), Result::Unchanged);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 3, nullptr, true), Result::Keyframe);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 4), Result::Unchanged);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 5), Result::Unchanged);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 6), Result::Unchanged);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 7), Result::Keyframe);
+
+    // A new root view is a new screen.
+    root.key = 99;
+    build(builder, root);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 8), Result::Keyframe);
+
+    // Most of the screen changed.
+    for (auto &row : root.children[0].children) {
+        row.y += 1;
+        row.children[0].text += "!";
+    }
+    build(builder, root);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 9), Result::Keyframe);
+
+    // Two views claiming the same key cannot be told apart.
+    root.children[0].children[1].key = root.children[0].children[0].key;
+    build(builder, root);
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 10), Result::Keyframe);
+
+    encoder.reset();
+    build(builder, feed(10));
+    EXPECT_EQ(encodeAndCheck(encoder, builder, keyframe, 11), Result::Keyframe);
+}
+
+TEST(HierarchyDeltaTest, RandomEditsRoundTrip) {
+    std::mt19937 random(42);
+    HierarchyDeltaEncoder::Options options;
+    options.keyframeInterval = 25;
+    HierarchySnapshotBuilder builder;
+    HierarchyDeltaEncoder encoder(options);
+    Tree keyframe;
+    View root = feed(30);
+    uint64_t nextKey = 50000;
+    size_t deltas = 0;
+    for (uint64_t step = 0; step < 300; ++step) {
+        auto &rows = root.children[0].children;
+        switch (random() % 5) {
+        case 0:
+            if (!rows.empty()) rows[random() % rows.size()].children[0].text = "t" + std::to_string(step);
+            break;
+        case 1: {
+            View row{nextKey++, "Row", static_cast<float>(step)};
+            row.children.push_back({nextKey++, "UILabel", 0, "new"});
+            rows.insert(rows.begin() + static_cast<long>(random() % (rows.size() + 1)), row);
+            break;
+        }
+        case 2:
+            if (rows.size() > 1) rows.erase(rows.begin() + static_cast<long>(random() % rows.size()));
+            break;
+        case 3:
+            if (rows.size() > 1) std::swap(rows[random() % rows.size()], rows[random() % rows.size()]);
+            break;
+        default:
+            root.children[0].y = static_cast<float>(random() % 1000);
+            break;
+        }
+        build(builder, root);
+        if (encodeAndCheck(encoder, builder, keyframe, step) != Result::Keyframe) ++deltas;
+    }
+    EXPECT_GT(deltas, 200u);
+}
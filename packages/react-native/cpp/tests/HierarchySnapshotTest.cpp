@@ -0,0 +1,177 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HierarchySnapshot.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+using rejourney::HierarchySnapshotBuilder;
+using Attribute = HierarchySnapshotBuilder::Attribute;
+using Frame = HierarchySnapshotBuilder::Frame;
+
+namespace {
+
+struct Reader {
+    const std::string &data;
+    size_t pos = 0;
+
+    uint32_t u8() { return static_cast<uint8_t>(data[pos++]); }
+    uint32_t u16() {
+        uint32_t value = u8() << 8;
+        return value | u8();
+    }
+    uint32_t u32() {
+        uint32_t value = u16() << 16;
+        return value | u16();
+    }
+    uint64_t u64() {
+        uint64_t value = static_cast<uint64_t>(u32()) << 32;
+        return value | u32();
+    }
+    float f32() {
+        uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::string bytes(size_t length) {
+        std::string value = data.substr(pos, length);
+        pos += length;
+        return value;
+    }
+};
+
+} // namespace
+
+TEST(HierarchySnapshotTest, InternsRepeatedStrings) {
+    HierarchySnapshotBuilder builder;
+    const uint32_t first = builder.intern("UIView");
+    EXPECT_EQ(builder.intern("UILabel"), first + 1);
+    EXPECT_EQ(builder.intern(std::string("UI") + "View"), first);
+    EXPECT_EQ(builder.intern(""), first + 2);
+    EXPECT_EQ(builder.intern(""), first + 2);
+}
+
+TEST(HierarchySnapshotTest, InternTableSurvivesGrowth) {
+    HierarchySnapshotBuilder builder;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(builder.intern("type" + std::to_string(i)), i);
+    }
+    for (uint32_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(builder.intern("type" + std::to_string(i)), i);
+    }
+}
+
+TEST(HierarchySnapshotTest, RejectsUnknownParents) {
+    HierarchySnapshotBuilder builder;
+    EXPECT_EQ(builder.addNode(0, 1, "UIView", Frame(), 1, 0), -1);
+    EXPECT_EQ(builder.addNode(-1, 2, "UIWindow", Frame(), 1, 0), 0);
+    EXPECT_EQ(builder.addNode(5, 3, "UIView", Frame(), 1, 0), -1);
+    EXPECT_EQ(builder.addNode(0, 4, "UIView", Frame(), 1, 0), 1);
+    EXPECT_EQ(builder.addNode(1, 5, "UIView", Frame(), 1, 0), 2);
+    EXPECT_EQ(builder.addNode(0, 6, "UIView", Frame(), 1, 0), 3);
+    EXPECT_EQ(builder.nodeCount(), 4u);
+    EXPECT_EQ(builder.childCount(0), 2u);
+    EXPECT_EQ(builder.childCount(1), 1u);
+}
+
+TEST(HierarchySnapshotTest, SerializesColumns) {
+    HierarchySnapshotBuilder builder;
+    builder.setScreen(390, 844, 3, "Home");
+    const int32_t root = builder.addNode(-1, 7, "UIWindow", {0, 0, 390, 844}, 1, 0);
+    const int32_t scroll = builder.addNode(root, 8, "UIScrollView", {0, 50, 390, 700}, 0.5f,
+                                           HierarchySnapshotBuilder::ScrollEnabled);
+    const int32_t label = builder.addNode(scroll, 9, "UILabel", {10, 20, 100, 18}, 1, HierarchySnapshotBuilder::Masked);
+    builder.setString(label, Attribute::Text, "***");
+    builder.setTextLength(label, 12);
+    builder.setString(label, Attribute::TextLength, "ignored");
+    builder.setScroll(scroll, 0, 120, 390, 2400);
+
+    const std::string data = builder.serialize(1700000000123ull, 7);
+    Reader in{data};
+    EXPECT_EQ(in.bytes(4), "RJHS");
+    EXPECT_EQ(in.u8(), HierarchySnapshotBuilder::kFormatVersion);
+    EXPECT_EQ(in.u64(), 1700000000123ull);
+    EXPECT_EQ(in.f32(), 390.0f);
+    EXPECT_EQ(in.f32(), 844.0f);
+    EXPECT_EQ(in.f32(), 3.0f);
+    EXPECT_EQ(in.u32(), 0u); // "Home" was interned first
+    EXPECT_EQ(in.u32(), 7u);
+
+    ASSERT_EQ(in.u32(), 5u);
+    const char *strings[] = {"Home", "UIWindow", "UIScrollView", "UILabel", "***"};
+    for (const char *expected : strings) {
+        const uint32_t length = in.u32();
+        EXPECT_EQ(in.bytes(length), expected);
+    }
+
+    ASSERT_EQ(in.u32(), 3u);
+    EXPECT_EQ(in.u32(), 0xFFFFFFFFu);
+    EXPECT_EQ(in.u32(), 0u);
+    EXPECT_EQ(in.u32(), 1u);
+    EXPECT_EQ(in.u32(), 1u);
+    EXPECT_EQ(in.u32(), 2u);
+    EXPECT_EQ(in.u32(), 3u);
+    const float xs[] = {0, 0, 10};
+    for (float x : xs) EXPECT_EQ(in.f32(), x);
+    const float ys[] = {0, 50, 20};
+    for (float y : ys) EXPECT_EQ(in.f32(), y);
+    const float widths[] = {390, 390, 100};
+    for (float w : widths) EXPECT_EQ(in.f32(), w);
+    const float heights[] = {844, 700, 18};
+    for (float h : heights) EXPECT_EQ(in.f32(), h);
+    const float alphas[] = {1, 0.5f, 1};
+    for (float a : alphas) EXPECT_EQ(in.f32(), a);
+    EXPECT_EQ(in.u16(), 0u);
+    EXPECT_EQ(in.u16(), static_cast<uint32_t>(HierarchySnapshotBuilder::ScrollEnabled));
+    EXPECT_EQ(in.u16(), static_cast<uint32_t>(HierarchySnapshotBuilder::Masked));
+
+    ASSERT_EQ(in.u32(), 2u);
+    EXPECT_EQ(in.u32(), 2u);
+    EXPECT_EQ(in.u8(), static_cast<uint32_t>(Attribute::Text));
+    EXPECT_EQ(in.u32(), 4u);
+    EXPECT_EQ(in.u32(), 2u);
+    EXPECT_EQ(in.u8(), static_cast<uint32_t>(Attribute::TextLength));
+    EXPECT_EQ(in.u32(), 12u);
+
+    ASSERT_EQ(in.u32(), 1u);
+    EXPECT_EQ(in.u32(), 1u);
+    EXPECT_EQ(in.f32(), 0.0f);
+    EXPECT_EQ(in.f32(), 120.0f);
+    EXPECT_EQ(in.f32(), 390.0f);
+    EXPECT_EQ(in.f32(), 2400.0f);
+    EXPECT_EQ(in.pos, data.size());
+}
+
+TEST(HierarchySnapshotTest, ResetStartsAnEmptySnapshot) {
+    HierarchySnapshotBuilder builder;
+    builder.setScreen(390, 844, 3, "Home");
+    builder.addNode(-1, 10, "UIWindow", Frame(), 1, 0);
+    builder.reset();
+    EXPECT_EQ(builder.nodeCount(), 0u);
+    EXPECT_EQ(builder.intern("UIWindow"), 0u);
+
+    const std::string data = builder.serialize(0, 1);
+    Reader in{data};
+    in.bytes(4 + 1 + 8 + 12);
+    EXPECT_EQ(in.u32(), HierarchySnapshotBuilder::kNoString);
+    EXPECT_EQ(in.u32(), 1u);
+    EXPECT_EQ(in.u32(), 1u);
+}
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImageScaler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using rejourney::ImageScaler;
+
+namespace {
+
+struct Bitmap {
+    size_t width;
+    size_t height;
+    size_t bytesPerRow;
+    std::vector<uint8_t> pixels;
+
+    Bitmap(size_t w, size_t h, size_t padding = 0) : width(w), height(h), bytesPerRow(w * 4 + padding), pixels(bytesPerRow * h) {}
+
+    uint8_t &at(size_t x, size_t y, size_t c) { return pixels[y * bytesPerRow + x * 4 + c]; }
+    uint8_t at(size_t x, size_t y, size_t c) const { return pixels[y * bytesPerRow + x * 4 + c]; }
+};
+
+Bitmap noise(size_t w, size_t h, uint32_t seed) {
+    Bitmap b(w, h, 12);
+    std::mt19937 rng(seed);
+    for (auto &p : b.pixels) {
+        p = static_cast<uint8_t>(rng());
+    }
+    return b;
+}
+
+/// Area average in floating point.
+double boxReference(const Bitmap &src, size_t dstW, size_t dstH, size_t x, size_t y, size_t c) {
+    const double rx = static_cast<double>(src.width) / dstW, ry = static_cast<double>(src.height) / dstH;
+    const double x0 = x * rx, x1 = (x + 1) * rx, y0 = y * ry, y1 = (y + 1) * ry;
+    double sum = 0;
+    for (size_t sy = static_cast<size_t>(y0); sy < src.height && sy < y1; ++sy) {
+        const double wy = std::min(y1, sy + 1.0) - std::max(y0, static_cast<double>(sy));
+        for (size_t sx = static_cast<size_t>(x0); sx < src.width && sx < x1; ++sx) {
+            const double wx = std::min(x1, sx + 1.0) - std::max(x0, static_cast<double>(sx));
+            sum += wx * wy * src.at(sx, sy, c);
+        }
+    }
+    return sum / (rx * ry);
+}
+
+int maxBoxError(const Bitmap &src, const Bitmap &dst) {
+    int worst = 0;
+    for (size_t y = 0; y < dst.height; ++y) {
+        for (size_t x = 0; x < dst.width; ++x) {
+            for (size_t c = 0; c < 4; ++c) {
+                const double expected = boxReference(src, dst.width, dst.height, x, y, c);
+                worst = std::max(worst, static_cast<int>(std::ceil(std::abs(dst.at(x, y, c) - expected) - 1e-9)));
+            }
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+TEST(ImageScalerTest, HalvingAveragesEachBlock) {
+    const Bitmap src = noise(16, 10, 1);
+    Bitmap dst(8, 5);
+    ImageScaler scaler;
+    ASSERT_TRUE(scaler.scale(src.pixels.data(), src.width, src.height, src.bytesPerRow, dst.pixels.data(), dst.width,
+                             dst.height, dst.bytesPerRow));
+    for (size_t y = 0; y < dst.height; ++y) {
+        for (size_t x = 0; x < dst.width; ++x) {
+            for (size_t c = 0; c < 4; ++c) {
+                const int sum = src.at(2 * x, 2 * y, c) + src.at(2 * x + 1, 2 * y, c) + src.at(2 * x, 2 * y + 1, c) +
+                                src.at(2 * x + 1, 2 * y + 1, c);
+                EXPECT_LE(std::abs(dst.at(x, y, c) * 4 - sum), 4) << x << "," << y << "," << c;
+            }
+        }
+    }
+}
+
+TEST(ImageScalerTest, FractionalRatiosMatchTheAreaAverage) {
+    // Odd widths leave a scalar tail after the vector loops.
+    const std::vector<std::pair<size_t, size_t>> sizes = {{390, 844}, {37, 23}, {101, 3}, {5, 5}};
+    ImageScaler scaler;
+    for (const auto &size : sizes) {
+        const Bitmap src = noise(size.first, size.second, static_cast<uint32_t>(size.first));
+        for (const double ratio : {1.25, 1.6, 2.0, 3.3}) {
+            Bitmap dst(std::max<size_t>(1, static_cast<size_t>(size.first / ratio)),
+                       std::max<size_t>(1, static_cast<size_t>(size.second / ratio)), 8);
+            ASSERT_TRUE(scaler.scale(src.pixels.data(), src.width, src.height, src.bytesPerRow, dst.pixels.data(),
+                                     dst.width, dst.height, dst.bytesPerRow));
+            EXPECT_LE(maxBoxError(src, dst), 1) << size.first << "x" << size.second << " / " << ratio;
+        }
+    }
+}
+
+TEST(ImageScalerTest, FlatColourStaysExact) {
+    Bitmap src(390, 844);
+    for (size_t i = 0; i < src.pixels.size(); i += 4) {
+        src.pixels[i] = 0x12, src.pixels[i + 1] = 0xEF, src.pixels[i + 2] = 0x80, src.pixels[i + 3] = 0xFF;
+    }
+    ImageScaler scaler;
+    for (const auto filter : {ImageScaler::Filter::Box, ImageScaler::Filter::Bilinear}) {
+        Bitmap dst(312, 675);
+        ASSERT_TRUE(scaler.scale(src.pixels.data(), src.width, src.height, src.bytesPerRow, dst.pixels.data(),
+                                 dst.width, dst.height, dst.bytesPerRow, filter));
+        for (size_t i = 0; i < dst.pixels.size(); i += 4) {
+            ASSERT_EQ(dst.pixels[i], 0x12);
+            ASSERT_EQ(dst.pixels[i + 1], 0xEF);
+            ASSERT_EQ(dst.pixels[i + 2], 0x80);
+            ASSERT_EQ(dst.pixels[i + 3], 0xFF);
+        }
+    }
+}
+
+TEST(ImageScalerTest, BilinearInterpolatesBetweenNeighbours) {
+    // A horizontal ramp 0, 10, 20, ... halved samples between pixel pairs.
+    Bitmap src(8, 2);
+    for (size_t y = 0; y < 2; ++y) {
+        for (size_t x = 0; x < 8; ++x) {
+            for (size_t c = 0; c < 4; ++c) {
+                src.at(x, y, c) = static_cast<uint8_t>(x * 10);
+            }
+        }
+    }
+    Bitmap dst(4, 1);
+    ImageScaler scaler;
+    ASSERT_TRUE(scaler.scale(src.pixels.data(), 8, 2, src.bytesPerRow, dst.pixels.data(), 4, 1, dst.bytesPerRow,
+                             ImageScaler::Filter::Bilinear));
+    for (size_t x = 0; x < 4; ++x) {
+        EXPECT_EQ(dst.at(x, 0, 0), 5 + 20 * x);
+    }
+}
+
+TEST(ImageScalerTest, RejectsInvalidSizesAndStrides) {
+    Bitmap src(4, 4);
+    Bitmap dst(2, 2);
+    ImageScaler scaler;
+    EXPECT_FALSE(scaler.scale(src.pixels.data(), 0, 4, 16, dst.pixels.data(), 2, 2, 8));
+    EXPECT_FALSE(scaler.scale(src.pixels.data(), 4, 4, 12, dst.pixels.data(), 2, 2, 8));
+    EXPECT_FALSE(scaler.scale(src.pixels.data(), 4, 4, 16, dst.pixels.data(), 2, 0, 8));
+    EXPECT_FALSE(scaler.scale(nullptr, 4, 4, 16, dst.pixels.data(), 2, 2, 8));
+    EXPECT_TRUE(scaler.scale(src.pixels.data(), 4, 4, 16, dst.pixels.data(), 2, 2, 8));
+}
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JpegEncoder.h"
+
+#if REJOURNEY_WITH_LIBJPEG
+
+#include <gtest/gtest.h>
+
+#include <jpeglib.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using rejourney::JpegEncoder;
+using rejourney::JpegEncoderPool;
+
+namespace {
+
+struct Bitmap {
+    size_t width;
+    size_t height;
+    size_t bytesPerRow;
+    std::vector<uint8_t> pixels;
+
+    /// Smooth BGRX gradient, so a decoded copy stays close to the source.
+    Bitmap(size_t w, size_t h) : width(w), height(h), bytesPerRow(w * 4 + 12), pixels(bytesPerRow * h) {
+        for (size_t y = 0; y < h; ++y) {
+            for (size_t x = 0; x < w; ++x) {
+                uint8_t *p = pixels.data() + y * bytesPerRow + x * 4;
+                p[0] = static_cast<uint8_t>(x * 255 / w);
+                p[1] = static_cast<uint8_t>(y * 255 / h);
+                p[2] = static_cast<uint8_t>(128 + (x + y) % 64);
+                p[3] = 0xFF;
+            }
+        }
+    }
+};
+
+struct Decoded {
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<uint8_t> rgb;
+};
+
+Decoded decode(const std::string &jpeg) {
+    jpeg_decompress_struct cinfo;
+    jpeg_error_mgr errors;
+    cinfo.err = jpeg_std_error(&errors);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, reinterpret_cast<const unsigned char *>(jpeg.data()), static_cast<unsigned long>(jpeg.size()));
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.out_color_space = JCS_RGB;
+    jpeg_start_decompress(&cinfo);
+    Decoded out;
+    out.width = cinfo.output_width;
+    out.height = cinfo.output_height;
+    out.rgb.resize(out.width * out.height * 3);
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = out.rgb.data() + static_cast<size_t>(cinfo.output_scanline) * out.width * 3;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return out;
+}
+
+double meanError(const Bitmap &source, const Decoded &decoded) {
+    double total = 0;
+    for (size_t y = 0; y < source.height; ++y) {
+        for (size_t x = 0; x < source.width; ++x) {
+            const uint8_t *p = source.pixels.data() + y * source.bytesPerRow + x * 4;
+            const uint8_t *q = decoded.rgb.data() + (y * decoded.width + x) * 3;
+            total += std::abs(p[2] - q[0]) + std::abs(p[1] - q[1]) + std::abs(p[0] - q[2]);
+        }
+    }
+    return total / static_cast<double>(source.width * source.height * 3);
+}
+
+/// Horizontal and vertical sampling factors of the first component (SOF0).
+std::pair<int, int> lumaSampling(const std::string &jpeg) {
+    for (size_t i = 0; i + 11 < jpeg.size(); ++i) {
+        if (static_cast<uint8_t>(jpeg[i]) == 0xFF && (static_cast<uint8_t>(jpeg[i + 1]) == 0xC0 ||
+                                                      static_cast<uint8_t>(jpeg[i + 1]) == 0xC1)) {
+            const auto factors = static_cast<uint8_t>(jpeg[i + 11]);
+            return {factors >> 4, factors & 0x0F};
+        }
+    }
+    return {0, 0};
+}
+
+bool hasRestartMarkers(const std::string &jpeg) {
+    return jpeg.find(std::string("\xFF\xDD", 2)) != std::string::npos;
+}
+
+} // namespace
+
+TEST(JpegEncoderTest, EncodesBitmapThatDecodesCloseToSource) {
+    Bitmap frame(123, 77);
+    JpegEncoder encoder;
+    JpegEncoder::Options options;
+    options.quality = 90;
+    ASSERT_TRUE(encoder.encode(frame.pixels.data(), frame.width, frame.height, frame.bytesPerRow,
+                               JpegEncoder::PixelFormat::BGRX, options));
+    Decoded decoded = decode(encoder.output());
+    ASSERT_EQ(decoded.width, 123u);
+    ASSERT_EQ(decoded.height, 77u);
+    EXPECT_LT(meanError(frame, decoded), 3.0);
+}
+
+TEST(JpegEncoderTest, ChannelOrderIsHonoured) {
+    Bitmap bgrx(64, 48);
+    Bitmap rgbx = bgrx;
+    for (size_t i = 0; i < rgbx.pixels.size(); i += 4) {
+        std::swap(rgbx.pixels[i], rgbx.pixels[i + 2]);
+    }
+    JpegEncoder encoder;
+    JpegEncoder::Options options;
+    ASSERT_TRUE(encoder.encode(bgrx.pixels.data(), 64, 48, bgrx.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    const std::string fromBgrx = encoder.output();
+    ASSERT_TRUE(encoder.encode(rgbx.pixels.data(), 64, 48, rgbx.bytesPerRow, JpegEncoder::PixelFormat::RGBX, options));
+    EXPECT_EQ(encoder.output(), fromBgrx);
+}
+
+TEST(JpegEncoderTest, OptionsReachTheBitstream) {
+    Bitmap frame(96, 64);
+    JpegEncoder encoder;
+    JpegEncoder::Options options;
+
+    options.subsampling = JpegEncoder::Subsampling::S444;
+    ASSERT_TRUE(encoder.encode(frame.pixels.data(), 96, 64, frame.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    EXPECT_EQ(lumaSampling(encoder.output()), std::make_pair(1, 1));
+    EXPECT_FALSE(hasRestartMarkers(encoder.output()));
+    const size_t plainSize = encoder.output().size();
+
+    options.subsampling = JpegEncoder::Subsampling::S422;
+    options.restartRows = 1;
+    ASSERT_TRUE(encoder.encode(frame.pixels.data(), 96, 64, frame.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    EXPECT_EQ(lumaSampling(encoder.output()), std::make_pair(2, 1));
+    EXPECT_TRUE(hasRestartMarkers(encoder.output()));
+
+    options.subsampling = JpegEncoder::Subsampling::S444;
+    options.restartRows = 0;
+    options.optimizeHuffman = true;
+    ASSERT_TRUE(encoder.encode(frame.pixels.data(), 96, 64, frame.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    EXPECT_LT(encoder.output().size(), plainSize);
+    EXPECT_EQ(decode(encoder.output()).width, 96u);
+}
+
+TEST(JpegEncoderTest, RejectsInvalidInputAndRecovers) {
+    Bitmap frame(32, 32);
+    JpegEncoder encoder;
+    JpegEncoder::Options options;
+    EXPECT_FALSE(encoder.encode(frame.pixels.data(), 32, 32, 64, JpegEncoder::PixelFormat::BGRX, options));
+    EXPECT_FALSE(encoder.encode(nullptr, 32, 32, frame.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    EXPECT_TRUE(encoder.output().empty());
+    ASSERT_TRUE(encoder.encode(frame.pixels.data(), 32, 32, frame.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    EXPECT_EQ(decode(encoder.output()).height, 32u);
+}
+
+TEST(JpegEncoderTest, TakenOutputSurvivesTheNextEncode) {
+    Bitmap frame(64, 48);
+    JpegEncoder encoder;
+    JpegEncoder::Options options;
+    ASSERT_TRUE(encoder.encode(frame.pixels.data(), 64, 48, frame.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    const std::string copy = encoder.output();
+    const std::string taken = encoder.takeOutput();
+    EXPECT_EQ(taken, copy);
+    EXPECT_TRUE(encoder.output().empty());
+
+    ASSERT_TRUE(encoder.encode(frame.pixels.data(), 64, 48, frame.bytesPerRow, JpegEncoder::PixelFormat::BGRX, options));
+    EXPECT_EQ(taken, copy);
+    EXPECT_EQ(encoder.output(), copy);
+}
+
+TEST(JpegEncoderTest, PoolReusesReleasedEncoders) {
+    JpegEncoderPool pool(1);
+    const JpegEncoder *kept;
+    {
+        auto lease = pool.acquire();
+        kept = &*lease;
+    }
+    auto again = pool.acquire();
+    EXPECT_EQ(&*again, kept);
+    auto concurrent = pool.acquire();
+    EXPECT_NE(&*concurrent, kept);
+}
+
+#endif // REJOURNEY_WITH_LIBJPEG
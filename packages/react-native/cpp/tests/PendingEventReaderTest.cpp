@@ -0,0 +1,157 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PendingEventReader.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using rejourney::PendingEventReader;
+using rejourney::SegmentedLog;
+
+namespace {
+
+class PendingEventReaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/rj_pending_XXXXXX";
+        ASSERT_NE(::mkdtemp(pattern), nullptr);
+        root_ = pattern;
+        logDir_ = root_ + "/events.wal";
+        legacyPath_ = root_ + "/events.jsonl";
+    }
+
+    void TearDown() override {
+        std::string command = "rm -rf '" + root_ + "'";
+        std::system(command.c_str());
+    }
+
+    void writeLog(const std::vector<std::string> &events, size_t segmentBytes = SegmentedLog::kDefaultSegmentBytes) {
+        SegmentedLog log(logDir_, segmentBytes);
+        ASSERT_TRUE(log.open());
+        for (const auto &event : events) {
+            ASSERT_TRUE(log.append(event, 1));
+        }
+    }
+
+    void writeLegacy(const std::string &contents) {
+        FILE *file = std::fopen(legacyPath_.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::fwrite(contents.data(), 1, contents.size(), file);
+        std::fclose(file);
+    }
+
+    std::vector<std::pair<std::string, size_t>> readAll(size_t maxBatchBytes) {
+        PendingEventReader reader(logDir_, legacyPath_, maxBatchBytes, "{\"platform\":\"ios\"}");
+        std::vector<std::pair<std::string, size_t>> batches;
+        std::string payload;
+        size_t count = 0;
+        while (reader.next(payload, count)) {
+            batches.emplace_back(payload, count);
+        }
+        return batches;
+    }
+
+    std::string root_;
+    std::string logDir_;
+    std::string legacyPath_;
+};
+
+} // namespace
+
+TEST_F(PendingEventReaderTest, WrapsEventsWithDeviceInfo) {
+    writeLog({"{\"a\":1}", "{\"b\":2}"});
+    auto batches = readAll(1 << 20);
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].first, "{\"events\":[{\"a\":1},{\"b\":2}],\"deviceInfo\":{\"platform\":\"ios\"}}");
+    EXPECT_EQ(batches[0].second, 2u);
+}
+
+TEST_F(PendingEventReaderTest, EmptySessionYieldsNoBatches) {
+    EXPECT_TRUE(readAll(1 << 20).empty());
+}
+
+TEST_F(PendingEventReaderTest, SplitsOnByteBudgetAcrossSegments) {
+    std::vector<std::string> events;
+    for (int i = 0; i < 200; ++i) {
+        events.push_back("{\"i\":" + std::to_string(i) + ",\"pad\":\"xxxxxxxxxxxxxxxx\"}");
+    }
+    writeLog(events, 512);
+
+    auto batches = readAll(400);
+    ASSERT_GT(batches.size(), 10u);
+    size_t total = 0;
+    std::string joined;
+    for (const auto &[payload, count] : batches) {
+        EXPECT_LE(payload.size(), 400u);
+        total += count;
+        joined += payload;
+    }
+    EXPECT_EQ(total, 200u);
+    size_t cursor = 0;
+    for (const auto &event : events) {
+        cursor = joined.find(event, cursor);
+        ASSERT_NE(cursor, std::string::npos) << event;
+    }
+}
+
+TEST_F(PendingEventReaderTest, OversizedEventIsSentAlone) {
+    std::string large = "{\"blob\":\"" + std::string(1000, 'x') + "\"}";
+    writeLog({"{\"a\":1}", large, "{\"b\":2}"});
+    auto batches = readAll(200);
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(batches[1].second, 1u);
+    EXPECT_NE(batches[1].first.find(large), std::string::npos);
+}
+
+TEST_F(PendingEventReaderTest, ReadsLegacyJsonlBeforeLogAndSkipsTornLines) {
+    writeLegacy("{\"legacy\":1}\r\n\n  {\"legacy\":2}\n{\"torn\":");
+    writeLog({"{\"wal\":1}"});
+    auto batches = readAll(1 << 20);
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].second, 3u);
+    EXPECT_EQ(batches[0].first,
+              "{\"events\":[{\"legacy\":1},{\"legacy\":2},{\"wal\":1}],\"deviceInfo\":{\"platform\":\"ios\"}}");
+}
+
+TEST_F(PendingEventReaderTest, ResumesAfterDeliveredBatches) {
+    writeLegacy("{\"legacy\":1}\n");
+    std::vector<std::string> events;
+    for (int i = 0; i < 40; ++i) {
+        events.push_back("{\"i\":" + std::to_string(i) + "}");
+    }
+    writeLog(events);
+    auto all = readAll(120);
+    ASSERT_GT(all.size(), 3u);
+
+    // Two batches went out before the upload failed; the retry starts with
+    // the third.
+    PendingEventReader reader(logDir_, legacyPath_, 120, "{\"platform\":\"ios\"}");
+    EXPECT_EQ(reader.skip(all[0].second + all[1].second), all[0].second + all[1].second);
+    std::string payload;
+    size_t count = 0;
+    ASSERT_TRUE(reader.next(payload, count));
+    EXPECT_EQ(payload, all[2].first);
+    EXPECT_EQ(count, all[2].second);
+
+    PendingEventReader done(logDir_, legacyPath_, 120, "{}");
+    EXPECT_EQ(done.skip(1000), 41u);
+    EXPECT_FALSE(done.next(payload, count));
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RateController.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using rejourney::RateController;
+
+namespace {
+
+/// Feeds frames every `intervalMs` from `startMs` to `endMs`, sized as a
+/// screen of `complexity` bytes at quality 50 and scale 1 would encode at
+/// whatever setting the controller asks for. Returns the rung after each
+/// frame.
+std::vector<size_t> run(RateController &controller, double complexity, uint64_t intervalMs, uint64_t startMs,
+                        uint64_t endMs) {
+    std::vector<size_t> rungs;
+    for (uint64_t now = startMs; now < endMs; now += intervalMs) {
+        const auto setting = controller.setting();
+        const auto bytes = static_cast<size_t>(complexity * RateController::cost(setting.quality, setting.scale));
+        controller.onFrameEncoded(setting, bytes, now);
+        rungs.push_back(controller.rung());
+    }
+    return rungs;
+}
+
+} // namespace
+
+TEST(RateControllerTest, LadderLowersQualityThenScale) {
+    RateController controller;
+    ASSERT_GT(controller.rungCount(), 2u);
+    EXPECT_EQ(controller.setting().quality, 50);
+    EXPECT_FLOAT_EQ(controller.setting().scale, 1.25f);
+
+    RateController::Setting previous = controller.setting();
+    double previousCost = RateController::cost(previous.quality, previous.scale);
+    for (size_t i = 1; i < controller.rungCount(); ++i) {
+        controller.onBacklog(0);
+        const auto setting = controller.setting();
+        const double cost = RateController::cost(setting.quality, setting.scale);
+        EXPECT_LT(cost, previousCost);
+        EXPECT_TRUE(setting.quality < previous.quality || setting.scale > previous.scale);
+        if (setting.scale > 1.25f) {
+            EXPECT_EQ(setting.quality, 20);
+        }
+        previous = setting;
+        previousCost = cost;
+    }
+    EXPECT_EQ(previous.quality, 20);
+    EXPECT_FLOAT_EQ(previous.scale, 2.0f);
+    EXPECT_FALSE(controller.onBacklog(0));
+}
+
+TEST(RateControllerTest, KeepsConfiguredQualityUnderTheTarget) {
+    RateController controller;
+    controller.start(0);
+    // 30 KB at the top rung, once a second.
+    const double complexity = 30000 / RateController::cost(50, 1.25f);
+    for (size_t rung : run(controller, complexity, 1000, 0, 60000)) {
+        EXPECT_EQ(rung, 0u);
+    }
+}
+
+TEST(RateControllerTest, StepsDownUntilTheRateFits) {
+    RateController controller;
+    controller.start(0);
+    // 80 KB/s at the top rung against a 40 KB/s target.
+    const double complexity = 80000 / RateController::cost(50, 1.25f);
+    const auto rungs = run(controller, complexity, 1000, 0, 30000);
+    for (size_t i = 1; i < rungs.size(); ++i) {
+        EXPECT_LE(rungs[i], rungs[i - 1] + controller.options().maxStepDown);
+    }
+    EXPECT_GT(rungs.back(), 0u);
+    EXPECT_LE(controller.encodedBytesPerSecond(30000), controller.targetBytesPerSecond());
+    // Settles rather than oscillating.
+    for (size_t i = rungs.size() - 10; i < rungs.size(); ++i) {
+        EXPECT_EQ(rungs[i], rungs.back());
+    }
+}
+
+TEST(RateControllerTest, RecoversOneRungPerHold) {
+    RateController controller;
+    controller.start(0);
+    run(controller, 200000, 500, 0, 20000);
+    const size_t low = controller.rung();
+    ASSERT_GT(low, 2u);
+
+    // The screen goes quiet: quality comes back, one rung per hold.
+    const auto rungs = run(controller, 10000, 500, 20000, 60000);
+    EXPECT_EQ(rungs.back(), 0u);
+    size_t steps = 0;
+    size_t previous = low;
+    for (size_t rung : rungs) {
+        EXPECT_GE(rung + 1, previous);
+        steps += rung < previous;
+        previous = rung;
+    }
+    EXPECT_EQ(steps, low);
+    EXPECT_GE(rungs.size(), low * controller.options().holdMs / 500);
+}
+
+TEST(RateControllerTest, ConstrainedNetworksAndSlowUploadsLowerTheTarget) {
+    RateController controller;
+    controller.start(0);
+    EXPECT_EQ(controller.targetBytesPerSecond(), 40u * 1024);
+    controller.setConstrained(true);
+    EXPECT_EQ(controller.targetBytesPerSecond(), 12u * 1024);
+
+    const double complexity = 30000 / RateController::cost(50, 1.25f);
+    run(controller, complexity, 1000, 0, 30000);
+    EXPECT_GT(controller.rung(), 0u);
+    EXPECT_LE(controller.encodedBytesPerSecond(30000), 12 * 1024);
+
+    controller.setConstrained(false);
+    controller.onUploadCompleted(8000, 1000);
+    EXPECT_EQ(controller.targetBytesPerSecond(), 4000u);
+    controller.onUploadCompleted(0, 0);
+    EXPECT_EQ(controller.targetBytesPerSecond(), 4000u);
+}
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RedactionCompositor.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using rejourney::RedactionCompositor;
+
+namespace {
+
+constexpr uint32_t kMask = 0xFF102030u;
+
+struct Bitmap {
+    size_t width;
+    size_t height;
+    size_t bytesPerRow;
+    std::vector<uint8_t> pixels;
+
+    Bitmap(size_t w, size_t h) : width(w), height(h), bytesPerRow(w * 4 + 16), pixels(bytesPerRow * h) {
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = static_cast<uint8_t>(i * 7);
+        }
+    }
+
+    uint32_t at(size_t x, size_t y) const {
+        uint32_t value;
+        std::memcpy(&value, pixels.data() + y * bytesPerRow + x * 4, 4);
+        return value;
+    }
+
+    void set(size_t x, size_t y, uint32_t value) { std::memcpy(pixels.data() + y * bytesPerRow + x * 4, &value, 4); }
+};
+
+size_t area(const std::vector<RedactionCompositor::Rect> &rects) {
+    size_t total = 0;
+    for (const auto &r : rects) {
+        total += static_cast<size_t>(r.width) * static_cast<size_t>(r.height);
+    }
+    return total;
+}
+
+} // namespace
+
+TEST(RedactionCompositorTest, AdjacentRegionsMergeIntoOneRect) {
+    RedactionCompositor compositor;
+    compositor.add(0, 0, 4, 4);
+    compositor.add(4, 0, 4, 4);
+    compositor.add(0, 4, 8, 4);
+    const auto &rects = compositor.coalesce(100, 100);
+    ASSERT_EQ(rects.size(), 1u);
+    EXPECT_EQ(rects[0].x, 0);
+    EXPECT_EQ(rects[0].y, 0);
+    EXPECT_EQ(rects[0].width, 8);
+    EXPECT_EQ(rects[0].height, 8);
+}
+
+TEST(RedactionCompositorTest, NestedRegionsAreNotOutermost) {
+    RedactionCompositor compositor;
+    compositor.add(10, 10, 50, 50);
+    compositor.add(20, 20, 5, 5);
+    compositor.add(10, 10, 50, 50);
+    compositor.add(55, 55, 20, 20);
+    const auto &rects = compositor.coalesce(100, 100);
+    EXPECT_EQ(area(rects), 50u * 50u + 20u * 20u - 5u * 5u);
+    EXPECT_TRUE(compositor.isOutermost(0));
+    EXPECT_FALSE(compositor.isOutermost(1));
+    EXPECT_FALSE(compositor.isOutermost(2));
+    EXPECT_TRUE(compositor.isOutermost(3));
+}
+
+TEST(RedactionCompositorTest, ClipsAndRoundsOutward) {
+    RedactionCompositor compositor;
+    compositor.add(-5.5f, 2.2f, 10, 3.1f);
+    compositor.add(NAN, 0, 4, 4);
+    compositor.add(90, 90, 0, 4);
+    compositor.add(200, 200, 10, 10);
+    const auto &rects = compositor.coalesce(8, 8);
+    ASSERT_EQ(rects.size(), 1u);
+    EXPECT_EQ(rects[0].x, 0);
+    EXPECT_EQ(rects[0].y, 2);
+    EXPECT_EQ(rects[0].width, 5);
+    EXPECT_EQ(rects[0].height, 4);
+    EXPECT_EQ(compositor.regionCount(), 4u);
+    EXPECT_TRUE(compositor.isOutermost(0));
+    EXPECT_FALSE(compositor.isOutermost(1));
+    EXPECT_FALSE(compositor.isOutermost(2));
+    EXPECT_FALSE(compositor.isOutermost(3));
+}
+
+TEST(RedactionCompositorTest, PaintMatchesNaiveFill) {
+    std::mt19937 rng(11);
+    for (int round = 0; round < 50; ++round) {
+        Bitmap actual(97, 61);
+        Bitmap expected = actual;
+        RedactionCompositor compositor;
+        const int regions = 1 + static_cast<int>(rng() % 30);
+        for (int i = 0; i < regions; ++i) {
+            const float x = static_cast<float>(static_cast<int>(rng() % 130) - 15) + (rng() % 4) * 0.25f;
+            const float y = static_cast<float>(static_cast<int>(rng() % 90) - 15) + (rng() % 4) * 0.25f;
+            const float w = static_cast<float>(rng() % 40) + (rng() % 4) * 0.25f;
+            const float h = static_cast<float>(rng() % 40) + (rng() % 4) * 0.25f;
+            compositor.add(x, y, w, h);
+            if (w <= 0 || h <= 0) {
+                continue;
+            }
+            for (long py = static_cast<long>(std::floor(y)); py < static_cast<long>(std::ceil(y + h)); ++py) {
+                for (long px = static_cast<long>(std::floor(x)); px < static_cast<long>(std::ceil(x + w)); ++px) {
+                    if (px >= 0 && py >= 0 && px < 97 && py < 61) {
+                        expected.set(static_cast<size_t>(px), static_cast<size_t>(py), kMask);
+                    }
+                }
+            }
+        }
+        compositor.paint(actual.pixels.data(), actual.width, actual.height, actual.bytesPerRow, kMask);
+        ASSERT_EQ(actual.pixels, expected.pixels) << "round " << round;
+
+        size_t masked = 0;
+        for (size_t y = 0; y < 61; ++y) {
+            for (size_t x = 0; x < 97; ++x) {
+                masked += actual.at(x, y) == kMask;
+            }
+        }
+        // Disjoint: every masked pixel is painted exactly once.
+        EXPECT_EQ(area(compositor.coalesce(97, 61)), masked);
+    }
+}
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SegmentedLog.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using rejourney::SegmentedLog;
+
+namespace {
+
+class SegmentedLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/rj_wal_XXXXXX";
+        ASSERT_NE(::mkdtemp(pattern), nullptr);
+        root_ = pattern;
+        dir_ = root_ + "/session/events.wal";
+    }
+
+    void TearDown() override {
+        std::string command = "rm -rf '" + root_ + "'";
+        std::system(command.c_str());
+    }
+
+    std::vector<std::string> readAll() {
+        std::vector<std::string> records;
+        SegmentedLog::forEach(dir_, [&](std::string_view payload, int64_t) {
+            records.emplace_back(payload);
+            return true;
+        });
+        return records;
+    }
+
+    off_t fileSize(const std::string &name) {
+        struct stat st;
+        return ::stat((dir_ + "/" + name).c_str(), &st) == 0 ? st.st_size : -1;
+    }
+
+    void overwrite(const std::string &name, off_t offset, const std::string &bytes) {
+        int fd = ::open((dir_ + "/" + name).c_str(), O_RDWR);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(::pwrite(fd, bytes.data(), bytes.size(), offset), static_cast<ssize_t>(bytes.size()));
+        ::close(fd);
+    }
+
+    std::string root_;
+    std::string dir_;
+};
+
+} // namespace
+
+TEST_F(SegmentedLogTest, AppendsAndReplaysInOrder) {
+    SegmentedLog log(dir_);
+    ASSERT_TRUE(log.open());
+    EXPECT_TRUE(log.append("{\"a\":1}", 100));
+    EXPECT_TRUE(log.append("{\"b\":2}", 300));
+    EXPECT_TRUE(log.append("{\"c\":3}", 200));
+    EXPECT_FALSE(log.append("", 400));
+
+    auto stats = log.stats();
+    EXPECT_EQ(stats.count, 3u);
+    EXPECT_EQ(stats.lastTimestampMs, 300);
+    EXPECT_EQ(stats.segments, 1u);
+
+    EXPECT_EQ(readAll(), (std::vector<std::string>{"{\"a\":1}", "{\"b\":2}", "{\"c\":3}"}));
+}
+
+TEST_F(SegmentedLogTest, RollsSegmentsAndRecoversFromFooters) {
+    {
+        SegmentedLog log(dir_, 256);
+        ASSERT_TRUE(log.open());
+        for (int i = 0; i < 40; ++i) {
+            ASSERT_TRUE(log.append("event-" + std::to_string(i), 1000 + i));
+        }
+        EXPECT_GT(log.stats().segments, 3u);
+    }
+
+    auto inspected = SegmentedLog::inspect(dir_);
+    EXPECT_EQ(inspected.count, 40u);
+    EXPECT_EQ(inspected.lastTimestampMs, 1039);
+
+    SegmentedLog reopened(dir_, 256);
+    ASSERT_TRUE(reopened.open());
+    EXPECT_EQ(reopened.stats().count, 40u);
+    ASSERT_TRUE(reopened.append("event-40", 1040));
+
+    auto records = readAll();
+    ASSERT_EQ(records.size(), 41u);
+    for (int i = 0; i <= 40; ++i) {
+        EXPECT_EQ(records[i], "event-" + std::to_string(i));
+    }
+}
+
+TEST_F(SegmentedLogTest, TruncatesTornTailOnRecovery) {
+    {
+        SegmentedLog log(dir_);
+        ASSERT_TRUE(log.open());
+        ASSERT_TRUE(log.append("first", 1));
+        ASSERT_TRUE(log.append("second", 2));
+    }
+    // Corrupt the payload of the last record: header 8 + record 16 + "first" 5 + header 16.
+    overwrite("00000001.seg", 8 + 16 + 5 + 16, "X");
+
+    SegmentedLog log(dir_);
+    ASSERT_TRUE(log.open());
+    EXPECT_EQ(log.stats().count, 1u);
+    EXPECT_EQ(log.stats().lastTimestampMs, 1);
+
+    ASSERT_TRUE(log.append("third", 3));
+    EXPECT_EQ(readAll(), (std::vector<std::string>{"first", "third"}));
+}
+
+TEST_F(SegmentedLogTest, ResealsSegmentWithDamagedFooter) {
+    {
+        SegmentedLog log(dir_, 128);
+        ASSERT_TRUE(log.open());
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(log.append("payload-" + std::to_string(i), i));
+        }
+    }
+    overwrite("00000001.seg", 128 - 32, std::string(32, '\0'));
+
+    EXPECT_EQ(SegmentedLog::inspect(dir_).count, 10u);
+
+    SegmentedLog log(dir_, 128);
+    ASSERT_TRUE(log.open());
+    EXPECT_EQ(log.stats().count, 10u);
+
+    char magic[4] = {};
+    int fd = ::open((dir_ + "/00000001.seg").c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::pread(fd, magic, 4, 128 - 32), 4);
+    ::close(fd);
+    EXPECT_EQ(std::string(magic, 4), "RJWF");
+}
+
+TEST_F(SegmentedLogTest, OversizedRecordGetsItsOwnSegment) {
+    SegmentedLog log(dir_, 128);
+    ASSERT_TRUE(log.open());
+    ASSERT_TRUE(log.append("small", 1));
+    std::string large(1000, 'x');
+    ASSERT_TRUE(log.append(large, 2));
+    ASSERT_TRUE(log.append("after", 3));
+
+    EXPECT_EQ(fileSize("00000001.seg"), 128);
+    EXPECT_GE(fileSize("00000002.seg"), 1000);
+    EXPECT_EQ(readAll(), (std::vector<std::string>{"small", large, "after"}));
+}
+
+TEST_F(SegmentedLogTest, ClearRemovesSegments) {
+    SegmentedLog log(dir_, 128);
+    ASSERT_TRUE(log.open());
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(log.append("payload-" + std::to_string(i), i));
+    }
+    ASSERT_TRUE(log.clear());
+    EXPECT_EQ(log.stats().count, 0u);
+    EXPECT_TRUE(readAll().empty());
+
+    ASSERT_TRUE(log.append("fresh", 42));
+    EXPECT_EQ(readAll(), (std::vector<std::string>{"fresh"}));
+}
+
+TEST_F(SegmentedLogTest, MissingDirectoryReadsAsEmpty) {
+    EXPECT_TRUE(SegmentedLog::forEach(root_ + "/absent", [](std::string_view, int64_t) { return true; }));
+    EXPECT_EQ(SegmentedLog::inspect(root_ + "/absent").count, 0u);
+}
@@ -0,0 +1,185 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TileDeltaEncoder.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using rejourney::TileDeltaEncoder;
+
+namespace {
+
+struct Bitmap {
+    size_t width;
+    size_t height;
+    size_t bytesPerRow;
+    std::vector<uint8_t> pixels;
+
+    Bitmap(size_t w, size_t h) : width(w), height(h), bytesPerRow(w * 4 + 32), pixels(bytesPerRow * h) {
+        for (size_t y = 0; y < h; ++y) {
+            for (size_t x = 0; x < w * 4; ++x) {
+                pixels[y * bytesPerRow + x] = static_cast<uint8_t>((x / 4 + y) & 0xFF);
+            }
+        }
+    }
+
+    uint8_t *at(size_t x, size_t y) { return pixels.data() + y * bytesPerRow + x * 4; }
+
+    TileDeltaEncoder::Result encode(TileDeltaEncoder &encoder, TileDeltaEncoder::Delta &delta, bool force = false) {
+        return encoder.encode(pixels.data(), width, height, bytesPerRow, force, delta);
+    }
+};
+
+TileDeltaEncoder::Options smallTiles() {
+    TileDeltaEncoder::Options options;
+    options.tileSize = 16;
+    options.tolerance = 0;
+    return options;
+}
+
+uint16_t readU16(const std::string &data, size_t offset) {
+    return static_cast<uint16_t>((static_cast<uint8_t>(data[offset]) << 8) | static_cast<uint8_t>(data[offset + 1]));
+}
+
+} // namespace
+
+TEST(TileDeltaEncoderTest, FirstFrameIsKeyframeAndUnchangedFrameHasNoTiles) {
+    TileDeltaEncoder encoder(smallTiles());
+    Bitmap frame(100, 70);
+    TileDeltaEncoder::Delta delta;
+    EXPECT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_TRUE(delta.tiles.empty());
+    EXPECT_EQ(delta.atlasWidth, 0u);
+    EXPECT_TRUE(delta.atlasPixels.empty());
+}
+
+TEST(TileDeltaEncoderTest, PacksChangedTilesIntoAtlas) {
+    TileDeltaEncoder encoder(smallTiles());
+    Bitmap frame(100, 70);
+    TileDeltaEncoder::Delta delta;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+
+    frame.at(20, 5)[1] ^= 0xFF;  // tile (1, 0)
+    frame.at(99, 69)[0] ^= 0xFF; // edge tile (6, 4), 4x6 pixels
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    ASSERT_EQ(delta.tiles.size(), 2u);
+    EXPECT_EQ(delta.tiles[0].first, 1);
+    EXPECT_EQ(delta.tiles[0].second, 0);
+    EXPECT_EQ(delta.tiles[1].first, 6);
+    EXPECT_EQ(delta.tiles[1].second, 4);
+    EXPECT_EQ(delta.atlasColumns, 2u);
+    EXPECT_EQ(delta.atlasWidth, 32u);
+    EXPECT_EQ(delta.atlasHeight, 16u);
+
+    const uint8_t *atlas = delta.atlasPixels.data();
+    // Tile (1, 0) pixel (20, 5) lands at atlas (4, 5).
+    EXPECT_EQ(std::memcmp(atlas + 5 * delta.atlasBytesPerRow() + 4 * 4, frame.at(20, 5), 4), 0);
+    // Edge tile pixel (99, 69) lands at atlas (16 + 3, 5).
+    EXPECT_EQ(std::memcmp(atlas + 5 * delta.atlasBytesPerRow() + 19 * 4, frame.at(99, 69), 4), 0);
+    // Outside the clipped edge tile the atlas stays zero.
+    EXPECT_EQ(atlas[5 * delta.atlasBytesPerRow() + 20 * 4], 0);
+}
+
+TEST(TileDeltaEncoderTest, DeltasAreRelativeToKeyframe) {
+    TileDeltaEncoder encoder(smallTiles());
+    Bitmap frame(64, 64);
+    TileDeltaEncoder::Delta delta;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+
+    frame.at(0, 0)[0] ^= 0xFF;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_EQ(delta.tiles.size(), 1u);
+    // Same change again is still a one-tile delta against the keyframe.
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_EQ(delta.tiles.size(), 1u);
+    // Reverting it leaves nothing to send.
+    frame.at(0, 0)[0] ^= 0xFF;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_TRUE(delta.tiles.empty());
+}
+
+TEST(TileDeltaEncoderTest, ToleranceIgnoresSmallDifferences) {
+    TileDeltaEncoder::Options options = smallTiles();
+    options.tolerance = 4;
+    TileDeltaEncoder encoder(options);
+    Bitmap frame(64, 64);
+    TileDeltaEncoder::Delta delta;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+    frame.at(10, 10)[2] += 4;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_TRUE(delta.tiles.empty());
+    frame.at(10, 10)[2] += 1;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_EQ(delta.tiles.size(), 1u);
+}
+
+TEST(TileDeltaEncoderTest, LargeChangesBecomeKeyframes) {
+    TileDeltaEncoder encoder(smallTiles());
+    Bitmap frame(64, 64);
+    TileDeltaEncoder::Delta delta;
+    ASSERT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+    for (auto &byte : frame.pixels) {
+        byte ^= 0x80;
+    }
+    EXPECT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+    EXPECT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+}
+
+TEST(TileDeltaEncoderTest, KeyframeIntervalSizeChangeAndForce) {
+    TileDeltaEncoder::Options options = smallTiles();
+    options.keyframeInterval = 3;
+    TileDeltaEncoder encoder(options);
+    Bitmap frame(64, 64);
+    TileDeltaEncoder::Delta delta;
+    EXPECT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+    EXPECT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Delta);
+    EXPECT_EQ(frame.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+    EXPECT_EQ(frame.encode(encoder, delta, true), TileDeltaEncoder::Result::Keyframe);
+
+    Bitmap rotated(64, 32);
+    EXPECT_EQ(rotated.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+    encoder.reset();
+    EXPECT_EQ(rotated.encode(encoder, delta), TileDeltaEncoder::Result::Keyframe);
+}
+
+TEST(TileDeltaEncoderTest, HeaderLayout) {
+    TileDeltaEncoder::Delta delta;
+    delta.tileSize = 32;
+    delta.frameWidth = 390;
+    delta.frameHeight = 844;
+    delta.atlasColumns = 2;
+    delta.tiles = {{3, 7}, {12, 26}};
+    std::string header = delta.header();
+    ASSERT_EQ(header.size(), 15u + 8u);
+    EXPECT_EQ(header.substr(0, 4), "RJTD");
+    EXPECT_EQ(static_cast<uint8_t>(header[4]), TileDeltaEncoder::kFormatVersion);
+    EXPECT_EQ(readU16(header, 5), 32);
+    EXPECT_EQ(readU16(header, 7), 390);
+    EXPECT_EQ(readU16(header, 9), 844);
+    EXPECT_EQ(readU16(header, 11), 2);
+    EXPECT_EQ(readU16(header, 13), 2);
+    EXPECT_EQ(readU16(header, 15), 3);
+    EXPECT_EQ(readU16(header, 17), 7);
+    EXPECT_EQ(readU16(header, 19), 12);
+    EXPECT_EQ(readU16(header, 21), 26);
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UploadLanes.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using rejourney::UploadLanes;
+using Lane = UploadLanes::Lane;
+
+namespace {
+
+UploadLanes::Options options(size_t window, size_t events, size_t hierarchy, size_t frames) {
+    UploadLanes::Options options;
+    options.window = window;
+    options.laneLimit = {events, hierarchy, frames};
+    return options;
+}
+
+} // namespace
+
+TEST(UploadLanesTest, FramesPipelineUpToTheWindow) {
+    UploadLanes lanes(options(3, 1, 1, 4));
+    std::vector<uint64_t> enqueued;
+    for (int i = 0; i < 5; ++i) {
+        enqueued.push_back(lanes.enqueue(Lane::Frames));
+    }
+
+    uint64_t ticket = 0;
+    Lane lane = Lane::Events;
+    std::vector<uint64_t> started;
+    while (lanes.next(ticket, lane)) {
+        EXPECT_EQ(lane, Lane::Frames);
+        started.push_back(ticket);
+    }
+    ASSERT_EQ(started.size(), 3u);
+    EXPECT_EQ(started, std::vector<uint64_t>(enqueued.begin(), enqueued.begin() + 3));
+
+    // Finishing out of order still starts the rest in enqueue order.
+    lanes.finished(started[1]);
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, enqueued[3]);
+    EXPECT_FALSE(lanes.next(ticket, lane));
+    EXPECT_EQ(lanes.stats().peakInFlight, 3u);
+}
+
+TEST(UploadLanesTest, HigherPriorityLanesStartFirst) {
+    UploadLanes lanes(options(2, 1, 1, 4));
+    const auto frame1 = lanes.enqueue(Lane::Frames);
+    const auto frame2 = lanes.enqueue(Lane::Frames);
+    const auto hierarchy = lanes.enqueue(Lane::Hierarchy);
+    const auto events1 = lanes.enqueue(Lane::Events);
+    const auto events2 = lanes.enqueue(Lane::Events);
+
+    uint64_t ticket = 0;
+    Lane lane = Lane::Frames;
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, events1);
+    // Events run one at a time, so hierarchy takes the other place.
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, hierarchy);
+    EXPECT_FALSE(lanes.next(ticket, lane));
+
+    lanes.finished(events1);
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, events2);
+    lanes.finished(hierarchy);
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, frame1);
+    lanes.finished(events2);
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, frame2);
+}
+
+TEST(UploadLanesTest, RetriesGoAheadOfFreshUploadsInOrder) {
+    UploadLanes lanes(options(4, 1, 1, 4));
+    const auto fresh = lanes.enqueue(Lane::Events);
+    const auto retry1 = lanes.enqueue(Lane::Events, true);
+    const auto retry2 = lanes.enqueue(Lane::Events, true);
+
+    uint64_t ticket = 0;
+    Lane lane = Lane::Frames;
+    std::vector<uint64_t> events;
+    while (lanes.next(ticket, lane)) {
+        events.push_back(ticket);
+        lanes.finished(ticket);
+    }
+    EXPECT_EQ(events, (std::vector<uint64_t>{retry1, retry2, fresh}));
+
+    // A retry queued after the earlier ones started still beats fresh work.
+    const auto fresh2 = lanes.enqueue(Lane::Events);
+    const auto retry3 = lanes.enqueue(Lane::Events, true);
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, retry3);
+    lanes.finished(ticket);
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(ticket, fresh2);
+
+    // Unknown and repeated tickets are ignored.
+    lanes.finished(retry1);
+    lanes.finished(9999);
+    EXPECT_EQ(lanes.stats().inFlight, 1u);
+}
+
+TEST(UploadLanesTest, ClearDropsOnlyQueuedUploads) {
+    UploadLanes lanes(options(1, 1, 1, 4));
+    lanes.enqueue(Lane::Frames);
+    lanes.enqueue(Lane::Frames);
+    lanes.enqueue(Lane::Hierarchy);
+
+    uint64_t ticket = 0;
+    Lane lane = Lane::Events;
+    ASSERT_TRUE(lanes.next(ticket, lane));
+    EXPECT_EQ(lane, Lane::Hierarchy);
+    EXPECT_EQ(lanes.clearQueued(), 2u);
+    EXPECT_FALSE(lanes.next(ticket, lane));
+
+    const auto stats = lanes.stats();
+    EXPECT_EQ(stats.inFlight, 1u);
+    EXPECT_EQ(stats.queued[2], 0u);
+
+    // A zero window still lets one upload through once the lane is free.
+    lanes.finished(ticket);
+    lanes.setOptions(options(0, 1, 1, 0));
+    lanes.enqueue(Lane::Frames);
+    EXPECT_TRUE(lanes.next(ticket, lane));
+    EXPECT_FALSE(lanes.next(ticket, lane));
+}
+
+TEST(UploadLanesTest, ConcurrentWorkersNeverExceedLimits) {
+    UploadLanes lanes(options(4, 1, 1, 3));
+    constexpr int kPerLane = 500;
+    std::atomic<int> finished{0};
+    std::atomic<bool> overLimit{false};
+    std::atomic<int> running[UploadLanes::kLaneCount] = {};
+
+    std::thread producer([&] {
+        for (int i = 0; i < kPerLane; ++i) {
+            lanes.enqueue(Lane::Events);
+            lanes.enqueue(Lane::Hierarchy);
+            lanes.enqueue(Lane::Frames);
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&] {
+            const size_t limits[] = {1, 1, 3};
+            while (finished.load() < kPerLane * 3) {
+                uint64_t ticket = 0;
+                Lane lane = Lane::Events;
+                if (!lanes.next(ticket, lane)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto i = static_cast<size_t>(lane);
+                if (static_cast<size_t>(++running[i]) > limits[i]) {
+                    overLimit = true;
+                }
+                --running[i];
+                lanes.finished(ticket);
+                ++finished;
+            }
+        });
+    }
+    producer.join();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_FALSE(overLimit.load());
+    const auto stats = lanes.stats();
+    EXPECT_EQ(stats.inFlight, 0u);
+    EXPECT_LE(stats.peakInFlight, 4u);
+    EXPECT_EQ(stats.queued[0] + stats.queued[1] + stats.queued[2], 0u);
+}
@@ -0,0 +1,328 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UploadPolicy.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using rejourney::UploadPolicy;
+using rejourney::UploadSpool;
+using Kind = UploadPolicy::Kind;
+using Path = UploadPolicy::Path;
+
+namespace {
+
+UploadPolicy::Options options(uint32_t baseFrames, uint32_t maxFrames, uint32_t targetUploadMs) {
+    UploadPolicy::Options options;
+    options.baseBundleFrames = baseFrames;
+    options.maxBundleFrames = maxFrames;
+    options.targetUploadMs = targetUploadMs;
+    options.minSampleBytes = 1024;
+    options.minSamples = 2;
+    options.smoothing = 0.5;
+    return options;
+}
+
+/// Plays the SDK side against a link: each bundle either goes out at the
+/// link's rate or waits in the spool, and path changes drain what they
+/// release.
+class UploadPolicySim {
+public:
+    UploadPolicySim(UploadPolicy &policy, UploadSpool &spool) : policy_(policy), spool_(spool) {}
+
+    void setLink(Path path, bool expensive, bool constrained, double bytesPerSecond) {
+        bytesPerSecond_ = bytesPerSecond;
+        if (policy_.setPath(path, expensive, constrained)) {
+            drain();
+        }
+    }
+
+    void upload(Kind kind, uint64_t bytes, uint32_t frames = 0) {
+        if (kind == Kind::Frames) {
+            policy_.onFrameBundle(bytes, frames);
+        }
+        if (!policy_.shouldSend(kind)) {
+            ASSERT_NE(spool_.put(kind, "", std::string(bytes, 'x'), ++nowMs_), 0u);
+            ++spooled;
+            return;
+        }
+        send(kind, bytes);
+    }
+
+    std::vector<Kind> sent;
+    size_t spooled = 0;
+
+private:
+    void send(Kind kind, uint64_t bytes) {
+        sent.push_back(kind);
+        policy_.onUploadCompleted(bytes, static_cast<double>(bytes) * 1000.0 / bytesPerSecond_);
+    }
+
+    void drain() {
+        Kind lowest = Kind::Crash;
+        if (!policy_.lowestSendable(lowest)) {
+            return;
+        }
+        for (const auto &entry : spool_.pending(1000, {}, lowest)) {
+            send(entry.kind, entry.bytes);
+            spool_.complete(entry.id);
+        }
+    }
+
+    UploadPolicy &policy_;
+    UploadSpool &spool_;
+    double bytesPerSecond_ = 0;
+    int64_t nowMs_ = 0;
+};
+
+/// Mirrors VisualCapture's flush: a bundle is sized when it opens and ships
+/// once full, or once it has been open for the age limit at the idle rate.
+std::vector<uint32_t> captureBundles(const UploadPolicy &policy, uint32_t frames, uint32_t captureIntervalMs,
+                                     uint32_t idleIntervalMs) {
+    std::vector<uint32_t> bundles;
+    uint32_t count = 0;
+    uint32_t target = 0;
+    uint64_t limitMs = 0;
+    uint64_t openedMs = 0;
+    for (uint32_t i = 0; i < frames; ++i) {
+        const uint64_t nowMs = static_cast<uint64_t>(i) * captureIntervalMs;
+        if (++count == 1) {
+            target = policy.bundleFrames();
+            limitMs = policy.bundleAgeLimitMs(idleIntervalMs);
+            openedMs = nowMs;
+        }
+        if (count >= target || nowMs - openedMs >= limitMs) {
+            bundles.push_back(count);
+            count = 0;
+        }
+    }
+    return bundles;
+}
+
+} // namespace
+
+TEST(UploadPolicyTest, SendsEverythingUntilThePathIsKnown) {
+    UploadPolicy policy;
+    EXPECT_TRUE(policy.shouldSend(Kind::Frames));
+    EXPECT_EQ(policy.bundleFrames(), policy.options().baseBundleFrames);
+}
+
+TEST(UploadPolicyTest, MeteredPathsDeferFramesOnly) {
+    UploadPolicy policy;
+    EXPECT_FALSE(policy.setPath(Path::Cellular, true, false));
+    EXPECT_FALSE(policy.shouldSend(Kind::Frames));
+    EXPECT_TRUE(policy.shouldSend(Kind::Hierarchy));
+    EXPECT_TRUE(policy.shouldSend(Kind::Events));
+    EXPECT_TRUE(policy.shouldSend(Kind::Crash));
+    Kind lowest = Kind::Frames;
+    ASSERT_TRUE(policy.lowestSendable(lowest));
+    EXPECT_EQ(lowest, Kind::Hierarchy);
+
+    // Low Data Mode on Wi-Fi defers frames as well; a hotspot is expensive.
+    EXPECT_FALSE(policy.setPath(Path::Wifi, false, true));
+    EXPECT_FALSE(policy.shouldSend(Kind::Frames));
+    EXPECT_FALSE(policy.setPath(Path::Wifi, true, false));
+    EXPECT_FALSE(policy.shouldSend(Kind::Frames));
+
+    EXPECT_TRUE(policy.setPath(Path::Wifi, false, false));
+    EXPECT_TRUE(policy.shouldSend(Kind::Frames));
+    EXPECT_EQ(policy.stats().releases, 1u);
+
+    auto opts = policy.options();
+    opts.deferOnMetered = false;
+    policy.setOptions(opts);
+    policy.setPath(Path::Cellular, true, true);
+    EXPECT_TRUE(policy.shouldSend(Kind::Frames));
+}
+
+TEST(UploadPolicyTest, NothingIsSentWithoutAPath) {
+    UploadPolicy policy;
+    policy.setPath(Path::Wifi, false, false);
+    EXPECT_FALSE(policy.setPath(Path::None, false, false));
+    EXPECT_FALSE(policy.shouldSend(Kind::Crash));
+    Kind lowest = Kind::Frames;
+    EXPECT_FALSE(policy.lowestSendable(lowest));
+
+    // Coming back on cellular releases everything but frames.
+    EXPECT_TRUE(policy.setPath(Path::Cellular, true, false));
+    EXPECT_TRUE(policy.shouldSend(Kind::Events));
+    EXPECT_FALSE(policy.shouldSend(Kind::Frames));
+    // Cellular to Wi-Fi releases the frames too; Wi-Fi to wired releases
+    // nothing new.
+    EXPECT_TRUE(policy.setPath(Path::Wifi, false, false));
+    EXPECT_FALSE(policy.setPath(Path::Wired, false, false));
+}
+
+TEST(UploadPolicyTest, BundlesGrowWithThroughputOnUnmeteredPaths) {
+    UploadPolicy policy(options(3, 30, 2000));
+    policy.setPath(Path::Wifi, false, false);
+    policy.onFrameBundle(30000, 3);
+
+    // One sample is not enough to go on.
+    policy.onUploadCompleted(100000, 1000);
+    EXPECT_EQ(policy.bundleFrames(), 3u);
+    policy.onUploadCompleted(100000, 1000);
+    // 100 KB/s for 2 s at 10 KB a frame.
+    EXPECT_EQ(policy.bundleFrames(), 20u);
+
+    // Uploads too small to measure throughput are ignored.
+    policy.onUploadCompleted(500, 1000);
+    EXPECT_EQ(policy.bundleFrames(), 20u);
+
+    // Capped at the most frames a bundle may hold.
+    policy.onUploadCompleted(1000000, 1000);
+    policy.onUploadCompleted(1000000, 1000);
+    EXPECT_EQ(policy.bundleFrames(), 30u);
+
+    // A slow link never shrinks bundles below the base.
+    policy.setPath(Path::Wired, false, false);
+    policy.onUploadCompleted(2000, 1000);
+    policy.onUploadCompleted(2000, 1000);
+    EXPECT_EQ(policy.bundleFrames(), 3u);
+}
+
+TEST(UploadPolicyTest, ThroughputIsForgottenOnPathChange) {
+    UploadPolicy policy(options(3, 30, 2000));
+    policy.setPath(Path::Wifi, false, false);
+    policy.onFrameBundle(30000, 3);
+    policy.onUploadCompleted(100000, 1000);
+    policy.onUploadCompleted(100000, 1000);
+    EXPECT_EQ(policy.bundleFrames(), 20u);
+
+    // Metered paths keep the base size.
+    policy.setPath(Path::Cellular, true, false);
+    policy.onUploadCompleted(100000, 1000);
+    policy.onUploadCompleted(100000, 1000);
+    EXPECT_EQ(policy.bundleFrames(), 3u);
+
+    // Back on Wi-Fi the new link has to be measured again.
+    policy.setPath(Path::Wifi, false, false);
+    EXPECT_EQ(policy.bundleFrames(), 3u);
+    EXPECT_EQ(policy.stats().throughputSamples, 0u);
+    // Constrained flags changing on the same link keep the measurements.
+    policy.onUploadCompleted(50000, 1000);
+    policy.onUploadCompleted(50000, 1000);
+    policy.setPath(Path::Wifi, false, true);
+    policy.setPath(Path::Wifi, false, false);
+    EXPECT_EQ(policy.bundleFrames(), 10u);
+}
+
+TEST(UploadPolicyTest, BundleAgeLimitGrowsWithBundlesUpToTheCap) {
+    UploadPolicy policy(options(3, 30, 2000));
+    policy.setPath(Path::Cellular, true, false);
+    EXPECT_EQ(policy.bundleAgeLimitMs(5000), 15000u);
+
+    policy.setPath(Path::Wifi, false, false);
+    policy.onFrameBundle(30000, 3);
+    policy.onUploadCompleted(100000, 1000);
+    policy.onUploadCompleted(100000, 1000);
+    ASSERT_EQ(policy.bundleFrames(), 20u);
+    EXPECT_EQ(policy.bundleAgeLimitMs(1000), 20000u);
+    EXPECT_EQ(policy.bundleAgeLimitMs(5000), 60000u);
+
+    // The cap never holds a base-sized bundle to less than it needs.
+    auto opts = policy.options();
+    opts.maxBundleAgeMs = 1000;
+    policy.setOptions(opts);
+    EXPECT_EQ(policy.bundleAgeLimitMs(5000), 15000u);
+}
+
+TEST(UploadPolicyTest, LargerBundlesSurviveTheIdleFlush) {
+    UploadPolicy policy(options(3, 30, 2000));
+    policy.setPath(Path::Wifi, false, false);
+    policy.onFrameBundle(30000, 3);
+    policy.onUploadCompleted(100000, 1000);
+    policy.onUploadCompleted(100000, 1000);
+    ASSERT_EQ(policy.bundleFrames(), 20u);
+
+    // Active capture fills the grown bundles before the age limit.
+    EXPECT_EQ(captureBundles(policy, 60, 1000, 5000), std::vector<uint32_t>(3, 20u));
+
+    // An idle screen, a frame every 5 s, ships at the one-minute cap: 13
+    // frames, not the 4 a limit of three base frames would have allowed.
+    EXPECT_EQ(captureBundles(policy, 60, 5000, 5000), std::vector<uint32_t>(4, 13u));
+
+    // On cellular the base size applies either way.
+    policy.setPath(Path::Cellular, true, false);
+    EXPECT_EQ(captureBundles(policy, 12, 5000, 5000), std::vector<uint32_t>(4, 3u));
+}
+
+TEST(UploadPolicyTest, SimulatedCommuteDefersFramesUntilWifi) {
+    char pattern[] = "/tmp/rj_policy_XXXXXX";
+    ASSERT_NE(::mkdtemp(pattern), nullptr);
+    const std::string root = pattern;
+    {
+        UploadSpool::Options spoolOptions;
+        spoolOptions.byteBudget = 1 << 20;
+        UploadSpool spool(root + "/rj_spool", spoolOptions);
+        ASSERT_TRUE(spool.open());
+        UploadPolicy policy(options(3, 30, 2000));
+        UploadPolicySim sim(policy, spool);
+
+        // Leaving home on Wi-Fi.
+        sim.setLink(Path::Wifi, false, false, 200000);
+        sim.upload(Kind::Events, 4000);
+        sim.upload(Kind::Frames, 30000, 3);
+        sim.upload(Kind::Frames, 30000, 3);
+        EXPECT_EQ(sim.spooled, 0u);
+        EXPECT_GT(policy.bundleFrames(), 3u);
+
+        // Cellular: events, hierarchy and crashes go, frames wait.
+        sim.setLink(Path::Cellular, true, false, 50000);
+        EXPECT_EQ(policy.bundleFrames(), 3u);
+        sim.upload(Kind::Frames, 30000, 3);
+        sim.upload(Kind::Events, 4000);
+        sim.upload(Kind::Hierarchy, 2000);
+        sim.upload(Kind::Frames, 30000, 3);
+        sim.upload(Kind::Crash, 8000);
+
+        // A tunnel: everything waits.
+        sim.setLink(Path::None, false, false, 0);
+        sim.upload(Kind::Events, 4000);
+        sim.upload(Kind::Frames, 30000, 3);
+        EXPECT_EQ(sim.spooled, 4u);
+
+        // Out of the tunnel, the events go and the frames keep waiting.
+        sim.setLink(Path::Cellular, true, false, 50000);
+        ASSERT_EQ(sim.sent.size(), 7u);
+        EXPECT_EQ(sim.sent.back(), Kind::Events);
+        EXPECT_EQ(spool.stats().entries, 3u);
+
+        // At work on Wi-Fi the deferred frames go, oldest first.
+        sim.setLink(Path::Wifi, false, false, 500000);
+        EXPECT_EQ(spool.stats().entries, 0u);
+        const std::vector<Kind> expected = {
+            Kind::Events, Kind::Frames, Kind::Frames,                 // Wi-Fi
+            Kind::Events, Kind::Hierarchy, Kind::Crash,               // cellular
+            Kind::Events,                                             // after the tunnel
+            Kind::Frames, Kind::Frames, Kind::Frames,                 // Wi-Fi again
+        };
+        EXPECT_EQ(sim.sent, expected);
+
+        // Bundles grow once the new link has been measured.
+        sim.upload(Kind::Frames, 30000, 3);
+        EXPECT_EQ(policy.bundleFrames(), 30u);
+    }
+    std::string command = "rm -rf '" + root + "'";
+    std::system(command.c_str());
+}
@@ -0,0 +1,277 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UploadSpool.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using rejourney::UploadSpool;
+using Kind = UploadSpool::Kind;
+
+namespace {
+
+class UploadSpoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/rj_spool_XXXXXX";
+        ASSERT_NE(::mkdtemp(pattern), nullptr);
+        root_ = pattern;
+        dir_ = root_ + "/rj_spool";
+    }
+
+    void TearDown() override {
+        std::string command = "rm -rf '" + root_ + "'";
+        std::system(command.c_str());
+    }
+
+    UploadSpool::Options options(uint64_t byteBudget, uint32_t maxAttempts = 10) {
+        UploadSpool::Options options;
+        options.byteBudget = byteBudget;
+        options.maxAttempts = maxAttempts;
+        return options;
+    }
+
+    std::vector<std::string> payloadFiles() {
+        std::vector<std::string> names;
+        DIR *dir = ::opendir(dir_.c_str());
+        if (!dir) {
+            return names;
+        }
+        while (struct dirent *entry = ::readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, ".up") == 0) {
+                names.push_back(name);
+            }
+        }
+        ::closedir(dir);
+        return names;
+    }
+
+    std::vector<uint64_t> pendingIds(const UploadSpool &spool) {
+        std::vector<uint64_t> ids;
+        for (const auto &entry : spool.pending(1000)) {
+            ids.push_back(entry.id);
+        }
+        return ids;
+    }
+
+    std::string root_;
+    std::string dir_;
+};
+
+} // namespace
+
+TEST_F(UploadSpoolTest, PendingUploadsSurviveReopen) {
+    uint64_t frame = 0;
+    uint64_t events = 0;
+    {
+        UploadSpool spool(dir_, options(1 << 20));
+        ASSERT_TRUE(spool.open());
+        frame = spool.put(Kind::Frames, "frame-meta", std::string(100, 'f'), 1000);
+        events = spool.put(Kind::Events, "event-meta", std::string(50, 'e'), 2000);
+        const auto done = spool.put(Kind::Hierarchy, "tree", "xyz", 3000);
+        ASSERT_NE(frame, 0u);
+        ASSERT_NE(events, 0u);
+        spool.complete(done);
+        EXPECT_TRUE(spool.failed(events));
+    }
+
+    UploadSpool spool(dir_, options(1 << 20));
+    ASSERT_TRUE(spool.open());
+    const auto pending = spool.pending(10);
+    ASSERT_EQ(pending.size(), 2u);
+    EXPECT_EQ(pending[0].id, frame);
+    EXPECT_EQ(pending[0].kind, Kind::Frames);
+    EXPECT_EQ(pending[0].meta, "frame-meta");
+    EXPECT_EQ(pending[0].createdMs, 1000);
+    EXPECT_EQ(pending[1].id, events);
+    EXPECT_EQ(pending[1].attempts, 1u);
+    EXPECT_EQ(spool.stats().bytes, 150u);
+
+    std::string payload;
+    ASSERT_TRUE(spool.read(events, payload));
+    EXPECT_EQ(payload, std::string(50, 'e'));
+    EXPECT_EQ(payloadFiles().size(), 2u);
+
+    // New ids never collide with recovered ones.
+    EXPECT_GT(spool.put(Kind::Frames, "", "n", 4000), events);
+}
+
+TEST_F(UploadSpoolTest, EvictsFramesBeforeEventsBeforeCrashes) {
+    UploadSpool spool(dir_, options(300));
+    ASSERT_TRUE(spool.open());
+    const auto crash = spool.put(Kind::Crash, "", std::string(100, 'c'), 1);
+    const auto frame1 = spool.put(Kind::Frames, "", std::string(50, 'f'), 2);
+    const auto events = spool.put(Kind::Events, "", std::string(100, 'e'), 3);
+    const auto frame2 = spool.put(Kind::Frames, "", std::string(50, 'f'), 4);
+    EXPECT_EQ(spool.stats().bytes, 300u);
+
+    // An event batch pushes out the oldest frames first.
+    const auto events2 = spool.put(Kind::Events, "", std::string(60, 'e'), 5);
+    ASSERT_NE(events2, 0u);
+    EXPECT_EQ(pendingIds(spool), (std::vector<uint64_t>{crash, events, events2}));
+
+    // Frames may not displace events or crashes.
+    EXPECT_EQ(spool.put(Kind::Frames, "", std::string(80, 'f'), 6), 0u);
+    EXPECT_EQ(pendingIds(spool), (std::vector<uint64_t>{crash, events, events2}));
+
+    // A crash report displaces events, oldest first.
+    const auto crash2 = spool.put(Kind::Crash, "", std::string(90, 'c'), 7);
+    ASSERT_NE(crash2, 0u);
+    EXPECT_EQ(pendingIds(spool), (std::vector<uint64_t>{crash, events2, crash2}));
+
+    const auto stats = spool.stats();
+    EXPECT_EQ(stats.evictedEntries, 3u);
+    EXPECT_EQ(stats.evictedBytes, 200u);
+    EXPECT_EQ(stats.refusedPuts, 1u);
+    EXPECT_EQ(payloadFiles().size(), 3u);
+    std::string payload;
+    EXPECT_FALSE(spool.read(frame1, payload));
+    EXPECT_FALSE(spool.read(frame2, payload));
+}
+
+TEST_F(UploadSpoolTest, DropsAfterMaxAttemptsAndWhenTooLarge) {
+    UploadSpool spool(dir_, options(100, 3));
+    ASSERT_TRUE(spool.open());
+    EXPECT_EQ(spool.put(Kind::Crash, "", std::string(101, 'x'), 1), 0u);
+
+    const auto id = spool.put(Kind::Events, "", "batch", 1);
+    EXPECT_TRUE(spool.failed(id));
+    EXPECT_TRUE(spool.failed(id));
+    EXPECT_FALSE(spool.failed(id));
+    EXPECT_TRUE(spool.pending(10).empty());
+    EXPECT_EQ(spool.stats().exhaustedEntries, 1u);
+    EXPECT_FALSE(spool.failed(id));
+}
+
+TEST_F(UploadSpoolTest, PendingSkipsUploadsInFlight) {
+    UploadSpool spool(dir_, options(1 << 20));
+    ASSERT_TRUE(spool.open());
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < 5; ++i) {
+        ids.push_back(spool.put(Kind::Frames, "", "p", i));
+    }
+    const auto pending = spool.pending(2, {ids[0], ids[2]});
+    ASSERT_EQ(pending.size(), 2u);
+    EXPECT_EQ(pending[0].id, ids[1]);
+    EXPECT_EQ(pending[1].id, ids[3]);
+}
+
+TEST_F(UploadSpoolTest, PendingCanLeaveOutLowerKinds) {
+    UploadSpool spool(dir_, options(1 << 20));
+    ASSERT_TRUE(spool.open());
+    spool.put(Kind::Frames, "", "f", 1);
+    const auto hierarchy = spool.put(Kind::Hierarchy, "", "h", 2);
+    spool.put(Kind::Frames, "", "f", 3);
+    const auto events = spool.put(Kind::Events, "", "e", 4);
+
+    const auto pending = spool.pending(10, {}, Kind::Hierarchy);
+    ASSERT_EQ(pending.size(), 2u);
+    EXPECT_EQ(pending[0].id, hierarchy);
+    EXPECT_EQ(pending[1].id, events);
+    EXPECT_EQ(spool.pending(10).size(), 4u);
+}
+
+TEST_F(UploadSpoolTest, RecoveryDropsTornPayloadsAndOrphans) {
+    uint64_t kept = 0;
+    uint64_t torn = 0;
+    {
+        UploadSpool spool(dir_, options(1 << 20));
+        ASSERT_TRUE(spool.open());
+        kept = spool.put(Kind::Events, "", "complete", 1);
+        torn = spool.put(Kind::Frames, "", "truncated", 2);
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%020llu.up", static_cast<unsigned long long>(torn));
+    ASSERT_EQ(::truncate((dir_ + "/" + name).c_str(), 3), 0);
+    FILE *orphan = std::fopen((dir_ + "/00000000000000000999.up").c_str(), "w");
+    ASSERT_NE(orphan, nullptr);
+    std::fclose(orphan);
+
+    UploadSpool spool(dir_, options(1 << 20));
+    ASSERT_TRUE(spool.open());
+    EXPECT_EQ(pendingIds(spool), std::vector<uint64_t>{kept});
+    EXPECT_EQ(payloadFiles().size(), 1u);
+}
+
+TEST_F(UploadSpoolTest, IndexIsRewrittenOnceMostRecordsAreDead) {
+    {
+        UploadSpool spool(dir_, options(1 << 20));
+        ASSERT_TRUE(spool.open());
+        for (int i = 0; i < 500; ++i) {
+            const auto id = spool.put(Kind::Frames, "m", "payload", i);
+            ASSERT_NE(id, 0u);
+            if (i % 10 != 0) {
+                spool.complete(id);
+            }
+        }
+        EXPECT_EQ(spool.stats().entries, 50u);
+    }
+    // The rewrite leaves one index and no staging directories behind.
+    struct stat st;
+    EXPECT_EQ(::stat((dir_ + "/index.next").c_str(), &st), -1);
+    EXPECT_EQ(::stat((dir_ + "/index.old").c_str(), &st), -1);
+
+    size_t records = 0;
+    rejourney::SegmentedLog::forEach(dir_ + "/index", [&](std::string_view, int64_t) {
+        ++records;
+        return true;
+    });
+    EXPECT_LE(records, 50u * 2 + 64 + 1);
+
+    UploadSpool spool(dir_, options(1 << 20));
+    ASSERT_TRUE(spool.open());
+    EXPECT_EQ(spool.stats().entries, 50u);
+    EXPECT_EQ(spool.stats().bytes, 50u * 7);
+}
+
+TEST_F(UploadSpoolTest, InterruptedRewriteIsCompletedOnOpen) {
+    uint64_t id = 0;
+    {
+        UploadSpool spool(dir_, options(1 << 20));
+        ASSERT_TRUE(spool.open());
+        id = spool.put(Kind::Events, "m", "payload", 1);
+    }
+    // A crash between the two renames leaves only index.next.
+    ASSERT_EQ(::rename((dir_ + "/index").c_str(), (dir_ + "/index.next").c_str()), 0);
+
+    UploadSpool spool(dir_, options(1 << 20));
+    ASSERT_TRUE(spool.open());
+    EXPECT_EQ(pendingIds(spool), std::vector<uint64_t>{id});
+}
+
+TEST_F(UploadSpoolTest, LoweredBudgetEvictsOnOpen) {
+    {
+        UploadSpool spool(dir_, options(1000));
+        ASSERT_TRUE(spool.open());
+        spool.put(Kind::Events, "", std::string(400, 'e'), 1);
+        spool.put(Kind::Frames, "", std::string(400, 'f'), 2);
+    }
+    UploadSpool spool(dir_, options(500));
+    ASSERT_TRUE(spool.open());
+    const auto pending = spool.pending(10);
+    ASSERT_EQ(pending.size(), 1u);
+    EXPECT_EQ(pending[0].kind, Kind::Events);
+}
@@ -0,0 +1,415 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Replays recorded session event timelines through CaptureScheduler and
+// through the fixed snapshot timer it replaced, and compares frame counts
+// with how long new interactions and screen changes wait for a frame:
+//   ./_gate_build/rejourney_capture_sim [--cost-ms=N] [--fpm=N] [--interval-ms=N] [path...]
+// Paths are event files (events_*.json[.gz]) or session directories; with
+// none, the dashboard's demo sessions are replayed.
+
+#include "CaptureScheduler.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifndef REJOURNEY_SESSION_CORPUS_DIR
+#define REJOURNEY_SESSION_CORPUS_DIR ""
+#endif
+
+namespace fs = std::filesystem;
+using rejourney::CaptureScheduler;
+
+namespace {
+
+enum class Kind { Interaction, ScreenChange, Low, Medium };
+
+struct Event {
+    uint64_t ms;
+    Kind kind;
+};
+
+bool readFile(const fs::path &path, std::string &out) {
+    gzFile file = gzopen(path.string().c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    char chunk[65536];
+    int n;
+    while ((n = gzread(file, chunk, sizeof(chunk))) > 0) {
+        out.append(chunk, static_cast<size_t>(n));
+    }
+    gzclose(file);
+    return n == 0;
+}
+
+/// Minimal reader for the SDK's flat event objects: only top-level string
+/// and number members are kept, nested values are skipped.
+class EventReader {
+public:
+    explicit EventReader(const std::string &json) : s_(json) {}
+
+    bool read(std::vector<Event> &out) {
+        const size_t key = s_.find("\"events\"");
+        if (key == std::string::npos || (i_ = s_.find('[', key)) == std::string::npos) {
+            return false;
+        }
+        ++i_;
+        while (skipSpace() && s_[i_] != ']') {
+            if (s_[i_] == ',') {
+                ++i_;
+                continue;
+            }
+            if (s_[i_] != '{' || !readEvent(out)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    bool skipSpace() {
+        while (i_ < s_.size() && std::strchr(" \t\r\n", s_[i_])) {
+            ++i_;
+        }
+        return i_ < s_.size();
+    }
+
+    bool readString(std::string &out) {
+        out.clear();
+        for (++i_; i_ < s_.size(); ++i_) {
+            if (s_[i_] == '\\') {
+                ++i_;
+                if (i_ < s_.size()) {
+                    out += s_[i_];
+                }
+            } else if (s_[i_] == '"') {
+                ++i_;
+                return true;
+            } else {
+                out += s_[i_];
+            }
+        }
+        return false;
+    }
+
+    bool skipValue() {
+        if (s_[i_] == '"') {
+            std::string ignored;
+            return readString(ignored);
+        }
+        if (s_[i_] == '{' || s_[i_] == '[') {
+            int depth = 0;
+            std::string ignored;
+            while (i_ < s_.size()) {
+                const char c = s_[i_];
+                if (c == '"') {
+                    if (!readString(ignored)) {
+                        return false;
+                    }
+                    continue;
+                }
+                depth += (c == '{' || c == '[') ? 1 : (c == '}' || c == ']') ? -1 : 0;
+                ++i_;
+                if (depth == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        while (i_ < s_.size() && s_[i_] != ',' && s_[i_] != '}') {
+            ++i_;
+        }
+        return true;
+    }
+
+    bool readEvent(std::vector<Event> &out) {
+        ++i_;
+        std::string key, type, name;
+        uint64_t timestamp = 0;
+        while (skipSpace() && s_[i_] != '}') {
+            if (s_[i_] == ',') {
+                ++i_;
+                continue;
+            }
+            if (s_[i_] != '"' || !readString(key) || !skipSpace() || s_[i_] != ':') {
+                return false;
+            }
+            ++i_;
+            if (!skipSpace()) {
+                return false;
+            }
+            if (key == "type" && s_[i_] == '"') {
+                readString(type);
+            } else if (key == "name" && s_[i_] == '"') {
+                readString(name);
+            } else if (key == "timestamp") {
+                timestamp = std::strtoull(s_.c_str() + i_, nullptr, 10);
+                skipValue();
+            } else if (!skipValue()) {
+                return false;
+            }
+        }
+        ++i_;
+
+        if (type == "touch" || type == "gesture" || type == "tap" || type == "scroll") {
+            out.push_back({timestamp, Kind::Interaction});
+        } else if (type == "navigation" || (type == "custom" && name == "screen_view")) {
+            out.push_back({timestamp, Kind::ScreenChange});
+        } else if (type == "custom" && name != "device_info") {
+            out.push_back({timestamp, Kind::Medium});
+        } else if (type == "network_request") {
+            out.push_back({timestamp, Kind::Low});
+        }
+        return true;
+    }
+
+    const std::string &s_;
+    size_t i_ = 0;
+};
+
+struct Session {
+    std::string name;
+    std::vector<Event> events;
+};
+
+void addEvents(const fs::path &file, Session &session) {
+    std::string json;
+    if (!readFile(file, json) || !EventReader(json).read(session.events)) {
+        std::fprintf(stderr, "skipping unreadable %s\n", file.string().c_str());
+    }
+}
+
+std::vector<Session> loadSessions(const std::vector<std::string> &paths) {
+    std::vector<Session> sessions;
+    for (const auto &path : paths) {
+        std::error_code ec;
+        if (fs::is_regular_file(path, ec)) {
+            Session session{fs::path(path).filename().string(), {}};
+            addEvents(path, session);
+            sessions.push_back(std::move(session));
+            continue;
+        }
+        // A session directory, or a directory of them.
+        std::vector<fs::path> dirs;
+        if (fs::is_directory(fs::path(path) / "events", ec)) {
+            dirs.push_back(path);
+        } else {
+            for (const auto &entry : fs::directory_iterator(path, ec)) {
+                if (fs::is_directory(entry.path() / "events", ec)) {
+                    dirs.push_back(entry.path());
+                }
+            }
+        }
+        std::sort(dirs.begin(), dirs.end());
+        for (const auto &dir : dirs) {
+            Session session{dir.filename().string(), {}};
+            std::vector<fs::path> files;
+            for (const auto &entry : fs::directory_iterator(dir / "events", ec)) {
+                files.push_back(entry.path());
+            }
+            std::sort(files.begin(), files.end());
+            for (const auto &file : files) {
+                addEvents(file, session);
+            }
+            sessions.push_back(std::move(session));
+        }
+    }
+    for (auto &session : sessions) {
+        std::stable_sort(session.events.begin(), session.events.end(),
+                         [](const Event &a, const Event &b) { return a.ms < b.ms; });
+    }
+    sessions.erase(std::remove_if(sessions.begin(), sessions.end(), [](const Session &s) { return s.events.empty(); }),
+                   sessions.end());
+    return sessions;
+}
+
+struct Result {
+    uint64_t durationMs = 0;
+    size_t frames = 0;
+    /// Frames more than 3 s after the last interaction, screen change or
+    /// visual change.
+    size_t idleFrames = 0;
+    /// Wait from each screen change, and each interaction after 500 ms
+    /// without one, to the next frame.
+    std::vector<uint64_t> waits;
+};
+
+Result measure(const Session &session, const std::vector<uint64_t> &frames) {
+    Result result;
+    const uint64_t start = session.events.front().ms;
+    result.durationMs = session.events.back().ms - start;
+    result.frames = frames.size();
+    size_t e = 0;
+    uint64_t lastSignal = start;
+    for (const uint64_t frame : frames) {
+        for (; e < session.events.size() && session.events[e].ms <= frame; ++e) {
+            if (session.events[e].kind != Kind::Low) {
+                lastSignal = session.events[e].ms;
+            }
+        }
+        if (frame > lastSignal + 3000) {
+            ++result.idleFrames;
+        }
+    }
+    // A gesture streams many events; only its first one waits for a frame.
+    uint64_t lastInteraction = 0;
+    for (const auto &event : session.events) {
+        if (event.kind == Kind::Interaction) {
+            const bool onset = lastInteraction == 0 || event.ms > lastInteraction + 500;
+            lastInteraction = event.ms;
+            if (!onset) {
+                continue;
+            }
+        } else if (event.kind != Kind::ScreenChange) {
+            continue;
+        }
+        const auto next = std::lower_bound(frames.begin(), frames.end(), event.ms);
+        if (next != frames.end()) {
+            result.waits.push_back(*next - event.ms);
+        }
+    }
+    return result;
+}
+
+std::vector<uint64_t> runScheduler(const Session &session, const CaptureScheduler::Options &options, float costMs) {
+    CaptureScheduler scheduler(options);
+    std::vector<uint64_t> frames;
+    const uint64_t start = session.events.front().ms;
+    const uint64_t end = session.events.back().ms;
+    scheduler.start(start);
+    size_t next = 0;
+    uint64_t now = start;
+    while (now <= end) {
+        for (; next < session.events.size() && session.events[next].ms <= now; ++next) {
+            switch (session.events[next].kind) {
+            case Kind::Interaction:
+                scheduler.onInteraction(now);
+                break;
+            case Kind::ScreenChange:
+                scheduler.onScreenChange(now);
+                break;
+            case Kind::Low:
+                scheduler.onVisualChange(CaptureScheduler::Importance::Low, now);
+                break;
+            case Kind::Medium:
+                scheduler.onVisualChange(CaptureScheduler::Importance::Medium, now);
+                break;
+            }
+        }
+        const auto decision = scheduler.poll(now);
+        if (decision.capture) {
+            frames.push_back(now);
+            scheduler.reportFrameCost(costMs);
+        }
+        uint64_t wake = decision.nextMs;
+        if (next < session.events.size()) {
+            wake = std::min(wake, session.events[next].ms);
+        }
+        now = std::max(now + 1, wake);
+    }
+    return frames;
+}
+
+std::vector<uint64_t> runTimer(const Session &session, uint64_t intervalMs) {
+    std::vector<uint64_t> frames;
+    for (uint64_t ms = session.events.front().ms; ms <= session.events.back().ms; ms += intervalMs) {
+        frames.push_back(ms);
+    }
+    return frames;
+}
+
+uint64_t percentile(std::vector<uint64_t> values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())))];
+}
+
+void print(const char *policy, const Result &r, float costMs) {
+    const double minutes = std::max(1.0, static_cast<double>(r.durationMs)) / 60000.0;
+    std::printf("  %-9s frames %5zu  per-min %6.1f  idle %5zu  wait p50 %5llu p95 %5llu max %6llu ms  capture %6.0f ms/min\n",
+                policy, r.frames, static_cast<double>(r.frames) / minutes, r.idleFrames,
+                static_cast<unsigned long long>(percentile(r.waits, 0.5)),
+                static_cast<unsigned long long>(percentile(r.waits, 0.95)),
+                static_cast<unsigned long long>(percentile(r.waits, 1.0)),
+                static_cast<double>(r.frames) * costMs / minutes);
+}
+
+void accumulate(Result &total, const Result &r) {
+    total.durationMs += r.durationMs;
+    total.frames += r.frames;
+    total.idleFrames += r.idleFrames;
+    total.waits.insert(total.waits.end(), r.waits.begin(), r.waits.end());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    CaptureScheduler::Options options;
+    float costMs = 12;
+    uint64_t intervalMs = 1000;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--cost-ms=", 0) == 0) {
+            costMs = std::strtof(arg.c_str() + 10, nullptr);
+        } else if (arg.rfind("--fpm=", 0) == 0) {
+            options.framesPerMinute = static_cast<uint32_t>(std::strtoul(arg.c_str() + 6, nullptr, 10));
+        } else if (arg.rfind("--interval-ms=", 0) == 0) {
+            intervalMs = std::max<uint64_t>(1, std::strtoull(arg.c_str() + 14, nullptr, 10));
+            options.activeIntervalMs = static_cast<uint32_t>(intervalMs);
+        } else if (arg.rfind("--", 0) == 0) {
+            std::fprintf(stderr, "usage: %s [--cost-ms=N] [--fpm=N] [--interval-ms=N] [path...]\n", argv[0]);
+            return 2;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty()) {
+        paths.push_back(REJOURNEY_SESSION_CORPUS_DIR);
+    }
+
+    const auto sessions = loadSessions(paths);
+    if (sessions.empty()) {
+        std::fprintf(stderr, "no session events found\n");
+        return 1;
+    }
+    Result timerTotal, schedulerTotal;
+    for (const auto &session : sessions) {
+        const Result timer = measure(session, runTimer(session, intervalMs));
+        const Result scheduled = measure(session, runScheduler(session, options, costMs));
+        std::printf("%s: %zu events over %.1f s\n", session.name.c_str(), session.events.size(),
+                    static_cast<double>(timer.durationMs) / 1000.0);
+        print("timer", timer, costMs);
+        print("scheduler", scheduled, costMs);
+        accumulate(timerTotal, timer);
+        accumulate(schedulerTotal, scheduled);
+    }
+    std::printf("all sessions:\n");
+    print("timer", timerTotal, costMs);
+    print("scheduler", schedulerTotal, costMs);
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// One pooled bitmap, leased from an RJCaptureBufferPool. Returned to the
+/// pool when it is deallocated, or, after `makeImage`, when the image is.
+@interface RJCaptureBuffer : NSObject
+
+@property(nonatomic, readonly) size_t width;
+@property(nonatomic, readonly) size_t height;
+
+/// 32bpp premultiplied BGRA sRGB context over the buffer, cleared and
+/// flipped to UIKit's top-left origin. NULL after `makeImage`.
+@property(nonatomic, readonly, nullable) CGContextRef context;
+
+/// Wraps the pixels in an image without copying them and hands the buffer
+/// to it; the context is released and must not be drawn into again.
+- (nullable CGImageRef)makeImage CF_RETURNS_RETAINED;
+
+/// Wraps pixels written directly by the caller; same hand-over as
+/// `makeImage`. `bitmapInfo` and `colorSpace` describe the layout written.
+- (nullable CGImageRef)makeImageWithColorSpace:(CGColorSpaceRef)colorSpace
+                                    bitmapInfo:(CGBitmapInfo)bitmapInfo CF_RETURNS_RETAINED;
+
+/// The buffer's rows, for callers that write pixels without the context.
+@property(nonatomic, readonly) uint8_t *pixels NS_RETURNS_INNER_POINTER;
+@property(nonatomic, readonly) size_t bytesPerRow;
+
+@end
+
+/// Objective-C facade over cpp/CaptureBufferPool.h: a bounded pool of
+/// capture bitmaps reused across frames. Thread-safe.
+@interface RJCaptureBufferPool : NSObject
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Most buffers out at once, including those held by images not yet
+/// released.
+@property(atomic) NSUInteger capacity;
+
+@property(nonatomic, readonly) NSUInteger outstandingCount;
+@property(nonatomic, readonly) uint64_t allocationCount;
+/// Acquires refused because `capacity` buffers were out.
+@property(nonatomic, readonly) uint64_t exhaustedCount;
+
+/// A buffer of `width` x `height` pixels, or nil when `capacity` are out.
+- (nullable RJCaptureBuffer *)acquireWithWidth:(size_t)width
+                                        height:(size_t)height NS_SWIFT_NAME(acquire(width:height:));
+
+/// The pooled pixels behind an image made by `makeImage` or
+/// `makeImageWithColorSpace:bitmapInfo:`, valid while `image` is; NULL for
+/// any other image. Lets readers skip CGDataProviderCopyData.
++ (nullable const uint8_t *)pixelsOfImage:(CGImageRef)image NS_RETURNS_INNER_POINTER;
+
+@end
+
+NS_ASSUME_NONNULL_END
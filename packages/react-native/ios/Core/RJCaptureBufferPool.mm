@@ -0,0 +1,206 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJCaptureBufferPool.h"
+
+#include "CaptureBufferPool.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+/// Keeps the pool alive for as long as an image holds one of its buffers.
+struct ImageLease {
+  std::shared_ptr<rejourney::CaptureBufferPool> pool;
+  rejourney::CaptureBufferPool::Lease lease;
+  CGDataProviderRef provider = NULL;
+};
+
+/// Providers over pooled buffers, so the scaler and the JPEG encoder can
+/// read a frame in place. An entry goes when its provider is destroyed.
+std::mutex gProvidersLock;
+std::unordered_map<CGDataProviderRef, const uint8_t *> &providerPixels() {
+  static auto *pixels = new std::unordered_map<CGDataProviderRef, const uint8_t *>();
+  return *pixels;
+}
+
+void releaseImageLease(void *info, const void *, size_t) {
+  auto *lease = static_cast<ImageLease *>(info);
+  if (lease->provider) {
+    std::lock_guard<std::mutex> guard(gProvidersLock);
+    providerPixels().erase(lease->provider);
+  }
+  delete lease;
+}
+
+} // namespace
+
+@interface RJCaptureBuffer ()
+
+- (instancetype)initWithPool:(std::shared_ptr<rejourney::CaptureBufferPool>)pool
+                       lease:(rejourney::CaptureBufferPool::Lease)lease;
+
+@end
+
+@implementation RJCaptureBuffer {
+  std::unique_ptr<ImageLease> _lease;
+  CGContextRef _context;
+}
+
+- (instancetype)initWithPool:(std::shared_ptr<rejourney::CaptureBufferPool>)pool
+                       lease:(rejourney::CaptureBufferPool::Lease)lease {
+  self = [super init];
+  if (self) {
+    _lease.reset(new ImageLease{std::move(pool), std::move(lease)});
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_context) {
+    CGContextRelease(_context);
+  }
+}
+
+- (size_t)width {
+  return _lease ? _lease->lease->width : 0;
+}
+
+- (size_t)height {
+  return _lease ? _lease->lease->height : 0;
+}
+
+- (uint8_t *)pixels {
+  return _lease ? _lease->lease->pixels : nullptr;
+}
+
+- (size_t)bytesPerRow {
+  return _lease ? _lease->lease->bytesPerRow : 0;
+}
+
+- (CGContextRef)context {
+  if (!_context && _lease) {
+    const auto &buffer = *_lease->lease;
+    CGColorSpaceRef space = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+    _context = CGBitmapContextCreate(buffer.pixels, buffer.width, buffer.height, 8, buffer.bytesPerRow, space,
+                                     kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little);
+    CGColorSpaceRelease(space);
+    if (_context) {
+      // A recycled buffer still holds an earlier frame.
+      CGContextClearRect(_context, CGRectMake(0, 0, buffer.width, buffer.height));
+      CGContextTranslateCTM(_context, 0, buffer.height);
+      CGContextScaleCTM(_context, 1, -1);
+    }
+  }
+  return _context;
+}
+
+- (CGImageRef)makeImage {
+  if (!_context) {
+    return NULL;
+  }
+  CGColorSpaceRef space = CGColorSpaceRetain(CGBitmapContextGetColorSpace(_context));
+  const CGBitmapInfo info = CGBitmapContextGetBitmapInfo(_context);
+  CGContextRelease(_context);
+  _context = NULL;
+  CGImageRef image = [self makeImageWithColorSpace:space bitmapInfo:info];
+  CGColorSpaceRelease(space);
+  return image;
+}
+
+- (CGImageRef)makeImageWithColorSpace:(CGColorSpaceRef)colorSpace bitmapInfo:(CGBitmapInfo)bitmapInfo {
+  if (!_lease) {
+    return NULL;
+  }
+  const auto &buffer = *_lease->lease;
+  const size_t width = buffer.width;
+  const size_t height = buffer.height;
+  const size_t bytesPerRow = buffer.bytesPerRow;
+  uint8_t *pixels = buffer.pixels;
+  if (_context) {
+    CGContextRelease(_context);
+    _context = NULL;
+  }
+  ImageLease *info = _lease.release();
+  CGDataProviderRef provider = CGDataProviderCreateWithData(info, pixels, bytesPerRow * height, releaseImageLease);
+  if (!provider) {
+    delete info;
+    return NULL;
+  }
+  {
+    std::lock_guard<std::mutex> guard(gProvidersLock);
+    info->provider = provider;
+    providerPixels()[provider] = pixels;
+  }
+  CGImageRef image = CGImageCreate(width, height, 8, 32, bytesPerRow, colorSpace, bitmapInfo, provider, NULL, false,
+                                   kCGRenderingIntentDefault);
+  CGDataProviderRelease(provider);
+  return image;
+}
+
+@end
+
+@implementation RJCaptureBufferPool {
+  std::shared_ptr<rejourney::CaptureBufferPool> _pool;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+  self = [super init];
+  if (self) {
+    _pool = std::make_shared<rejourney::CaptureBufferPool>(capacity);
+  }
+  return self;
+}
+
+- (NSUInteger)capacity {
+  return _pool->capacity();
+}
+
+- (void)setCapacity:(NSUInteger)capacity {
+  _pool->setCapacity(capacity);
+}
+
+- (NSUInteger)outstandingCount {
+  return _pool->stats().outstanding;
+}
+
+- (uint64_t)allocationCount {
+  return _pool->stats().allocations;
+}
+
+- (uint64_t)exhaustedCount {
+  return _pool->stats().exhausted;
+}
+
+- (RJCaptureBuffer *)acquireWithWidth:(size_t)width height:(size_t)height {
+  auto lease = _pool->acquire(width, height);
+  if (!lease) {
+    return nil;
+  }
+  return [[RJCaptureBuffer alloc] initWithPool:_pool lease:std::move(lease)];
+}
+
++ (const uint8_t *)pixelsOfImage:(CGImageRef)image {
+  CGDataProviderRef provider = CGImageGetDataProvider(image);
+  std::lock_guard<std::mutex> guard(gProvidersLock);
+  const auto found = providerPixels().find(provider);
+  return found == providerPixels().end() ? nullptr : found->second;
+}
+
+@end
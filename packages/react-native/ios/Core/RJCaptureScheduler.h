@@ -0,0 +1,67 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Values match cpp/CaptureScheduler.h.
+typedef NS_ENUM(NSInteger, RJVisualChangeImportance) {
+  RJVisualChangeImportanceLow,
+  RJVisualChangeImportanceMedium,
+  /// Captured promptly and never skipped as a repeat.
+  RJVisualChangeImportanceHigh,
+  /// Captured at once, past the frame budget.
+  RJVisualChangeImportanceCritical,
+};
+
+/// Objective-C facade over cpp/CaptureScheduler.h: decides when the next
+/// frame is captured from interactions, screen changes, visual changes and
+/// the measured frame cost, within a frames-per-minute budget. Times are
+/// milliseconds on a monotonic clock. Not thread-safe; use it from the main
+/// thread.
+@interface RJCaptureScheduler : NSObject
+
+/// Frame interval while the user is active, the heartbeat when idle, and
+/// the long-run budget.
+- (void)configureWithActiveIntervalMs:(uint32_t)activeIntervalMs
+                       idleIntervalMs:(uint32_t)idleIntervalMs
+                      framesPerMinute:(uint32_t)framesPerMinute
+    NS_SWIFT_NAME(configure(activeIntervalMs:idleIntervalMs:framesPerMinute:));
+
+/// Starts a session with a frame due at once.
+- (void)startAtMs:(uint64_t)nowMs NS_SWIFT_NAME(start(atMs:));
+
+- (void)noteInteractionAtMs:(uint64_t)nowMs NS_SWIFT_NAME(noteInteraction(atMs:));
+- (void)noteScreenChangeAtMs:(uint64_t)nowMs NS_SWIFT_NAME(noteScreenChange(atMs:));
+- (void)noteVisualChange:(RJVisualChangeImportance)importance
+                    atMs:(uint64_t)nowMs NS_SWIFT_NAME(noteVisualChange(_:atMs:));
+
+/// Main-thread cost of the frame just captured.
+- (void)reportFrameCostMs:(double)costMs NS_SWIFT_NAME(reportFrameCost(ms:));
+
+@property(nonatomic, readonly) double averageFrameCostMs;
+
+/// When the next frame is due; may be in the past.
+- (uint64_t)nextCaptureMsAtMs:(uint64_t)nowMs NS_SWIFT_NAME(nextCaptureMs(atMs:));
+
+/// YES if a frame should be captured now, counting it as taken. `forced`
+/// is set for frames that must not be skipped as repeats.
+- (BOOL)pollAtMs:(uint64_t)nowMs forced:(BOOL *)forced NS_SWIFT_NAME(poll(atMs:forced:));
+
+@end
+
+NS_ASSUME_NONNULL_END
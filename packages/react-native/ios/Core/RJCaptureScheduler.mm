@@ -0,0 +1,95 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJCaptureScheduler.h"
+
+#include "CaptureScheduler.h"
+
+#include <memory>
+
+@implementation RJCaptureScheduler {
+  std::unique_ptr<rejourney::CaptureScheduler> _scheduler;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _scheduler = std::make_unique<rejourney::CaptureScheduler>();
+  }
+  return self;
+}
+
+- (void)configureWithActiveIntervalMs:(uint32_t)activeIntervalMs
+                       idleIntervalMs:(uint32_t)idleIntervalMs
+                      framesPerMinute:(uint32_t)framesPerMinute {
+  auto options = _scheduler->options();
+  options.activeIntervalMs = activeIntervalMs;
+  options.idleIntervalMs = idleIntervalMs;
+  options.framesPerMinute = framesPerMinute;
+  _scheduler->setOptions(options);
+}
+
+- (void)startAtMs:(uint64_t)nowMs {
+  _scheduler->start(nowMs);
+}
+
+- (void)noteInteractionAtMs:(uint64_t)nowMs {
+  _scheduler->onInteraction(nowMs);
+}
+
+- (void)noteScreenChangeAtMs:(uint64_t)nowMs {
+  _scheduler->onScreenChange(nowMs);
+}
+
+- (void)noteVisualChange:(RJVisualChangeImportance)importance atMs:(uint64_t)nowMs {
+  using Importance = rejourney::CaptureScheduler::Importance;
+  switch (importance) {
+    case RJVisualChangeImportanceLow:
+      _scheduler->onVisualChange(Importance::Low, nowMs);
+      break;
+    case RJVisualChangeImportanceMedium:
+      _scheduler->onVisualChange(Importance::Medium, nowMs);
+      break;
+    case RJVisualChangeImportanceHigh:
+      _scheduler->onVisualChange(Importance::High, nowMs);
+      break;
+    case RJVisualChangeImportanceCritical:
+      _scheduler->onVisualChange(Importance::Critical, nowMs);
+      break;
+  }
+}
+
+- (void)reportFrameCostMs:(double)costMs {
+  _scheduler->reportFrameCost(static_cast<float>(costMs));
+}
+
+- (double)averageFrameCostMs {
+  return _scheduler->averageFrameCostMs();
+}
+
+- (uint64_t)nextCaptureMsAtMs:(uint64_t)nowMs {
+  return _scheduler->nextCaptureMs(nowMs);
+}
+
+- (BOOL)pollAtMs:(uint64_t)nowMs forced:(BOOL *)forced {
+  const auto decision = _scheduler->poll(nowMs);
+  if (forced) {
+    *forced = decision.forced;
+  }
+  return decision.capture;
+}
+
+@end
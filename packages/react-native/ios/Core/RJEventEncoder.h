@@ -0,0 +1,40 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over the shared binary event codec (cpp/EventCodec.h).
+/// Events are encoded once when recorded; batches concatenate the encoded
+/// records without parsing them again.
+@interface RJEventEncoder : NSObject
+
+/// `baseTimestampMs` anchors the per-record timestamp deltas.
+- (instancetype)initWithBaseTimestampMs:(int64_t)baseTimestampMs NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Encodes a JSON-compatible event dictionary. Integer "timestamp" and string
+/// "type" entries are stored in the record header.
+- (NSData *)encodeEvent:(NSDictionary<NSString *, id> *)event NS_SWIFT_NAME(encode(_:));
+
+/// Builds an upload batch from records returned by -encodeEvent:.
+- (NSData *)batchWithRecords:(NSArray<NSData *> *)records
+              deviceInfoJSON:(NSData *)deviceInfoJSON NS_SWIFT_NAME(batch(records:deviceInfoJSON:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJEventEncoder.h"
+
+#include "EventCodec.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+static NSString *const kTimestampKey = @"timestamp";
+static NSString *const kTypeKey = @"type";
+
+static std::string_view RJStringView(NSString *string, std::string &storage) {
+  const char *utf8 = string.UTF8String;
+  if (!utf8) {
+    return {};
+  }
+  storage.assign(utf8);
+  return storage;
+}
+
+static BOOL RJIsBoolean(NSNumber *number) {
+  return CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID();
+}
+
+static BOOL RJIsFloatingPoint(NSNumber *number) {
+  const char *type = number.objCType;
+  return type[0] == 'f' || type[0] == 'd';
+}
+
+static void RJWriteValue(rejourney::EventRecordWriter &writer, id value, std::string &scratch) {
+  if (!value || value == [NSNull null]) {
+    writer.nullValue();
+  } else if ([value isKindOfClass:[NSString class]]) {
+    writer.stringValue(RJStringView(value, scratch));
+  } else if ([value isKindOfClass:[NSNumber class]]) {
+    NSNumber *number = value;
+    if (RJIsBoolean(number)) {
+      writer.boolValue(number.boolValue);
+    } else if (RJIsFloatingPoint(number)) {
+      double d = number.doubleValue;
+      // Mirrors JSON, which has no representation for NaN or infinity.
+      if (std::isfinite(d)) {
+        writer.doubleValue(d);
+      } else {
+        writer.nullValue();
+      }
+    } else if (number.objCType[0] == 'Q' && number.unsignedLongLongValue > INT64_MAX) {
+      writer.doubleValue(number.doubleValue);
+    } else {
+      writer.intValue(number.longLongValue);
+    }
+  } else if ([value isKindOfClass:[NSArray class]]) {
+    NSArray *array = value;
+    writer.beginArray(array.count);
+    for (id element in array) {
+      RJWriteValue(writer, element, scratch);
+    }
+  } else if ([value isKindOfClass:[NSDictionary class]]) {
+    NSDictionary *dict = value;
+    writer.beginObject(dict.count);
+    for (id key in dict) {
+      NSString *name = [key isKindOfClass:[NSString class]] ? key : [key description];
+      writer.key(RJStringView(name, scratch));
+      RJWriteValue(writer, dict[key], scratch);
+    }
+  } else {
+    writer.stringValue(RJStringView([value description], scratch));
+  }
+}
+
+static NSData *RJDataFromString(std::string &&bytes) {
+  auto *owned = new std::string(std::move(bytes));
+  return [[NSData alloc] initWithBytesNoCopy:owned->data()
+                                      length:owned->size()
+                                 deallocator:^(void *, NSUInteger) {
+                                   delete owned;
+                                 }];
+}
+
+@implementation RJEventEncoder {
+  std::unique_ptr<rejourney::EventEncoder> _encoder;
+}
+
+- (instancetype)initWithBaseTimestampMs:(int64_t)baseTimestampMs {
+  self = [super init];
+  if (self) {
+    _encoder = std::make_unique<rejourney::EventEncoder>(baseTimestampMs);
+  }
+  return self;
+}
+
+- (NSData *)encodeEvent:(NSDictionary<NSString *, id> *)event {
+  int64_t timestamp = 0;
+  const int64_t *timestampPtr = nullptr;
+  id rawTimestamp = event[kTimestampKey];
+  if ([rawTimestamp isKindOfClass:[NSNumber class]] && !RJIsBoolean(rawTimestamp) &&
+      !RJIsFloatingPoint(rawTimestamp)) {
+    timestamp = [rawTimestamp longLongValue];
+    timestampPtr = &timestamp;
+  }
+
+  std::string typeStorage;
+  std::string_view type;
+  const std::string_view *typePtr = nullptr;
+  id rawType = event[kTypeKey];
+  if ([rawType isKindOfClass:[NSString class]]) {
+    type = RJStringView(rawType, typeStorage);
+    typePtr = &type;
+  }
+
+  size_t fieldCount = event.count - (timestampPtr ? 1 : 0) - (typePtr ? 1 : 0);
+  auto writer = _encoder->beginRecord(timestampPtr, typePtr, fieldCount);
+  std::string scratch;
+  for (NSString *key in event) {
+    if ((timestampPtr && [key isEqualToString:kTimestampKey]) ||
+        (typePtr && [key isEqualToString:kTypeKey])) {
+      continue;
+    }
+    writer.key(RJStringView(key, scratch));
+    RJWriteValue(writer, event[key], scratch);
+  }
+  return RJDataFromString(writer.finish());
+}
+
+- (NSData *)batchWithRecords:(NSArray<NSData *> *)records deviceInfoJSON:(NSData *)deviceInfoJSON {
+  std::vector<std::string_view> views;
+  views.reserve(records.count);
+  for (NSData *record in records) {
+    views.emplace_back(static_cast<const char *>(record.bytes), record.length);
+  }
+  std::string_view meta(static_cast<const char *>(deviceInfoJSON.bytes), deviceInfoJSON.length);
+  return RJDataFromString(_encoder->buildBatch(views, meta));
+}
+
+@end
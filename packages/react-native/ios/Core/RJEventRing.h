@@ -0,0 +1,43 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over the shared C++ event ring (cpp/EventRing.h).
+/// Pushes are lock-free and O(1); a full ring overwrites its oldest event.
+@interface RJEventRing : NSObject
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property(nonatomic, readonly) NSUInteger count;
+
+/// Number of events overwritten because the ring was full.
+@property(nonatomic, readonly) uint64_t evictedCount;
+
+- (void)push:(NSData *)record;
+
+/// Removes events in FIFO order up to `maxBytes` (at least one event when non-empty).
+- (NSArray<NSData *> *)drainWithMaxBytes:(NSUInteger)maxBytes NS_SWIFT_NAME(drain(maxBytes:));
+
+/// Discards all pending events and returns how many were dropped.
+- (NSUInteger)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJEventRing.h"
+
+#include "EventRing.h"
+
+#include <memory>
+#include <string>
+
+@implementation RJEventRing {
+  std::unique_ptr<rejourney::EventRing> _ring;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+  self = [super init];
+  if (self) {
+    _ring = std::make_unique<rejourney::EventRing>(capacity);
+  }
+  return self;
+}
+
+- (NSUInteger)count {
+  return _ring->size();
+}
+
+- (uint64_t)evictedCount {
+  return _ring->evicted();
+}
+
+- (void)push:(NSData *)record {
+  _ring->push(std::string(static_cast<const char *>(record.bytes), record.length));
+}
+
+- (NSArray<NSData *> *)drainWithMaxBytes:(NSUInteger)maxBytes {
+  std::vector<std::string> batch = _ring->drain(maxBytes);
+  NSMutableArray<NSData *> *result = [NSMutableArray arrayWithCapacity:batch.size()];
+  for (std::string &record : batch) {
+    // Hand the drained bytes to NSData without copying; the string is freed
+    // together with the NSData.
+    auto *owned = new std::string(std::move(record));
+    NSData *data = [[NSData alloc] initWithBytesNoCopy:owned->data()
+                                                length:owned->size()
+                                           deallocator:^(void *, NSUInteger) {
+                                             delete owned;
+                                           }];
+    [result addObject:data];
+  }
+  return result;
+}
+
+- (NSUInteger)clear {
+  return _ring->clear();
+}
+
+@end
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A finished gzip frame bundle and the frames it covers.
+@interface RJFrameBundle : NSObject
+
+@property(nonatomic, readonly) NSData *payload;
+@property(nonatomic, readonly) NSUInteger frameCount;
+@property(nonatomic, readonly) uint64_t firstTimestampMs;
+@property(nonatomic, readonly) uint64_t lastTimestampMs;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/// Objective-C facade over cpp/FrameBundleWriter.h: writes frames into the
+/// open bundle as they are appended, storing or deflating each batch
+/// depending on how compressible its first frame is.
+@interface RJFrameBundleWriter : NSObject
+
+@property(nonatomic, readonly) NSUInteger frameCount;
+/// Capture time of the first frame in the open batch, or 0 when empty.
+@property(nonatomic, readonly) uint64_t firstTimestampMs;
+
+- (void)resetWithSessionEpochMs:(uint64_t)sessionEpochMs NS_SWIFT_NAME(reset(sessionEpochMs:));
+
+/// `quality` (0...1) is recorded for the frame in the bundle header.
+- (BOOL)appendFrame:(NSData *)jpeg
+        timestampMs:(uint64_t)timestampMs
+            quality:(CGFloat)quality NS_SWIFT_NAME(append(_:timestampMs:quality:));
+
+/// Appends a tile delta payload from RJTileDeltaEncoder. NO if the batch is
+/// empty; a bundle must open with a full frame.
+- (BOOL)appendDelta:(NSData *)payload
+        timestampMs:(uint64_t)timestampMs
+            quality:(CGFloat)quality NS_SWIFT_NAME(appendDelta(_:timestampMs:quality:));
+
+/// Records that the screen still shows the last appended frame. NO if no
+/// frame has been appended since the last reset.
+- (BOOL)appendRepeatWithTimestampMs:(uint64_t)timestampMs NS_SWIFT_NAME(appendRepeat(timestampMs:));
+
+/// Closes the open batch and starts the next one. Nil when no frames were
+/// appended.
+- (nullable RJFrameBundle *)finish;
+
+/// Bundle of the frames appended so far; the batch stays open.
+- (nullable RJFrameBundle *)snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJFrameBundleWriter.h"
+
+#include "FrameBundleWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace {
+
+uint8_t headerQuality(CGFloat quality) {
+  return static_cast<uint8_t>(std::max(1L, std::min(100L, std::lround(quality * 100))));
+}
+
+} // namespace
+
+@implementation RJFrameBundle
+
+- (instancetype)initWithBundle:(rejourney::FrameBundleWriter::Bundle &)bundle {
+  self = [super init];
+  if (self) {
+    auto *payload = new std::string(std::move(bundle.payload));
+    _payload = [[NSData alloc] initWithBytesNoCopy:payload->data()
+                                            length:payload->size()
+                                       deallocator:^(void *, NSUInteger) {
+                                         delete payload;
+                                       }];
+    _frameCount = bundle.frameCount;
+    _firstTimestampMs = bundle.firstTimestampMs;
+    _lastTimestampMs = bundle.lastTimestampMs;
+  }
+  return self;
+}
+
+@end
+
+@implementation RJFrameBundleWriter {
+  std::unique_ptr<rejourney::FrameBundleWriter> _writer;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _writer = std::make_unique<rejourney::FrameBundleWriter>();
+  }
+  return self;
+}
+
+- (NSUInteger)frameCount {
+  return _writer->frameCount();
+}
+
+- (uint64_t)firstTimestampMs {
+  return _writer->firstTimestampMs();
+}
+
+- (void)resetWithSessionEpochMs:(uint64_t)sessionEpochMs {
+  _writer->reset(sessionEpochMs);
+}
+
+- (BOOL)appendFrame:(NSData *)jpeg timestampMs:(uint64_t)timestampMs quality:(CGFloat)quality {
+  return _writer->append(static_cast<const uint8_t *>(jpeg.bytes), jpeg.length, timestampMs, headerQuality(quality));
+}
+
+- (BOOL)appendDelta:(NSData *)payload timestampMs:(uint64_t)timestampMs quality:(CGFloat)quality {
+  return _writer->appendDelta(static_cast<const uint8_t *>(payload.bytes), payload.length, timestampMs,
+                              headerQuality(quality));
+}
+
+- (BOOL)appendRepeatWithTimestampMs:(uint64_t)timestampMs {
+  return _writer->appendRepeat(timestampMs);
+}
+
+- (RJFrameBundle *)finish {
+  rejourney::FrameBundleWriter::Bundle bundle;
+  if (!_writer->finish(bundle)) {
+    return nil;
+  }
+  return [[RJFrameBundle alloc] initWithBundle:bundle];
+}
+
+- (RJFrameBundle *)snapshot {
+  rejourney::FrameBundleWriter::Bundle bundle;
+  if (!_writer->snapshot(bundle)) {
+    return nil;
+  }
+  return [[RJFrameBundle alloc] initWithBundle:bundle];
+}
+
+@end
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over cpp/FrameCredits.h: upload slots granted by the
+/// dispatcher, turned into credits capture must hold before it renders a
+/// frame. Thread-safe.
+@interface RJFrameCredits : NSObject
+
+- (instancetype)initWithQueueSlots:(NSUInteger)queueSlots framesPerBundle:(NSUInteger)framesPerBundle;
+
+/// Frames capture batches into one bundle; each free slot is worth this many
+/// frame credits.
+@property(nonatomic) NSUInteger framesPerBundle;
+
+/// Takes a credit for one frame. NO when uploads are too far behind.
+- (BOOL)acquireFrame;
+/// Gives back credits of frames that will not be queued.
+- (void)releaseFrames:(NSUInteger)frames;
+/// Drops every reservation, at the start of a session.
+- (void)resetFrames;
+@property(nonatomic, readonly) NSUInteger frameCredits;
+
+/// `frames` captured frames went into a bundle that is now queued.
+- (void)bundleQueuedWithFrames:(NSUInteger)frames NS_SWIFT_NAME(bundleQueued(frames:));
+/// Forgets queued bundles the pipeline discarded.
+- (void)clearBundles;
+
+/// Slots the dispatcher grants right now; none while it refuses uploads.
+@property(nonatomic) NSUInteger uploadSlots;
+/// Moves the next queued bundle into an upload slot. NO when nothing is
+/// queued or every slot is taken.
+- (BOOL)startUpload;
+/// An upload started by startUpload is over; `requeued` when the bundle went
+/// back to the front of the queue.
+- (void)uploadFinishedRequeued:(BOOL)requeued NS_SWIFT_NAME(uploadFinished(requeued:));
+
+@property(nonatomic, readonly) NSUInteger queuedBundles;
+@property(nonatomic, readonly) NSUInteger uploadingBundles;
+@property(nonatomic, readonly) uint64_t deniedFrames;
+
+@end
+
+NS_ASSUME_NONNULL_END
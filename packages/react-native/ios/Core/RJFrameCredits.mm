@@ -0,0 +1,101 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJFrameCredits.h"
+
+#include "FrameCredits.h"
+
+#include <algorithm>
+#include <memory>
+
+@implementation RJFrameCredits {
+  std::unique_ptr<rejourney::FrameCredits> _credits;
+}
+
+- (instancetype)initWithQueueSlots:(NSUInteger)queueSlots framesPerBundle:(NSUInteger)framesPerBundle {
+  self = [super init];
+  if (self) {
+    rejourney::FrameCredits::Options options;
+    options.queueSlots = queueSlots;
+    options.framesPerBundle = std::max<NSUInteger>(1, framesPerBundle);
+    _credits = std::make_unique<rejourney::FrameCredits>(options);
+  }
+  return self;
+}
+
+- (NSUInteger)framesPerBundle {
+  return _credits->options().framesPerBundle;
+}
+
+- (void)setFramesPerBundle:(NSUInteger)framesPerBundle {
+  auto options = _credits->options();
+  options.framesPerBundle = std::max<NSUInteger>(1, framesPerBundle);
+  _credits->setOptions(options);
+}
+
+- (BOOL)acquireFrame {
+  return _credits->acquireFrame();
+}
+
+- (void)releaseFrames:(NSUInteger)frames {
+  _credits->releaseFrames(frames);
+}
+
+- (void)resetFrames {
+  _credits->resetFrames();
+}
+
+- (NSUInteger)frameCredits {
+  return _credits->frameCredits();
+}
+
+- (void)bundleQueuedWithFrames:(NSUInteger)frames {
+  _credits->bundleQueued(frames);
+}
+
+- (void)clearBundles {
+  _credits->clearBundles();
+}
+
+- (NSUInteger)uploadSlots {
+  return _credits->stats().uploadSlots;
+}
+
+- (void)setUploadSlots:(NSUInteger)uploadSlots {
+  _credits->setUploadSlots(uploadSlots);
+}
+
+- (BOOL)startUpload {
+  return _credits->startUpload();
+}
+
+- (void)uploadFinishedRequeued:(BOOL)requeued {
+  _credits->uploadFinished(requeued);
+}
+
+- (NSUInteger)queuedBundles {
+  return _credits->stats().queuedBundles;
+}
+
+- (NSUInteger)uploadingBundles {
+  return _credits->stats().uploadingBundles;
+}
+
+- (uint64_t)deniedFrames {
+  return _credits->stats().deniedFrames;
+}
+
+@end
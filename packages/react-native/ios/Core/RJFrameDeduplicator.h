@@ -0,0 +1,34 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over cpp/FrameDeduplicator.h: tells whether a captured
+/// frame looks the same as the last frame that was kept.
+@interface RJFrameDeduplicator : NSObject
+
+/// Returns YES if `image` matches the last kept frame; otherwise `image`
+/// becomes the frame later captures are compared against.
+- (BOOL)isRepeatFrame:(CGImageRef)image NS_SWIFT_NAME(isRepeat(_:));
+
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
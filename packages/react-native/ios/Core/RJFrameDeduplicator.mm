@@ -0,0 +1,55 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJFrameDeduplicator.h"
+
+#include "FrameDeduplicator.h"
+
+#include <memory>
+
+@implementation RJFrameDeduplicator {
+  std::unique_ptr<rejourney::FrameDeduplicator> _deduplicator;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _deduplicator = std::make_unique<rejourney::FrameDeduplicator>();
+  }
+  return self;
+}
+
+- (BOOL)isRepeatFrame:(CGImageRef)image {
+  if (CGImageGetBitsPerPixel(image) != 32) {
+    _deduplicator->reset();
+    return NO;
+  }
+  CFDataRef data = CGDataProviderCopyData(CGImageGetDataProvider(image));
+  if (!data) {
+    _deduplicator->reset();
+    return NO;
+  }
+  BOOL repeat = _deduplicator->isRepeat(CFDataGetBytePtr(data), CGImageGetWidth(image), CGImageGetHeight(image),
+                                       CGImageGetBytesPerRow(image));
+  CFRelease(data);
+  return repeat;
+}
+
+- (void)reset {
+  _deduplicator->reset();
+}
+
+@end
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Per-node flags; values match cpp/HierarchySnapshot.h.
+typedef NS_OPTIONS(uint16_t, RJHierarchyNodeFlags) {
+  RJHierarchyNodeFlagHidden = 1 << 0,
+  RJHierarchyNodeFlagMasked = 1 << 1,
+  RJHierarchyNodeFlagInteractive = 1 << 2,
+  RJHierarchyNodeFlagEnabled = 1 << 3,
+  RJHierarchyNodeFlagScrollEnabled = 1 << 4,
+  RJHierarchyNodeFlagHasImage = 1 << 5,
+  RJHierarchyNodeFlagBailout = 1 << 6,
+  RJHierarchyNodeFlagHasEnabled = 1 << 7,
+};
+
+/// String attributes; values match cpp/HierarchySnapshot.h.
+typedef NS_ENUM(uint8_t, RJHierarchyAttribute) {
+  RJHierarchyAttributeTestId = 1,
+  RJHierarchyAttributeLabel = 2,
+  RJHierarchyAttributeBackground = 3,
+  RJHierarchyAttributeText = 4,
+  RJHierarchyAttributePlaceholder = 6,
+  RJHierarchyAttributeButtonTitle = 7,
+};
+
+typedef NS_ENUM(NSInteger, RJHierarchyEncoding) {
+  /// Full snapshot that later deltas refer to.
+  RJHierarchyEncodingKeyframe,
+  /// Changes since the last keyframe.
+  RJHierarchyEncodingDelta,
+  /// A delta with no changes since the last keyframe.
+  RJHierarchyEncodingUnchanged,
+};
+
+@interface RJHierarchyPayload : NSObject
+
+@property(nonatomic, readonly) NSData *data;
+@property(nonatomic, readonly) RJHierarchyEncoding encoding;
+
+@end
+
+/// Objective-C facade over cpp/HierarchySnapshot.h and cpp/HierarchyDelta.h:
+/// builds a flat view hierarchy snapshot one node at a time and encodes it
+/// as a keyframe or as a delta against the last keyframe. Reuse one builder
+/// across scans; it is not thread-safe.
+@interface RJHierarchySnapshotBuilder : NSObject
+
+@property(nonatomic, readonly) NSUInteger nodeCount;
+
+/// Starts a new snapshot, keeping the buffers of the previous one.
+- (void)resetWithScreenSize:(CGSize)size
+                      scale:(CGFloat)scale
+                 screenName:(nullable NSString *)screenName NS_SWIFT_NAME(reset(screenSize:scale:screenName:));
+
+/// Appends a node under `parent` (-1 for the root) and returns its index,
+/// or -1 if `parent` is not a node of this snapshot. `key` must identify the
+/// view across scans.
+- (int32_t)addNodeWithParent:(int32_t)parent
+                         key:(uint64_t)key
+                        type:(NSString *)type
+                       frame:(CGRect)frame
+                       alpha:(CGFloat)alpha
+                       flags:(RJHierarchyNodeFlags)flags NS_SWIFT_NAME(addNode(parent:key:type:frame:alpha:flags:));
+
+- (void)setString:(NSString *)value
+     forAttribute:(RJHierarchyAttribute)attribute
+             node:(int32_t)node NS_SWIFT_NAME(set(_:for:node:));
+
+- (void)setTextLength:(NSUInteger)length node:(int32_t)node NS_SWIFT_NAME(setTextLength(_:node:));
+
+- (void)setScrollOffset:(CGPoint)offset
+            contentSize:(CGSize)contentSize
+                   node:(int32_t)node NS_SWIFT_NAME(setScroll(offset:contentSize:node:));
+
+- (RJHierarchyPayload *)encodeWithTimestampMs:(uint64_t)timestampMs
+                                forceKeyframe:(BOOL)forceKeyframe NS_SWIFT_NAME(encode(timestampMs:forceKeyframe:));
+
+/// Makes the next encode a keyframe.
+- (void)resetEncoding;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJHierarchySnapshotBuilder.h"
+
+#include "HierarchyDelta.h"
+#include "HierarchySnapshot.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace {
+
+std::string_view stringView(NSString *value) {
+  const char *utf8 = value.UTF8String;
+  return utf8 ? std::string_view(utf8, std::strlen(utf8)) : std::string_view();
+}
+
+float finiteOrZero(CGFloat value) {
+  return std::isfinite(value) ? static_cast<float>(value) : 0.0f;
+}
+
+} // namespace
+
+@implementation RJHierarchyPayload
+
+- (instancetype)initWithPayload:(std::string &&)payload encoding:(RJHierarchyEncoding)encoding {
+  self = [super init];
+  if (self) {
+    auto *bytes = new std::string(std::move(payload));
+    _data = [[NSData alloc] initWithBytesNoCopy:bytes->data()
+                                         length:bytes->size()
+                                    deallocator:^(void *, NSUInteger) {
+                                      delete bytes;
+                                    }];
+    _encoding = encoding;
+  }
+  return self;
+}
+
+@end
+
+@implementation RJHierarchySnapshotBuilder {
+  std::unique_ptr<rejourney::HierarchySnapshotBuilder> _builder;
+  std::unique_ptr<rejourney::HierarchyDeltaEncoder> _encoder;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _builder = std::make_unique<rejourney::HierarchySnapshotBuilder>();
+    _encoder = std::make_unique<rejourney::HierarchyDeltaEncoder>();
+  }
+  return self;
+}
+
+- (NSUInteger)nodeCount {
+  return _builder->nodeCount();
+}
+
+- (void)resetWithScreenSize:(CGSize)size scale:(CGFloat)scale screenName:(NSString *)screenName {
+  _builder->reset();
+  _builder->setScreen(finiteOrZero(size.width), finiteOrZero(size.height), finiteOrZero(scale),
+                      screenName ? stringView(screenName) : std::string_view());
+}
+
+- (int32_t)addNodeWithParent:(int32_t)parent
+                         key:(uint64_t)key
+                        type:(NSString *)type
+                       frame:(CGRect)frame
+                       alpha:(CGFloat)alpha
+                       flags:(RJHierarchyNodeFlags)flags {
+  rejourney::HierarchySnapshotBuilder::Frame nodeFrame{finiteOrZero(frame.origin.x), finiteOrZero(frame.origin.y),
+                                                       finiteOrZero(frame.size.width),
+                                                       finiteOrZero(frame.size.height)};
+  return _builder->addNode(parent, key, stringView(type), nodeFrame, finiteOrZero(alpha), flags);
+}
+
+- (void)setString:(NSString *)value forAttribute:(RJHierarchyAttribute)attribute node:(int32_t)node {
+  _builder->setString(node, static_cast<rejourney::HierarchySnapshotBuilder::Attribute>(attribute), stringView(value));
+}
+
+- (void)setTextLength:(NSUInteger)length node:(int32_t)node {
+  _builder->setTextLength(node, static_cast<uint32_t>(MIN(length, (NSUInteger)UINT32_MAX)));
+}
+
+- (void)setScrollOffset:(CGPoint)offset contentSize:(CGSize)contentSize node:(int32_t)node {
+  _builder->setScroll(node, finiteOrZero(offset.x), finiteOrZero(offset.y), finiteOrZero(contentSize.width),
+                      finiteOrZero(contentSize.height));
+}
+
+- (RJHierarchyPayload *)encodeWithTimestampMs:(uint64_t)timestampMs forceKeyframe:(BOOL)forceKeyframe {
+  std::string payload;
+  RJHierarchyEncoding encoding = RJHierarchyEncodingKeyframe;
+  switch (_encoder->encode(*_builder, timestampMs, forceKeyframe, payload)) {
+  case rejourney::HierarchyDeltaEncoder::Result::Keyframe:
+    encoding = RJHierarchyEncodingKeyframe;
+    break;
+  case rejourney::HierarchyDeltaEncoder::Result::Delta:
+    encoding = RJHierarchyEncodingDelta;
+    break;
+  case rejourney::HierarchyDeltaEncoder::Result::Unchanged:
+    encoding = RJHierarchyEncodingUnchanged;
+    break;
+  }
+  return [[RJHierarchyPayload alloc] initWithPayload:std::move(payload) encoding:encoding];
+}
+
+- (void)resetEncoding {
+  _encoder->reset();
+}
+
+@end
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+#import "RJCaptureBufferPool.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Resampling filter; values match cpp/ImageScaler.h.
+typedef NS_ENUM(NSInteger, RJImageScalerFilter) {
+  /// Area average; keeps thin text legible at any ratio.
+  RJImageScalerFilterBox,
+  /// Two taps per axis; cheaper, aliases below half size.
+  RJImageScalerFilterBilinear,
+};
+
+/// Objective-C facade over cpp/ImageScaler.h: downscales a captured 32bpp
+/// image with the core's vectorized resampler instead of a scaled
+/// CoreGraphics draw. Reuse one scaler; it is not thread-safe.
+@interface RJImageScaler : NSObject
+
+@property(nonatomic) RJImageScalerFilter filter;
+
+/// Where scaled images get their pixels; they are allocated when unset or
+/// when every pooled buffer is out.
+@property(nonatomic, nullable) RJCaptureBufferPool *outputPool;
+
+/// `image` resampled to `width` x `height` pixels with the same color space
+/// and bitmap layout, or NULL when the image is not 8 bits per component at
+/// 32bpp.
+- (nullable CGImageRef)newImageByScalingImage:(CGImageRef)image
+                                        width:(size_t)width
+                                       height:(size_t)height
+    CF_RETURNS_RETAINED NS_SWIFT_NAME(scale(_:width:height:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJImageScaler.h"
+
+#include "ImageScaler.h"
+
+#include <memory>
+
+@implementation RJImageScaler {
+  std::unique_ptr<rejourney::ImageScaler> _scaler;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _scaler = std::make_unique<rejourney::ImageScaler>();
+  }
+  return self;
+}
+
+- (CGImageRef)newImageByScalingImage:(CGImageRef)image width:(size_t)width height:(size_t)height {
+  if (width == 0 || height == 0 || CGImageGetBitsPerComponent(image) != 8 || CGImageGetBitsPerPixel(image) != 32 ||
+      (CGImageGetBitmapInfo(image) & kCGBitmapFloatComponents)) {
+    return NULL;
+  }
+  // Captures come from a pool and are read in place; anything else is
+  // copied out of its provider.
+  CFDataRef source = NULL;
+  const uint8_t *src = [RJCaptureBufferPool pixelsOfImage:image];
+  if (!src) {
+    source = CGDataProviderCopyData(CGImageGetDataProvider(image));
+    if (!source) {
+      return NULL;
+    }
+    src = CFDataGetBytePtr(source);
+  }
+  const auto filter = self.filter == RJImageScalerFilterBilinear ? rejourney::ImageScaler::Filter::Bilinear
+                                                                  : rejourney::ImageScaler::Filter::Box;
+  const size_t srcWidth = CGImageGetWidth(image);
+  const size_t srcHeight = CGImageGetHeight(image);
+  const size_t srcBytesPerRow = CGImageGetBytesPerRow(image);
+
+  CGImageRef scaled = NULL;
+  RJCaptureBuffer *buffer = [self.outputPool acquireWithWidth:width height:height];
+  if (buffer) {
+    if (_scaler->scale(src, srcWidth, srcHeight, srcBytesPerRow, buffer.pixels, width, height, buffer.bytesPerRow,
+                       filter)) {
+      scaled = [buffer makeImageWithColorSpace:CGImageGetColorSpace(image) bitmapInfo:CGImageGetBitmapInfo(image)];
+    }
+  } else {
+    const size_t bytesPerRow = width * 4;
+    NSMutableData *pixels = [NSMutableData dataWithLength:bytesPerRow * height];
+    if (_scaler->scale(src, srcWidth, srcHeight, srcBytesPerRow, static_cast<uint8_t *>(pixels.mutableBytes), width,
+                       height, bytesPerRow, filter)) {
+      CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)pixels);
+      if (provider) {
+        scaled = CGImageCreate(width, height, 8, 32, bytesPerRow, CGImageGetColorSpace(image),
+                               CGImageGetBitmapInfo(image), provider, NULL, false, kCGRenderingIntentDefault);
+        CGDataProviderRelease(provider);
+      }
+    }
+  }
+  if (source) {
+    CFRelease(source);
+  }
+  return scaled;
+}
+
+@end
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Chroma subsampling; values match cpp/JpegEncoder.h.
+typedef NS_ENUM(NSInteger, RJJpegSubsampling) {
+  /// 4:4:4, full colour resolution.
+  RJJpegSubsamplingFull,
+  /// 4:2:2, half horizontal colour resolution.
+  RJJpegSubsamplingHalfHorizontal,
+  /// 4:2:0, half colour resolution both ways.
+  RJJpegSubsamplingQuarter,
+};
+
+/// Objective-C facade over cpp/JpegEncoder.h: encodes a captured image's
+/// bitmap in place with pooled, reused libjpeg compressors. libjpeg is
+/// opt-in on iOS: set REJOURNEY_LIBJPEG_POD to the pod providing it (see
+/// rejourney.podspec). Without it, or when the bitmap layout is not 32bpp
+/// RGB, frames are encoded with ImageIO and only `quality` applies.
+@interface RJJpegEncoder : NSObject
+
+@property(atomic) RJJpegSubsampling subsampling;
+/// Two-pass Huffman tables: a few percent smaller, somewhat slower.
+@property(atomic) BOOL optimizeHuffman;
+/// Restart marker every this many MCU rows; 0 for none.
+@property(atomic) NSUInteger restartRows;
+
+/// YES when the core was built with libjpeg; NO means ImageIO encodes
+/// every frame and the properties above are ignored.
+@property(class, nonatomic, readonly) BOOL usesLibjpeg;
+
+/// JPEG for `image` at `quality` (0...1), or nil on failure. Thread-safe.
+- (nullable NSData *)encodeImage:(CGImageRef)image quality:(CGFloat)quality NS_SWIFT_NAME(encode(_:quality:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJJpegEncoder.h"
+
+#import <ImageIO/ImageIO.h>
+
+#import "RJCaptureBufferPool.h"
+
+#include "JpegEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+@implementation RJJpegEncoder {
+#if REJOURNEY_WITH_LIBJPEG
+  std::unique_ptr<rejourney::JpegEncoderPool> _pool;
+#endif
+}
+
++ (BOOL)usesLibjpeg {
+#if REJOURNEY_WITH_LIBJPEG
+  return YES;
+#else
+  return NO;
+#endif
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _subsampling = RJJpegSubsamplingQuarter;
+#if REJOURNEY_WITH_LIBJPEG
+    _pool = std::make_unique<rejourney::JpegEncoderPool>();
+#endif
+  }
+  return self;
+}
+
+- (NSData *)encodeImage:(CGImageRef)image quality:(CGFloat)quality {
+#if REJOURNEY_WITH_LIBJPEG
+  rejourney::JpegEncoder::PixelFormat format;
+  if (CGImageGetBitsPerPixel(image) == 32 && [self pixelFormatOf:image into:&format]) {
+    // Captures are encoded straight from their pooled buffer; other images
+    // are copied out of their provider first.
+    CFDataRef copied = NULL;
+    const uint8_t *pixels = [RJCaptureBufferPool pixelsOfImage:image];
+    if (!pixels) {
+      copied = CGDataProviderCopyData(CGImageGetDataProvider(image));
+      pixels = copied ? CFDataGetBytePtr(copied) : nullptr;
+    }
+    if (pixels) {
+      rejourney::JpegEncoder::Options options;
+      options.quality = static_cast<int>(std::lround(std::fmin(1.0, std::fmax(0.0, quality)) * 100.0));
+      switch (self.subsampling) {
+        case RJJpegSubsamplingFull:
+          options.subsampling = rejourney::JpegEncoder::Subsampling::S444;
+          break;
+        case RJJpegSubsamplingHalfHorizontal:
+          options.subsampling = rejourney::JpegEncoder::Subsampling::S422;
+          break;
+        case RJJpegSubsamplingQuarter:
+          options.subsampling = rejourney::JpegEncoder::Subsampling::S420;
+          break;
+      }
+      options.optimizeHuffman = self.optimizeHuffman;
+      options.restartRows = static_cast<uint32_t>(std::min<NSUInteger>(self.restartRows, UINT32_MAX));
+
+      auto encoder = _pool->acquire();
+      const bool ok = encoder->encode(pixels, CGImageGetWidth(image), CGImageGetHeight(image),
+                                      CGImageGetBytesPerRow(image), format, options);
+      if (copied) {
+        CFRelease(copied);
+      }
+      if (ok) {
+        auto *jpeg = new std::string(encoder->takeOutput());
+        return [[NSData alloc] initWithBytesNoCopy:jpeg->data()
+                                            length:jpeg->size()
+                                       deallocator:^(void *, NSUInteger) {
+                                         delete jpeg;
+                                       }];
+      }
+    }
+  }
+#endif
+  return [self imageIOJpegForImage:image quality:quality];
+}
+
+#if REJOURNEY_WITH_LIBJPEG
+/// Memory order of a 32bpp RGB image's pixels.
+- (BOOL)pixelFormatOf:(CGImageRef)image into:(rejourney::JpegEncoder::PixelFormat *)format {
+  CGColorSpaceRef space = CGImageGetColorSpace(image);
+  const CGBitmapInfo info = CGImageGetBitmapInfo(image);
+  if (!space || CGColorSpaceGetModel(space) != kCGColorSpaceModelRGB || (info & kCGBitmapFloatComponents)) {
+    return NO;
+  }
+  bool alphaFirst;
+  switch (CGImageGetAlphaInfo(image)) {
+    case kCGImageAlphaPremultipliedFirst:
+    case kCGImageAlphaNoneSkipFirst:
+    case kCGImageAlphaFirst:
+      alphaFirst = true;
+      break;
+    case kCGImageAlphaPremultipliedLast:
+    case kCGImageAlphaNoneSkipLast:
+    case kCGImageAlphaLast:
+      alphaFirst = false;
+      break;
+    default:
+      return NO;
+  }
+  using PixelFormat = rejourney::JpegEncoder::PixelFormat;
+  const CGBitmapInfo byteOrder = info & kCGBitmapByteOrderMask;
+  if (byteOrder == kCGBitmapByteOrder32Little) {
+    *format = alphaFirst ? PixelFormat::BGRX : PixelFormat::XBGR;
+  } else if (byteOrder == kCGBitmapByteOrderDefault || byteOrder == kCGBitmapByteOrder32Big) {
+    *format = alphaFirst ? PixelFormat::XRGB : PixelFormat::RGBX;
+  } else {
+    return NO;
+  }
+  return YES;
+}
+#endif
+
+- (NSData *)imageIOJpegForImage:(CGImageRef)image quality:(CGFloat)quality {
+  NSMutableData *jpeg = [NSMutableData data];
+  CGImageDestinationRef destination =
+      CGImageDestinationCreateWithData((__bridge CFMutableDataRef)jpeg, CFSTR("public.jpeg"), 1, nullptr);
+  if (!destination) {
+    return nil;
+  }
+  NSDictionary *properties = @{(__bridge NSString *)kCGImageDestinationLossyCompressionQuality : @(quality)};
+  CGImageDestinationAddImage(destination, image, (__bridge CFDictionaryRef)properties);
+  const bool ok = CGImageDestinationFinalize(destination);
+  CFRelease(destination);
+  return ok ? jpeg : nil;
+}
+
+@end
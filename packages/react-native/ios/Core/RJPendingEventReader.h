@@ -0,0 +1,40 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over cpp/PendingEventReader.h: streams a persisted
+/// session's events as upload-sized JSON payloads without parsing them.
+@interface RJPendingEventReader : NSObject
+
+- (instancetype)initWithLogDirectory:(NSString *)logDirectory
+                      legacyFilePath:(nullable NSString *)legacyFilePath
+                       maxBatchBytes:(NSUInteger)maxBatchBytes
+                      deviceInfoJSON:(NSData *)deviceInfoJSON NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Returns the next `{"events":[...],"deviceInfo":{...}}` payload, or nil
+/// once every event has been returned.
+- (nullable NSData *)nextBatchWithEventCount:(NSUInteger *)eventCount NS_SWIFT_NAME(nextBatch(eventCount:));
+
+/// Passes over up to `count` events already delivered; returns how many.
+- (NSUInteger)skipEvents:(NSUInteger)count NS_SWIFT_NAME(skip(_:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJPendingEventReader.h"
+
+#include "PendingEventReader.h"
+
+#include <memory>
+#include <string>
+
+@implementation RJPendingEventReader {
+  std::unique_ptr<rejourney::PendingEventReader> _reader;
+}
+
+- (instancetype)initWithLogDirectory:(NSString *)logDirectory
+                      legacyFilePath:(NSString *)legacyFilePath
+                       maxBatchBytes:(NSUInteger)maxBatchBytes
+                      deviceInfoJSON:(NSData *)deviceInfoJSON {
+  self = [super init];
+  if (self) {
+    _reader = std::make_unique<rejourney::PendingEventReader>(
+        std::string(logDirectory.fileSystemRepresentation),
+        legacyFilePath ? std::string(legacyFilePath.fileSystemRepresentation) : std::string(),
+        maxBatchBytes,
+        std::string(static_cast<const char *>(deviceInfoJSON.bytes), deviceInfoJSON.length));
+  }
+  return self;
+}
+
+- (NSData *)nextBatchWithEventCount:(NSUInteger *)eventCount {
+  auto *payload = new std::string();
+  size_t count = 0;
+  if (!_reader->next(*payload, count)) {
+    delete payload;
+    *eventCount = 0;
+    return nil;
+  }
+  *eventCount = count;
+  return [[NSData alloc] initWithBytesNoCopy:payload->data()
+                                      length:payload->size()
+                                 deallocator:^(void *, NSUInteger) {
+                                   delete payload;
+                                 }];
+}
+
+- (NSUInteger)skipEvents:(NSUInteger)count {
+  return _reader->skip(count);
+}
+
+@end
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over cpp/RateController.h: lowers JPEG quality, then
+/// capture scale, so encoded frames stay near a target upload rate, and
+/// raises them again once the screen or the network allows. Times are
+/// milliseconds on a monotonic clock. Thread-safe: frames are reported from
+/// the encode queue and uploads from the network callbacks.
+@interface RJRateController : NSObject
+
+/// Top of the ladder (the configured quality, 0...1, and capture scale) and
+/// the rate to hold frames to. Restarts at the top.
+- (void)configureWithQuality:(CGFloat)quality
+                captureScale:(CGFloat)captureScale
+        targetBytesPerSecond:(NSUInteger)targetBytesPerSecond
+    NS_SWIFT_NAME(configure(quality:captureScale:targetBytesPerSecond:));
+
+/// Forgets measurements at the start of a session.
+- (void)startAtMs:(uint64_t)nowMs NS_SWIFT_NAME(start(atMs:));
+
+/// JPEG quality, 0...1, for the next frame.
+@property(nonatomic, readonly) CGFloat quality;
+/// Capture scale divisor for the next frame.
+@property(nonatomic, readonly) CGFloat captureScale;
+
+/// Reports a frame encoded at `quality` and `captureScale` as `bytes`.
+- (void)reportFrameBytes:(NSUInteger)bytes
+                 quality:(CGFloat)quality
+            captureScale:(CGFloat)captureScale
+                    atMs:(uint64_t)nowMs NS_SWIFT_NAME(reportFrame(bytes:quality:captureScale:atMs:));
+
+/// Reports an upload of `bytes` that took `durationMs` end to end.
+- (void)reportUploadBytes:(NSUInteger)bytes
+               durationMs:(double)durationMs NS_SWIFT_NAME(reportUpload(bytes:durationMs:));
+
+/// Low Data Mode or a similarly constrained path.
+@property(nonatomic) BOOL constrained;
+
+/// Uploads are backing up: steps down at once. NO if quality and scale are
+/// already at their floor.
+- (BOOL)relieveBacklogAtMs:(uint64_t)nowMs NS_SWIFT_NAME(relieveBacklog(atMs:));
+
+@property(nonatomic, readonly) NSUInteger targetBytesPerSecond;
+
+@end
+
+NS_ASSUME_NONNULL_END
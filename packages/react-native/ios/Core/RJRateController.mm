@@ -0,0 +1,104 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJRateController.h"
+
+#include "RateController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+int libjpegQuality(CGFloat quality) {
+  return std::max(1, std::min(100, static_cast<int>(std::lround(quality * 100))));
+}
+
+} // namespace
+
+@implementation RJRateController {
+  std::mutex _lock;
+  std::unique_ptr<rejourney::RateController> _controller;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _controller = std::make_unique<rejourney::RateController>();
+  }
+  return self;
+}
+
+- (void)configureWithQuality:(CGFloat)quality
+                captureScale:(CGFloat)captureScale
+        targetBytesPerSecond:(NSUInteger)targetBytesPerSecond {
+  std::lock_guard<std::mutex> guard(_lock);
+  auto options = _controller->options();
+  options.maxQuality = libjpegQuality(quality);
+  options.minScale = static_cast<float>(std::max<CGFloat>(1, captureScale));
+  options.maxScale = std::max(options.minScale, options.maxScale);
+  options.targetBytesPerSecond = static_cast<uint32_t>(std::min<NSUInteger>(targetBytesPerSecond, UINT32_MAX));
+  _controller->setOptions(options);
+}
+
+- (void)startAtMs:(uint64_t)nowMs {
+  std::lock_guard<std::mutex> guard(_lock);
+  _controller->start(nowMs);
+}
+
+- (CGFloat)quality {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _controller->setting().quality / 100.0;
+}
+
+- (CGFloat)captureScale {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _controller->setting().scale;
+}
+
+- (void)reportFrameBytes:(NSUInteger)bytes quality:(CGFloat)quality captureScale:(CGFloat)captureScale atMs:(uint64_t)nowMs {
+  std::lock_guard<std::mutex> guard(_lock);
+  _controller->onFrameEncoded({libjpegQuality(quality), static_cast<float>(captureScale)}, bytes, nowMs);
+}
+
+- (void)reportUploadBytes:(NSUInteger)bytes durationMs:(double)durationMs {
+  std::lock_guard<std::mutex> guard(_lock);
+  _controller->onUploadCompleted(bytes, static_cast<uint64_t>(std::max(0.0, durationMs)));
+}
+
+- (BOOL)constrained {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _controller->constrained();
+}
+
+- (void)setConstrained:(BOOL)constrained {
+  std::lock_guard<std::mutex> guard(_lock);
+  _controller->setConstrained(constrained);
+}
+
+- (BOOL)relieveBacklogAtMs:(uint64_t)nowMs {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _controller->onBacklog(nowMs);
+}
+
+- (NSUInteger)targetBytesPerSecond {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _controller->targetBytesPerSecond();
+}
+
+@end
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over cpp/RedactionCompositor.h: paints mask regions
+/// straight into a bitmap context's pixels, coalesced into disjoint fills.
+@interface RJRedactionCompositor : NSObject
+
+/// Forgets the regions of the previous frame.
+- (void)reset;
+
+/// Adds a region in the user space of the context passed to
+/// `paintIntoContext:color:`.
+- (void)addRect:(CGRect)rect NS_SWIFT_NAME(add(_:));
+
+/// Fills every region with `color`. Returns NO, painting nothing, when the
+/// context is not a 32bpp RGB bitmap whose pixels can be written directly;
+/// the caller then fills the regions itself.
+- (BOOL)paintIntoContext:(CGContextRef)context color:(CGColorRef)color NS_SWIFT_NAME(paint(into:color:));
+
+/// After painting: NO if region `index` was empty or lies inside another
+/// region, so it needs no indicator of its own.
+- (BOOL)isOutermostAtIndex:(NSUInteger)index NS_SWIFT_NAME(isOutermost(_:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJRedactionCompositor.h"
+
+#include "RedactionCompositor.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+@implementation RJRedactionCompositor {
+  std::unique_ptr<rejourney::RedactionCompositor> _compositor;
+  std::vector<CGRect> _rects;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _compositor = std::make_unique<rejourney::RedactionCompositor>();
+  }
+  return self;
+}
+
+- (void)reset {
+  _compositor->reset();
+  _rects.clear();
+}
+
+- (void)addRect:(CGRect)rect {
+  _rects.push_back(rect);
+}
+
+- (BOOL)paintIntoContext:(CGContextRef)context color:(CGColorRef)color {
+  uint8_t *pixels = static_cast<uint8_t *>(CGBitmapContextGetData(context));
+  const size_t width = CGBitmapContextGetWidth(context);
+  const size_t height = CGBitmapContextGetHeight(context);
+  const size_t bytesPerRow = CGBitmapContextGetBytesPerRow(context);
+  uint32_t pixel = 0;
+  if (!pixels || CGBitmapContextGetBitsPerPixel(context) != 32 || bytesPerRow % 4 != 0 ||
+      ![self packColor:color forContext:context into:&pixel]) {
+    return NO;
+  }
+
+  // Device space has its origin at the bottom-left; bitmap rows start at
+  // the top.
+  _compositor->reset();
+  for (const CGRect &rect : _rects) {
+    const CGRect device = CGContextConvertRectToDeviceSpace(context, rect);
+    _compositor->add(static_cast<float>(device.origin.x),
+                     static_cast<float>(static_cast<CGFloat>(height) - CGRectGetMaxY(device)),
+                     static_cast<float>(device.size.width), static_cast<float>(device.size.height));
+  }
+  _compositor->paint(pixels, width, height, bytesPerRow, pixel);
+  return YES;
+}
+
+/// `color` as one pixel in the context's memory layout: RGB with alpha
+/// first or last, in either byte order. Alpha is premultiplied.
+- (BOOL)packColor:(CGColorRef)color forContext:(CGContextRef)context into:(uint32_t *)pixel {
+  CGColorSpaceRef space = CGBitmapContextGetColorSpace(context);
+  if (!space || CGColorSpaceGetModel(space) != kCGColorSpaceModelRGB) {
+    return NO;
+  }
+  CGColorRef matched = CGColorCreateCopyByMatchingToColorSpace(space, kCGRenderingIntentDefault, color, nullptr);
+  if (!matched) {
+    return NO;
+  }
+  const CGFloat *components = CGColorGetComponents(matched);
+  const bool hasComponents = CGColorGetNumberOfComponents(matched) == 4;
+  uint8_t rgba[4] = {0, 0, 0, 0};
+  if (hasComponents) {
+    const CGFloat alpha = components[3];
+    for (int i = 0; i < 4; ++i) {
+      const CGFloat value = i < 3 ? components[i] * alpha : alpha;
+      rgba[i] = static_cast<uint8_t>(std::lround(std::fmin(1.0, std::fmax(0.0, value)) * 255.0));
+    }
+  }
+  CGColorRelease(matched);
+  if (!hasComponents) {
+    return NO;
+  }
+
+  const CGBitmapInfo info = CGBitmapContextGetBitmapInfo(context);
+  const CGImageAlphaInfo alphaInfo = static_cast<CGImageAlphaInfo>(info & kCGBitmapAlphaInfoMask);
+  const CGBitmapInfo byteOrder = info & kCGBitmapByteOrderMask;
+  if (info & kCGBitmapFloatComponents) {
+    return NO;
+  }
+  bool alphaFirst;
+  switch (alphaInfo) {
+    case kCGImageAlphaPremultipliedFirst:
+    case kCGImageAlphaNoneSkipFirst:
+    case kCGImageAlphaFirst:
+      alphaFirst = true;
+      break;
+    case kCGImageAlphaPremultipliedLast:
+    case kCGImageAlphaNoneSkipLast:
+    case kCGImageAlphaLast:
+      alphaFirst = false;
+      break;
+    default:
+      return NO;
+  }
+  // Bytes as they sit in memory for the default (big-endian) order.
+  uint8_t bytes[4];
+  if (alphaFirst) {
+    bytes[0] = rgba[3], bytes[1] = rgba[0], bytes[2] = rgba[1], bytes[3] = rgba[2];
+  } else {
+    bytes[0] = rgba[0], bytes[1] = rgba[1], bytes[2] = rgba[2], bytes[3] = rgba[3];
+  }
+  if (byteOrder == kCGBitmapByteOrder32Little) {
+    std::swap(bytes[0], bytes[3]);
+    std::swap(bytes[1], bytes[2]);
+  } else if (byteOrder != kCGBitmapByteOrderDefault && byteOrder != kCGBitmapByteOrder32Big) {
+    return NO;
+  }
+  std::memcpy(pixel, bytes, 4);
+  return YES;
+}
+
+- (BOOL)isOutermostAtIndex:(NSUInteger)index {
+  return _compositor->isOutermost(index);
+}
+
+@end
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over the shared segmented write-ahead log
+/// (cpp/SegmentedLog.h). Appends and flushes are thread-safe; open, close
+/// and clear must not race with them.
+@interface RJSegmentedLog : NSObject
+
+/// Writes every append through to the file.
+- (instancetype)initWithDirectory:(NSString *)directory;
+
+/// With a non-zero \`groupCommitDelayMs\`, appends are staged in memory and
+/// written in batches by a background writer (cpp/GroupCommitLog.h), so a
+/// crash loses at most that many milliseconds of records.
+- (instancetype)initWithDirectory:(NSString *)directory
+               groupCommitDelayMs:(uint32_t)groupCommitDelayMs NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Record count (including staged records) and newest written timestamp.
+@property(nonatomic, readonly) NSUInteger count;
+@property(nonatomic, readonly) int64_t lastTimestampMs;
+
+/// Creates the directory if needed and recovers state from existing segments.
+- (BOOL)open;
+- (BOOL)append:(NSData *)record timestampMs:(int64_t)timestampMs NS_SWIFT_NAME(append(_:timestampMs:));
+/// Writes staged records to the file. Cheap enough for crash handlers.
+- (BOOL)flush;
+/// Writes staged records and forces them to stable storage.
+- (BOOL)sync;
+- (void)close;
+- (BOOL)clear;
+
+/// Visits every valid record of the log in `directory`. The NSData passed to
+/// the block points into a read-only mapping and is only valid during the call.
++ (void)enumerateRecordsInDirectory:(NSString *)directory
+                         usingBlock:(void (NS_NOESCAPE ^)(NSData *record, int64_t timestampMs, BOOL *stop))block
+    NS_SWIFT_NAME(enumerateRecords(inDirectory:using:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJSegmentedLog.h"
+
+#include "GroupCommitLog.h"
+#include "SegmentedLog.h"
+
+#include <memory>
+#include <string>
+
+@implementation RJSegmentedLog {
+  std::unique_ptr<rejourney::SegmentedLog> _log;
+  std::unique_ptr<rejourney::GroupCommitLog> _group;
+  uint32_t _groupCommitDelayMs;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory {
+  return [self initWithDirectory:directory groupCommitDelayMs:0];
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory groupCommitDelayMs:(uint32_t)groupCommitDelayMs {
+  self = [super init];
+  if (self) {
+    _log = std::make_unique<rejourney::SegmentedLog>(std::string(directory.fileSystemRepresentation));
+    _groupCommitDelayMs = groupCommitDelayMs;
+  }
+  return self;
+}
+
+- (NSUInteger)count {
+  size_t pending = _group ? _group->pending() : 0;
+  return static_cast<NSUInteger>(_log->stats().count + pending);
+}
+
+- (int64_t)lastTimestampMs {
+  return _log->stats().lastTimestampMs;
+}
+
+- (BOOL)open {
+  _group.reset();
+  if (!_log->open()) {
+    return NO;
+  }
+  if (_groupCommitDelayMs > 0) {
+    rejourney::GroupCommitLog::Options options;
+    options.maxDelayMs = _groupCommitDelayMs;
+    _group = std::make_unique<rejourney::GroupCommitLog>(*_log, options);
+  }
+  return YES;
+}
+
+- (BOOL)append:(NSData *)record timestampMs:(int64_t)timestampMs {
+  if (_group) {
+    return _group->append(std::string(static_cast<const char *>(record.bytes), record.length), timestampMs);
+  }
+  return _log->append(std::string_view(static_cast<const char *>(record.bytes), record.length), timestampMs);
+}
+
+- (BOOL)flush {
+  return _group ? _group->flush(false) : YES;
+}
+
+- (BOOL)sync {
+  return _group ? _group->flush(true) : _log->sync();
+}
+
+- (void)close {
+  // Destroying the group-commit writer flushes whatever is still staged.
+  _group.reset();
+  _log->close();
+}
+
+- (BOOL)clear {
+  if (_group) {
+    _group->flush(false);
+  }
+  return _log->clear();
+}
+
++ (void)enumerateRecordsInDirectory:(NSString *)directory
+                         usingBlock:(void (NS_NOESCAPE ^)(NSData *record, int64_t timestampMs, BOOL *stop))block {
+  rejourney::SegmentedLog::forEach(std::string(directory.fileSystemRepresentation),
+                                   [&](std::string_view payload, int64_t timestampMs) {
+                                     @autoreleasepool {
+                                       NSData *record = [[NSData alloc] initWithBytesNoCopy:const_cast<char *>(payload.data())
+                                                                                     length:payload.size()
+                                                                               freeWhenDone:NO];
+                                       BOOL stop = NO;
+                                       block(record, timestampMs, &stop);
+                                       return !stop;
+                                     }
+                                   });
+}
+
+@end
@@ -0,0 +1,39 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Objective-C facade over cpp/TileDeltaEncoder.h: turns a captured frame
+/// into a tile delta against the last keyframe when that is worthwhile.
+@interface RJTileDeltaEncoder : NSObject
+
+/// Returns a frame bundle delta payload (header plus the changed tiles as a
+/// JPEG atlas), or nil when `image` must be shipped as a full JPEG. A nil
+/// result always makes `image` the new keyframe.
+- (nullable NSData *)deltaPayloadForImage:(CGImageRef)image
+                                  quality:(CGFloat)quality
+                            forceKeyframe:(BOOL)forceKeyframe
+    NS_SWIFT_NAME(deltaPayload(for:quality:forceKeyframe:));
+
+/// Drops the keyframe so the next image is shipped whole.
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
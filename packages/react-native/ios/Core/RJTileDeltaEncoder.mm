@@ -0,0 +1,103 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJTileDeltaEncoder.h"
+
+#import <ImageIO/ImageIO.h>
+
+#include "TileDeltaEncoder.h"
+
+#include <memory>
+#include <string>
+
+@implementation RJTileDeltaEncoder {
+  std::unique_ptr<rejourney::TileDeltaEncoder> _encoder;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _encoder = std::make_unique<rejourney::TileDeltaEncoder>();
+  }
+  return self;
+}
+
+- (NSData *)deltaPayloadForImage:(CGImageRef)image quality:(CGFloat)quality forceKeyframe:(BOOL)forceKeyframe {
+  CFDataRef pixels = CGImageGetBitsPerPixel(image) == 32 ? CGDataProviderCopyData(CGImageGetDataProvider(image)) : nullptr;
+  if (!pixels) {
+    _encoder->reset();
+    return nil;
+  }
+  const size_t width = CGImageGetWidth(image);
+  const size_t height = CGImageGetHeight(image);
+  const size_t bytesPerRow = CGImageGetBytesPerRow(image);
+  rejourney::TileDeltaEncoder::Delta delta;
+  auto result = _encoder->encode(CFDataGetBytePtr(pixels), width, height, bytesPerRow, forceKeyframe, delta);
+  if (result == rejourney::TileDeltaEncoder::Result::Keyframe) {
+    CFRelease(pixels);
+    return nil;
+  }
+
+  std::string header = delta.header();
+  NSMutableData *payload = [NSMutableData dataWithBytes:header.data() length:header.size()];
+  if (!delta.tiles.empty() && ![self appendAtlas:delta like:image quality:quality to:payload]) {
+    // Ship this frame whole and make it the keyframe the next delta is
+    // taken against.
+    _encoder->encode(CFDataGetBytePtr(pixels), width, height, bytesPerRow, true, delta);
+    CFRelease(pixels);
+    return nil;
+  }
+  CFRelease(pixels);
+  return payload;
+}
+
+- (BOOL)appendAtlas:(const rejourney::TileDeltaEncoder::Delta &)delta
+               like:(CGImageRef)source
+            quality:(CGFloat)quality
+                 to:(NSMutableData *)payload {
+  CFDataRef atlasData = CFDataCreate(kCFAllocatorDefault, delta.atlasPixels.data(), delta.atlasPixels.size());
+  CGDataProviderRef provider = CGDataProviderCreateWithCFData(atlasData);
+  CFRelease(atlasData);
+  CGImageRef atlas = CGImageCreate(delta.atlasWidth, delta.atlasHeight, 8, 32, delta.atlasBytesPerRow(),
+                                   CGImageGetColorSpace(source), CGImageGetBitmapInfo(source), provider, nullptr,
+                                   false, kCGRenderingIntentDefault);
+  CGDataProviderRelease(provider);
+  if (!atlas) {
+    return NO;
+  }
+
+  NSMutableData *jpeg = [NSMutableData data];
+  CGImageDestinationRef destination =
+      CGImageDestinationCreateWithData((__bridge CFMutableDataRef)jpeg, CFSTR("public.jpeg"), 1, nullptr);
+  BOOL ok = NO;
+  if (destination) {
+    NSDictionary *properties = @{(__bridge NSString *)kCGImageDestinationLossyCompressionQuality : @(quality)};
+    CGImageDestinationAddImage(destination, atlas, (__bridge CFDictionaryRef)properties);
+    ok = CGImageDestinationFinalize(destination);
+    CFRelease(destination);
+  }
+  CGImageRelease(atlas);
+  if (ok) {
+    [payload appendData:jpeg];
+  }
+  return ok;
+}
+
+- (void)reset {
+  _encoder->reset();
+}
+
+@end
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Upload kinds, highest priority first. Matches UploadLanes::Lane.
+typedef NS_ENUM(NSUInteger, RJUploadLane) {
+  RJUploadLaneEvents = 0,
+  RJUploadLaneHierarchy = 1,
+  RJUploadLaneFrames = 2,
+} NS_SWIFT_NAME(UploadLane);
+
+/// Objective-C facade over cpp/UploadLanes.h: picks the next upload to start
+/// within an in-flight window, by lane priority and per-lane limits.
+/// Thread-safe.
+@interface RJUploadLanes : NSObject
+
+- (instancetype)initWithWindow:(NSUInteger)window;
+
+/// Uploads in flight across all lanes.
+@property(nonatomic) NSUInteger window;
+- (NSUInteger)limitForLane:(RJUploadLane)lane NS_SWIFT_NAME(limit(for:));
+- (void)setLimit:(NSUInteger)limit forLane:(RJUploadLane)lane NS_SWIFT_NAME(setLimit(_:for:));
+
+/// Queues an upload and returns its ticket; retries go ahead of fresh uploads
+/// of the same lane.
+- (uint64_t)enqueueInLane:(RJUploadLane)lane retry:(BOOL)retry NS_SWIFT_NAME(enqueue(in:retry:));
+/// Ticket of the next upload to start, or 0 when nothing can start yet.
+- (uint64_t)startNext;
+/// An upload returned by startNext is over.
+- (void)finishTicket:(uint64_t)ticket NS_SWIFT_NAME(finish(_:));
+
+@property(nonatomic, readonly) NSUInteger inFlight;
+@property(nonatomic, readonly) NSUInteger queued;
+@property(nonatomic, readonly) NSUInteger peakInFlight;
+
+@end
+
+NS_ASSUME_NONNULL_END
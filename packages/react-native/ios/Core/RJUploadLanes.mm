@@ -0,0 +1,88 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJUploadLanes.h"
+
+#include "UploadLanes.h"
+
+#include <memory>
+
+@implementation RJUploadLanes {
+  std::unique_ptr<rejourney::UploadLanes> _lanes;
+}
+
+- (instancetype)initWithWindow:(NSUInteger)window {
+  self = [super init];
+  if (self) {
+    rejourney::UploadLanes::Options options;
+    options.window = window;
+    _lanes = std::make_unique<rejourney::UploadLanes>(options);
+  }
+  return self;
+}
+
+- (NSUInteger)window {
+  return _lanes->options().window;
+}
+
+- (void)setWindow:(NSUInteger)window {
+  auto options = _lanes->options();
+  options.window = window;
+  _lanes->setOptions(options);
+}
+
+- (NSUInteger)limitForLane:(RJUploadLane)lane {
+  return _lanes->options().laneLimit[lane];
+}
+
+- (void)setLimit:(NSUInteger)limit forLane:(RJUploadLane)lane {
+  auto options = _lanes->options();
+  options.laneLimit[lane] = limit;
+  _lanes->setOptions(options);
+}
+
+- (uint64_t)enqueueInLane:(RJUploadLane)lane retry:(BOOL)retry {
+  return _lanes->enqueue(static_cast<rejourney::UploadLanes::Lane>(lane), retry);
+}
+
+- (uint64_t)startNext {
+  uint64_t ticket = 0;
+  rejourney::UploadLanes::Lane lane;
+  return _lanes->next(ticket, lane) ? ticket : 0;
+}
+
+- (void)finishTicket:(uint64_t)ticket {
+  _lanes->finished(ticket);
+}
+
+- (NSUInteger)inFlight {
+  return _lanes->stats().inFlight;
+}
+
+- (NSUInteger)queued {
+  const auto stats = _lanes->stats();
+  NSUInteger queued = 0;
+  for (auto count : stats.queued) {
+    queued += count;
+  }
+  return queued;
+}
+
+- (NSUInteger)peakInFlight {
+  return _lanes->stats().peakInFlight;
+}
+
+@end
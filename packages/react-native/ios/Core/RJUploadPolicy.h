@@ -0,0 +1,67 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJUploadSpool.h"
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Interface a network path runs over. Matches UploadPolicy::Path.
+typedef NS_ENUM(NSUInteger, RJNetworkPath) {
+  RJNetworkPathUnknown = 0,
+  RJNetworkPathNone = 1,
+  RJNetworkPathWifi = 2,
+  RJNetworkPathWired = 3,
+  RJNetworkPathCellular = 4,
+  RJNetworkPathOther = 5,
+} NS_SWIFT_NAME(NetworkPath);
+
+/// Objective-C facade over cpp/UploadPolicy.h: which uploads go out on the
+/// current network path and which wait in the spool, and how many frames a
+/// bundle holds at the measured throughput. Thread-safe.
+@interface RJUploadPolicy : NSObject
+
+- (instancetype)initWithBaseBundleFrames:(NSUInteger)baseBundleFrames
+                         maxBundleFrames:(NSUInteger)maxBundleFrames;
+
+/// Defer frames on expensive and constrained paths at all.
+@property(nonatomic) BOOL deferOnMetered;
+/// Frames per bundle off unmetered paths, and the least on them.
+@property(nonatomic) NSUInteger baseBundleFrames;
+
+/// YES when kinds that were deferred may be sent now.
+- (BOOL)updatePath:(RJNetworkPath)path
+         expensive:(BOOL)expensive
+       constrained:(BOOL)constrained NS_SWIFT_NAME(update(path:expensive:constrained:));
+
+- (BOOL)shouldSendKind:(RJSpoolKind)kind NS_SWIFT_NAME(shouldSend(_:));
+/// Lowest kind that may be sent now, or nil when nothing may.
+@property(nonatomic, readonly, nullable) NSNumber *lowestSendableKind;
+
+- (void)noteUploadBytes:(NSUInteger)bytes durationMs:(double)durationMs NS_SWIFT_NAME(noteUpload(bytes:durationMs:));
+- (void)noteFrameBundleBytes:(NSUInteger)bytes frames:(NSUInteger)frames NS_SWIFT_NAME(noteFrameBundle(bytes:frames:));
+
+/// Frames the next bundle should hold.
+@property(nonatomic, readonly) NSUInteger bundleFrames;
+/// How long a bundle filling one frame per `frameIntervalMs` may stay open
+/// before it ships short; grows with `bundleFrames` up to a one-minute cap.
+- (uint64_t)bundleAgeLimitMsForFrameInterval:(uint32_t)frameIntervalMs NS_SWIFT_NAME(bundleAgeLimitMs(frameIntervalMs:));
+@property(nonatomic, readonly) double throughputBytesPerSecond;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJUploadPolicy.h"
+
+#include "UploadPolicy.h"
+
+#include <memory>
+
+@implementation RJUploadPolicy {
+  std::unique_ptr<rejourney::UploadPolicy> _policy;
+}
+
+- (instancetype)initWithBaseBundleFrames:(NSUInteger)baseBundleFrames maxBundleFrames:(NSUInteger)maxBundleFrames {
+  self = [super init];
+  if (self) {
+    rejourney::UploadPolicy::Options options;
+    options.baseBundleFrames = static_cast<uint32_t>(baseBundleFrames);
+    options.maxBundleFrames = static_cast<uint32_t>(maxBundleFrames);
+    _policy = std::make_unique<rejourney::UploadPolicy>(options);
+  }
+  return self;
+}
+
+- (BOOL)deferOnMetered {
+  return _policy->options().deferOnMetered;
+}
+
+- (void)setDeferOnMetered:(BOOL)deferOnMetered {
+  auto options = _policy->options();
+  options.deferOnMetered = deferOnMetered;
+  _policy->setOptions(options);
+}
+
+- (NSUInteger)baseBundleFrames {
+  return _policy->options().baseBundleFrames;
+}
+
+- (void)setBaseBundleFrames:(NSUInteger)baseBundleFrames {
+  auto options = _policy->options();
+  options.baseBundleFrames = static_cast<uint32_t>(baseBundleFrames);
+  _policy->setOptions(options);
+}
+
+- (BOOL)updatePath:(RJNetworkPath)path expensive:(BOOL)expensive constrained:(BOOL)constrained {
+  return _policy->setPath(static_cast<rejourney::UploadPolicy::Path>(path), expensive, constrained);
+}
+
+- (BOOL)shouldSendKind:(RJSpoolKind)kind {
+  return _policy->shouldSend(static_cast<rejourney::UploadPolicy::Kind>(kind));
+}
+
+- (nullable NSNumber *)lowestSendableKind {
+  rejourney::UploadPolicy::Kind kind;
+  if (!_policy->lowestSendable(kind)) {
+    return nil;
+  }
+  return @(static_cast<NSUInteger>(kind));
+}
+
+- (void)noteUploadBytes:(NSUInteger)bytes durationMs:(double)durationMs {
+  _policy->onUploadCompleted(bytes, durationMs);
+}
+
+- (void)noteFrameBundleBytes:(NSUInteger)bytes frames:(NSUInteger)frames {
+  _policy->onFrameBundle(bytes, static_cast<uint32_t>(frames));
+}
+
+- (NSUInteger)bundleFrames {
+  return _policy->bundleFrames();
+}
+
+- (uint64_t)bundleAgeLimitMsForFrameInterval:(uint32_t)frameIntervalMs {
+  return _policy->bundleAgeLimitMs(frameIntervalMs);
+}
+
+- (double)throughputBytesPerSecond {
+  return _policy->stats().throughputBytesPerSecond;
+}
+
+@end
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// What a spooled upload carries, in eviction order: frames go first, crash
+/// reports last. Matches UploadSpool::Kind.
+typedef NS_ENUM(NSUInteger, RJSpoolKind) {
+  RJSpoolKindFrames = 0,
+  RJSpoolKindHierarchy = 1,
+  RJSpoolKindEvents = 2,
+  RJSpoolKindCrash = 3,
+} NS_SWIFT_NAME(SpoolKind);
+
+/// A pending upload; its payload stays on disk until read.
+@interface RJSpoolEntry : NSObject
+
+@property(nonatomic, readonly) uint64_t entryId;
+@property(nonatomic, readonly) RJSpoolKind kind;
+@property(nonatomic, readonly) NSUInteger attempts;
+@property(nonatomic, readonly) NSData *meta;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/// Objective-C facade over cpp/UploadSpool.h: undelivered uploads kept on
+/// disk under a byte budget across launches. Thread-safe.
+@interface RJUploadSpool : NSObject
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                       byteBudget:(uint64_t)byteBudget
+                      maxAttempts:(NSUInteger)maxAttempts;
+
+/// Recovers pending uploads from a previous launch.
+- (BOOL)open;
+
+/// Writes the payload to disk and returns its id, or 0 if the spool refused
+/// it (no room without evicting a higher kind, or a write failed).
+- (uint64_t)putKind:(RJSpoolKind)kind meta:(NSData *)meta payload:(NSData *)payload NS_SWIFT_NAME(put(kind:meta:payload:));
+
+/// Up to `limit` pending uploads of kind `lowest` or above, oldest first,
+/// leaving out ids in `excluded`.
+- (NSArray<RJSpoolEntry *> *)pendingWithLimit:(NSUInteger)limit
+                                    excluding:(NSArray<NSNumber *> *)excluded
+                                     fromKind:(RJSpoolKind)lowest NS_SWIFT_NAME(pending(limit:excluding:from:));
+
+/// Nil when the entry was evicted or its file is gone.
+- (nullable NSData *)payloadForEntry:(uint64_t)entryId NS_SWIFT_NAME(payload(for:));
+
+- (void)completeEntry:(uint64_t)entryId NS_SWIFT_NAME(complete(_:));
+/// NO when that was the last attempt and the entry was dropped.
+- (BOOL)failEntry:(uint64_t)entryId NS_SWIFT_NAME(fail(_:));
+
+@property(nonatomic, readonly) NSUInteger count;
+@property(nonatomic, readonly) uint64_t bytes;
+@property(nonatomic, readonly) uint64_t evictedEntries;
+@property(nonatomic, readonly) uint64_t evictedBytes;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "RJUploadSpool.h"
+
+#include "UploadSpool.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+@implementation RJSpoolEntry
+
+- (instancetype)initWithEntry:(const rejourney::UploadSpool::Entry &)entry {
+  self = [super init];
+  if (self) {
+    _entryId = entry.id;
+    _kind = static_cast<RJSpoolKind>(entry.kind);
+    _attempts = entry.attempts;
+    _meta = [NSData dataWithBytes:entry.meta.data() length:entry.meta.size()];
+  }
+  return self;
+}
+
+@end
+
+@implementation RJUploadSpool {
+  std::unique_ptr<rejourney::UploadSpool> _spool;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                       byteBudget:(uint64_t)byteBudget
+                      maxAttempts:(NSUInteger)maxAttempts {
+  self = [super init];
+  if (self) {
+    rejourney::UploadSpool::Options options;
+    options.byteBudget = byteBudget;
+    options.maxAttempts = static_cast<uint32_t>(maxAttempts);
+    _spool = std::make_unique<rejourney::UploadSpool>(directory.UTF8String, options);
+  }
+  return self;
+}
+
+- (BOOL)open {
+  return _spool->open();
+}
+
+- (uint64_t)putKind:(RJSpoolKind)kind meta:(NSData *)meta payload:(NSData *)payload {
+  const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+  return _spool->put(static_cast<rejourney::UploadSpool::Kind>(kind),
+                     std::string_view(static_cast<const char *>(meta.bytes), meta.length),
+                     std::string_view(static_cast<const char *>(payload.bytes), payload.length),
+                     nowMs);
+}
+
+- (NSArray<RJSpoolEntry *> *)pendingWithLimit:(NSUInteger)limit
+                                    excluding:(NSArray<NSNumber *> *)excluded
+                                     fromKind:(RJSpoolKind)lowest {
+  std::vector<uint64_t> exclude;
+  exclude.reserve(excluded.count);
+  for (NSNumber *entryId in excluded) {
+    exclude.push_back(entryId.unsignedLongLongValue);
+  }
+  const auto entries = _spool->pending(limit, exclude, static_cast<rejourney::UploadSpool::Kind>(lowest));
+  NSMutableArray<RJSpoolEntry *> *result = [NSMutableArray arrayWithCapacity:entries.size()];
+  for (const auto &entry : entries) {
+    [result addObject:[[RJSpoolEntry alloc] initWithEntry:entry]];
+  }
+  return result;
+}
+
+- (nullable NSData *)payloadForEntry:(uint64_t)entryId {
+  auto *payload = new std::string();
+  if (!_spool->read(entryId, *payload)) {
+    delete payload;
+    return nil;
+  }
+  return [[NSData alloc] initWithBytesNoCopy:payload->data()
+                                      length:payload->size()
+                                 deallocator:^(void *, NSUInteger) {
+                                   delete payload;
+                                 }];
+}
+
+- (void)completeEntry:(uint64_t)entryId {
+  _spool->complete(entryId);
+}
+
+- (BOOL)failEntry:(uint64_t)entryId {
+  return _spool->failed(entryId);
+}
+
+- (NSUInteger)count {
+  return _spool->stats().entries;
+}
+
+- (uint64_t)bytes {
+  return _spool->stats().bytes;
+}
+
+- (uint64_t)evictedEntries {
+  return _spool->stats().evictedEntries;
+}
+
+- (uint64_t)evictedBytes {
+  return _spool->stats().evictedBytes;
+}
+
+@end
@@ -607,13 +607,24 @@ public final class RejourneyImpl: NSObject {
         resolve: @escaping RCTPromiseResolveBlock,
         reject: @escaping RCTPromiseRejectBlock
     ) {
+        _routeEvent(eventType, details: details)
+        resolve(["success": true])
+    }
+
+    /// Fire-and-forget variant used by the JSI fast path in Rejourney.mm.
+    /// No promise is created on either side of the call.
+    @objc(logEventFast:details:)
+    public func logEventFast(_ eventType: String, details: NSDictionary) {
+        _routeEvent(eventType, details: details)
+    }
+
+    private func _routeEvent(_ eventType: String, details: NSDictionary) {
         // Handle network_request events specially to preserve type for backend metrics
         if eventType == "network_request" {
             // Convert NSDictionary to Swift dictionary for network event encoding
             if let detailsDict = details as? [String: Any] {
                 TelemetryPipeline.shared.recordNetworkEvent(details: detailsDict)
             }
-            resolve(["success": true])
             return
         }
 
@@ -624,7 +635,6 @@ public final class RejourneyImpl: NSObject {
             let name = details["name"] as? String ?? "Error"
             let stack = details["stack"] as? String
             TelemetryPipeline.shared.recordJSErrorEvent(name: name, message: message, stack: stack)
-            resolve(["success": true])
             return
         }
 
@@ -635,12 +645,10 @@ public final class RejourneyImpl: NSObject {
             let y = (details["y"] as? NSNumber)?.uint64Value ?? 0
             let label = details["label"] as? String ?? "unknown"
             guard !TelemetryPipeline.shared.isKeyboardVisible else {
-                resolve(["success": true])
                 return
             }
             TelemetryPipeline.shared.recordDeadTapEvent(label: label, x: x, y: y)
             ReplayOrchestrator.shared.incrementDeadTapTally()
-            resolve(["success": true])
             return
         }
 
@@ -650,7 +658,6 @@ public final class RejourneyImpl: NSObject {
             let level = details["level"] as? String ?? "log"
             let message = details["message"] as? String ?? ""
             TelemetryPipeline.shared.recordConsoleLogEvent(level: level, message: message)
-            resolve(["success": true])
             return
         }
 
@@ -661,7 +668,6 @@ public final class RejourneyImpl: NSObject {
             payload = str
         }
         ReplayOrchestrator.shared.recordCustomEvent(name: eventType, payload: payload)
-        resolve(["success": true])
     }
 
     @objc(screenChanged:resolve:reject:)
@@ -670,9 +676,14 @@ public final class RejourneyImpl: NSObject {
         resolve: @escaping RCTPromiseResolveBlock,
         reject: @escaping RCTPromiseRejectBlock
     ) {
+        screenChangedFast(screenName)
+        resolve(["success": true])
+    }
+
+    @objc(screenChangedFast:)
+    public func screenChangedFast(_ screenName: String) {
         TelemetryPipeline.shared.recordViewTransition(viewId: screenName, viewLabel: screenName, entering: true)
         ReplayOrchestrator.shared.logScreenView(screenName)
-        resolve(["success": true])
     }
 
     @objc(onScroll:resolve:reject:)
@@ -681,10 +692,15 @@ public final class RejourneyImpl: NSObject {
         resolve: @escaping RCTPromiseResolveBlock,
         reject: @escaping RCTPromiseRejectBlock
     ) {
-        ReplayOrchestrator.shared.logScrollAction()
+        onScrollFast(offsetY)
         resolve(["success": true])
     }
 
+    @objc(onScrollFast:)
+    public func onScrollFast(_ offsetY: Double) {
+        ReplayOrchestrator.shared.logScrollAction()
+    }
+
     @objc(markVisualChange:importance:resolve:reject:)
     public func markVisualChange(
         _ reason: String,
@@ -692,8 +708,11 @@ public final class RejourneyImpl: NSObject {
         resolve: @escaping RCTPromiseResolveBlock,
         reject: @escaping RCTPromiseRejectBlock
     ) {
-        if importance == "high" {
-            VisualCapture.shared.snapshotNow()
+        switch importance {
+        case "critical": VisualCapture.shared.noteVisualChange(.critical)
+        case "high": VisualCapture.shared.noteVisualChange(.high)
+        case "low": VisualCapture.shared.noteVisualChange(.low)
+        default: VisualCapture.shared.noteVisualChange(.medium)
         }
         resolve(true)
     }
@@ -736,9 +755,7 @@ public final class RejourneyImpl: NSObject {
         reject: @escaping RCTPromiseRejectBlock
     ) {
         DispatchQueue.main.async {
-            if let target = self.findView(by: nativeID) {
-                ReplayOrchestrator.shared.redactView(target)
-            }
+            NativeIDViewIndex.shared.mask(nativeID)
         }
         resolve(["success": true])
     }
@@ -750,30 +767,11 @@ public final class RejourneyImpl: NSObject {
         reject: @escaping RCTPromiseRejectBlock
     ) {
         DispatchQueue.main.async {
-            if let target = self.findView(by: nativeID) {
-                ReplayOrchestrator.shared.unredactView(target)
-            }
+            NativeIDViewIndex.shared.unmask(nativeID)
         }
         resolve(["success": true])
     }
 
-    private func findView(by identifier: String) -> UIView? {
-        guard let window = UIApplication.shared.windows.first(where: { $0.isKeyWindow }) else { return nil }
-        return scanView(window, id: identifier)
-    }
-
-    private func scanView(_ node: UIView, id: String) -> UIView? {
-        if node.accessibilityIdentifier == id || node.nativeID == id {
-            return node
-        }
-        for child in node.subviews {
-            if let match = scanView(child, id: id) {
-                return match
-            }
-        }
-        return nil
-    }
-
     @objc(setDebugMode:resolve:reject:)
     public func setDebugMode(
         _ enabled: Bool,
@@ -818,7 +816,9 @@ public final class RejourneyImpl: NSObject {
         reject: @escaping RCTPromiseRejectBlock
     ) {
         let queueDepth = TelemetryPipeline.shared.getQueueDepth()
-        resolve(SegmentDispatcher.shared.sdkTelemetrySnapshot(currentQueueDepth: queueDepth))
+        var metrics = SegmentDispatcher.shared.sdkTelemetrySnapshot(currentQueueDepth: queueDepth)
+        metrics.merge(ViewClassifier.shared.metrics()) { current, _ in current }
+        resolve(metrics)
     }
 
     @objc(getDeviceInfo:reject:)
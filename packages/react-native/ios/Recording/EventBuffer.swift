@@ -17,18 +17,29 @@
 import Foundation
 
 /// Write-first event buffer for crash-safe event persistence.
-/// Events are written to disk on append for crash safety.
-/// JSONL format (one JSON object per line).
+/// Events are appended to a segmented write-ahead log (one JSON object per
+/// record) so recovery after a crash reads segment footers instead of
+/// re-parsing every event.
 @objc(RJEventBuffer)
 public final class EventBuffer: NSObject {
     
     @objc public static let shared = EventBuffer()
     
+    private static let logDirectoryName = "events.wal"
+    /// Written by SDK versions before the segmented log; still read on recovery.
+    private static let legacyEventsFileName = "events.jsonl"
+    /// Events of the session already delivered by recovery uploads.
+    private static let uploadProgressFileName = "upload_progress"
+    
+    /// Appends are staged in memory and written in batches; a crash loses at
+    /// most this many milliseconds of events. Zero writes every event through.
+    /// Applied on the next `configure`.
+    @objc public var durabilityWindowMs: UInt32 = 100
+    
     private let _lock = NSLock()
     private var _sessionId: String?
-    private var _eventsFile: URL?
+    private var _log: RJSegmentedLog?
     private var _metaFile: URL?
-    private var _fileHandle: FileHandle?
     private var _eventCount: Int = 0
     private var _lastEventTimestamp: Int64 = 0
     private var _pendingRootPath: URL?
@@ -56,7 +67,8 @@ public final class EventBuffer: NSObject {
         _lock.lock()
         defer { _lock.unlock() }
         
-        _closeFileHandle()
+        _log?.close()
+        _log = nil
         
         _sessionId = sessionId
         _isShutdown = false
@@ -76,11 +88,19 @@ public final class EventBuffer: NSObject {
             return
         }
         
-        _eventsFile = sessionDir.appendingPathComponent("events.jsonl")
         _metaFile = sessionDir.appendingPathComponent("buffer_meta.json")
         
-        _countExistingEvents()
-        _openFileHandle()
+        let log = RJSegmentedLog(
+            directory: sessionDir.appendingPathComponent(EventBuffer.logDirectoryName).path,
+            groupCommitDelayMs: durabilityWindowMs
+        )
+        guard log.open() else {
+            DiagnosticLog.debugStorage(op: "CONFIGURE", key: sessionId, success: false, detail: "Failed to open event log")
+            return
+        }
+        _log = log
+        _eventCount = Int(log.count)
+        _lastEventTimestamp = log.lastTimestampMs
         
         DiagnosticLog.debugStorage(op: "CONFIGURE", key: sessionId, success: true, detail: "Ready with \(_eventCount) existing events")
     }
@@ -101,77 +121,69 @@ public final class EventBuffer: NSObject {
         _lock.lock()
         defer { _lock.unlock() }
         
-        guard let handle = _fileHandle else { return false }
+        guard let log = _log else { return false }
         
-        do {
-            try handle.synchronize()
-            _saveMeta()
-            return true
-        } catch {
-            DiagnosticLog.debugStorage(op: "FLUSH", key: _sessionId ?? "", success: false, detail: "\(error)")
+        guard log.sync() else {
+            DiagnosticLog.debugStorage(op: "FLUSH", key: _sessionId ?? "", success: false, detail: "sync failed")
             return false
         }
+        _saveMeta()
+        return true
     }
     
-    @objc public func shutdown() {
-        _lock.lock()
+    /// Writes staged events to the file without waiting for the buffer lock,
+    /// which the crashing thread may hold. Used by crash handlers.
+    @objc public func flushForCrash() {
+        guard _lock.try() else { return }
         defer { _lock.unlock() }
-        
-        _isShutdown = true
-        _saveMeta()
-        _closeFileHandle()
+        _ = _log?.flush()
     }
     
-    @objc public func readPendingEvents() -> [[String: Any]] {
+    @objc public func shutdown() {
         _lock.lock()
         defer { _lock.unlock() }
         
-        guard let eventsFile = _eventsFile, FileManager.default.fileExists(atPath: eventsFile.path) else {
-            return []
-        }
-        
-        var events: [[String: Any]] = []
-        
-        do {
-            let content = try String(contentsOf: eventsFile, encoding: .utf8)
-            let lines = content.components(separatedBy: .newlines)
-            
-            for line in lines where !line.isEmpty {
-                if let data = line.data(using: .utf8),
-                   let event = try? JSONSerialization.jsonObject(with: data) as? [String: Any] {
-                    events.append(event)
-                }
-            }
-        } catch {
-            DiagnosticLog.debugStorage(op: "READ", key: _sessionId ?? "", success: false, detail: "\(error)")
-        }
-        
-        return events
+        _isShutdown = true
+        _saveMeta()
+        _log?.close()
     }
     
     @objc public func clearEvents() {
         _lock.lock()
         defer { _lock.unlock() }
         
-        _closeFileHandle()
+        _log?.clear()
         
-        if let eventsFile = _eventsFile {
-            try? FileManager.default.removeItem(at: eventsFile)
-        }
         if let metaFile = _metaFile {
             try? FileManager.default.removeItem(at: metaFile)
+            let legacyFile = metaFile.deletingLastPathComponent().appendingPathComponent(EventBuffer.legacyEventsFileName)
+            try? FileManager.default.removeItem(at: legacyFile)
         }
         
         _eventCount = 0
         _lastEventTimestamp = 0
-        
-        _openFileHandle()
     }
     
+    /// Removes the session's events once they are delivered. The session
+    /// directory is shared with VisualCapture's unsent frames, so it only
+    /// goes when nothing else is left in it.
     @objc public func clearSession(_ sessionId: String) {
-        guard let cacheDir = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first else { return }
-        let sessionDir = cacheDir.appendingPathComponent("rj_pending").appendingPathComponent(sessionId)
-        try? FileManager.default.removeItem(at: sessionDir)
+        guard let sessionDir = _sessionDirectory(sessionId) else { return }
+        let fileManager = FileManager.default
+        for name in [EventBuffer.logDirectoryName, EventBuffer.legacyEventsFileName,
+                     EventBuffer.uploadProgressFileName, "buffer_meta.json"] {
+            try? fileManager.removeItem(at: sessionDir.appendingPathComponent(name))
+        }
+        if let rest = try? fileManager.contentsOfDirectory(atPath: sessionDir.path), rest.isEmpty {
+            try? fileManager.removeItem(at: sessionDir)
+        }
+    }
+    
+    /// Session the buffer is currently writing, if configured.
+    @objc public var activeSessionId: String? {
+        _lock.lock()
+        defer { _lock.unlock() }
+        return _sessionId
     }
     
     /// Returns list of session IDs that have pending data on disk
@@ -184,123 +196,99 @@ public final class EventBuffer: NSObject {
         }
         
         return contents.compactMap { url in
-            let eventsFile = url.appendingPathComponent("events.jsonl")
-            if FileManager.default.fileExists(atPath: eventsFile.path) {
+            let logDir = url.appendingPathComponent(EventBuffer.logDirectoryName)
+            let legacyFile = url.appendingPathComponent(EventBuffer.legacyEventsFileName)
+            if FileManager.default.fileExists(atPath: logDir.path) || FileManager.default.fileExists(atPath: legacyFile.path) {
                 return url.lastPathComponent
             }
             return nil
         }
     }
     
-    /// Read events from a specific session's pending data
-    @objc public func readEventsForSession(_ sessionId: String) -> [[String: Any]] {
-        guard let cacheDir = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first else { return [] }
-        let eventsFile = cacheDir.appendingPathComponent("rj_pending").appendingPathComponent(sessionId).appendingPathComponent("events.jsonl")
-        
-        guard FileManager.default.fileExists(atPath: eventsFile.path) else { return [] }
+    /// Streams a session's persisted events as upload-sized JSON payloads
+    /// read straight from disk. Returns nil when the session has nothing on disk.
+    @objc public func pendingEventReader(sessionId: String, maxBatchBytes: Int, deviceInfoJSON: Data) -> RJPendingEventReader? {
+        guard let sessionDir = _sessionDirectory(sessionId) else { return nil }
         
-        var events: [[String: Any]] = []
-        
-        do {
-            let content = try String(contentsOf: eventsFile, encoding: .utf8)
-            let lines = content.components(separatedBy: .newlines)
-            
-            for line in lines where !line.isEmpty {
-                if let data = line.data(using: .utf8),
-                   let event = try? JSONSerialization.jsonObject(with: data) as? [String: Any] {
-                    events.append(event)
-                }
-            }
-        } catch {
-            DiagnosticLog.debugStorage(op: "READ_SESSION", key: sessionId, success: false, detail: "\(error)")
+        _lock.lock()
+        if sessionId == _sessionId {
+            _ = _log?.flush()
         }
-        
-        return events
+        _lock.unlock()
+        
+        let logDir = sessionDir.appendingPathComponent(EventBuffer.logDirectoryName)
+        let legacyFile = sessionDir.appendingPathComponent(EventBuffer.legacyEventsFileName)
+        let hasLog = FileManager.default.fileExists(atPath: logDir.path)
+        let hasLegacy = FileManager.default.fileExists(atPath: legacyFile.path)
+        guard hasLog || hasLegacy else { return nil }
+        
+        let reader = RJPendingEventReader(
+            logDirectory: logDir.path,
+            legacyFilePath: hasLegacy ? legacyFile.path : nil,
+            maxBatchBytes: UInt(maxBatchBytes),
+            deviceInfoJSON: deviceInfoJSON
+        )
+        // Resume after the batches an earlier attempt got acknowledged.
+        let delivered = uploadedEventCount(sessionId: sessionId)
+        if delivered > 0 {
+            _ = reader.skip(UInt(delivered))
+        }
+        return reader
     }
     
-    // MARK: - Private Methods
-    
-    private func _countExistingEvents() {
-        guard let eventsFile = _eventsFile, FileManager.default.fileExists(atPath: eventsFile.path) else {
-            _eventCount = 0
-            _lastEventTimestamp = 0
-            return
-        }
-        
-        do {
-            let content = try String(contentsOf: eventsFile, encoding: .utf8)
-            let lines = content.components(separatedBy: .newlines)
-            
-            var count = 0
-            var lastTs: Int64 = 0
-            
-            for line in lines where !line.isEmpty {
-                if let data = line.data(using: .utf8),
-                   let event = try? JSONSerialization.jsonObject(with: data) as? [String: Any] {
-                    count += 1
-                    if let ts = event["timestamp"] as? Int64, ts > lastTs {
-                        lastTs = ts
-                    } else if let ts = event["timestamp"] as? Int, Int64(ts) > lastTs {
-                        lastTs = Int64(ts)
-                    }
-                }
-            }
-            
-            _eventCount = count
-            _lastEventTimestamp = lastTs
-            
-            // Load meta if exists
-            if let metaFile = _metaFile, FileManager.default.fileExists(atPath: metaFile.path) {
-                if let metaData = try? Data(contentsOf: metaFile),
-                   let meta = try? JSONSerialization.jsonObject(with: metaData) as? [String: Any] {
-                    // Could track uploadedEventCount here
-                }
-            }
-        } catch {
-            _eventCount = 0
-            _lastEventTimestamp = 0
-        }
+    /// Events of `sessionId` the backend has acknowledged so far.
+    @objc public func uploadedEventCount(sessionId: String) -> Int {
+        guard let file = _sessionDirectory(sessionId)?.appendingPathComponent(EventBuffer.uploadProgressFileName),
+              let text = try? String(contentsOf: file, encoding: .utf8) else { return 0 }
+        return max(0, Int(text.trimmingCharacters(in: .whitespacesAndNewlines)) ?? 0)
     }
     
-    private func _openFileHandle() {
-        guard let eventsFile = _eventsFile else { return }
-        
-        if !FileManager.default.fileExists(atPath: eventsFile.path) {
-            FileManager.default.createFile(atPath: eventsFile.path, contents: nil)
-        }
-        
+    /// Records that `count` more events of `sessionId` were acknowledged, so
+    /// a failure later in the session does not send them again.
+    @objc public func markEventsUploaded(_ count: Int, sessionId: String) {
+        guard count > 0,
+              let file = _sessionDirectory(sessionId)?.appendingPathComponent(EventBuffer.uploadProgressFileName) else { return }
+        let total = uploadedEventCount(sessionId: sessionId) + count
         do {
-            _fileHandle = try FileHandle(forWritingTo: eventsFile)
-            try _fileHandle?.seekToEnd()
+            try String(total).write(to: file, atomically: true, encoding: .utf8)
         } catch {
-            DiagnosticLog.debugStorage(op: "OPEN_HANDLE", key: _sessionId ?? "", success: false, detail: "\(error)")
+            DiagnosticLog.debugStorage(op: "UPLOAD_PROGRESS", key: sessionId, success: false, detail: "\(error)")
         }
     }
     
-    private func _closeFileHandle() {
-        try? _fileHandle?.close()
-        _fileHandle = nil
+    // MARK: - Private Methods
+    
+    private func _sessionDirectory(_ sessionId: String) -> URL? {
+        guard let cacheDir = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first else { return nil }
+        return cacheDir.appendingPathComponent("rj_pending").appendingPathComponent(sessionId)
     }
     
     private func _writeEventToDisk(_ event: [String: Any]) -> Bool {
-        guard let handle = _fileHandle else {
-            _openFileHandle()
-            guard _fileHandle != nil else { return false }
-            return _writeEventToDisk(event)
+        guard let log = _log else { return false }
+        // JSONSerialization raises rather than throws on values it cannot encode.
+        guard JSONSerialization.isValidJSONObject(event) else {
+            DiagnosticLog.debugStorage(op: "WRITE", key: event["type"] as? String ?? "unknown", success: false, detail: "not JSON")
+            return false
         }
         
         do {
             let data = try JSONSerialization.data(withJSONObject: event)
-            var line = data
-            line.append(0x0A) // newline
-            
-            try handle.write(contentsOf: line)
             
-            _eventCount += 1
+            var timestamp: Int64 = 0
             if let ts = event["timestamp"] as? Int64 {
-                _lastEventTimestamp = ts
+                timestamp = ts
             } else if let ts = event["timestamp"] as? Int {
-                _lastEventTimestamp = Int64(ts)
+                timestamp = Int64(ts)
+            }
+            
+            guard log.append(data, timestampMs: timestamp) else {
+                DiagnosticLog.debugStorage(op: "WRITE", key: event["type"] as? String ?? "unknown", success: false, detail: "append failed")
+                return false
+            }
+            
+            _eventCount += 1
+            if timestamp > 0 {
+                _lastEventTimestamp = timestamp
             }
             
             return true
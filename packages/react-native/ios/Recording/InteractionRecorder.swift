@@ -107,6 +107,7 @@ public final class InteractionRecorder: NSObject {
         guard isTracking, let agg = _gestureAggregator else { return }
         guard let touches = event.allTouches else { return }
         _lastInteractionTimestampMs = UInt64(Date().timeIntervalSince1970 * 1000)
+        VisualCapture.shared.noteInteraction()
 
         // Notify SpecialCases about touch phases for touch-based map idle detection
         // (used by Mapbox v10+ where SDK idle callbacks can't be hooked).
@@ -406,7 +407,7 @@ private final class GestureAggregator: NSObject {
         
         guard let hit = window.hitTest(point, with: nil) else { return ("window", false) }
         
-        let label = hit.accessibilityIdentifier ?? hit.accessibilityLabel ?? String(describing: type(of: hit))
+        let label = hit.accessibilityIdentifier ?? hit.accessibilityLabel ?? ViewClassifier.shared.classify(hit).name
         let isInteractive = _isViewInteractive(hit)
         
         return (label, isInteractive)
@@ -440,11 +441,8 @@ private final class GestureAggregator: NSObject {
     }
     
     private func _isSingleViewInteractive(_ view: UIView) -> Bool {
-        // Native UIControls (UIButton, UISwitch, UISlider, etc.)
-        if view is UIControl { return true }
-        
-        // Text inputs
-        if view is UITextField || view is UITextView { return true }
+        // Native UIControls (UIButton, UISwitch, UISlider, etc.) and text inputs
+        if ViewClassifier.shared.classify(view).traits.contains(.interactiveClass) { return true }
         
         // Keep this for RN 1.2.x compatibility: Pressable / TouchableOpacity /
         // Button commonly rely on `isAccessibilityElement`, unlike SwiftUI
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import UIKit
+import ObjectiveC
+import React
+
+// MARK: - NativeIDViewIndex
+/// Live views by `nativeID` / `accessibilityIdentifier`, for
+/// `maskViewByNativeID` and `unmaskViewByNativeID`.
+///
+/// Looking a view up used to walk the whole key window on the main thread
+/// for every call, and a view mounted after the call was never masked.
+/// Instead a `UIView.didMoveToWindow` swizzle, installed on first use, keeps
+/// this index current, and masks are remembered by identifier so a view that
+/// mounts later is masked as soon as it reaches a window.
+///
+/// Main thread only, like the UIKit callbacks that feed it.
+final class NativeIDViewIndex {
+
+    static let shared = NativeIDViewIndex()
+
+    private var _views: [String: NSHashTable<UIView>] = [:]
+    private var _maskedIDs: Set<String> = []
+    private var _installed = false
+
+    private init() {}
+
+    func mask(_ identifier: String) {
+        _installIfNeeded()
+        _maskedIDs.insert(identifier)
+        for view in _liveViews(for: identifier) {
+            ReplayOrchestrator.shared.redactView(view)
+        }
+    }
+
+    func unmask(_ identifier: String) {
+        _installIfNeeded()
+        _maskedIDs.remove(identifier)
+        for view in _liveViews(for: identifier) {
+            ReplayOrchestrator.shared.unredactView(view)
+        }
+    }
+
+    /// Called from the swizzled `didMoveToWindow`; cheap for views without
+    /// an identifier, which are most of them.
+    fileprivate func viewDidMoveToWindow(_ view: UIView) {
+        let accessibilityID = view.accessibilityIdentifier
+        let nativeID = view.nativeID
+        if accessibilityID == nil && nativeID == nil { return }
+
+        for identifier in [accessibilityID, nativeID] {
+            guard let identifier = identifier, !identifier.isEmpty else { continue }
+            if view.window != nil {
+                _index(view, as: identifier)
+                if _maskedIDs.contains(identifier) {
+                    ReplayOrchestrator.shared.redactView(view)
+                }
+            } else {
+                _views[identifier]?.remove(view)
+                if _views[identifier]?.count == 0 { _views[identifier] = nil }
+            }
+        }
+    }
+
+    private func _index(_ view: UIView, as identifier: String) {
+        if let views = _views[identifier] {
+            views.add(view)
+        } else {
+            let views = NSHashTable<UIView>.weakObjects()
+            views.add(view)
+            _views[identifier] = views
+        }
+    }
+
+    /// Identifiers can change after mount; only trust views that still carry it.
+    private func _liveViews(for identifier: String) -> [UIView] {
+        guard let views = _views[identifier] else { return [] }
+        return views.allObjects.filter {
+            $0.window != nil && ($0.accessibilityIdentifier == identifier || $0.nativeID == identifier)
+        }
+    }
+
+    /// Swizzle once, then index what is already on screen with a single walk.
+    private func _installIfNeeded() {
+        guard !_installed else { return }
+        _installed = true
+        ObjCRuntimeUtils.hotswapSafely(
+            cls: UIView.self,
+            original: #selector(UIView.didMoveToWindow),
+            replacement: #selector(UIView.rj_didMoveToWindow)
+        )
+        let windows = UIApplication.shared.connectedScenes
+            .compactMap { $0 as? UIWindowScene }
+            .flatMap { $0.windows }
+        for window in windows {
+            _seed(window)
+        }
+    }
+
+    private func _seed(_ view: UIView) {
+        viewDidMoveToWindow(view)
+        for subview in view.subviews {
+            _seed(subview)
+        }
+    }
+}
+
+// MARK: - UIView didMoveToWindow Swizzle
+
+extension UIView {
+    /// After ObjCRuntimeUtils.hotswapSafely swaps the IMP pointers, calling
+    /// rj_didMoveToWindow actually invokes the ORIGINAL didMoveToWindow.
+    @objc func rj_didMoveToWindow() {
+        rj_didMoveToWindow()
+        NativeIDViewIndex.shared.viewDidMoveToWindow(self)
+    }
+}
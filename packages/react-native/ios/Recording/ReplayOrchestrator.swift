@@ -39,6 +39,8 @@ public final class ReplayOrchestrator: NSObject {
 
     @objc public var snapshotInterval: Double = 1.0
     @objc public var compressionLevel: Double = 0.5
+    /// Upload rate frame quality is held to (kilobits per second).
+    @objc public var frameBitrateKbps: Int = 320
     @objc public var visualCaptureEnabled: Bool = true
     @objc public var interactionCaptureEnabled: Bool = true
     @objc public var faultTrackingEnabled: Bool = true
@@ -97,7 +99,9 @@ public final class ReplayOrchestrator: NSObject {
     private var _bgStartMs: UInt64?
     private var _finalized = false
     private var _hierarchyTimer: Timer?
-    private var _lastHierarchyHash: String?
+    /// Deltas refer to the last keyframe, so a new session or a lost keyframe
+    /// upload needs a fresh one.
+    private var _needsHierarchyKeyframe = true
     private var _durationLimitTimer: DispatchWorkItem?
     private var _recoveryCheckpointTimer: DispatchSourceTimer?
     private var _lastActiveCheckpointMs: UInt64 = 0
@@ -415,6 +419,7 @@ public final class ReplayOrchestrator: NSObject {
         }
         _visitedScreens.append(screenId)
         currentScreenName = screenId
+        VisualCapture.shared.noteScreenChange()
         if hierarchyCaptureEnabled { _captureHierarchy() }
     }
 
@@ -437,7 +442,7 @@ public final class ReplayOrchestrator: NSObject {
         _bgStartMs = nil
         _lastActiveCheckpointMs = replayStartMs
         _lastBackgroundEntryMs = nil
-        _lastHierarchyHash = nil
+        _needsHierarchyKeyframe = true
 
         TelemetryPipeline.shared.currentReplayId = replayId
         SegmentDispatcher.shared.currentReplayId = replayId
@@ -472,6 +477,7 @@ public final class ReplayOrchestrator: NSObject {
         captureNativeSheets = cfg["captureNativeSheets"] as? Bool ?? true
         wifiRequired = cfg["wifiOnly"] as? Bool ?? false
         frameBundleSize = cfg["screenshotBatchSize"] as? Int ?? 3
+        frameBitrateKbps = cfg["frameBitrateKbps"] as? Int ?? 320
         InteractionRecorder.shared.configureRageTapDetection(
             enabled: cfg["detectRageTaps"] as? Bool ?? true,
             threshold: cfg["rageTapThreshold"] as? Int ?? 3,
@@ -480,6 +486,8 @@ public final class ReplayOrchestrator: NSObject {
         )
         SegmentDispatcher.shared.collectGeoLocation = cfg["collectGeoLocation"] as? Bool ?? true
         SegmentDispatcher.shared.observeOnly = cfg["observeOnly"] as? Bool ?? false
+        SegmentDispatcher.shared.configureUploadWindow(cfg["uploadConcurrency"] as? Int ?? 4)
+        SegmentDispatcher.shared.configureMeteredDeferral(cfg["deferMeteredFrames"] as? Bool ?? true)
     }
 
     private func _monitorNetwork(token: String) {
@@ -505,21 +513,28 @@ public final class ReplayOrchestrator: NSObject {
 
         // Extract network interface type
         let networkType: String
+        let networkPath: NetworkPath
         let isExpensive = path.isExpensive
         let isConstrained = path.isConstrained
 
         if path.status != .satisfied {
             networkType = "none"
+            networkPath = .none
         } else if path.usesInterfaceType(.wifi) {
             networkType = "wifi"
+            networkPath = .wifi
         } else if path.usesInterfaceType(.cellular) {
             networkType = "cellular"
+            networkPath = .cellular
         } else if path.usesInterfaceType(.wiredEthernet) {
             networkType = "wired"
+            networkPath = .wired
         } else if path.usesInterfaceType(.loopback) {
             networkType = "other"
+            networkPath = .other
         } else {
             networkType = "other"
+            networkPath = .other
         }
 
         DispatchQueue.main.async { [weak self] in
@@ -528,6 +543,8 @@ public final class ReplayOrchestrator: NSObject {
             self.currentNetworkType = networkType
             self.networkIsExpensive = isExpensive
             self.networkIsConstrained = isConstrained
+            VisualCapture.shared.noteNetworkConstrained(isConstrained)
+            SegmentDispatcher.shared.notePath(networkPath, expensive: isExpensive, constrained: isConstrained)
 
             if canProceed && !self._live {
                 self._beginRecording(token: token)
@@ -562,7 +579,9 @@ public final class ReplayOrchestrator: NSObject {
         SegmentDispatcher.shared.activate()
         TelemetryPipeline.shared.activate()
 
-        VisualCapture.shared.configure(snapshotInterval: snapshotInterval, jpegQuality: compressionLevel, uploadBatchSize: frameBundleSize)
+        VisualCapture.shared.configure(snapshotInterval: snapshotInterval, jpegQuality: compressionLevel, uploadBatchSize: frameBundleSize,
+                                       targetBytesPerSecond: frameBitrateKbps * 1000 / 8)
+        VisualCapture.shared.noteNetworkConstrained(networkIsConstrained)
 
         if visualCaptureEnabled { VisualCapture.shared.beginCapture(sessionOrigin: replayStartMs) }
         if interactionCaptureEnabled { InteractionRecorder.shared.activate() }
@@ -737,27 +756,21 @@ public final class ReplayOrchestrator: NSObject {
             return
         }
 
-        guard var hierarchy = ViewHierarchyScanner.shared.captureHierarchy() else { return }
         let ts = timestampMs ?? UInt64(Date().timeIntervalSince1970 * 1000)
-        hierarchy["timestamp"] = Int64(ts)
+        guard let snapshot = ViewHierarchyScanner.shared.captureSnapshot(timestampMs: ts, forceKeyframe: _needsHierarchyKeyframe) else { return }
+        if skipDuplicate && snapshot.encoding == .unchanged { return }
 
-        let hash = _hierarchyHash(hierarchy)
-        if skipDuplicate && hash == _lastHierarchyHash { return }
-        _lastHierarchyHash = hash
-
-        guard let json = try? JSONSerialization.data(withJSONObject: hierarchy) else { return }
-        guard let compressed = json.gzipCompress() else { return }
-
-        SegmentDispatcher.shared.transmitHierarchy(replayId: sid, hierarchyPayload: compressed, timestampMs: ts, completion: nil)
-    }
+        let isKeyframe = snapshot.encoding == .keyframe
+        guard let compressed = snapshot.payload.gzipCompress() else {
+            if isKeyframe { _needsHierarchyKeyframe = true }
+            return
+        }
+        if isKeyframe { _needsHierarchyKeyframe = false }
 
-    private func _hierarchyHash(_ h: [String: Any]) -> String {
-        let screen = currentScreenName ?? "unknown"
-        var childCount = 0
-        if let root = h["root"] as? [String: Any], let children = root["children"] as? [[String: Any]] {
-            childCount = children.count
+        SegmentDispatcher.shared.transmitHierarchy(replayId: sid, hierarchyPayload: compressed, timestampMs: ts) { [weak self] ok in
+            guard isKeyframe && !ok else { return }
+            DispatchQueue.main.async { self?._needsHierarchyKeyframe = true }
         }
-        return "\(screen):\(childCount)"
     }
 }
 
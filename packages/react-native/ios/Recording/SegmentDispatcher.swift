@@ -39,17 +39,20 @@ final class SegmentDispatcher {
     private let circuitBreakerThreshold = 5
     private let circuitResetTime: TimeInterval = 60
     
-    private let workerQueue: OperationQueue = {
-        let q = OperationQueue()
-        q.maxConcurrentOperationCount = 2
-        q.qualityOfService = .utility
-        q.name = "co.rejourney.uploader"
-        return q
-    }()
+    // Uploads start through per-kind lanes (see cpp/UploadLanes.h): events
+    // ahead of hierarchy ahead of frames, up to the upload window in flight.
+    // Events and hierarchy go one at a time so batches land in order; frames
+    // pipeline across the window minus one place kept for the other kinds.
+    private static let defaultUploadWindow = 4
+    private static let maxUploadWindow = 6
+    private let uploadLanes = RJUploadLanes(window: UInt(defaultUploadWindow))
+    private let laneLock = NSLock()
+    private var laneWork: [UInt64: (@escaping () -> Void) -> Void] = [:]
+    private let laneQueue = DispatchQueue(label: "co.rejourney.uploader", qos: .utility, attributes: .concurrent)
     
     private let httpSession: URLSession = {
         let cfg = URLSessionConfiguration.ephemeral
-        cfg.httpMaximumConnectionsPerHost = 4
+        cfg.httpMaximumConnectionsPerHost = SegmentDispatcher.maxUploadWindow
         cfg.waitsForConnectivity = true
         cfg.timeoutIntervalForRequest = 30
         cfg.timeoutIntervalForResource = 60
@@ -60,13 +63,55 @@ final class SegmentDispatcher {
         return URLSession(configuration: cfg)
     }()
     
-    private var retryQueue: [PendingUpload] = []
-    private let retryLock = NSLock()
-    private let maxRetryQueueSize = 20
+    // Uploads that failed, or were refused while the circuit was open, wait
+    // on disk in the spool (see cpp/UploadSpool.h) rather than in memory.
+    // They are retried oldest first, ahead of fresh uploads of their kind,
+    // after any successful upload and on the next launch.
+    private static let spoolByteBudget: UInt64 = 50 * 1024 * 1024
+    private static let spoolMaxAttempts: UInt = 10
+    private static let spoolDrainBatch = 8
+    private let spool: RJUploadSpool? = {
+        guard let cacheDir = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first else { return nil }
+        let spool = RJUploadSpool(
+            directory: cacheDir.appendingPathComponent("rj_spool").path,
+            byteBudget: SegmentDispatcher.spoolByteBudget,
+            maxAttempts: SegmentDispatcher.spoolMaxAttempts
+        )
+        guard spool.open() else {
+            DiagnosticLog.caution("[SegmentDispatcher] Upload spool unavailable; failed uploads will not be retried")
+            return nil
+        }
+        return spool
+    }()
+    private let spoolLock = NSLock()
+    private var spoolInFlight: Set<UInt64> = []
     private var active = true
 
-    // Tracks in-flight upload chains so the shutdown drain can wait for real completion.
+    // Network-aware routing (see cpp/UploadPolicy.h): on expensive or
+    // constrained paths frame bundles go straight to the spool and ship once
+    // an unmetered path comes back; on Wi-Fi bundles grow with the measured
+    // throughput. Events and hierarchy are only held back with no path at all.
+    private let uploadPolicy = RJUploadPolicy(baseBundleFrames: 3, maxBundleFrames: 30)
+
+    // Tracks queued and in-flight upload chains so the shutdown drain can wait for real completion.
     private let _uploadGroup = DispatchGroup()
+
+    // Replay segments are presigned and confirmed through the batch endpoints:
+    // segments that need a URL while a presign call is out ride the next one,
+    // and confirms do the same. Frame bundles still waiting for an upload slot
+    // are presigned ahead of time so their PUT starts as soon as one frees up.
+    private let segmentBatchLimit = 16
+    private let maxPresignedSlots = 16
+    private let presignedSlotLifetime: TimeInterval = 600
+    private let segmentBatchLock = NSLock()
+    private var presignWaiters: [PresignWaiter] = []
+    private var presignInFlight = false
+    private var confirmWaiters: [ConfirmWaiter] = []
+    private var confirmInFlight = false
+    private var presignedSlots: [String: PresignedSlot] = [:]
+    private var prefetchingSlots: [String: [(PresignResponse?) -> Void]] = [:]
+    /// Set once the backend turns out to predate the batch endpoints.
+    private var segmentBatchUnsupported = false
     
     private let metricsLock = NSLock()
     private var uploadSuccessCount = 0
@@ -84,7 +129,9 @@ final class SegmentDispatcher {
     private var lastUploadTime: Int64?
     private var lastRetryTime: Int64?
     
-    private init() {}
+    private init() {
+        configureUploadWindow(Self.defaultUploadWindow)
+    }
     
     func configure(replayId: String, apiToken: String?, credential: String?, projectId: String?, isSampledIn: Bool = true) {
         currentReplayId = replayId
@@ -98,13 +145,9 @@ final class SegmentDispatcher {
         circuitOpen = false
         circuitOpenTime = 0
         active = true
-        retryLock.lock()
-        let droppedRetries = retryQueue.count
-        retryQueue.removeAll()
-        retryLock.unlock()
-        if droppedRetries > 0 {
-            DiagnosticLog.trace("[SegmentDispatcher] Dropped \(droppedRetries) stale retries while configuring session \(replayId.prefix(20))")
-        }
+        segmentBatchLock.lock()
+        presignedSlots.removeAll()
+        segmentBatchLock.unlock()
         resetSessionTelemetry()
     }
     
@@ -119,17 +162,70 @@ final class SegmentDispatcher {
         active = false
     }
     
-    func shipPending() {
-        workerQueue.addOperation { [weak self] in self?.drainRetryQueue() }
-        workerQueue.waitUntilAllOperationsAreFinished()
+    /// Sets how many uploads may be in flight at once (remote config
+    /// `uploadConcurrency`). Applies as running uploads finish.
+    func configureUploadWindow(_ window: Int) {
+        let clamped = min(max(window, 1), Self.maxUploadWindow)
+        uploadLanes.window = UInt(clamped)
+        uploadLanes.setLimit(UInt(max(clamped - 1, 1)), for: .frames)
+    }
+    
+    /// Starts the spooled uploads the path allows and blocks until they and
+    /// any already in flight have finished, or `timeout` seconds pass.
+    /// Callers finalize the session right after, so it must not return while
+    /// uploads are still starting. Never call from `laneQueue`.
+    func shipPending(timeout: TimeInterval = 2.0) {
+        drainSpool()
+        waitForPendingUploads(timeout: timeout)
+    }
+
+    /// Starts the spooled uploads the path allows without waiting for them;
+    /// for launch, where nothing is finalized afterwards.
+    func startSpoolDrain() {
+        laneQueue.async { self.drainSpool() }
+    }
+
+    /// Path updates from the orchestrator's path monitor. A change that lets
+    /// deferred uploads go drains the spool.
+    func notePath(_ path: NetworkPath, expensive: Bool, constrained: Bool) {
+        guard uploadPolicy.update(path: path, expensive: expensive, constrained: constrained) else { return }
+        laneQueue.async { self.drainSpool() }
+    }
+
+    /// Remote config `deferMeteredFrames`: hold frame bundles back on
+    /// expensive and constrained paths.
+    func configureMeteredDeferral(_ enabled: Bool) {
+        guard uploadPolicy.deferOnMetered != enabled else { return }
+        uploadPolicy.deferOnMetered = enabled
+        if !enabled {
+            laneQueue.async { self.drainSpool() }
+        }
+    }
+
+    /// Frames per bundle when the path gives no reason to batch more.
+    func configureFrameBundles(baseFrames: Int) {
+        uploadPolicy.baseBundleFrames = UInt(max(1, baseFrames))
+    }
+
+    /// Frames the next bundle should hold on the current path.
+    var frameBundleFrames: Int {
+        Int(uploadPolicy.bundleFrames)
+    }
+
+    /// How long the open bundle may wait for frames `frameIntervalMs` apart
+    /// before it ships short (cpp/UploadPolicy.h).
+    func frameBundleAgeLimitMs(frameIntervalMs: UInt32) -> UInt64 {
+        uploadPolicy.bundleAgeLimitMs(frameIntervalMs: frameIntervalMs)
     }
     
     func transmitFrameBundle(payload: Data, startMs: UInt64, endMs: UInt64, frameCount: Int, completion: ((Bool) -> Void)? = nil) {
         transmitFrameBundle(for: currentReplayId, payload: payload, startMs: startMs, endMs: endMs, frameCount: frameCount, completion: completion)
     }
 
+    /// `completion` gets true once the bundle landed or was spooled to be
+    /// retried; either way the caller can let go of it.
     func transmitFrameBundle(for sessionId: String?, payload: Data, startMs: UInt64, endMs: UInt64, frameCount: Int, completion: ((Bool) -> Void)? = nil) {
-        guard let sid = sessionId, canUploadNow() else {
+        guard let sid = sessionId else {
             completion?(false)
             return
         }
@@ -141,19 +237,15 @@ final class SegmentDispatcher {
             rangeStart: startMs,
             rangeEnd: endMs,
             itemCount: frameCount,
-            attempt: 0,
+            spoolId: 0,
             batchNumber: 0,
             isSampledIn: isSampledIn
         )
-        scheduleUpload(upload, completion: completion)
+        uploadPolicy.noteFrameBundle(bytes: UInt(payload.count), frames: UInt(max(0, frameCount)))
+        submitUpload(upload, completion: completion)
     }
     
     func transmitHierarchy(replayId: String, hierarchyPayload: Data, timestampMs: UInt64, completion: ((Bool) -> Void)? = nil) {
-        guard canUploadNow() else {
-            completion?(false)
-            return
-        }
-        
         let upload = PendingUpload(
             sessionId: replayId,
             contentType: "hierarchy",
@@ -161,38 +253,75 @@ final class SegmentDispatcher {
             rangeStart: timestampMs,
             rangeEnd: timestampMs,
             itemCount: 1,
-            attempt: 0,
+            spoolId: 0,
             batchNumber: 0,
             isSampledIn: isSampledIn
         )
-        scheduleUpload(upload, completion: completion)
+        submitUpload(upload, completion: completion)
     }
     
     func transmitEventBatch(payload: Data, batchNumber: Int, eventCount: Int, completion: ((Bool) -> Void)? = nil) {
-        guard let sid = currentReplayId, canUploadNow() else {
+        guard let sid = currentReplayId else {
             completion?(false)
             return
         }
         
-        let sampledIn = isSampledIn
-        workerQueue.addOperation { [weak self] in
-            self?.executeEventBatchUpload(sessionId: sid, payload: payload, batchNum: batchNumber, eventCount: eventCount, isSampledIn: sampledIn, completion: completion)
-        }
+        submitUpload(PendingUpload(
+            sessionId: sid,
+            contentType: "events",
+            payload: payload,
+            rangeStart: 0,
+            rangeEnd: 0,
+            itemCount: eventCount,
+            spoolId: 0,
+            batchNumber: batchNumber,
+            isSampledIn: isSampledIn
+        ), completion: completion)
     }
     
     func transmitEventBatchAlternate(replayId: String, eventPayload: Data, eventCount: Int, completion: ((Bool) -> Void)? = nil) {
-        guard canUploadNow() else {
-            completion?(false)
-            return
-        }
-        
         batchSeqNumber += 1
         let seq = batchSeqNumber
         
-        let sampledIn = isSampledIn
-        workerQueue.addOperation { [weak self] in
-            self?.executeEventBatchUpload(sessionId: replayId, payload: eventPayload, batchNum: seq, eventCount: eventCount, isSampledIn: sampledIn, completion: completion)
+        submitUpload(PendingUpload(
+            sessionId: replayId,
+            contentType: "events",
+            payload: eventPayload,
+            rangeStart: 0,
+            rangeEnd: 0,
+            itemCount: eventCount,
+            spoolId: 0,
+            batchNumber: seq,
+            isSampledIn: isSampledIn
+        ), completion: completion)
+    }
+    
+    /// Sends a crash report persisted by StabilityMonitor. It goes through the
+    /// spool like any other upload, as the kind evicted last; the caller
+    /// hears true once it was delivered or spooled.
+    func transmitCrashReport(sessionId: String, payload: Data, completion: ((Bool) -> Void)? = nil) {
+        submitUpload(PendingUpload(
+            sessionId: sessionId,
+            contentType: "crash",
+            payload: payload,
+            rangeStart: 0,
+            rangeEnd: 0,
+            itemCount: 1,
+            spoolId: 0,
+            batchNumber: 0,
+            isSampledIn: isSampledIn
+        ), completion: completion)
+    }
+    
+    /// Uploads now, or spools while the circuit is open or the path defers
+    /// this kind of upload.
+    private func submitUpload(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
+        let deferred = spool != nil && !uploadPolicy.shouldSend(upload.spoolKind)
+        guard canUploadNow(), !deferred else {
+            spoolUpload(upload, completion: completion)
+            return
         }
+        scheduleUpload(upload, completion: completion)
     }
     
     func concludeReplay(
@@ -248,6 +377,13 @@ final class SegmentDispatcher {
         }.resume()
     }
     
+    /// Frame bundle uploads the pipeline may have in flight right now: the
+    /// frames lane limit, none while billing is blocked. While the circuit is
+    /// open bundles still go out, straight into the spool.
+    var frameUploadSlots: Int {
+        billingBlocked ? 0 : Int(uploadLanes.limit(for: .frames))
+    }
+
     private func canUploadNow() -> Bool {
         if billingBlocked { return false }
         if circuitOpen {
@@ -284,51 +420,87 @@ final class SegmentDispatcher {
         uploadSuccessCount += 1
         lastUploadTime = Self.nowMs()
         metricsLock.unlock()
+        // The network is back; let spooled uploads follow.
+        if let spool, spool.count > 0 {
+            laneQueue.async { self.drainSpool() }
+        }
     }
     
-    private func scheduleUpload(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
+    private func scheduleUpload(_ upload: PendingUpload, retry: Bool = false, completion: ((Bool) -> Void)?) {
         guard active else {
             completion?(false)
             return
         }
-        workerQueue.addOperation { [weak self] in
-            self?.executeSegmentUpload(upload, completion: completion)
+        enqueueUpload(in: upload.lane, retry: retry) { done in
+            let finish: (Bool) -> Void = { ok in
+                done()
+                completion?(ok)
+            }
+            if upload.contentType == "events" {
+                self.executeEventBatchUpload(upload, completion: finish)
+            } else if upload.contentType == "crash" {
+                self.executeCrashUpload(upload, completion: finish)
+            } else {
+                self.executeSegmentUpload(upload, completion: finish)
+            }
         }
     }
     
-    private func executeSegmentUpload(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
+    /// Queues `work` in `lane`. It runs once the lanes start its ticket and
+    /// must call `done` exactly once when its upload chain is over.
+    private func enqueueUpload(in lane: UploadLane, retry: Bool = false, _ work: @escaping (_ done: @escaping () -> Void) -> Void) {
         // Track this upload chain so waitForPendingUploads() can block until completion.
         _uploadGroup.enter()
-
+        laneLock.lock()
+        let ticket = uploadLanes.enqueue(in: lane, retry: retry)
+        laneWork[ticket] = work
+        laneLock.unlock()
+        startQueuedUploads()
+    }
+    
+    private func startQueuedUploads() {
+        while true {
+            laneLock.lock()
+            let ticket = uploadLanes.startNext()
+            let work = ticket == 0 ? nil : laneWork.removeValue(forKey: ticket)
+            laneLock.unlock()
+            guard let work else { return }
+            
+            laneQueue.async {
+                work {
+                    self.uploadLanes.finish(ticket)
+                    self._uploadGroup.leave()
+                    self.startQueuedUploads()
+                }
+            }
+        }
+    }
+    
+    private func executeSegmentUpload(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
         guard active else {
-            _uploadGroup.leave()
             completion?(false)
             return
         }
-        if isUploadForClosedSession(upload.sessionId) {
+        if upload.spoolId == 0 && isUploadForClosedSession(upload.sessionId) {
             DiagnosticLog.trace("[SegmentDispatcher] Dropping stale \(upload.contentType) upload for closed session \(upload.sessionId.prefix(20))")
-            _uploadGroup.leave()
             completion?(false)
             return
         }
 
-        requestPresignedUrl(upload: upload) { [weak self] presignResponse in
+        presignForUpload(upload) { [weak self] presignResponse in
             guard let self, self.active else {
-                self?._uploadGroup.leave()
                 completion?(false)
                 return
             }
 
             guard let presign = presignResponse else {
                 self.registerFailure()
-                self._uploadGroup.leave()
-                self.scheduleRetryIfNeeded(upload, completion: completion)
+                self.spoolUpload(upload, completion: completion)
                 return
             }
 
             if presign.skipUpload {
                 self.registerSuccess()
-                self._uploadGroup.leave()
                 completion?(true)
                 return
             }
@@ -336,17 +508,18 @@ final class SegmentDispatcher {
             self.uploadToS3(url: presign.presignedUrl, payload: upload.payload) { s3ok in
                 guard s3ok else {
                     self.registerFailure()
-                    self._uploadGroup.leave()
-                    self.scheduleRetryIfNeeded(upload, completion: completion)
+                    self.spoolUpload(upload, completion: completion)
                     return
                 }
 
-                self.confirmBatchComplete(batchId: presign.batchId, upload: upload) { confirmOk in
-                    if confirmOk {
-                        self.registerSuccess()
+                self.confirmSegment(segmentId: presign.batchId, upload: upload) { confirmOk in
+                    guard confirmOk else {
+                        self.registerFailure()
+                        self.spoolUpload(upload, completion: completion)
+                        return
                     }
-                    self._uploadGroup.leave()
-                    completion?(confirmOk)
+                    self.registerSuccess()
+                    completion?(true)
                 }
             }
         }
@@ -359,36 +532,68 @@ final class SegmentDispatcher {
         _ = _uploadGroup.wait(timeout: .now() + timeout)
     }
     
-    private func scheduleRetryIfNeeded(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
-        if isUploadForClosedSession(upload.sessionId) {
-            DiagnosticLog.trace("[SegmentDispatcher] Discarding retry for closed session \(upload.sessionId.prefix(20))")
+    /// Hands an upload that could not be delivered to the spool. The caller
+    /// hears true when the spool took it; an upload that was already spooled
+    /// has the failed attempt counted instead, and is dropped once it runs out.
+    private func spoolUpload(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
+        guard let spool, !billingBlocked else {
             completion?(false)
             return
         }
-        if upload.attempt < 3 {
-            var retry = upload
-            retry.attempt += 1
-            retryLock.lock()
-            if retryQueue.count >= maxRetryQueueSize {
-                retryQueue.removeFirst()
+        if upload.spoolId != 0 {
+            if !spool.fail(upload.spoolId) {
+                DiagnosticLog.trace("[SegmentDispatcher] Giving up on spooled \(upload.contentType) upload for session \(upload.sessionId.prefix(20))")
+            }
+            completion?(false)
+            return
+        }
+        guard spool.put(kind: upload.spoolKind, meta: upload.spoolMeta, payload: upload.payload) != 0 else {
+            completion?(false)
+            return
+        }
+        metricsLock.lock()
+        offlinePersistCount += 1
+        metricsLock.unlock()
+        completion?(true)
+    }
+    
+    /// Starts up to `spoolDrainBatch` spooled uploads, so only that many
+    /// payloads are read back into memory at a time. Kinds the current path
+    /// defers stay in the spool.
+    private func drainSpool() {
+        guard let spool, active, canUploadNow(),
+              let lowest = uploadPolicy.lowestSendableKind.flatMap({ SpoolKind(rawValue: $0.uintValue) }) else { return }
+        spoolLock.lock()
+        let room = Self.spoolDrainBatch - spoolInFlight.count
+        let entries = room > 0
+            ? spool.pending(limit: UInt(room), excluding: spoolInFlight.map { NSNumber(value: $0) }, from: lowest)
+            : []
+        entries.forEach { spoolInFlight.insert($0.entryId) }
+        spoolLock.unlock()
+        
+        for entry in entries {
+            let entryId = entry.entryId
+            guard let payload = spool.payload(for: entryId),
+                  let upload = PendingUpload(spooled: entry, payload: payload) else {
+                spool.complete(entryId)
+                releaseSpooled(entryId)
+                continue
             }
-            retryQueue.append(retry)
-            retryLock.unlock()
-            
             metricsLock.lock()
             retryAttemptCount += 1
             lastRetryTime = Self.nowMs()
             metricsLock.unlock()
+            scheduleUpload(upload, retry: true) { ok in
+                if ok { spool.complete(entryId) }
+                self.releaseSpooled(entryId)
+            }
         }
-        completion?(false)
     }
     
-    private func drainRetryQueue() {
-        retryLock.lock()
-        let items = retryQueue
-        retryQueue.removeAll()
-        retryLock.unlock()
-        items.forEach { executeSegmentUpload($0, completion: nil) }
+    private func releaseSpooled(_ entryId: UInt64) {
+        spoolLock.lock()
+        spoolInFlight.remove(entryId)
+        spoolLock.unlock()
     }
     
     private func requestPresignedUrl(upload: PendingUpload, completion: @escaping (PresignResponse?) -> Void) {
@@ -448,19 +653,185 @@ final class SegmentDispatcher {
                 return
             }
             
-            if json["skipUpload"] as? Bool == true {
-                completion(PresignResponse(presignedUrl: "", batchId: "", skipUpload: true))
+            completion(Self.presignResponse(from: json))
+        }.resume()
+    }
+
+    private static func presignResponse(from json: [String: Any]) -> PresignResponse? {
+        if json["skipUpload"] as? Bool == true {
+            return PresignResponse(presignedUrl: "", batchId: "", skipUpload: true)
+        }
+        guard let presignedUrl = json["presignedUrl"] as? String else {
+            return nil
+        }
+        let batchId = json["batchId"] as? String ?? json["segmentId"] as? String ?? ""
+        return PresignResponse(presignedUrl: presignedUrl, batchId: batchId, skipUpload: false)
+    }
+
+    /// Presigns a frame bundle that is still waiting for an upload slot, so
+    /// its PUT can start the moment one frees up. No-op if the bundle already
+    /// has a URL or enough are prefetched.
+    func prefetchFrameBundle(for sessionId: String, payload: Data, startMs: UInt64, endMs: UInt64, frameCount: Int) {
+        guard active, canUploadNow(), uploadPolicy.shouldSend(.frames), !isUploadForClosedSession(sessionId) else { return }
+        let upload = PendingUpload(
+            sessionId: sessionId,
+            contentType: "screenshots",
+            payload: payload,
+            rangeStart: startMs,
+            rangeEnd: endMs,
+            itemCount: frameCount,
+            spoolId: 0,
+            batchNumber: 0,
+            isSampledIn: isSampledIn
+        )
+        let key = upload.segmentKey
+        segmentBatchLock.lock()
+        let skip = segmentBatchUnsupported
+            || presignedSlots[key] != nil
+            || prefetchingSlots[key] != nil
+            || presignedSlots.count + prefetchingSlots.count >= maxPresignedSlots
+        if !skip {
+            prefetchingSlots[key] = []
+        }
+        segmentBatchLock.unlock()
+        guard !skip else { return }
+
+        presignSegment(upload) { [weak self] presign in
+            guard let self else { return }
+            self.segmentBatchLock.lock()
+            let waiting = self.prefetchingSlots.removeValue(forKey: key) ?? []
+            if waiting.isEmpty, let presign {
+                self.presignedSlots[key] = PresignedSlot(response: presign, fetchedAt: Date().timeIntervalSince1970)
+            }
+            self.segmentBatchLock.unlock()
+            waiting.forEach { $0(presign) }
+        }
+    }
+
+    /// A prefetched URL if the segment has a fresh one, the prefetch in
+    /// flight for it, or a seat in the next batch presign call.
+    private func presignForUpload(_ upload: PendingUpload, completion: @escaping (PresignResponse?) -> Void) {
+        let key = upload.segmentKey
+        segmentBatchLock.lock()
+        if let slot = presignedSlots.removeValue(forKey: key),
+           Date().timeIntervalSince1970 - slot.fetchedAt < presignedSlotLifetime {
+            segmentBatchLock.unlock()
+            completion(slot.response)
+            return
+        }
+        if prefetchingSlots[key] != nil {
+            prefetchingSlots[key]?.append(completion)
+            segmentBatchLock.unlock()
+            return
+        }
+        segmentBatchLock.unlock()
+        presignSegment(upload, completion: completion)
+    }
+
+    private func presignSegment(_ upload: PendingUpload, completion: @escaping (PresignResponse?) -> Void) {
+        segmentBatchLock.lock()
+        presignWaiters.append(PresignWaiter(upload: upload, completion: completion))
+        segmentBatchLock.unlock()
+        flushPresignBatch()
+    }
+
+    /// Sends waiting presigns of one session as a single call unless one is
+    /// already out; its completion sends the next.
+    private func flushPresignBatch() {
+        segmentBatchLock.lock()
+        if segmentBatchUnsupported {
+            let waiters = presignWaiters
+            presignWaiters.removeAll()
+            segmentBatchLock.unlock()
+            waiters.forEach { requestPresignedUrl(upload: $0.upload, completion: $0.completion) }
+            return
+        }
+        guard !presignInFlight, let sessionId = presignWaiters.first?.upload.sessionId else {
+            segmentBatchLock.unlock()
+            return
+        }
+        let batch = takeSegmentBatch(&presignWaiters) { $0.upload.sessionId == sessionId }
+        presignInFlight = true
+        segmentBatchLock.unlock()
+
+        requestPresignBatch(batch.map { $0.upload }) { [weak self] responses in
+            guard let self else { return }
+            self.segmentBatchLock.lock()
+            self.presignInFlight = false
+            if responses == nil {
+                self.segmentBatchUnsupported = true
+                self.presignWaiters.insert(contentsOf: batch, at: 0)
+            }
+            self.segmentBatchLock.unlock()
+            if let responses {
+                for (waiter, response) in zip(batch, responses) {
+                    waiter.completion(response)
+                }
+            }
+            self.flushPresignBatch()
+        }
+    }
+
+    /// One result per upload, in order; nil entries failed. Nil when the
+    /// backend has no batch endpoint.
+    private func requestPresignBatch(_ uploads: [PendingUpload], completion: @escaping ([PresignResponse?]?) -> Void) {
+        let failed = [PresignResponse?](repeating: nil, count: uploads.count)
+        guard let first = uploads.first,
+              let url = URL(string: "\(endpoint)/api/ingest/segment/presign/batch") else {
+            completion(failed)
+            return
+        }
+
+        var req = URLRequest(url: url)
+        req.httpMethod = "POST"
+        req.setValue("application/json", forHTTPHeaderField: "Content-Type")
+        applyAuthHeaders(&req, sessionId: first.sessionId)
+
+        let body: [String: Any] = [
+            "sessionId": first.sessionId,
+            "sdkVersion": RejourneyImpl.sdkVersion,
+            "isSampledIn": first.isSampledIn,
+            "segments": uploads.map { upload -> [String: Any] in
+                [
+                    "kind": upload.contentType,
+                    "startTime": upload.rangeStart,
+                    "endTime": upload.rangeEnd,
+                    "frameCount": upload.itemCount,
+                    "sizeBytes": upload.payload.count,
+                    "compression": "gzip"
+                ]
+            }
+        ]
+
+        do {
+            req.httpBody = try JSONSerialization.data(withJSONObject: body)
+        } catch {
+            completion(failed)
+            return
+        }
+
+        httpSession.dataTask(with: req) { [weak self] data, resp, _ in
+            guard let httpResp = resp as? HTTPURLResponse else {
+                completion(failed)
                 return
             }
-            
-            guard let presignedUrl = json["presignedUrl"] as? String else {
+            if httpResp.statusCode == 404 {
                 completion(nil)
                 return
             }
-            
-            let batchId = json["batchId"] as? String ?? json["segmentId"] as? String ?? ""
-            
-            completion(PresignResponse(presignedUrl: presignedUrl, batchId: batchId, skipUpload: false))
+            if httpResp.statusCode == 402 {
+                self?.billingBlocked = true
+                completion(failed)
+                return
+            }
+            guard httpResp.statusCode == 200,
+                  let data,
+                  let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any],
+                  let segments = json["segments"] as? [[String: Any]] else {
+                completion(failed)
+                return
+            }
+            completion(uploads.indices.map { $0 < segments.count ? Self.presignResponse(from: segments[$0]) : nil })
         }.resume()
     }
     
@@ -491,6 +862,10 @@ final class SegmentDispatcher {
                 self.totalBytesUploaded += Int64(payload.count)
             }
             self.metricsLock.unlock()
+            if succeeded {
+                self.uploadPolicy.noteUpload(bytes: UInt(payload.count), durationMs: durationMs)
+                VisualCapture.shared.noteUploadCompleted(bytes: payload.count, durationMs: durationMs)
+            }
             
             completion(succeeded)
         }.resume()
@@ -535,48 +910,186 @@ final class SegmentDispatcher {
         }.resume()
     }
     
-    private func executeEventBatchUpload(sessionId: String, payload: Data, batchNum: Int, eventCount: Int, isSampledIn: Bool, completion: ((Bool) -> Void)?) {
-        let upload = PendingUpload(
-            sessionId: sessionId,
-            contentType: "events",
-            payload: payload,
-            rangeStart: 0,
-            rangeEnd: 0,
-            itemCount: eventCount,
-            attempt: 0,
-            batchNumber: batchNum,
-            isSampledIn: isSampledIn
-        )
-        if isUploadForClosedSession(upload.sessionId) {
+    private func confirmSegment(segmentId: String, upload: PendingUpload, completion: @escaping (Bool) -> Void) {
+        segmentBatchLock.lock()
+        confirmWaiters.append(ConfirmWaiter(segmentId: segmentId, upload: upload, completion: completion))
+        segmentBatchLock.unlock()
+        flushConfirmBatch()
+    }
+
+    /// Confirms waiting segments of one session in a single call unless one
+    /// is already out; its completion sends the next.
+    private func flushConfirmBatch() {
+        segmentBatchLock.lock()
+        if segmentBatchUnsupported {
+            let waiters = confirmWaiters
+            confirmWaiters.removeAll()
+            segmentBatchLock.unlock()
+            waiters.forEach { confirmBatchComplete(batchId: $0.segmentId, upload: $0.upload, completion: $0.completion) }
+            return
+        }
+        guard !confirmInFlight, let sessionId = confirmWaiters.first?.upload.sessionId else {
+            segmentBatchLock.unlock()
+            return
+        }
+        let batch = takeSegmentBatch(&confirmWaiters) { $0.upload.sessionId == sessionId }
+        confirmInFlight = true
+        segmentBatchLock.unlock()
+
+        requestConfirmBatch(batch) { [weak self] results in
+            guard let self else { return }
+            self.segmentBatchLock.lock()
+            self.confirmInFlight = false
+            if results == nil {
+                self.segmentBatchUnsupported = true
+                self.confirmWaiters.insert(contentsOf: batch, at: 0)
+            }
+            self.segmentBatchLock.unlock()
+            if let results {
+                for (waiter, ok) in zip(batch, results) {
+                    waiter.completion(ok)
+                }
+            }
+            self.flushConfirmBatch()
+        }
+    }
+
+    /// One result per segment, in order. Nil when the backend has no batch
+    /// endpoint.
+    private func requestConfirmBatch(_ waiters: [ConfirmWaiter], completion: @escaping ([Bool]?) -> Void) {
+        let failed = [Bool](repeating: false, count: waiters.count)
+        guard let first = waiters.first,
+              let url = URL(string: "\(endpoint)/api/ingest/segment/complete/batch") else {
+            completion(failed)
+            return
+        }
+
+        var req = URLRequest(url: url)
+        req.httpMethod = "POST"
+        req.setValue("application/json", forHTTPHeaderField: "Content-Type")
+        applyAuthHeaders(&req, sessionId: first.upload.sessionId)
+
+        let body: [String: Any] = [
+            "timestamp": Date().timeIntervalSince1970 * 1000,
+            "sdkTelemetry": sdkTelemetrySnapshot(currentQueueDepth: 0),
+            "segments": waiters.map { waiter -> [String: Any] in
+                [
+                    "segmentId": waiter.segmentId,
+                    "actualSizeBytes": waiter.upload.payload.count,
+                    "frameCount": waiter.upload.itemCount
+                ]
+            }
+        ]
+
+        do {
+            req.httpBody = try JSONSerialization.data(withJSONObject: body)
+        } catch {
+            completion(failed)
+            return
+        }
+
+        httpSession.dataTask(with: req) { data, resp, _ in
+            let status = (resp as? HTTPURLResponse)?.statusCode ?? 0
+            if status == 404 {
+                completion(nil)
+                return
+            }
+            guard status == 200,
+                  let data,
+                  let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any],
+                  let segments = json["segments"] as? [[String: Any]] else {
+                completion(failed)
+                return
+            }
+            completion(waiters.indices.map { $0 < segments.count && segments[$0]["success"] as? Bool == true })
+        }.resume()
+    }
+
+    /// Removes and returns, in order, up to segmentBatchLimit waiters that
+    /// `belongs` accepts.
+    private func takeSegmentBatch<Waiter>(_ waiters: inout [Waiter], where belongs: (Waiter) -> Bool) -> [Waiter] {
+        var batch: [Waiter] = []
+        var rest: [Waiter] = []
+        for waiter in waiters {
+            if batch.count < segmentBatchLimit && belongs(waiter) {
+                batch.append(waiter)
+            } else {
+                rest.append(waiter)
+            }
+        }
+        waiters = rest
+        return batch
+    }
+    
+    private func executeEventBatchUpload(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
+        if upload.spoolId == 0 && isUploadForClosedSession(upload.sessionId) {
             DiagnosticLog.trace("[SegmentDispatcher] Dropping stale events upload for closed session \(upload.sessionId.prefix(20))")
             completion?(false)
             return
         }
         
         requestPresignedUrl(upload: upload) { [weak self] presignResponse in
-            guard let self, let presign = presignResponse else {
-                self?.registerFailure()
+            guard let self else {
                 completion?(false)
                 return
             }
+            guard let presign = presignResponse else {
+                self.registerFailure()
+                self.spoolUpload(upload, completion: completion)
+                return
+            }
             
-            self.uploadToS3(url: presign.presignedUrl, payload: payload) { s3ok in
+            self.uploadToS3(url: presign.presignedUrl, payload: upload.payload) { s3ok in
                 guard s3ok else {
                     self.registerFailure()
-                    completion?(false)
+                    self.spoolUpload(upload, completion: completion)
                     return
                 }
                 
                 self.confirmBatchComplete(batchId: presign.batchId, upload: upload) { confirmOk in
-                    if confirmOk {
-                        self.registerSuccess()
+                    guard confirmOk else {
+                        self.registerFailure()
+                        self.spoolUpload(upload, completion: completion)
+                        return
                     }
-                    completion?(confirmOk)
+                    self.registerSuccess()
+                    completion?(true)
                 }
             }
         }
     }
     
+    /// Crash reports are posted whole to the fault endpoint. They belong to
+    /// an earlier session by nature, so they are never dropped as stale.
+    private func executeCrashUpload(_ upload: PendingUpload, completion: ((Bool) -> Void)?) {
+        guard let url = URL(string: "\(endpoint)/api/ingest/fault") else {
+            completion?(false)
+            return
+        }
+        var req = URLRequest(url: url)
+        req.httpMethod = "POST"
+        req.setValue("application/json", forHTTPHeaderField: "Content-Type")
+        if let key = apiToken {
+            req.setValue(key, forHTTPHeaderField: "x-rejourney-key")
+        }
+        req.httpBody = upload.payload
+        
+        URLSession.shared.dataTask(with: req) { [weak self] _, resp, _ in
+            guard let self else {
+                completion?(false)
+                return
+            }
+            let code = (resp as? HTTPURLResponse)?.statusCode ?? 0
+            guard code >= 200 && code < 300 else {
+                self.registerFailure()
+                self.spoolUpload(upload, completion: completion)
+                return
+            }
+            self.registerSuccess()
+            completion?(true)
+        }.resume()
+    }
+    
     private func applyAuthHeaders(_ req: inout URLRequest, sessionId: String? = nil) {
         if let t = apiToken {
             req.setValue(t, forHTTPHeaderField: "x-rejourney-key")
@@ -610,9 +1123,7 @@ final class SegmentDispatcher {
     }
     
     func sdkTelemetrySnapshot(currentQueueDepth: Int = 0) -> [String: Any] {
-        retryLock.lock()
-        let retryDepth = retryQueue.count
-        retryLock.unlock()
+        let retryDepth = Int(spool?.count ?? 0)
         
         metricsLock.lock()
         let successCount = uploadSuccessCount
@@ -646,7 +1157,7 @@ final class SegmentDispatcher {
             "crashCount": crashes,
             "uploadSuccessRate": successRate,
             "avgUploadDurationMs": avgUploadDurationMs,
-            "currentQueueDepth": currentQueueDepth + retryDepth,
+            "currentQueueDepth": currentQueueDepth + retryDepth + Int(uploadLanes.queued),
             "lastUploadTime": uploadTs.map { NSNumber(value: $0) } ?? NSNull(),
             "lastRetryTime": retryTs.map { NSNumber(value: $0) } ?? NSNull(),
             "totalBytesUploaded": uploadedBytes,
@@ -685,13 +1196,87 @@ private struct PendingUpload {
     let rangeStart: UInt64
     let rangeEnd: UInt64
     let itemCount: Int
-    var attempt: Int
+    /// Spool entry this upload was read back from, or 0 for a fresh upload.
+    let spoolId: UInt64
     let batchNumber: Int
     let isSampledIn: Bool
 }
 
+private extension PendingUpload {
+    /// Identifies the segment the way the backend derives its segment id.
+    var segmentKey: String {
+        "\(sessionId)|\(contentType)|\(rangeStart)|\(rangeEnd)|\(itemCount)|\(payload.count)"
+    }
+
+    var lane: UploadLane {
+        switch contentType {
+        case "events", "crash": return .events
+        case "hierarchy": return .hierarchy
+        default: return .frames
+        }
+    }
+
+    var spoolKind: SpoolKind {
+        switch contentType {
+        case "crash": return .crash
+        case "events": return .events
+        case "hierarchy": return .hierarchy
+        default: return .frames
+        }
+    }
+
+    /// Everything but the payload, as stored alongside it in the spool.
+    var spoolMeta: Data {
+        let meta: [String: Any] = [
+            "sessionId": sessionId,
+            "contentType": contentType,
+            "rangeStart": rangeStart,
+            "rangeEnd": rangeEnd,
+            "itemCount": itemCount,
+            "batchNumber": batchNumber,
+            "isSampledIn": isSampledIn
+        ]
+        return (try? JSONSerialization.data(withJSONObject: meta)) ?? Data()
+    }
+
+    init?(spooled entry: RJSpoolEntry, payload: Data) {
+        guard let meta = try? JSONSerialization.jsonObject(with: entry.meta) as? [String: Any],
+              let sessionId = meta["sessionId"] as? String,
+              let contentType = meta["contentType"] as? String else {
+            return nil
+        }
+        self.init(
+            sessionId: sessionId,
+            contentType: contentType,
+            payload: payload,
+            rangeStart: (meta["rangeStart"] as? NSNumber)?.uint64Value ?? 0,
+            rangeEnd: (meta["rangeEnd"] as? NSNumber)?.uint64Value ?? 0,
+            itemCount: meta["itemCount"] as? Int ?? 0,
+            spoolId: entry.entryId,
+            batchNumber: meta["batchNumber"] as? Int ?? 0,
+            isSampledIn: meta["isSampledIn"] as? Bool ?? true
+        )
+    }
+}
+
 private struct PresignResponse {
     let presignedUrl: String
     let batchId: String
     let skipUpload: Bool
 }
+
+private struct PresignWaiter {
+    let upload: PendingUpload
+    let completion: (PresignResponse?) -> Void
+}
+
+private struct ConfirmWaiter {
+    let segmentId: String
+    let upload: PendingUpload
+    let completion: (Bool) -> Void
+}
+
+private struct PresignedSlot {
+    let response: PresignResponse
+    let fetchedAt: TimeInterval
+}
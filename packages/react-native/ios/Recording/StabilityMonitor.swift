@@ -56,8 +56,9 @@ private func _rjSignalHandler(_ signum: Int32) {
     ReplayOrchestrator.shared.incrementFaultTally()
     StabilityMonitor.shared.persistIncidentSync(incident)
 
-    // Flush visual frames to disk for crash safety
+    // Flush visual frames and staged events to disk for crash safety
     VisualCapture.shared.flushToDisk()
+    EventBuffer.shared.flushForCrash()
 
     signal(signum, SIG_DFL)
     raise(signum)
@@ -139,8 +140,9 @@ public final class StabilityMonitor: NSObject {
         ReplayOrchestrator.shared.incrementFaultTally()
         _persistIncident(incident)
 
-        // Flush visual frames to disk for crash safety
+        // Flush visual frames and staged events to disk for crash safety
         VisualCapture.shared.flushToDisk()
+        EventBuffer.shared.flushForCrash()
 
         Thread.sleep(forTimeInterval: 0.15)
     }
@@ -175,44 +177,19 @@ public final class StabilityMonitor: NSObject {
         }
     }
 
+    /// Hands the stored report to SegmentDispatcher, which retries it from
+    /// its spool; the local copy goes once it was delivered or spooled.
     private func _uploadStoredIncidents() {
         guard FileManager.default.fileExists(atPath: _incidentStore.path),
               let data = try? Data(contentsOf: _incidentStore),
-              let incident = try? JSONDecoder().decode(IncidentRecord.self, from: data) else { return }
+              let incident = try? JSONDecoder().decode(IncidentRecord.self, from: data),
+              let payload = try? JSONEncoder().encode(incident) else { return }
 
-        _transmitIncident(incident) { [weak self] ok in
+        SegmentDispatcher.shared.transmitCrashReport(sessionId: incident.sessionId, payload: payload) { [weak self] ok in
             guard ok, let self else { return }
             try? FileManager.default.removeItem(at: self._incidentStore)
         }
     }
-
-    private func _transmitIncident(_ incident: IncidentRecord, completion: @escaping (Bool) -> Void) {
-        let base = SegmentDispatcher.shared.endpoint
-        guard let url = URL(string: "\(base)/api/ingest/fault") else {
-            completion(false)
-            return
-        }
-
-        var req = URLRequest(url: url)
-        req.httpMethod = "POST"
-        req.setValue("application/json", forHTTPHeaderField: "Content-Type")
-
-        if let key = SegmentDispatcher.shared.apiToken {
-            req.setValue(key, forHTTPHeaderField: "x-rejourney-key")
-        }
-
-        do {
-            req.httpBody = try JSONEncoder().encode(incident)
-        } catch {
-            completion(false)
-            return
-        }
-
-        URLSession.shared.dataTask(with: req) { _, resp, _ in
-            let code = (resp as? HTTPURLResponse)?.statusCode ?? 0
-            completion(code >= 200 && code < 300)
-        }.resume()
-    }
 }
 
 @objc(FaultTracker)
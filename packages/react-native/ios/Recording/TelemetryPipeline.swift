@@ -49,9 +49,32 @@ public final class TelemetryPipeline: NSObject {
         didSet { SegmentDispatcher.shared.isSampledIn = isSampledIn }
     }
     
-    private let _eventRing = EventRingBuffer(capacity: 5000)
-    private let _frameQueue = FrameBundleQueue(maxPending: 200)
+    private let _eventRing = RJEventRing(capacity: 5000)
+    private let _eventEncoder = RJEventEncoder(baseTimestampMs: Int64(Date().timeIntervalSince1970 * 1000))
+    private let _frameQueue = FrameBundleQueue()
+    /// Upload slots from SegmentDispatcher plus room for this many queued
+    /// bundles, handed to VisualCapture as per-frame credits.
+    private let _frameCredits = RJFrameCredits(queueSlots: 32, framesPerBundle: 3)
+    /// Queued bundles presigned ahead of their upload slot.
+    private let _framePrefetchDepth = 4
     private var _batchSeq = 0
+    /// Orders ring pushes and event log appends the same way, so delivered
+    /// batches map to a prefix of the log.
+    private let _ingestLock = NSLock()
+    /// Events that reached the ring but not the log. Guarded by `_ingestLock`.
+    private var _walAppendFailures: UInt64 = 0
+    /// Session whose EventBuffer log the ring's events are also written to.
+    /// The `_wal*` state below is only touched on `_serialWorker`.
+    private var _walSessionId: String?
+    /// Live batches not yet answered, oldest first. Delivery is recorded for
+    /// answered batches at the head only.
+    private var _walBatches: [(seq: Int, count: Int, acked: Bool)] = []
+    /// Set once delivered events stop being a prefix of the log: a batch
+    /// went back to the ring, or the ring evicted events. Recovery then
+    /// resends from the last recorded point rather than skip undelivered events.
+    private var _walPrefixBroken = false
+    private var _walEvictedBase: UInt64 = 0
+    private var _walAppendFailureBase: UInt64 = 0
     private var _draining = false
     private let _drainStateLock = NSLock()
     private var _shutdownCompletions: [() -> Void] = []
@@ -198,14 +221,55 @@ public final class TelemetryPipeline: NSObject {
         _serialWorker.async {
             let bundle = PendingFrameBundle(tag: filename, payload: payload, rangeStart: startMs, rangeEnd: endMs, count: frameCount, sessionId: capturedSessionId)
             self._frameQueue.enqueue(bundle)
+            self._frameCredits.bundleQueued(frames: UInt(max(0, frameCount)))
             self._shipPendingFrames()
         }
     }
 
+    /// Frames per bundle VisualCapture batches; sets what a free slot is
+    /// worth in frame credits.
+    @objc public func configureFrameCredits(framesPerBundle: Int) {
+        _frameCredits.framesPerBundle = UInt(max(1, framesPerBundle))
+    }
+
+    /// Takes a credit for one frame before it is rendered. False while the
+    /// upload queue is full, so the frame is skipped instead of encoded and
+    /// thrown away later.
+    @objc public func acquireFrameCredit() -> Bool {
+        _frameCredits.acquireFrame()
+    }
+
+    /// Gives back credits of frames that will not reach a bundle.
+    @objc public func releaseFrameCredits(_ frames: Int) {
+        _frameCredits.releaseFrames(UInt(max(0, frames)))
+    }
+
+    /// Drops credits held by frames of the previous session.
+    @objc public func resetFrameCredits() {
+        _frameCredits.resetFrames()
+    }
+
+    @objc public var deniedFrameCount: UInt64 {
+        _frameCredits.deniedFrames
+    }
+
     @objc public func prepareForNewSession(_ replayId: String) {
         _batchSeq = 0
+        _ingestLock.lock()
         let droppedEvents = _eventRing.clear()
+        EventBuffer.shared.configure(sessionId: replayId)
+        let appendFailures = _walAppendFailures
+        _ingestLock.unlock()
+        let evicted = _eventRing.evictedCount
+        _serialWorker.async {
+            self._walSessionId = replayId
+            self._walBatches.removeAll()
+            self._walPrefixBroken = false
+            self._walEvictedBase = evicted
+            self._walAppendFailureBase = appendFailures
+        }
         let droppedFrames = _frameQueue.clear()
+        _frameCredits.clearBundles()
         if droppedEvents > 0 || droppedFrames > 0 {
             DiagnosticLog.trace("[TelemetryPipeline] Dropped stale pending telemetry for new session \(replayId.prefix(20)) (events=\(droppedEvents), frames=\(droppedFrames))")
         }
@@ -255,6 +319,9 @@ public final class TelemetryPipeline: NSObject {
                 // Step C: wait for all in-flight uploads before ending the background task.
                 // Timeout is 25s — well within iOS's ~30s background budget.
                 SegmentDispatcher.shared.waitForPendingUploads(timeout: 25.0)
+                // The session is over; events recorded before the next one
+                // starts are not logged against it.
+                EventBuffer.shared.shutdown()
                 self?._finishDrainIfNeeded()
             }
         }
@@ -268,8 +335,9 @@ public final class TelemetryPipeline: NSObject {
             self?._finishDrainIfNeeded()
         }
 
-        // Flush visual frames to disk for crash safety
+        // Flush visual frames and staged events to disk for crash safety
         VisualCapture.shared.flushToDisk()
+        _ = EventBuffer.shared.flush()
         // Submit any buffered frames to the upload pipeline (even if below batch threshold)
         VisualCapture.shared.flushBufferToNetwork()
 
@@ -403,13 +471,58 @@ public final class TelemetryPipeline: NSObject {
     }
     
     private func _uploadPendingSessions() {
-        // Intentionally deferred: crash/interruption recovery currently restores
-        // pending visual frames via ReplayOrchestrator + VisualCapture only.
-        // Telemetry events remain best-effort and are not replayed from EventBuffer yet.
+        // Uploads a previous launch could not deliver wait in the dispatcher's
+        // disk spool; start them now that credentials are in place.
+        // Interrupted sessions' visual frames are still restored through
+        // ReplayOrchestrator + VisualCapture.
+        SegmentDispatcher.shared.startSpoolDrain()
+        
+        // Events other sessions persisted through EventBuffer are streamed
+        // from disk, one session after another.
+        let excluded = Set([currentReplayId, EventBuffer.shared.activeSessionId].compactMap { $0 })
+        let sessions = EventBuffer.shared.getPendingSessions().filter { !excluded.contains($0) }
+        guard !sessions.isEmpty else { return }
+        _serialWorker.async { [weak self] in
+            self?._uploadNextPendingSession(sessions[...])
+        }
+    }
+    
+    /// Stops at the first failure: the network is likely down, and the
+    /// sessions left over are tried again on the next launch.
+    private func _uploadNextPendingSession(_ sessions: ArraySlice<String>) {
+        guard let sessionId = sessions.first else { return }
+        _uploadSessionEvents(sessionId: sessionId) { [weak self] ok in
+            guard ok, let self else { return }
+            EventBuffer.shared.clearSession(sessionId)
+            self._serialWorker.async {
+                self._uploadNextPendingSession(sessions.dropFirst())
+            }
+        }
+    }
+    
+    /// Streams a persisted session's events to the backend one batch at a
+    /// time. Events are sliced straight from disk without being parsed, and
+    /// the next batch is read only after the previous upload finished. Each
+    /// acknowledged batch is recorded, so a retry resumes after it.
+    private func _uploadSessionEvents(sessionId: String, completion: @escaping (Bool) -> Void) {
+        let reader = EventBuffer.shared.pendingEventReader(
+            sessionId: sessionId,
+            maxBatchBytes: _batchSizeLimit,
+            deviceInfoJSON: _pendingSessionDeviceInfoJSON()
+        )
+        guard let reader else {
+            completion(true)
+            return
+        }
+        _uploadNextSessionBatch(reader, sessionId: sessionId, completion: completion)
     }
     
-    private func _uploadSessionEvents(sessionId: String, events: [[String: Any]], completion: @escaping (Bool) -> Void) {
-        let payload = _serializeBatchFromEvents(events: events)
+    private func _uploadNextSessionBatch(_ reader: RJPendingEventReader, sessionId: String, completion: @escaping (Bool) -> Void) {
+        var eventCount: UInt = 0
+        guard let payload = reader.nextBatch(eventCount: &eventCount) else {
+            completion(true)
+            return
+        }
         guard let compressed = payload.gzipCompress() else {
             completion(false)
             return
@@ -418,12 +531,20 @@ public final class TelemetryPipeline: NSObject {
         SegmentDispatcher.shared.transmitEventBatchAlternate(
             replayId: sessionId,
             eventPayload: compressed,
-            eventCount: events.count,
-            completion: completion
-        )
+            eventCount: Int(eventCount)
+        ) { [weak self] ok in
+            guard ok, let self else {
+                completion(false)
+                return
+            }
+            EventBuffer.shared.markEventsUploaded(Int(eventCount), sessionId: sessionId)
+            self._serialWorker.async {
+                self._uploadNextSessionBatch(reader, sessionId: sessionId, completion: completion)
+            }
+        }
     }
     
-    private func _serializeBatchFromEvents(events: [[String: Any]]) -> Data {
+    private func _pendingSessionDeviceInfoJSON() -> Data {
         let device = UIDevice.current
         
         let networkType = ReplayOrchestrator.shared.currentNetworkType
@@ -445,26 +566,54 @@ public final class TelemetryPipeline: NSObject {
             "isExpensive": isExpensive
         ]
         
-        let wrapper: [String: Any] = ["events": events, "deviceInfo": meta]
-        return (try? JSONSerialization.data(withJSONObject: wrapper)) ?? Data()
+        return (try? JSONSerialization.data(withJSONObject: meta)) ?? Data("{}".utf8)
     }
     
+    /// Starts uploads while SegmentDispatcher grants slots. Each finished
+    /// upload frees a slot, which is worth more frame credits to capture.
     private func _shipPendingFrames() {
-        guard let next = _frameQueue.dequeue() else { return }
+        _frameCredits.uploadSlots = UInt(SegmentDispatcher.shared.frameUploadSlots)
+        while _frameCredits.startUpload() {
+            guard let next = _frameQueue.dequeue() else {
+                _frameCredits.uploadFinished(requeued: false)
+                return
+            }
+            // A bundle that went straight back to the queue would be
+            // dequeued again at once; it waits for the next heartbeat.
+            guard _shipFrameBundle(next) else { break }
+        }
+        // The bundles next in line get their upload URLs now, so each PUT
+        // starts the moment a slot frees up.
+        for bundle in _frameQueue.peek(_framePrefetchDepth) {
+            guard let sessionId = bundle.sessionId ?? currentReplayId else { continue }
+            SegmentDispatcher.shared.prefetchFrameBundle(
+                for: sessionId,
+                payload: bundle.payload,
+                startMs: bundle.rangeStart,
+                endMs: bundle.rangeEnd,
+                frameCount: bundle.count
+            )
+        }
+    }
 
+    /// Runs on _serialWorker with an upload slot already taken for `next`.
+    /// False when `next` was put back at the front of the queue: with no
+    /// session to attribute it to yet, it stays there until one starts.
+    private func _shipFrameBundle(_ next: PendingFrameBundle) -> Bool {
         let activeSession = currentReplayId
         if let bundleSession = next.sessionId,
            let activeSession,
            bundleSession != activeSession {
             DiagnosticLog.trace("[TelemetryPipeline] Dropping stale frame bundle for closed session \(bundleSession.prefix(20)) (current=\(activeSession.prefix(20)))")
-            _serialWorker.async { [weak self] in self?._shipPendingFrames() }
-            return
+            _frameCredits.uploadFinished(requeued: false)
+            return true
         }
 
         let targetSession = next.sessionId ?? activeSession
         guard let targetSession else {
             _frameQueue.requeue(next)
-            return
+            _frameCredits.uploadFinished(requeued: true)
+            return false
         }
 
         if let bundleSession = next.sessionId, bundleSession != currentReplayId {
@@ -478,48 +627,84 @@ public final class TelemetryPipeline: NSObject {
             endMs: next.rangeEnd,
             frameCount: next.count
         ) { [weak self] ok in
-            if !ok {
-                if let bundleSession = next.sessionId,
-                   let latestSession = self?.currentReplayId,
-                   bundleSession != latestSession {
-                    DiagnosticLog.trace("[TelemetryPipeline] Discarding failed stale frame bundle for closed session \(bundleSession.prefix(20)) (current=\(latestSession.prefix(20)))")
-                    self?._serialWorker.async { self?._shipPendingFrames() }
+            guard let self else { return }
+            self._serialWorker.async {
+                if !ok {
+                    if let bundleSession = next.sessionId,
+                       let latestSession = self.currentReplayId,
+                       bundleSession != latestSession {
+                        DiagnosticLog.trace("[TelemetryPipeline] Discarding failed stale frame bundle for closed session \(bundleSession.prefix(20)) (current=\(latestSession.prefix(20)))")
+                        self._frameCredits.uploadFinished(requeued: false)
+                    } else {
+                        // Back to the front of the queue, still holding its
+                        // queue slot; the heartbeat retries it.
+                        self._frameQueue.requeue(next)
+                        self._frameCredits.uploadFinished(requeued: true)
+                        return
+                    }
                 } else {
-                    self?._frameQueue.requeue(next)
+                    self._frameCredits.uploadFinished(requeued: false)
                 }
-            } else {
-                self?._serialWorker.async { self?._shipPendingFrames() }
+                self._shipPendingFrames()
             }
         }
+        return true
     }
     
     private func _shipPendingEvents() {
         let batch = _eventRing.drain(maxBytes: _batchSizeLimit)
         guard !batch.isEmpty else { return }
         
+        _ingestLock.lock()
+        let appendFailures = _walAppendFailures
+        _ingestLock.unlock()
+        if _eventRing.evictedCount != _walEvictedBase || appendFailures != _walAppendFailureBase {
+            _walPrefixBroken = true
+        }
+        
         let payload = _serializeBatch(events: batch)
         guard let compressed = payload.gzipCompress() else {
             batch.forEach { _eventRing.push($0) }
+            _walPrefixBroken = true
             return
         }
         
         let seq = _batchSeq
         _batchSeq += 1
+        let walSessionId = _walSessionId
+        _walBatches.append((seq: seq, count: batch.count, acked: false))
         
         SegmentDispatcher.shared.transmitEventBatch(payload: compressed, batchNumber: seq, eventCount: batch.count) { [weak self] ok in
             if !ok { batch.forEach { self?._eventRing.push($0) } }
-            else if self?._draining == true { }
+            self?._serialWorker.async {
+                self?._noteEventBatch(seq: seq, sessionId: walSessionId, ok: ok)
+            }
         }
     }
     
-    private func _serializeBatch(events: [EventEntry]) -> Data {
-        var jsonEvents: [[String: Any]] = []
-        for e in events {
-            var clean = e.data
-            if clean.last == 0x0A { clean = clean.dropLast() }
-            if let obj = try? JSONSerialization.jsonObject(with: clean) as? [String: Any] { jsonEvents.append(obj) }
+    /// Records how many of the session's logged events were delivered (sent
+    /// or taken by the dispatcher's spool), so recovery after a crash skips
+    /// them. Runs on `_serialWorker`.
+    private func _noteEventBatch(seq: Int, sessionId: String?, ok: Bool) {
+        guard let sessionId, sessionId == _walSessionId,
+              let index = _walBatches.firstIndex(where: { $0.seq == seq }) else { return }
+        guard ok else {
+            _walPrefixBroken = true
+            _walBatches.removeAll()
+            return
         }
-        
+        _walBatches[index].acked = true
+        var delivered = 0
+        while let head = _walBatches.first, head.acked {
+            delivered += head.count
+            _walBatches.removeFirst()
+        }
+        if delivered > 0, !_walPrefixBroken {
+            EventBuffer.shared.markEventsUploaded(delivered, sessionId: sessionId)
+        }
+    }
+    
+    private func _serializeBatch(events: [Data]) -> Data {
         let device = UIDevice.current
         let screen = UIScreen.main
         let bounds = screen.bounds
@@ -560,8 +745,10 @@ public final class TelemetryPipeline: NSObject {
             "name": device.name
         ]
         
-        let wrapper: [String: Any] = ["events": jsonEvents, "deviceInfo": meta]
-        return (try? JSONSerialization.data(withJSONObject: wrapper)) ?? Data()
+        // Records are already binary-encoded; only the small device header goes
+        // through JSONSerialization.
+        let metaJSON = (try? JSONSerialization.data(withJSONObject: meta)) ?? Data("{}".utf8)
+        return _eventEncoder.batch(records: events, deviceInfoJSON: metaJSON)
     }
     
     @objc public func recordAttribute(key: String, value: String) {
@@ -766,68 +953,20 @@ public final class TelemetryPipeline: NSObject {
     }
     
     private func _enqueue(_ dict: [String: Any]) {
-        // Keep in memory ring for immediate upload
-        guard let data = try? JSONSerialization.data(withJSONObject: dict) else { return }
-        var d = data
-        d.append(0x0A)
-        _eventRing.push(EventEntry(data: d, size: d.count))
+        let record = _eventEncoder.encode(dict)
+        // Keep in memory ring for immediate upload, and in the session's
+        // event log (group-committed) so a crash does not lose it.
+        _ingestLock.lock()
+        _eventRing.push(record)
+        if !EventBuffer.shared.appendEvent(dict) {
+            _walAppendFailures += 1
+        }
+        _ingestLock.unlock()
     }
     
     private func _ts() -> Int64 { Int64(Date().timeIntervalSince1970 * 1000) }
 }
 
-private struct EventEntry {
-    let data: Data
-    let size: Int
-}
-
-private final class EventRingBuffer {
-    private var _storage: ContiguousArray<EventEntry> = []
-    private let _capacity: Int
-    private let _lock = NSLock()
-    
-    init(capacity: Int) {
-        _capacity = capacity
-        _storage.reserveCapacity(capacity)
-    }
-    
-    var count: Int {
-        _lock.lock()
-        defer { _lock.unlock() }
-        return _storage.count
-    }
-    
-    func push(_ entry: EventEntry) {
-        _lock.lock()
-        defer { _lock.unlock() }
-        if _storage.count >= _capacity { _storage.removeFirst() }
-        _storage.append(entry)
-    }
-    
-    func drain(maxBytes: Int) -> [EventEntry] {
-        _lock.lock()
-        defer { _lock.unlock() }
-        var result: [EventEntry] = []
-        var total = 0
-        while !_storage.isEmpty {
-            let next = _storage.first!
-            if total + next.size > maxBytes { break }
-            result.append(next)
-            total += next.size
-            _storage.removeFirst()
-        }
-        return result
-    }
-
-    func clear() -> Int {
-        _lock.lock()
-        defer { _lock.unlock() }
-        let cleared = _storage.count
-        _storage.removeAll()
-        return cleared
-    }
-}
-
 private struct PendingFrameBundle {
     let tag: String
     let payload: Data
@@ -837,15 +976,13 @@ private struct PendingFrameBundle {
     let sessionId: String?
 }
 
+/// Bundles waiting for an upload slot. Unbounded on purpose: frame credits
+/// stop capture before the queue grows, and a bundle that made it this far
+/// is never evicted.
 private final class FrameBundleQueue {
     private var _queue: [PendingFrameBundle] = []
-    private let _maxPending: Int
     private let _lock = NSLock()
     
-    init(maxPending: Int) {
-        _maxPending = maxPending
-    }
-    
     var count: Int {
         _lock.lock()
         defer { _lock.unlock() }
@@ -855,10 +992,15 @@ private final class FrameBundleQueue {
     func enqueue(_ bundle: PendingFrameBundle) {
         _lock.lock()
         defer { _lock.unlock() }
-        if _queue.count >= _maxPending { _queue.removeFirst() }
         _queue.append(bundle)
     }
     
+    func peek(_ limit: Int) -> [PendingFrameBundle] {
+        _lock.lock()
+        defer { _lock.unlock() }
+        return Array(_queue.prefix(limit))
+    }
+    
     func dequeue() -> PendingFrameBundle? {
         _lock.lock()
         defer { _lock.unlock() }
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2026 Rejourney
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import UIKit
+
+// MARK: - ViewClassifier
+/// Class-level facts about views, computed once per concrete class.
+///
+/// Masking, hierarchy scanning and tap attribution all ask the same questions
+/// of every view they visit ("is this a keyboard window?", "is this an RN text
+/// input?"), and answering them from `String(describing: type(of:))` plus
+/// lowercased substring checks dominated the main-thread cost of deep React
+/// Native trees. Answers depend only on the class, so they are cached by class
+/// pointer; anything that depends on the instance (secure entry, layers,
+/// accessibility, bounds) is still checked by the caller.
+final class ViewClassifier {
+
+    static let shared = ViewClassifier()
+
+    struct Traits: OptionSet {
+        let rawValue: UInt16
+
+        /// Keyboard and text-effects windows; never scanned or recorded.
+        static let keyboardChrome = Traits(rawValue: 1 << 0)
+        /// Camera classes that are always masked.
+        static let alwaysSensitive = Traits(rawValue: 1 << 1)
+        /// React Native / Expo text input containers.
+        static let textInputClass = Traits(rawValue: 1 << 2)
+        /// Name says camera or preview and video or capture.
+        static let cameraName = Traits(rawValue: 1 << 3)
+        /// Name says camera or preview only; the layer decides.
+        static let cameraOrPreviewName = Traits(rawValue: 1 << 4)
+        static let imageName = Traits(rawValue: 1 << 5)
+        static let videoName = Traits(rawValue: 1 << 6)
+        static let textField = Traits(rawValue: 1 << 7)
+        static let textView = Traits(rawValue: 1 << 8)
+        static let imageView = Traits(rawValue: 1 << 9)
+        /// UIControl, UITextField or UITextView.
+        static let interactiveClass = Traits(rawValue: 1 << 10)
+    }
+
+    struct Entry {
+        let name: String
+        let traits: Traits
+    }
+
+    private static let _alwaysSensitiveClassNames: Set<String> = [
+        // Camera views
+        "AVCaptureVideoPreviewLayer",
+        "CameraView",
+        "RCTCameraView",
+        "ExpoCamera",
+        "EXCameraView",
+    ]
+
+    private static let _textInputClassNames: Set<String> = [
+        // React Native text inputs (internal class names)
+        "RCTSinglelineTextInputView",
+        "RCTMultilineTextInputView",
+        "RCTTextInput",
+        "RCTBaseTextInputView",
+        "RCTTextInputComponentView",
+        "RCTUITextField",
+        // Expo text inputs
+        "EXTextInput",
+    ]
+
+    /// Classes are finite, but runtime-generated subclasses (KVO) are not
+    /// bounded in principle; start over rather than grow without limit.
+    private let _maxEntries = 4096
+
+    private let _lock = NSLock()
+    private var _entries: [ObjectIdentifier: Entry] = [:]
+    private var _hits: Int = 0
+    private var _misses: Int = 0
+
+    private init() {}
+
+    func classify(_ view: UIView) -> Entry {
+        let cls: AnyClass = type(of: view)
+        let key = ObjectIdentifier(cls)
+        _lock.lock()
+        if let entry = _entries[key] {
+            _hits += 1
+            _lock.unlock()
+            return entry
+        }
+        _misses += 1
+        _lock.unlock()
+
+        let entry = _classify(view, name: String(describing: cls))
+
+        _lock.lock()
+        if _entries.count >= _maxEntries { _entries.removeAll(keepingCapacity: true) }
+        _entries[key] = entry
+        _lock.unlock()
+        return entry
+    }
+
+    /// Lookup counters for `getSDKMetrics`.
+    func metrics() -> [String: Any] {
+        _lock.lock()
+        defer { _lock.unlock() }
+        return [
+            "classificationCacheHits": _hits,
+            "classificationCacheMisses": _misses,
+        ]
+    }
+
+    private func _classify(_ view: UIView, name: String) -> Entry {
+        var traits: Traits = []
+        if name.contains("UIRemoteKeyboardWindow") ||
+           name.contains("UITextEffectsWindow") ||
+           name.contains("UIInputSetHostView") ||
+           name.contains("UIKeyboard") {
+            traits.insert(.keyboardChrome)
+        }
+        if ViewClassifier._alwaysSensitiveClassNames.contains(name) { traits.insert(.alwaysSensitive) }
+        if ViewClassifier._textInputClassNames.contains(name) { traits.insert(.textInputClass) }
+
+        let lower = name.lowercased()
+        if lower.contains("camera") || lower.contains("preview") {
+            // Only a camera preview if the name also says video or capture,
+            // or (per instance) its layer is a capture preview layer.
+            if lower.contains("video") || lower.contains("capture") || lower.contains("avcapture") {
+                traits.insert(.cameraName)
+            } else {
+                traits.insert(.cameraOrPreviewName)
+            }
+        }
+        if lower == "videoview" || lower.hasSuffix(".videoview") || lower.hasSuffix("videoview") {
+            traits.insert(.videoName)
+        }
+        if lower == "imageview" || lower.hasSuffix(".imageview") || lower.hasSuffix("imageview") ||
+           lower.contains("expoimage") || lower.contains("sdanimatedimage") {
+            traits.insert(.imageName)
+        }
+
+        if view is UITextField { traits.insert(.textField) }
+        if view is UITextView { traits.insert(.textView) }
+        if view is UIImageView { traits.insert(.imageView) }
+        if view is UIControl || view is UITextField || view is UITextView { traits.insert(.interactiveClass) }
+        return Entry(name: name, traits: traits)
+    }
+}
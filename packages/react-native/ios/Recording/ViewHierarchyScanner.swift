@@ -25,32 +25,33 @@ import UIKit
     
     private let _timeBudgetNs: UInt64 = 16_000_000
     
+    /// Reused across scans so a snapshot allocates nothing per view once its
+    /// tables have grown to the size of the screen.
+    private let _builder = RJHierarchySnapshotBuilder()
+    
+    /// Keyframe (cpp/HierarchySnapshot.h) or delta against the last keyframe
+    /// (cpp/HierarchyDelta.h).
+    public struct Snapshot {
+        public let payload: Data
+        public let encoding: RJHierarchyEncoding
+    }
+    
     private override init() {
         super.init()
     }
     
-    @objc public func captureHierarchy() -> [String: Any]? {
+    /// Must be called on the main thread.
+    public func captureSnapshot(timestampMs: UInt64, forceKeyframe: Bool) -> Snapshot? {
         guard let w = _keyWindow() else { return nil }
-        return serializeWindow(w)
+        return snapshotWindow(w, timestampMs: timestampMs, forceKeyframe: forceKeyframe)
     }
     
-    @objc public func serializeWindow(_ window: UIWindow) -> [String: Any] {
-        let ts = Int64(Date().timeIntervalSince1970 * 1000)
-        let scale = window.screen.scale
-        let bounds = window.bounds
+    public func snapshotWindow(_ window: UIWindow, timestampMs: UInt64, forceKeyframe: Bool) -> Snapshot {
+        _builder.reset(screenSize: window.bounds.size, scale: window.screen.scale, screenName: ReplayOrchestrator.shared.currentScreenName)
         let start = DispatchTime.now().uptimeNanoseconds
-        let root = _serializeView(window, depth: 0, start: start)
-        
-        var result: [String: Any] = [
-            "timestamp": ts,
-            "screen": ["width": bounds.width, "height": bounds.height, "scale": scale],
-            "root": root ?? [:]
-        ]
-        
-        if let sn = ReplayOrchestrator.shared.currentScreenName {
-            result["screenName"] = sn
-        }
-        return result
+        _appendView(window, parent: -1, depth: 0, start: start)
+        let encoded = _builder.encode(timestampMs: timestampMs, forceKeyframe: forceKeyframe)
+        return Snapshot(payload: encoded.data, encoding: encoded.encoding)
     }
     
     private func _keyWindow() -> UIWindow? {
@@ -61,109 +62,87 @@ import UIKit
         }
     }
     
-    private func _serializeView(_ view: UIView, depth: Int, start: UInt64) -> [String: Any]? {
-        if depth > maxDepth { return nil }
-        if (DispatchTime.now().uptimeNanoseconds - start) > _timeBudgetNs { return ["type": _typeName(view), "bailout": true] }
-        if depth > 0 && (view.isHidden || view.alpha <= 0.01 || view.bounds.width <= 0 || view.bounds.height <= 0) { return nil }
+    private func _appendView(_ view: UIView, parent: Int32, depth: Int, start: UInt64) {
+        if depth > maxDepth { return }
+        if (DispatchTime.now().uptimeNanoseconds - start) > _timeBudgetNs {
+            _builder.addNode(parent: parent, key: _viewKey(view), type: ViewClassifier.shared.classify(view).name, frame: .zero, alpha: 1, flags: .bailout)
+            return
+        }
+        if depth > 0 && (view.isHidden || view.alpha <= 0.01 || view.bounds.width <= 0 || view.bounds.height <= 0) { return }
         
         // Skip keyboard/system windows to avoid NaN frames during keyboard transitions
-        let className = _typeName(view)
-        if className.contains("UIRemoteKeyboardWindow") ||
-           className.contains("UITextEffectsWindow") ||
-           className.contains("UIInputSetHostView") ||
-           className.contains("UIKeyboard") {
-            return nil
+        let entry = ViewClassifier.shared.classify(view)
+        if entry.traits.contains(.keyboardChrome) {
+            return
         }
         
-        var node: [String: Any] = [:]
-        node["type"] = className
+        var flags: RJHierarchyNodeFlags = []
+        if view.isHidden { flags.insert(.hidden) }
+        let sensitive = _isSensitive(view, traits: entry.traits)
+        if sensitive { flags.insert(.masked) }
+        if entry.traits.contains(.interactiveClass) {
+            flags.insert(.interactive)
+            if let ctrl = view as? UIControl {
+                flags.insert(.hasEnabled)
+                if ctrl.isEnabled { flags.insert(.enabled) }
+            }
+        }
+        let sv = view as? UIScrollView
+        if sv?.isScrollEnabled == true { flags.insert(.scrollEnabled) }
+        if entry.traits.contains(.imageView) { flags.insert(.hasImage) }
         
-        // Guard frame values against NaN / Inf — keyboard and animated views
-        // can have degenerate frames that poison downstream JSON serialization
-        let f = view.frame
-        let fx = f.origin.x.isFinite && !f.origin.x.isNaN ? f.origin.x : 0
-        let fy = f.origin.y.isFinite && !f.origin.y.isNaN ? f.origin.y : 0
-        let fw = f.width.isFinite && !f.width.isNaN ? f.width : 0
-        let fh = f.height.isFinite && !f.height.isNaN ? f.height : 0
-        node["frame"] = ["x": fx, "y": fy, "w": fw, "h": fh]
+        // Frame values are guarded against NaN / Inf by the builder — keyboard
+        // and animated views can have degenerate frames.
+        let node = _builder.addNode(parent: parent, key: _viewKey(view), type: entry.name, frame: view.frame, alpha: view.alpha, flags: flags)
+        if node < 0 { return }
         
-        if view.isHidden { node["hidden"] = true }
-        if view.alpha < 1.0 { node["alpha"] = view.alpha }
-        if let aid = view.accessibilityIdentifier, !aid.isEmpty { node["testID"] = aid }
-        if let lbl = view.accessibilityLabel, !lbl.isEmpty { node["label"] = lbl }
-        let sensitive = _isSensitive(view)
-        if sensitive { node["masked"] = true }
+        if let aid = view.accessibilityIdentifier, !aid.isEmpty { _builder.set(aid, for: .testId, node: node) }
+        if let lbl = view.accessibilityLabel, !lbl.isEmpty { _builder.set(lbl, for: .label, node: node) }
         
-        if includeVisualProperties, let bg = view.backgroundColor, bg != .clear { node["bg"] = _hexColor(bg) }
+        if includeVisualProperties, let bg = view.backgroundColor, bg != .clear { _builder.set(_hexColor(bg), for: .background, node: node) }
         
         if includeTextContent {
             if let tv = view as? UITextView {
                 let text = tv.text ?? ""
-                node["text"] = sensitive ? "***" : _mask(text)
-                node["textLength"] = text.count
+                _builder.set(sensitive ? "***" : _mask(text), for: .text, node: node)
+                _builder.setTextLength(UInt(text.count), node: node)
+            }
+            else if let lb = view as? UILabel {
+                let text = lb.text ?? ""
+                _builder.set(_mask(text), for: .text, node: node)
+                _builder.setTextLength(UInt(text.count), node: node)
             }
-            else if let lb = view as? UILabel { node["text"] = _mask(lb.text ?? ""); node["textLength"] = lb.text?.count ?? 0 }
             else if let tf = view as? UITextField {
                 let text = tf.text ?? ""
-                node["text"] = sensitive ? "***" : _mask(text)
-                node["textLength"] = text.count
-                node["placeholder"] = tf.placeholder
+                _builder.set(sensitive ? "***" : _mask(text), for: .text, node: node)
+                _builder.setTextLength(UInt(text.count), node: node)
+                if let placeholder = tf.placeholder { _builder.set(placeholder, for: .placeholder, node: node) }
             }
         }
         
-        if _isInteractive(view) {
-            node["interactive"] = true
-            if let btn = view as? UIButton { if let t = btn.title(for: .normal) { node["buttonTitle"] = t }; node["enabled"] = btn.isEnabled }
-            if let ctrl = view as? UIControl { node["enabled"] = ctrl.isEnabled }
+        if flags.contains(.interactive), let btn = view as? UIButton, let t = btn.title(for: .normal) {
+            _builder.set(t, for: .buttonTitle, node: node)
         }
         
-        if let sv = view as? UIScrollView {
-            node["scrollEnabled"] = sv.isScrollEnabled
-            let ox = sv.contentOffset.x.isFinite && !sv.contentOffset.x.isNaN ? sv.contentOffset.x : 0
-            let oy = sv.contentOffset.y.isFinite && !sv.contentOffset.y.isNaN ? sv.contentOffset.y : 0
-            let cw = sv.contentSize.width.isFinite && !sv.contentSize.width.isNaN ? sv.contentSize.width : 0
-            let ch = sv.contentSize.height.isFinite && !sv.contentSize.height.isNaN ? sv.contentSize.height : 0
-            node["contentOffset"] = ["x": ox, "y": oy]
-            node["contentSize"] = ["w": cw, "h": ch]
+        if let sv = sv {
+            _builder.setScroll(offset: sv.contentOffset, contentSize: sv.contentSize, node: node)
         }
         
-        if view is UIImageView { node["hasImage"] = true }
-        
-        let subs = view.subviews.filter { !$0.isHidden && $0.alpha > 0.01 }
-        if !subs.isEmpty {
-            var children: [[String: Any]] = []
-            for s in subs {
-                if let cn = _serializeView(s, depth: depth + 1, start: start) { children.append(cn) }
-            }
-            if !children.isEmpty { node["children"] = children }
+        for s in view.subviews where !s.isHidden && s.alpha > 0.01 {
+            _appendView(s, parent: node, depth: depth + 1, start: start)
         }
-        
-        return node
     }
     
-    private func _typeName(_ v: UIView) -> String { String(describing: type(of: v)) }
+    /// Identity of a live view, so deltas can match it across scans.
+    private func _viewKey(_ v: UIView) -> UInt64 { UInt64(UInt(bitPattern: Unmanaged.passUnretained(v).toOpaque())) }
     
-    private func _isSensitive(_ v: UIView) -> Bool {
+    private func _isSensitive(_ v: UIView, traits: ViewClassifier.Traits) -> Bool {
         if v.accessibilityHint == "rejourney_occlude" { return true }
-        if let tf = v as? UITextField, tf.isSecureTextEntry { return true }
-        if ReplayOrchestrator.shared.maskTextInputsByDefault && (v is UITextField || v is UITextView) { return true }
-        if ReplayOrchestrator.shared.maskTextInputsByDefault && _isTextInputClass(_typeName(v)) { return true }
+        if traits.contains(.textField), let tf = v as? UITextField, tf.isSecureTextEntry { return true }
+        if ReplayOrchestrator.shared.maskTextInputsByDefault &&
+           (traits.contains(.textField) || traits.contains(.textView) || traits.contains(.textInputClass)) { return true }
         return false
     }
-
-    private func _isTextInputClass(_ className: String) -> Bool {
-        className == "RCTSinglelineTextInputView" ||
-        className == "RCTMultilineTextInputView" ||
-        className == "RCTTextInput" ||
-        className == "RCTBaseTextInputView" ||
-        className == "RCTTextInputComponentView" ||
-        className == "RCTUITextField" ||
-        className == "EXTextInput"
-    }
-    
-    private func _isInteractive(_ v: UIView) -> Bool {
-        v is UIButton || v is UIControl || v is UITextField || v is UITextView
-    }
     
     private func _mask(_ text: String) -> String {
         text.count > 100 ? String(text.prefix(100)) + "..." : text
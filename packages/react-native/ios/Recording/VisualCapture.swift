@@ -26,22 +26,61 @@ public final class VisualCapture: NSObject {
     
     @objc public static let shared = VisualCapture()
     
+    /// Frame interval while the user is active.
     @objc public var snapshotInterval: Double = 1.0
+    /// Heartbeat when nothing happens on screen.
+    @objc public var idleSnapshotInterval: Double = 5.0
+    /// Long-run frame budget; bursts around activity may briefly exceed it.
+    @objc public var framesPerMinute: Int = 60
+    /// Best JPEG quality; rate control lowers it while frames run over budget.
     @objc public var quality: CGFloat = 0.5
     /// Capture scale (e.g. 1.25 = capture at 80% linear size). Matches Android for parity; reduces JPEG size.
+    /// The finest scale used: rate control coarsens it per frame, which is
+    /// resampled from a one-pixel-per-point render.
     @objc public var captureScale: CGFloat = 1.25
+    /// Encoded frame bytes per second rate control aims for.
+    @objc public var targetBytesPerSecond: Int = 40 * 1024
     
     @objc public var isCapturing: Bool {
         _stateMachine.currentState == .capturing
     }
     
     private let _stateMachine = CaptureStateMachine()
-    private var _screenshots: [(Data, UInt64)] = []
+    /// Open frame bundle; frames are written into it as they are encoded.
+    private let _bundleWriter = RJFrameBundleWriter()
+    /// Spots captures that match the last encoded frame.
+    private let _frameDeduplicator = RJFrameDeduplicator()
+    /// Reduces frames to the tiles that changed since the last keyframe.
+    private let _tileDeltaEncoder = RJTileDeltaEncoder()
+    /// Crash-persisted snapshot of the open bundle, if any.
+    private var _pendingBundleURL: URL?
     private let _stateLock = NSLock()
+    /// Decides when frames are captured (cpp/CaptureScheduler.h); the
+    /// one-shot timer is re-armed for its next frame after every poll and
+    /// whenever a signal moves that frame earlier. Main thread only.
+    private let _scheduler = RJCaptureScheduler()
     private var _captureTimer: Timer?
+    private var _captureTimerFireMs: UInt64 = 0
+    private var _scheduling = false
     private var _frameCounter: UInt64 = 0
     private var _sessionEpoch: UInt64 = 0
     private var _redactionMask: RedactionMask
+    private let _redactionCompositor = RJRedactionCompositor()
+    /// Encodes frames from the pooled capture bitmap with libjpeg
+    /// (cpp/JpegEncoder.h) when the pod is built with it, ImageIO otherwise.
+    private let _jpegEncoder = RJJpegEncoder()
+    /// Resamples the full-resolution capture to the capture scale on the
+    /// encode queue (cpp/ImageScaler.h).
+    private let _imageScaler = RJImageScaler()
+    /// Full-resolution capture bitmaps, and the scaled frames made from
+    /// them, recycled once the encode queue is done with a frame
+    /// (cpp/CaptureBufferPool.h). A frame is skipped when every buffer is
+    /// still waiting to be encoded.
+    private let _captureBuffers: RJCaptureBufferPool
+    private let _scaledBuffers: RJCaptureBufferPool
+    /// Picks quality and scale per frame from encoded sizes and upload
+    /// throughput (cpp/RateController.h).
+    private let _rateController = RJRateController()
     private var _framesDiskPath: URL?
     private var _currentSessionId: String?
     private let _ciContext = CIContext(options: nil)
@@ -64,16 +103,32 @@ public final class VisualCapture: NSObject {
     }()
     
     // Backpressure limits to prevent stutter
-    private let _maxPendingBatches = 50
-    private let _maxBufferedScreenshots = 500
+    private static let _maxPendingBatches = 50
+    /// Full-screen bitmaps: the one the serial encode queue is working on
+    /// and two captured behind it. Deeper pools would only raise peak memory;
+    /// a capture that finds none free hands its credit back and the next
+    /// tick tries again.
+    private static let _captureBufferDepth = 3
+    /// Scaled frames live only while the encode queue works on one; the
+    /// delta and dedup encoders copy what they keep.
+    private static let _scaledBufferDepth = 2
     
     /// Flush to the network after this many frames (smaller = more frequent uploads).
     private var _uploadBatchSize = 3
+    /// Frames the open bundle flushes at: `_uploadBatchSize`, or more on a
+    /// fast unmetered link (SegmentDispatcher's upload policy).
+    private var _bundleFrames = 3
+    /// How long the open bundle may wait for `_bundleFrames` at the idle
+    /// capture rate before it ships short.
+    private var _bundleAgeLimitMs: UInt64 = 15_000
 
     
     private override init() {
+        _captureBuffers = RJCaptureBufferPool(capacity: UInt(VisualCapture._captureBufferDepth))
+        _scaledBuffers = RJCaptureBufferPool(capacity: UInt(VisualCapture._scaledBufferDepth))
         _redactionMask = RedactionMask()
         super.init()
+        _imageScaler.outputPool = _scaledBuffers
         _setupLifecycleObservers()
     }
     
@@ -123,7 +178,7 @@ public final class VisualCapture: NSObject {
     @objc private func _handleBackground() {
         // Stop capturing when app goes to background to prevent
         // "Rendering a view that is not in a visible window" warnings
-        _stopCaptureTimer()
+        _stopCaptureScheduling()
         
         // Flush any pending screenshots immediately before background
         // This ensures we don't lose data when app is backgrounded
@@ -133,7 +188,7 @@ public final class VisualCapture: NSObject {
     @objc private func _handleForeground() {
         // Resume capturing when app comes back to foreground
         if _stateMachine.currentState == .capturing {
-            _startCaptureTimer()
+            _startCaptureScheduling()
         }
     }
 
@@ -174,7 +229,7 @@ public final class VisualCapture: NSObject {
         // run yet), force-halt first to prevent it from stopping the new session.
         if _stateMachine.currentState == .capturing {
             DiagnosticLog.trace("[VisualCapture] Force-halting stale capture before starting new session")
-            _stopCaptureTimer()
+            _stopCaptureScheduling()
             _ = _stateMachine.transition(to: .halted)
         }
 
@@ -185,15 +240,20 @@ public final class VisualCapture: NSObject {
 
         // Discard leftover frames from the previous session
         _stateLock.lock()
-        let staleCount = _screenshots.count
+        let staleCount = _bundleWriter.frameCount
         if staleCount > 0 {
             DiagnosticLog.trace("[VisualCapture] Clearing \(staleCount) stale frames from previous session")
-            _screenshots.removeAll()
         }
+        _bundleWriter.reset(sessionEpochMs: sessionOrigin)
+        _frameDeduplicator.reset()
+        _tileDeltaEncoder.reset()
+        _pendingBundleURL = nil
         _stateLock.unlock()
 
         _sessionEpoch = sessionOrigin
         _frameCounter = 0
+        _rateController.start(atMs: _nowMs())
+        TelemetryPipeline.shared.resetFrameCredits()
         
         // Set up disk persistence for frames
         _currentSessionId = TelemetryPipeline.shared.currentReplayId
@@ -203,10 +263,8 @@ public final class VisualCapture: NSObject {
             try? FileManager.default.createDirectory(at: _framesDiskPath!, withIntermediateDirectories: true)
         }
         
-        _startCaptureTimer()
-        DispatchQueue.main.async { [weak self] in
-            self?._captureFrame(forced: true)
-        }
+        // The scheduler asks for a forced frame as soon as it starts.
+        _startCaptureScheduling()
     }
     
     @objc public func halt(expectedGeneration: Int = -1) {
@@ -217,15 +275,11 @@ public final class VisualCapture: NSObject {
             return
         }
         guard _stateMachine.transition(to: .halted) else { return }
-        _stopCaptureTimer()
+        _stopCaptureScheduling()
         
         // Flush any remaining frames to disk before halting
         _flushBufferToDisk()
         _flushBuffer()
-        
-        _stateLock.lock()
-        _screenshots.removeAll()
-        _stateLock.unlock()
     }
     
     /// Synchronously flush all pending frames to disk for crash safety
@@ -259,34 +313,142 @@ public final class VisualCapture: NSObject {
         _redactionMask.invalidateCache()
     }
 
-    
-    @objc public func configure(snapshotInterval: Double, jpegQuality: Double, captureScale: CGFloat = 1.25, uploadBatchSize: Int = 3) {
+
+    /// `jpegSubsampling`, `optimizeHuffman` and `restartRows` only take
+    /// effect when libjpeg is available (`RJJpegEncoder.usesLibjpeg`, opted
+    /// into with REJOURNEY_LIBJPEG_POD); with ImageIO only `jpegQuality`
+    /// applies.
+    @objc public func configure(snapshotInterval: Double, jpegQuality: Double, captureScale: CGFloat = 1.25, uploadBatchSize: Int = 3,
+                                jpegSubsampling: RJJpegSubsampling = .quarter, optimizeHuffman: Bool = false, restartRows: Int = 0,
+                                idleSnapshotInterval: Double = 5.0, framesPerMinute: Int = 60,
+                                targetBytesPerSecond: Int = 40 * 1024) {
         self.snapshotInterval = snapshotInterval
+        self.idleSnapshotInterval = max(snapshotInterval, idleSnapshotInterval)
+        self.framesPerMinute = max(0, framesPerMinute)
         self.quality = CGFloat(jpegQuality)
+        _jpegEncoder.subsampling = jpegSubsampling
+        _jpegEncoder.optimizeHuffman = optimizeHuffman
+        _jpegEncoder.restartRows = UInt(max(0, restartRows))
         self.captureScale = max(1.0, captureScale)
+        self.targetBytesPerSecond = max(1024, targetBytesPerSecond)
+        _rateController.configure(quality: self.quality, captureScale: self.captureScale,
+                                  targetBytesPerSecond: UInt(self.targetBytesPerSecond))
         _uploadBatchSize = max(1, min(uploadBatchSize, 100))
-        if _stateMachine.currentState == .capturing {
-            _stopCaptureTimer()
-            _startCaptureTimer()
+        SegmentDispatcher.shared.configureFrameBundles(baseFrames: _uploadBatchSize)
+        _stateLock.lock()
+        _bundleFrames = _uploadBatchSize
+        _bundleAgeLimitMs = UInt64(_uploadBatchSize) * UInt64(_idleIntervalMs)
+        _stateLock.unlock()
+        TelemetryPipeline.shared.configureFrameCredits(framesPerBundle: _uploadBatchSize)
+        _onMain { [weak self] in
+            guard let self else { return }
+            self._configureScheduler()
+            self._armCaptureTimer()
         }
     }
     
+    /// Captures a forced frame right away, past the frame budget.
     @objc public func snapshotNow() {
-        DispatchQueue.main.async { [weak self] in
-            self?._captureFrame(forced: true)
+        noteVisualChange(.critical)
+    }
+    
+    @objc public func noteVisualChange(_ importance: RJVisualChangeImportance) {
+        _onMain { [weak self] in
+            guard let self, self._scheduling else { return }
+            self._scheduler.noteVisualChange(importance, atMs: self._nowMs())
+            self._armCaptureTimer()
+        }
+    }
+    
+    @objc public func noteInteraction() {
+        _onMain { [weak self] in
+            guard let self, self._scheduling else { return }
+            self._scheduler.noteInteraction(atMs: self._nowMs())
+            self._armCaptureTimer()
         }
     }
     
-    private func _startCaptureTimer() {
-        _stopCaptureTimer()
-        _captureTimer = Timer.scheduledTimer(withTimeInterval: snapshotInterval, repeats: true) { [weak self] _ in
-            self?._captureFrame()
+    /// Upload throughput, from the dispatcher; frames are held to a share of it.
+    @objc public func noteUploadCompleted(bytes: Int, durationMs: Double) {
+        _rateController.reportUpload(bytes: UInt(max(0, bytes)), durationMs: durationMs)
+    }
+    
+    /// Constrained (Low Data Mode) paths get a lower frame rate target.
+    @objc public func noteNetworkConstrained(_ constrained: Bool) {
+        _rateController.constrained = constrained
+    }
+    
+    @objc public func noteScreenChange() {
+        _onMain { [weak self] in
+            guard let self, self._scheduling else { return }
+            self._scheduler.noteScreenChange(atMs: self._nowMs())
+            self._armCaptureTimer()
         }
     }
     
-    private func _stopCaptureTimer() {
+    private func _onMain(_ work: @escaping () -> Void) {
+        if Thread.isMainThread {
+            work()
+        } else {
+            DispatchQueue.main.async(execute: work)
+        }
+    }
+    
+    private func _nowMs() -> UInt64 {
+        DispatchTime.now().uptimeNanoseconds / 1_000_000
+    }
+    
+    private func _configureScheduler() {
+        _scheduler.configure(activeIntervalMs: UInt32(max(0.05, snapshotInterval) * 1000),
+                             idleIntervalMs: UInt32(max(snapshotInterval, idleSnapshotInterval) * 1000),
+                             framesPerMinute: UInt32(clamping: framesPerMinute))
+    }
+    
+    private func _startCaptureScheduling() {
+        _onMain { [weak self] in
+            guard let self else { return }
+            self._stopCaptureScheduling()
+            self._configureScheduler()
+            self._scheduling = true
+            self._scheduler.start(atMs: self._nowMs())
+            self._armCaptureTimer()
+        }
+    }
+    
+    private func _stopCaptureScheduling() {
+        _scheduling = false
+        _captureTimer?.invalidate()
+        _captureTimer = nil
+    }
+    
+    /// Points the one-shot timer at the scheduler's next frame unless it
+    /// already fires sooner.
+    private func _armCaptureTimer() {
+        guard _scheduling else { return }
+        let now = _nowMs()
+        let next = _scheduler.nextCaptureMs(atMs: now)
+        if let timer = _captureTimer, timer.isValid, _captureTimerFireMs <= next {
+            return
+        }
         _captureTimer?.invalidate()
+        _captureTimerFireMs = next
+        let delay = next > now ? Double(next - now) / 1000.0 : 0
+        // Default run loop mode, like the pipeline heartbeat: the timer holds
+        // off while a scroll view tracks, so drawHierarchy never runs on main
+        // at the burst rate mid-scroll. The burst resumes once it settles.
+        _captureTimer = Timer.scheduledTimer(withTimeInterval: delay, repeats: false) { [weak self] _ in
+            self?._onCaptureTimer()
+        }
+    }
+    
+    private func _onCaptureTimer() {
         _captureTimer = nil
+        guard _scheduling else { return }
+        var forced: ObjCBool = false
+        if _scheduler.poll(atMs: _nowMs(), forced: &forced) {
+            _captureFrame(forced: forced.boolValue)
+        }
+        _armCaptureTimer()
     }
     
     private func _captureFrame(forced: Bool = false) {
@@ -309,7 +471,7 @@ public final class VisualCapture: NSObject {
                 }
             }
             let memMB = Double(info.resident_size) / 1_048_576.0
-            DiagnosticLog.trace("[VisualCapture] frame#\(_frameCounter) mapVisible=\(SpecialCases.shared.mapVisible) mapIdle=\(SpecialCases.shared.mapIdle) forced=\(forced) residentMB=\(String(format: "%.0f", memMB))")
+            DiagnosticLog.trace("[VisualCapture] frame#\(_frameCounter) mapVisible=\(SpecialCases.shared.mapVisible) mapIdle=\(SpecialCases.shared.mapIdle) forced=\(forced) residentMB=\(String(format: "%.0f", memMB)) captureBuffers=\(_captureBuffers.outstandingCount)/\(_captureBuffers.allocationCount) quality=\(String(format: "%.2f", _rateController.quality)) scale=\(String(format: "%.2f", _rateController.captureScale)) targetBps=\(_rateController.targetBytesPerSecond)")
         }
         
         // Map stutter prevention: when a map view is visible and its camera
@@ -344,36 +506,63 @@ public final class VisualCapture: NSObject {
             if ReplayOrchestrator.shared.maskImagesAndVideosByDefault {
                 redactionRegions.append(contentsOf: _redactionMask.computeMediaRegions(windows: captureWindows))
             }
-            let scale = max(1.0, captureScale)
-            let scaledSize = CGSize(width: bounds.width / scale, height: bounds.height / scale)
-            guard scaledSize.width >= 1, scaledSize.height >= 1 else {
+            // Render once at one pixel per point; the encode queue resamples
+            // to the capture scale, so rate control can change it per frame
+            // without drawing the hierarchy again.
+            let scale = max(1.0, _rateController.captureScale)
+            let targetWidth = Int(bounds.width / scale)
+            let targetHeight = Int(bounds.height / scale)
+            guard targetWidth >= 1, targetHeight >= 1 else {
                 return
             }
             
-            UIGraphicsBeginImageContextWithOptions(scaledSize, false, 1.0)
-            guard let context = UIGraphicsGetCurrentContext() else {
-                UIGraphicsEndImageContext()
+            // No credit means the upload queue is full: skip the frame now
+            // rather than render and encode something that cannot ship.
+            let credits = TelemetryPipeline.shared
+            guard credits.acquireFrameCredit() else {
+                DiagnosticLog.trace("[VisualCapture] SKIPPING frame (no upload credit, denied=\(credits.deniedFrameCount))")
+                return
+            }
+            guard let buffer = _captureBuffers.acquire(width: Int(bounds.width.rounded(.up)), height: Int(bounds.height.rounded(.up))) else {
+                DiagnosticLog.trace("[VisualCapture] SKIPPING frame (capture buffers in use)")
+                credits.releaseFrameCredits(1)
+                return
+            }
+            guard let context = buffer.context else {
+                credits.releaseFrameCredits(1)
                 return
             }
-            context.scaleBy(x: 1.0 / scale, y: 1.0 / scale)
+            UIGraphicsPushContext(context)
             for captureWindow in captureWindows {
                 let drawRect = captureWindow === window ? bounds : captureWindow.frame
                 captureWindow.drawHierarchy(in: drawRect, afterScreenUpdates: false)
                 if !ReplayOrchestrator.shared.maskImagesAndVideosByDefault {
-                    _compositeVideoLayers(in: captureWindow, context: context, snapshotScale: scale)
+                    _compositeVideoLayers(in: captureWindow, context: context, snapshotScale: 1.0)
                 }
             }
             
-            // Apply redactions inline while context is open
+            // Apply redactions inline while context is open. Fills go
+            // straight into the bitmap, coalesced so overlapping and nested
+            // regions cost one pass; indicators are drawn only for regions
+            // no other region covers.
             if !redactionRegions.isEmpty {
+                _redactionCompositor.reset()
                 for region in redactionRegions {
+                    _redactionCompositor.add(region.rect)
+                }
+                let painted = _redactionCompositor.paint(into: context, color: _placeholderFillColor.cgColor)
+                for (index, region) in redactionRegions.enumerated() {
                     let r = region.rect
                     // Skip invalid rects that could cause CoreGraphics errors
                     guard r.width > 0 && r.height > 0 else { continue }
                     guard r.origin.x.isFinite && r.origin.y.isFinite && r.width.isFinite && r.height.isFinite else { continue }
                     guard !r.origin.x.isNaN && !r.origin.y.isNaN && !r.width.isNaN && !r.height.isNaN else { continue }
-                    context.setFillColor(_placeholderFillColor(for: region.kind).cgColor)
-                    context.fill(r)
+                    if painted {
+                        guard _redactionCompositor.isOutermost(UInt(index)) else { continue }
+                    } else {
+                        context.setFillColor(_placeholderFillColor(for: region.kind).cgColor)
+                        context.fill(r)
+                    }
                     if region.kind == .camera {
                         _drawCameraMaskIndicator(in: r, context: context)
                     } else if region.kind == .image || region.kind == .video {
@@ -388,16 +577,19 @@ public final class VisualCapture: NSObject {
 
             _drawKeyboardPlaceholderIfNeeded(in: context, window: window)
             
-            guard let image = UIGraphicsGetImageFromCurrentImageContext() else {
-                UIGraphicsEndImageContext()
+            UIGraphicsPopContext()
+            // The image owns the buffer from here; it returns to the pool
+            // when the encode closure lets go of the image.
+            guard let fullCGImage = buffer.makeImage() else {
+                credits.releaseFrameCredits(1)
                 return
             }
-            UIGraphicsEndImageContext()
+            let fullImage = UIImage(cgImage: fullCGImage)
             
             let captureTs = UInt64(Date().timeIntervalSince1970 * 1000)
             _frameCounter += 1
             let frameNumber = _frameCounter
-            let jpegQuality = quality
+            let jpegQuality = _rateController.quality
             let generation = captureGeneration
 
             if ReplayOrchestrator.shared.hierarchyCaptureEnabled {
@@ -405,11 +597,21 @@ public final class VisualCapture: NSObject {
             }
             
             // Move JPEG compression off the main thread.
-            // drawHierarchy must be on main, but jpegData is thread-safe and
+            // drawHierarchy must be on main, but JPEG encoding is thread-safe and
             // accounts for ~40-60% of per-frame main-thread cost.
             _encodeQueue.addOperation { [weak self] in
                 guard let self else { return }
-                guard let data = image.jpegData(compressionQuality: jpegQuality) else { return }
+                let image = self._downscaled(fullImage, width: targetWidth, height: targetHeight)
+                // The writer is only read under the lock; a bundle flushed
+                // after this check is caught by the append below.
+                self._stateLock.lock()
+                let opensBundle = self._bundleWriter.frameCount == 0
+                self._stateLock.unlock()
+                guard let frame = self._encodeFrame(image, quality: jpegQuality, forced: forced,
+                                                    opensBundle: opensBundle) else {
+                    self._releaseFrameCredit(generation: generation)
+                    return
+                }
                 
                 // Log frame timing every 30 frames to avoid log spam
                 if frameNumber % 30 == 0 {
@@ -417,25 +619,47 @@ public final class VisualCapture: NSObject {
                     DiagnosticLog.perfFrame(operation: "screenshot", durationMs: frameDurationMs, frameNumber: Int(frameNumber), isMainThread: Thread.isMainThread)
                 }
                 
-                // Store in buffer (fast operation)
+                // Write into the open bundle right away so finishing the
+                // batch only has to flush the stream tail.
                 self._stateLock.lock()
                 guard generation == self.captureGeneration, self._stateMachine.currentState == .capturing else {
                     self._stateLock.unlock()
                     return
                 }
-                self._screenshots.append((data, captureTs))
-                self._enforceScreenshotCaps()
-                let count = self._screenshots.count
-                let shouldSend = forced || count >= self._uploadBatchSize
+                var appended = frame
+                if !self._appendFrameLocked(frame, timestampMs: captureTs, quality: jpegQuality) {
+                    // The batch was flushed after this frame was classified
+                    // and a bundle has to open with a full frame.
+                    self._stateLock.unlock()
+                    guard let keyframe = self._encodeKeyframe(image, quality: jpegQuality) else {
+                        self._releaseFrameCredit(generation: generation)
+                        return
+                    }
+                    self._stateLock.lock()
+                    guard generation == self.captureGeneration, self._stateMachine.currentState == .capturing else {
+                        self._stateLock.unlock()
+                        return
+                    }
+                    _ = self._appendFrameLocked(keyframe, timestampMs: captureTs, quality: jpegQuality)
+                    appended = keyframe
+                }
+                self._rateController.reportFrame(bytes: UInt(appended.recordBytes), quality: jpegQuality,
+                                                 captureScale: scale, atMs: self._nowMs())
+                let count = Int(self._bundleWriter.frameCount)
+                let oldestTs = self._bundleWriter.firstTimestampMs
+                if count == 1 {
+                    self._refreshBundleFrames()
+                }
+                let shouldSend = forced || count >= self._bundleFrames
                 // Time-based flush: if frames have been sitting for longer than one full
-                // batch interval, send regardless of count. This ensures sessions that end
-                // before reaching uploadBatchSize frames (very short sessions) still ship
-                // their frames promptly rather than waiting for shutdown.
+                // bundle takes at the idle rate, send regardless of count. This ensures
+                // sessions that end before filling a bundle (very short sessions) still
+                // ship their frames promptly rather than waiting for shutdown. The limit
+                // grows with the bundle, up to the policy's latency cap.
                 let shouldFlushByTime: Bool
-                if !shouldSend, count > 0, let oldestTs = self._screenshots.first?.1 {
+                if !shouldSend, count > 0 {
                     let waitMs = captureTs > oldestTs ? captureTs - oldestTs : 0
-                    let thresholdMs = UInt64(Double(self._uploadBatchSize) * self.snapshotInterval * 1_000)
-                    shouldFlushByTime = waitMs >= thresholdMs
+                    shouldFlushByTime = waitMs >= self._bundleAgeLimitMs
                 } else {
                     shouldFlushByTime = false
                 }
@@ -445,6 +669,107 @@ public final class VisualCapture: NSObject {
                     self._sendScreenshots()
                 }
             }
+            // Main-thread share only; encoding runs on its own queue.
+            _scheduler.reportFrameCost(ms: (CFAbsoluteTimeGetCurrent() - frameStart) * 1000)
+        }
+    }
+
+    /// Sizes the bundle that just opened from the upload policy, and lets
+    /// frame credits cover it. Called with `_stateLock` held.
+    private func _refreshBundleFrames() {
+        let frames = max(1, SegmentDispatcher.shared.frameBundleFrames)
+        _bundleAgeLimitMs = SegmentDispatcher.shared.frameBundleAgeLimitMs(frameIntervalMs: _idleIntervalMs)
+        guard frames != _bundleFrames else { return }
+        _bundleFrames = frames
+        TelemetryPipeline.shared.configureFrameCredits(framesPerBundle: frames)
+    }
+
+    private var _idleIntervalMs: UInt32 {
+        UInt32(min(Double(UInt32.max), max(0, idleSnapshotInterval * 1_000)))
+    }
+
+    /// Gives back the credit of a frame that failed to encode. Frames of an
+    /// earlier generation lost theirs when the next session reset credits.
+    private func _releaseFrameCredit(generation: Int) {
+        guard generation == captureGeneration else { return }
+        TelemetryPipeline.shared.releaseFrameCredits(1)
+    }
+
+    /// Classifies and encodes a captured frame on the encode queue.
+    /// `opensBundle` is whether the open bundle was empty, read under
+    /// `_stateLock` by the caller.
+    private func _encodeFrame(_ image: UIImage, quality: CGFloat, forced: Bool, opensBundle: Bool) -> EncodedFrame? {
+        guard let cgImage = image.cgImage else {
+            return _encodeKeyframe(image, quality: quality)
+        }
+        // A static screen becomes a 12-byte repeat record instead of another
+        // JPEG. Forced frames are always encoded.
+        if _frameDeduplicator.isRepeat(cgImage) && !forced {
+            return .repeatPrevious
+        }
+        // New batches open with a keyframe; otherwise ship only the tiles
+        // that changed since the last one.
+        let forceKeyframe = forced || opensBundle
+        if let payload = _tileDeltaEncoder.deltaPayload(for: cgImage, quality: quality, forceKeyframe: forceKeyframe) {
+            return .delta(payload)
+        }
+        guard let jpeg = _jpeg(image, quality: quality) else {
+            // Deltas must never reference a keyframe that was not shipped.
+            _tileDeltaEncoder.reset()
+            return nil
+        }
+        return .full(jpeg)
+    }
+
+    /// Encodes `image` whole and makes it the keyframe for later deltas.
+    private func _encodeKeyframe(_ image: UIImage, quality: CGFloat) -> EncodedFrame? {
+        if let cgImage = image.cgImage {
+            _ = _tileDeltaEncoder.deltaPayload(for: cgImage, quality: quality, forceKeyframe: true)
+        } else {
+            _tileDeltaEncoder.reset()
+        }
+        guard let jpeg = _jpeg(image, quality: quality) else {
+            _tileDeltaEncoder.reset()
+            return nil
+        }
+        return .full(jpeg)
+    }
+
+    /// Runs on the encode queue.
+    private func _downscaled(_ image: UIImage, width: Int, height: Int) -> UIImage {
+        guard let cgImage = image.cgImage else { return image }
+        if cgImage.width == width && cgImage.height == height {
+            return image
+        }
+        if let scaled = _imageScaler.scale(cgImage, width: width, height: height) {
+            return UIImage(cgImage: scaled)
+        }
+        let format = UIGraphicsImageRendererFormat()
+        format.scale = 1.0
+        format.opaque = false
+        return UIGraphicsImageRenderer(size: CGSize(width: width, height: height), format: format).image { _ in
+            image.draw(in: CGRect(x: 0, y: 0, width: width, height: height))
+        }
+    }
+
+    private func _jpeg(_ image: UIImage, quality: CGFloat) -> Data? {
+        if let cgImage = image.cgImage, let jpeg = _jpegEncoder.encode(cgImage, quality: quality) {
+            return jpeg
+        }
+        return image.jpegData(compressionQuality: quality)
+    }
+
+    /// Called with `_stateLock` held. False when the open batch cannot take
+    /// a repeat or delta record.
+    private func _appendFrameLocked(_ frame: EncodedFrame, timestampMs: UInt64, quality: CGFloat) -> Bool {
+        switch frame {
+        case .full(let jpeg):
+            _bundleWriter.append(jpeg, timestampMs: timestampMs, quality: quality)
+            return true
+        case .delta(let payload):
+            return _bundleWriter.appendDelta(payload, timestampMs: timestampMs, quality: quality)
+        case .repeatPrevious:
+            return _bundleWriter.appendRepeat(timestampMs: timestampMs)
         }
     }
 
@@ -770,7 +1095,7 @@ public final class VisualCapture: NSObject {
     }
 
     private func _compositeVideoLayers(in window: UIWindow, context: CGContext, snapshotScale: CGFloat) {
-        guard let baseImage = UIGraphicsGetImageFromCurrentImageContext()?.cgImage else { return }
+        guard let baseImage = context.makeImage() else { return }
 
         _visitVideoLayers(in: window) { [weak self] layer, region in
             guard let self else { return }
@@ -996,81 +1321,69 @@ public final class VisualCapture: NSObject {
     }
 
     
-    /// Enforce memory caps to prevent unbounded growth (industry standard backpressure)
-    private func _enforceScreenshotCaps() {
-        // Called with lock held
-        if _screenshots.count > _maxBufferedScreenshots {
-            _screenshots.removeFirst(_screenshots.count - _maxBufferedScreenshots)
-        }
-    }
-    
-    /// Send screenshots to server - runs on OperationQueue to avoid blocking main thread
+    /// Ship the open bundle - runs on the encode queue right after the frame
+    /// that completed the batch was appended.
     private func _sendScreenshots() {
-        // Check backpressure first - drop if too backed up (prevents stutter)
-        guard _encodeQueue.operationCount <= _maxPendingBatches else {
-            DiagnosticLog.trace("Dropping screenshot batch due to backlog")
+        // Check backpressure first - hold the batch open if too backed up
+        // (prevents stutter) and make the next frames cheaper. Nothing is
+        // dropped here: frames in the open batch hold upload credits, so
+        // capture stops on its own until the queue drains, and the last
+        // queued encode ships the batch.
+        guard _encodeQueue.operationCount <= VisualCapture._maxPendingBatches else {
+            _rateController.relieveBacklog(atMs: _nowMs())
             return
         }
         
-        // Copy and clear under lock (fast operation)
+        let batchStart = CFAbsoluteTimeGetCurrent()
+        
         _stateLock.lock()
-        let images = _screenshots
-        _screenshots.removeAll()
-        let sessionEpoch = _sessionEpoch
+        let bundle = _bundleWriter.finish()
+        let staleSnapshot = _pendingBundleURL
+        _pendingBundleURL = nil
         let captureSessionId = _currentSessionId
         _stateLock.unlock()
         
-        guard !images.isEmpty else { return }
-        
-        // All heavy work (package, gzip, network) happens in background queue
-        _encodeQueue.addOperation { [weak self] in
-            self?._packageAndShip(images: images, sessionEpoch: sessionEpoch, sessionId: captureSessionId)
+        if let staleSnapshot {
+            try? FileManager.default.removeItem(at: staleSnapshot)
         }
-    }
-    
-    private func _packageAndShip(images: [(Data, UInt64)], sessionEpoch: UInt64, sessionId: String?) {
-        let batchStart = CFAbsoluteTimeGetCurrent()
+        guard let bundle else { return }
         
-        guard let bundle = _packageFrameBundle(images: images, sessionEpoch: sessionEpoch) else { return }
+        let packDurationMs = (CFAbsoluteTimeGetCurrent() - batchStart) * 1000
+        DiagnosticLog.perfBatch(operation: "package-frames", itemCount: Int(bundle.frameCount), totalMs: packDurationMs, isMainThread: Thread.isMainThread)
         
+        _submitBundle(bundle, sessionId: captureSessionId)
+    }
+    
+    private func _submitBundle(_ bundle: RJFrameBundle, sessionId: String?) {
         let rid = sessionId ?? "unknown"
-        let endTs = images.last?.1 ?? sessionEpoch
-        let fname = "\(rid)-\(endTs).tar.gz"
-        
-        let packDurationMs = (CFAbsoluteTimeGetCurrent() - batchStart) * 1000
-        DiagnosticLog.perfBatch(operation: "package-frames", itemCount: images.count, totalMs: packDurationMs, isMainThread: Thread.isMainThread)
+        let fname = "\(rid)-\(bundle.lastTimestampMs).tar.gz"
         
         // Submit directly - no main thread dispatch needed
         TelemetryPipeline.shared.submitFrameBundle(
-            payload: bundle,
+            payload: bundle.payload,
             filename: fname,
-            startMs: images.first?.1 ?? sessionEpoch,
-            endMs: endTs,
-            frameCount: images.count,
+            startMs: bundle.firstTimestampMs,
+            endMs: bundle.lastTimestampMs,
+            frameCount: Int(bundle.frameCount),
             sessionId: sessionId
         )
     }
     
-    private func _writeFrameToDisk(jpeg: Data, timestamp: UInt64) {
-        guard let path = _framesDiskPath else { return }
-        let framePath = path.appendingPathComponent("\(timestamp).jpeg")
-        try? jpeg.write(to: framePath)
-    }
-    
     private func _flushBufferToDisk() {
-        // Package any frames still in memory to disk
+        // Persist a closed-off copy of the open bundle; the stream stays open
         _stateLock.lock()
-        let frames = _screenshots
-        _stateLock.unlock()
+        defer { _stateLock.unlock() }
+        guard let path = _framesDiskPath, let snapshot = _bundleWriter.snapshot() else { return }
         
-        guard !frames.isEmpty, let path = _framesDiskPath else { return }
-        
-        for (jpeg, timestamp) in frames {
-            let framePath = path.appendingPathComponent("\(timestamp).jpeg")
-            if !FileManager.default.fileExists(atPath: framePath.path) {
-                try? jpeg.write(to: framePath)
-            }
+        let bundlePath = path.appendingPathComponent(
+            "\(snapshot.firstTimestampMs)-\(snapshot.lastTimestampMs)-\(snapshot.frameCount).\(VisualCapture._pendingBundleExtension)"
+        )
+        guard bundlePath != _pendingBundleURL else { return }
+        guard (try? snapshot.payload.write(to: bundlePath)) != nil else { return }
+        if let previous = _pendingBundleURL {
+            try? FileManager.default.removeItem(at: previous)
         }
+        _pendingBundleURL = bundlePath
     }
     
     /// Load and upload any pending frames from disk for a session
@@ -1090,38 +1403,64 @@ public final class VisualCapture: NSObject {
             return
         }
         
-        var frames: [(Data, UInt64)] = []
+        // Bundles snapshotted by _flushBufferToDisk are already compressed and
+        // named "<startMs>-<endMs>-<frameCount>".
+        var bundles: [(payload: Data, startMs: UInt64, endMs: UInt64, frameCount: Int)] = []
+        // Loose JPEGs ("<timestamp>.jpeg") from older SDK versions are streamed
+        // through a fresh writer one file at a time.
+        var looseFrames: [(URL, UInt64)] = []
         for file in frameFiles.sorted(by: { $0.lastPathComponent < $1.lastPathComponent }) {
-            guard file.pathExtension == "jpeg",
-                  let data = try? Data(contentsOf: file) else { continue }
-            
-            // Try to parse timestamp from filename
             let filename = file.deletingPathExtension().lastPathComponent
-            let ts = UInt64(filename) ?? 0
-            guard ts > 0 else { continue }
-            
-            frames.append((data, ts))
+            if file.pathExtension == VisualCapture._pendingBundleExtension {
+                let parts = filename.split(separator: "-").compactMap { UInt64($0) }
+                guard parts.count == 3, parts[2] > 0,
+                      let data = try? Data(contentsOf: file) else { continue }
+                bundles.append((data, parts[0], parts[1], Int(parts[2])))
+            } else if file.pathExtension == "jpeg", let ts = UInt64(filename), ts > 0 {
+                looseFrames.append((file, ts))
+            }
         }
         
-        let recoveryEpoch = sessionEpoch ?? frames.first?.1 ?? 0
-        guard !frames.isEmpty, let bundle = _packageFrameBundle(images: frames, sessionEpoch: recoveryEpoch) else {
-            completion?(frames.isEmpty)
-            return
+        if !looseFrames.isEmpty {
+            let writer = RJFrameBundleWriter()
+            writer.reset(sessionEpochMs: sessionEpoch ?? looseFrames[0].1)
+            for (file, ts) in looseFrames {
+                guard let data = try? Data(contentsOf: file) else { continue }
+                writer.append(data, timestampMs: ts)
+            }
+            if let bundle = writer.finish() {
+                bundles.append((bundle.payload, bundle.firstTimestampMs, bundle.lastTimestampMs, Int(bundle.frameCount)))
+            }
         }
         
-        let endTs = frames.last?.1 ?? 0
+        guard !bundles.isEmpty else {
+            completion?(looseFrames.isEmpty)
+            return
+        }
         
-        SegmentDispatcher.shared.transmitFrameBundle(
-            for: sessionId,
-            payload: bundle,
-            startMs: frames.first?.1 ?? 0,
-            endMs: endTs,
-            frameCount: frames.count
-        ) { ok in
-            if ok {
+        let group = DispatchGroup()
+        let resultLock = NSLock()
+        var allUploaded = true
+        for bundle in bundles {
+            group.enter()
+            SegmentDispatcher.shared.transmitFrameBundle(
+                for: sessionId,
+                payload: bundle.payload,
+                startMs: bundle.startMs,
+                endMs: bundle.endMs,
+                frameCount: bundle.frameCount
+            ) { ok in
+                resultLock.lock()
+                allUploaded = allUploaded && ok
+                resultLock.unlock()
+                group.leave()
+            }
+        }
+        group.notify(queue: .global(qos: .utility)) {
+            if allUploaded {
                 try? FileManager.default.removeItem(at: framesPath)
             }
-            completion?(ok)
+            completion?(allUploaded)
         }
     }
     
@@ -1134,75 +1473,44 @@ public final class VisualCapture: NSObject {
     
     private func _flushBuffer() {
         _stateLock.lock()
-        let frames = _screenshots
-        _screenshots.removeAll()
+        let bundle = _bundleWriter.finish()
+        let staleSnapshot = _pendingBundleURL
+        _pendingBundleURL = nil
         let captureSessionId = _currentSessionId
         _stateLock.unlock()
         
-        guard !frames.isEmpty else { return }
-        
-        // Clear the disk copies since we're uploading
-        if let path = _framesDiskPath {
-            for (_, timestamp) in frames {
-                let framePath = path.appendingPathComponent("\(timestamp).jpeg")
-                try? FileManager.default.removeItem(at: framePath)
-            }
+        // Clear the disk copy since we're uploading
+        if let staleSnapshot {
+            try? FileManager.default.removeItem(at: staleSnapshot)
         }
         
-        guard let bundle = _packageFrameBundle(images: frames, sessionEpoch: _sessionEpoch) else { return }
-        
-        let rid = captureSessionId ?? "unknown"
-        let endTs = frames.last?.1 ?? _sessionEpoch
-        let fname = "\(rid)-\(endTs).tar.gz"
+        guard let bundle else { return }
         
         // No main thread dispatch - submit directly (fixes stutter)
-        TelemetryPipeline.shared.submitFrameBundle(
-            payload: bundle,
-            filename: fname,
-            startMs: frames.first?.1 ?? _sessionEpoch,
-            endMs: endTs,
-            frameCount: frames.count,
-            sessionId: captureSessionId
-        )
-    }
-    
-    /// Android-compatible binary format: [8-byte BE timestamp offset][4-byte BE size][jpeg] per frame. Backend auto-detects.
-    private func _packageFrameBundle(images: [(Data, UInt64)], sessionEpoch: UInt64) -> Data? {
-        var archive = Data()
-        for (jpeg, timestamp) in images {
-            let tsOffset = timestamp - sessionEpoch
-            archive.append(_uint64BigEndian(tsOffset))
-            archive.append(_uint32BigEndian(UInt32(jpeg.count)))
-            archive.append(jpeg)
-        }
-        return archive.gzipCompress()
-    }
-    
-    private func _uint64BigEndian(_ value: UInt64) -> Data {
-        Data([
-            UInt8((value >> 56) & 0xff),
-            UInt8((value >> 48) & 0xff),
-            UInt8((value >> 40) & 0xff),
-            UInt8((value >> 32) & 0xff),
-            UInt8((value >> 24) & 0xff),
-            UInt8((value >> 16) & 0xff),
-            UInt8((value >> 8) & 0xff),
-            UInt8(value & 0xff)
-        ])
+        _submitBundle(bundle, sessionId: captureSessionId)
     }
     
-    private func _uint32BigEndian(_ value: UInt32) -> Data {
-        Data([
-            UInt8((value >> 24) & 0xff),
-            UInt8((value >> 16) & 0xff),
-            UInt8((value >> 8) & 0xff),
-            UInt8(value & 0xff)
-        ])
-    }
+    /// Extension of crash-persisted bundle snapshots in the frames directory.
+    private static let _pendingBundleExtension = "rjbundle"
 }
 
 private enum CaptureState { case idle, capturing, halted }
 
+/// One captured frame as it goes into the frame bundle.
+private enum EncodedFrame {
+    case full(Data)
+    case delta(Data)
+    case repeatPrevious
+
+    /// Bytes the frame adds to the bundle, record header included.
+    var recordBytes: Int {
+        switch self {
+        case .full(let data), .delta(let data): return 12 + data.count
+        case .repeatPrevious: return 12
+        }
+    }
+}
+
 private final class CaptureStateMachine {
     private var _state: CaptureState = .idle
     private let _lock = NSLock()
@@ -1249,9 +1557,9 @@ private final class RedactionMask {
     private let _lock = NSLock()
     
     // Cache the hierarchy scan results to avoid scanning every frame.
-    // The full recursive scan runs String(describing: type(of:)) reflection
-    // on every view in the key window, which is expensive in React Native
-    // hierarchies (thousands of views). Cache view references, not rects:
+    // The full recursive scan visits every view in the key window, which is
+    // expensive in React Native hierarchies (thousands of views), even with
+    // class checks answered by ViewClassifier. Cache view references, not rects:
     // rects must be recomputed every frame so masks follow scrolling and
     // pull-to-refresh transforms instead of staying at stale coordinates.
     private struct WeakRegionRef {
@@ -1284,27 +1592,6 @@ private final class RedactionMask {
         _lock.unlock()
     }
     
-    // View class names that should always be masked (privacy sensitive)
-    private let _alwaysSensitiveClassNames: Set<String> = [
-        // Camera views
-        "AVCaptureVideoPreviewLayer",
-        "CameraView",
-        "RCTCameraView",
-        "ExpoCamera",
-        "EXCameraView",
-    ]
-
-    private let _textInputClassNames: Set<String> = [
-        // React Native text inputs (internal class names)
-        "RCTSinglelineTextInputView",
-        "RCTMultilineTextInputView", 
-        "RCTTextInput",
-        "RCTBaseTextInputView",
-        "RCTTextInputComponentView",
-        "RCTUITextField",
-        // Expo text inputs
-        "EXTextInput"
-    ]
     private let _minimumMediaMaskSide: CGFloat = 44
     private let _minimumMediaMaskArea: CGFloat = 2_500
     
@@ -1336,8 +1623,8 @@ private final class RedactionMask {
         }
         
         // 2. Auto-detect sensitive views from a cached hierarchy scan.
-        //    The full recursive scan is expensive (String(describing:) reflection
-        //    on every view) so we cache sensitive view refs for ~0.5s. Rects are
+        //    The full recursive scan is expensive (it visits every view) so we
+        //    cache sensitive view refs for ~0.5s. Rects are
         //    always re-evaluated, so moving list content stays covered.
         let now = CFAbsoluteTimeGetCurrent()
         if now - _lastScanTime >= _scanCacheDurationSec {
@@ -1476,11 +1763,8 @@ private final class RedactionMask {
         // converted via UIView.convert(_:to:), causing CoreGraphics
         // "invalid numeric value (NaN)" errors. Keyboard content is
         // not meaningful for session replay and is never recorded.
-        let className = String(describing: type(of: view))
-        if className.contains("UIRemoteKeyboardWindow") ||
-           className.contains("UITextEffectsWindow") ||
-           className.contains("UIInputSetHostView") ||
-           className.contains("UIKeyboard") {
+        let traits = ViewClassifier.shared.classify(view).traits
+        if traits.contains(.keyboardChrome) {
             return
         }
         
@@ -1489,7 +1773,7 @@ private final class RedactionMask {
         // of whether we can compute its rect — we never want to expose child content
         // of a Mask wrapper (e.g. when the view has active animation keys during map
         // loading or a screen transition).
-        if let maskKind = _maskKind(view) {
+        if let maskKind = _maskKind(view, traits: traits) {
             views.append(WeakRegionRef(view: view, kind: maskKind))
             return // Always stop — never recurse into children of a masked view
         }
@@ -1505,11 +1789,8 @@ private final class RedactionMask {
         guard !view.isHidden && view.alpha > 0.01 else { return }
         guard view.bounds.width > 0 && view.bounds.height > 0 else { return }
 
-        let className = String(describing: type(of: view))
-        if className.contains("UIRemoteKeyboardWindow") ||
-           className.contains("UITextEffectsWindow") ||
-           className.contains("UIInputSetHostView") ||
-           className.contains("UIKeyboard") {
+        let traits = ViewClassifier.shared.classify(view).traits
+        if traits.contains(.keyboardChrome) {
             return
         }
 
@@ -1521,7 +1802,7 @@ private final class RedactionMask {
             return
         }
 
-        if let mediaKind = _mediaMaskKind(view, className: className), let rect = _maskRect(view) {
+        if let mediaKind = _mediaMaskKind(view, traits: traits), let rect = _maskRect(view) {
             // Expo Video wraps AVPlayerViewController and Expo Image wraps
             // SDAnimatedImageView through several RN/Gesture Handler views. This
             // uncached media-only pass keeps those poster/player views covered when
@@ -1531,7 +1812,7 @@ private final class RedactionMask {
         }
     }
     
-    private func _maskKind(_ view: UIView) -> RedactionMaskKind? {
+    private func _maskKind(_ view: UIView, traits: ViewClassifier.Traits) -> RedactionMaskKind? {
         if view.accessibilityHint == "rejourney_occlude" {
             return .generic
         }
@@ -1543,56 +1824,49 @@ private final class RedactionMask {
         }
         
         // Secure fields are always masked, even when ordinary text input masking is relaxed.
-        if let textField = view as? UITextField, textField.isSecureTextEntry {
+        if traits.contains(.textField), let textField = view as? UITextField, textField.isSecureTextEntry {
             return .textInput
         }
 
         // 1. Mask ALL text input fields by default (privacy first)
         // This includes password fields, instructions, notes, etc.
-        if view is UITextField {
+        if traits.contains(.textField) {
             return ReplayOrchestrator.shared.maskTextInputsByDefault ? .textInput : nil
         }
         
         // 2. Mask ALL text views (multiline inputs like instructions, notes, etc.)
-        if view is UITextView {
+        if traits.contains(.textView) {
             return ReplayOrchestrator.shared.maskTextInputsByDefault ? .textInput : nil
         }
         
         // 3. Check class name against known sensitive types
-        let className = String(describing: type(of: view))
-        if _alwaysSensitiveClassNames.contains(className) {
-            return _isCameraView(view, className: className) ? .camera : .generic
+        if traits.contains(.alwaysSensitive) {
+            return .camera
         }
-        if ReplayOrchestrator.shared.maskTextInputsByDefault && _textInputClassNames.contains(className) {
+        if ReplayOrchestrator.shared.maskTextInputsByDefault && traits.contains(.textInputClass) {
             return .textInput
         }
 
         // 4. Check camera previews separately so the replay can annotate them.
-        if _isCameraView(view, className: className) {
+        if _isCameraView(view, traits: traits) {
             return .camera
         }
 
         if ReplayOrchestrator.shared.maskImagesAndVideosByDefault,
-           let mediaKind = _mediaMaskKind(view, className: className) {
+           let mediaKind = _mediaMaskKind(view, traits: traits) {
             return mediaKind
         }
 
         return nil
     }
 
-    private func _isCameraView(_ view: UIView, className: String? = nil) -> Bool {
-        let resolvedClassName = className ?? String(describing: type(of: view))
-        if _alwaysSensitiveClassNames.contains(resolvedClassName) {
+    private func _isCameraView(_ view: UIView, traits: ViewClassifier.Traits) -> Bool {
+        if traits.contains(.alwaysSensitive) || traits.contains(.cameraName) {
             return true
         }
-
-        let lowerClassName = resolvedClassName.lowercased()
-        if lowerClassName.contains("camera") || lowerClassName.contains("preview") {
-            // Verify it's actually a camera preview, not just any view with "camera" in name
-            if lowerClassName.contains("video") || lowerClassName.contains("capture") ||
-                lowerClassName.contains("avcapture") || view.layer is AVCaptureVideoPreviewLayer {
-                return true
-            }
+        // Verify it's actually a camera preview, not just any view with "camera" in name
+        if traits.contains(.cameraOrPreviewName) && view.layer is AVCaptureVideoPreviewLayer {
+            return true
         }
 
         // Check layer type for camera preview layers
@@ -1603,12 +1877,8 @@ private final class RedactionMask {
         return false
     }
 
-    private func _isImageOrVideoView(_ view: UIView, className: String? = nil) -> Bool {
-        return _mediaMaskKind(view, className: className) != nil
-    }
-
-    private func _mediaMaskKind(_ view: UIView, className: String? = nil) -> RedactionMaskKind? {
-        if _isCameraView(view, className: className) {
+    private func _mediaMaskKind(_ view: UIView, traits: ViewClassifier.Traits) -> RedactionMaskKind? {
+        if _isCameraView(view, traits: traits) {
             return nil
         }
         // RN/expo icon renderers often use UIImageView internally. Keep remote
@@ -1617,16 +1887,13 @@ private final class RedactionMask {
         guard _isContentSizedMediaView(view) else {
             return nil
         }
-        if view is UIImageView {
+        if traits.contains(.imageView) {
             return .image
         }
-
-        let resolvedClassName = className ?? String(describing: type(of: view))
-        let lowerClassName = resolvedClassName.lowercased()
-        if _classNameLooksLikeVideoView(lowerClassName) {
+        if traits.contains(.videoName) {
             return .video
         }
-        if _classNameLooksLikeImageView(lowerClassName) {
+        if traits.contains(.imageName) {
             return .image
         }
         return nil
@@ -1641,18 +1908,4 @@ private final class RedactionMask {
         let area = bounds.width * bounds.height
         return minSide >= _minimumMediaMaskSide && area >= _minimumMediaMaskArea
     }
-
-    private func _classNameLooksLikeImageView(_ lowerClassName: String) -> Bool {
-        lowerClassName == "imageview" ||
-        lowerClassName.hasSuffix(".imageview") ||
-        lowerClassName.hasSuffix("imageview") ||
-        lowerClassName.contains("expoimage") ||
-        lowerClassName.contains("sdanimatedimage")
-    }
-
-    private func _classNameLooksLikeVideoView(_ lowerClassName: String) -> Bool {
-        lowerClassName == "videoview" ||
-        lowerClassName.hasSuffix(".videoview") ||
-        lowerClassName.hasSuffix("videoview")
-    }
 }
@@ -40,6 +40,164 @@
 #endif
 #endif
 
+#if defined(RCT_NEW_ARCH_ENABLED) && defined(RJ_USE_NEW_ARCH_CODEGEN)
+#import <jsi/jsi.h>
+#include "MpscRing.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#pragma mark - JSI Fast Path
+
+// Hot tracking calls (logEvent, screenChanged, onScroll) are exposed as
+// synchronous host functions on the TurboModule itself. Arguments are copied
+// into the lock-free core ring (cpp/MpscRing.h) on the JS thread and drained
+// on a background queue, so no promise, bridge hop or NSDictionary boxing
+// happens per call.
+namespace rejourney {
+
+namespace jsi = facebook::jsi;
+
+enum class FastCallKind : uint8_t { LogEvent, ScreenChanged, Scroll };
+
+struct FastCall {
+  FastCallKind kind = FastCallKind::LogEvent;
+  std::string name;
+  std::string detailsJson;
+  double number = 0;
+};
+
+class FastCallQueue {
+public:
+  using Sink = std::function<void(std::vector<FastCall> &&)>;
+
+  explicit FastCallQueue(Sink sink)
+      : sink_(std::move(sink)),
+        calls_(kCapacity),
+        queue_(dispatch_queue_create(
+            "co.rejourney.fastpath",
+            dispatch_queue_attr_make_with_qos_class(
+                DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0))) {}
+
+  void push(FastCall &&call) {
+    calls_.push(std::move(call));
+    // One drain block per burst: calls arriving while a drain is pending are
+    // picked up by it instead of scheduling their own.
+    if (!drainScheduled_.exchange(true, std::memory_order_acq_rel)) {
+      std::weak_ptr<FastCallQueue> weak = self_;
+      dispatch_async(queue_, ^{
+        if (auto strong = weak.lock()) {
+          strong->drain();
+        }
+      });
+    }
+  }
+
+  static std::shared_ptr<FastCallQueue> create(Sink sink) {
+    auto queue = std::make_shared<FastCallQueue>(std::move(sink));
+    queue->self_ = queue;
+    return queue;
+  }
+
+private:
+  static constexpr size_t kCapacity = 4096;
+
+  void drain() {
+    // Reset before popping so a push racing with this drain either lands in
+    // this batch or schedules the next one.
+    drainScheduled_.store(false, std::memory_order_release);
+    std::vector<FastCall> batch;
+    FastCall call;
+    while (calls_.tryPop(call)) {
+      batch.push_back(std::move(call));
+    }
+    if (!batch.empty()) {
+      sink_(std::move(batch));
+    }
+  }
+
+  Sink sink_;
+  MpscRing<FastCall> calls_;
+  dispatch_queue_t queue_;
+  std::atomic<bool> drainScheduled_{false};
+  std::weak_ptr<FastCallQueue> self_;
+};
+
+static std::string stringifyDetails(jsi::Runtime &rt, const jsi::Value &value) {
+  if (!value.isObject()) {
+    return "{}";
+  }
+  try {
+    jsi::Function stringify = rt.global()
+                                  .getPropertyAsObject(rt, "JSON")
+                                  .getPropertyAsFunction(rt, "stringify");
+    jsi::Value json = stringify.call(rt, value);
+    return json.isString() ? json.getString(rt).utf8(rt) : "{}";
+  } catch (const std::exception &) {
+    // Cyclic or otherwise unserializable details - record the event without them.
+    return "{}";
+  }
+}
+
+class RejourneyTurboModule : public facebook::react::NativeRejourneySpecJSI {
+public:
+  RejourneyTurboModule(const facebook::react::ObjCTurboModule::InitParams &params,
+                       std::shared_ptr<FastCallQueue> calls)
+      : NativeRejourneySpecJSI(params), calls_(std::move(calls)) {}
+
+  jsi::Value get(jsi::Runtime &rt, const jsi::PropNameID &propName) override {
+    std::string name = propName.utf8(rt);
+    std::shared_ptr<FastCallQueue> calls = calls_;
+
+    if (name == "logEventFast") {
+      return jsi::Function::createFromHostFunction(
+          rt, propName, 2,
+          [calls](jsi::Runtime &rt, const jsi::Value &, const jsi::Value *args,
+                  size_t count) -> jsi::Value {
+            if (count < 1 || !args[0].isString()) {
+              return jsi::Value::undefined();
+            }
+            FastCall call{FastCallKind::LogEvent, args[0].getString(rt).utf8(rt),
+                          count > 1 ? stringifyDetails(rt, args[1]) : "{}"};
+            calls->push(std::move(call));
+            return jsi::Value::undefined();
+          });
+    }
+    if (name == "screenChangedFast") {
+      return jsi::Function::createFromHostFunction(
+          rt, propName, 1,
+          [calls](jsi::Runtime &rt, const jsi::Value &, const jsi::Value *args,
+                  size_t count) -> jsi::Value {
+            if (count < 1 || !args[0].isString()) {
+              return jsi::Value::undefined();
+            }
+            calls->push(FastCall{FastCallKind::ScreenChanged,
+                                 args[0].getString(rt).utf8(rt)});
+            return jsi::Value::undefined();
+          });
+    }
+    if (name == "onScrollFast") {
+      return jsi::Function::createFromHostFunction(
+          rt, propName, 1,
+          [calls](jsi::Runtime &, const jsi::Value &, const jsi::Value *args,
+                  size_t count) -> jsi::Value {
+            double offset = (count > 0 && args[0].isNumber()) ? args[0].asNumber() : 0;
+            calls->push(FastCall{FastCallKind::Scroll, std::string(), std::string(), offset});
+            return jsi::Value::undefined();
+          });
+    }
+    return NativeRejourneySpecJSI::get(rt, propName);
+  }
+
+private:
+  std::shared_ptr<FastCallQueue> calls_;
+};
+
+} // namespace rejourney
+#endif
+
 #pragma mark - Private Interface
 
 @interface Rejourney ()
@@ -115,7 +273,50 @@ RCT_EXPORT_METHOD(removeListeners : (double)count) {
 #if defined(RCT_NEW_ARCH_ENABLED) && defined(RJ_USE_NEW_ARCH_CODEGEN)
 - (std::shared_ptr<facebook::react::TurboModule>)getTurboModule:
     (const facebook::react::ObjCTurboModule::InitParams &)params {
-  return std::make_shared<facebook::react::NativeRejourneySpecJSI>(params);
+  __weak Rejourney *weakSelf = self;
+  auto calls = rejourney::FastCallQueue::create(
+      [weakSelf](std::vector<rejourney::FastCall> &&batch) {
+        Rejourney *strongSelf = weakSelf;
+        RejourneyImpl *impl = [strongSelf ensureImpl];
+        if (!impl) {
+          return;
+        }
+        for (const auto &call : batch) {
+          @autoreleasepool {
+            [strongSelf dispatchFastCall:call toImpl:impl];
+          }
+        }
+      });
+  return std::make_shared<rejourney::RejourneyTurboModule>(params, calls);
+}
+
+- (void)dispatchFastCall:(const rejourney::FastCall &)call
+                  toImpl:(RejourneyImpl *)impl {
+  switch (call.kind) {
+  case rejourney::FastCallKind::LogEvent: {
+    NSString *eventType = [NSString stringWithUTF8String:call.name.c_str()];
+    if (!eventType) {
+      return;
+    }
+    NSData *json = [NSData dataWithBytesNoCopy:(void *)call.detailsJson.data()
+                                        length:call.detailsJson.size()
+                                  freeWhenDone:NO];
+    id details = [NSJSONSerialization JSONObjectWithData:json options:0 error:nil];
+    [impl logEventFast:eventType
+               details:[details isKindOfClass:[NSDictionary class]] ? details : @{}];
+    break;
+  }
+  case rejourney::FastCallKind::ScreenChanged: {
+    NSString *screenName = [NSString stringWithUTF8String:call.name.c_str()];
+    if (screenName) {
+      [impl screenChangedFast:screenName];
+    }
+    break;
+  }
+  case rejourney::FastCallKind::Scroll:
+    [impl onScrollFast:call.number];
+    break;
+  }
 }
 #endif
 
@@ -0,0 +1,66 @@
+import { describe, expect, it, vi } from 'vitest';
+import {
+  logEventFireAndForget,
+  onScrollFireAndForget,
+  resolveFastPath,
+  screenChangedFireAndForget,
+} from '../../sdk/nativeFastPath';
+import type { Spec } from '../../NativeRejourney';
+
+function promiseSpec() {
+  return {
+    logEvent: vi.fn(async () => ({ success: true })),
+    screenChanged: vi.fn(async () => ({ success: true })),
+    onScroll: vi.fn(async () => ({ success: true })),
+  };
+}
+
+describe('nativeFastPath', () => {
+  it('uses the synchronous host functions when all are installed', () => {
+    const native = {
+      ...promiseSpec(),
+      logEventFast: vi.fn(),
+      screenChangedFast: vi.fn(),
+      onScrollFast: vi.fn(),
+    };
+
+    logEventFireAndForget(native as unknown as Spec, 'button_click', { id: 'submit' });
+    screenChangedFireAndForget(native as unknown as Spec, 'Home');
+    expect(onScrollFireAndForget(native as unknown as Spec, 120)).toBe(true);
+
+    expect(native.logEventFast).toHaveBeenCalledWith('button_click', { id: 'submit' });
+    expect(native.screenChangedFast).toHaveBeenCalledWith('Home');
+    expect(native.onScrollFast).toHaveBeenCalledWith(120);
+    expect(native.logEvent).not.toHaveBeenCalled();
+    expect(native.screenChanged).not.toHaveBeenCalled();
+  });
+
+  it('falls back to the promise methods when the host functions are missing', () => {
+    const native = promiseSpec();
+
+    logEventFireAndForget(native as unknown as Spec, 'log', { level: 'info' });
+    screenChangedFireAndForget(native as unknown as Spec, 'Settings');
+
+    expect(native.logEvent).toHaveBeenCalledWith('log', { level: 'info' });
+    expect(native.screenChanged).toHaveBeenCalledWith('Settings');
+    expect(onScrollFireAndForget(native as unknown as Spec, 10)).toBe(false);
+  });
+
+  it('resolves the host functions once per module instance', () => {
+    let reads = 0;
+    const native = {
+      ...promiseSpec(),
+      get logEventFast() {
+        reads++;
+        return () => undefined;
+      },
+      screenChangedFast: () => undefined,
+      onScrollFast: () => undefined,
+    };
+
+    resolveFastPath(native as unknown as Spec);
+    resolveFastPath(native as unknown as Spec);
+
+    expect(reads).toBe(1);
+  });
+});
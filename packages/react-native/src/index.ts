@@ -55,6 +55,7 @@ import type { Spec } from './NativeRejourney';
 // SDK version is safe - no react-native imports
 import { SDK_VERSION } from './sdk/constants';
 import { resolveRejourneyNativeModule } from './sdk/resolveRejourneyNative';
+import { logEventFireAndForget, onScrollFireAndForget } from './sdk/nativeFastPath';
 import {
   DEFAULT_REMOTE_CONFIG,
   deriveRemoteStartState,
@@ -823,7 +824,7 @@ export const Rejourney: RejourneyAPI = {
     safeNativeCallSync(
       'logEvent',
       () => {
-        getRejourneyNative()!.logEvent(name, properties || {}).catch(() => { });
+        logEventFireAndForget(getRejourneyNative()!, name, properties || {});
       },
       undefined
     );
@@ -1095,6 +1096,13 @@ export const Rejourney: RejourneyAPI = {
     // Track scroll for metrics
     getAutoTracking().trackScroll();
 
+    const handledSync = safeNativeCallSync(
+      'onScroll',
+      () => onScrollFireAndForget(getRejourneyNative()!, scrollOffset),
+      false
+    );
+    if (handledSync) return;
+
     await safeNativeCall(
       'onScroll',
       () => getRejourneyNative()!.onScroll(scrollOffset),
@@ -1250,7 +1258,7 @@ export const Rejourney: RejourneyAPI = {
           cached: request.cached,
         };
 
-        getRejourneyNative()!.logEvent('network_request', networkEvent).catch(() => { });
+        logEventFireAndForget(getRejourneyNative()!, 'network_request', networkEvent);
       },
       undefined
     );
@@ -36,6 +36,7 @@ import type {
   ErrorEvent,
 } from '../types';
 import { resolveRejourneyNativeModule } from './resolveRejourneyNative';
+import { logEventFireAndForget, screenChangedFireAndForget } from './nativeFastPath';
 import { logger } from './utils';
 
 // Lazy-loaded React Native modules
@@ -659,7 +660,7 @@ function setupConsoleTracking(): void {
               level,
               message: message.length > 2000 ? message.substring(0, 2000) + '...' : message,
             };
-            nativeModule.logEvent('log', logEvent).catch(() => { });
+            logEventFireAndForget(nativeModule, 'log', logEvent);
           }
         }
       } catch {
@@ -1067,7 +1068,7 @@ export function trackScreen(screenName: string): void {
       if (__DEV__) {
         logger.debug('Notifying native screenChanged:', screenName);
       }
-      RejourneyNative.screenChanged(screenName).catch((e: Error) => {
+      screenChangedFireAndForget(RejourneyNative, screenName, (e: Error) => {
         if (__DEV__) {
           logger.debug('Native screenChanged error:', e);
         }
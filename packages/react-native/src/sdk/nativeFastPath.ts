@@ -0,0 +1,72 @@
+import type { Spec } from '../NativeRejourney';
+
+/**
+ * Synchronous, fire-and-forget entry points installed by the iOS TurboModule
+ * host object (see Rejourney.mm). They are intentionally not part of the
+ * codegen Spec: old-architecture builds and Android do not expose them, and
+ * callers fall back to the promise-returning methods.
+ */
+export type RejourneyFastPath = {
+  logEventFast?: (eventType: string, details: Object) => void;
+  screenChangedFast?: (screenName: string) => void;
+  onScrollFast?: (offsetY: number) => void;
+};
+
+type ResolvedFastPath = Required<RejourneyFastPath> | null;
+
+// Each property read on the host object creates a fresh host function, so the
+// lookup is done once per native module instance.
+const fastPathCache = new WeakMap<object, ResolvedFastPath>();
+
+export function resolveFastPath(nativeModule: Spec): ResolvedFastPath {
+  const cached = fastPathCache.get(nativeModule);
+  if (cached !== undefined) return cached;
+
+  const candidate = nativeModule as Spec & RejourneyFastPath;
+  const resolved: ResolvedFastPath =
+    typeof candidate.logEventFast === 'function' &&
+    typeof candidate.screenChangedFast === 'function' &&
+    typeof candidate.onScrollFast === 'function'
+      ? {
+        logEventFast: candidate.logEventFast,
+        screenChangedFast: candidate.screenChangedFast,
+        onScrollFast: candidate.onScrollFast,
+      }
+      : null;
+
+  fastPathCache.set(nativeModule, resolved);
+  return resolved;
+}
+
+export function logEventFireAndForget(
+  nativeModule: Spec,
+  eventType: string,
+  details: Object
+): void {
+  const fastPath = resolveFastPath(nativeModule);
+  if (fastPath) {
+    fastPath.logEventFast(eventType, details);
+    return;
+  }
+  nativeModule.logEvent(eventType, details).catch(() => { });
+}
+
+export function screenChangedFireAndForget(
+  nativeModule: Spec,
+  screenName: string,
+  onError?: (error: Error) => void
+): void {
+  const fastPath = resolveFastPath(nativeModule);
+  if (fastPath) {
+    fastPath.screenChangedFast(screenName);
+    return;
+  }
+  nativeModule.screenChanged(screenName).catch((e: Error) => onError?.(e));
+}
+
+export function onScrollFireAndForget(nativeModule: Spec, offsetY: number): boolean {
+  const fastPath = resolveFastPath(nativeModule);
+  if (!fastPath) return false;
+  fastPath.onScrollFast(offsetY);
+  return true;
+}
@@ -707,6 +707,10 @@ export interface SDKMetrics {
   lastRetryTime: number | null;
   totalBytesUploaded: number;
   totalBytesEvicted: number;
+  /** iOS: view classifications answered from the per-class cache */
+  classificationCacheHits?: number;
+  /** iOS: view classes classified for the first time */
+  classificationCacheMisses?: number;
 }
 
 /**